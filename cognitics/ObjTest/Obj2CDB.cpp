@@ -10,7 +10,7 @@
 #include "Obj2CDB.h"
 #include "OBJRender.h"
 #include "ip/pngwrapper.h"
-#include "sfa/BSP.h"
+#include "sfa/RTree.h"
 #include "rapidxml/rapidxml.hpp"
 
 using namespace rapidxml;
@@ -99,7 +99,7 @@ Obj2CDB::Obj2CDB(const std::string &inputOBJDir,
 
     ltp_ellipsoid = new Cognitics::CoordinateSystems::EllipsoidTangentPlane(dbOriginLat, dbOriginLon);
     collectHighestLODTiles();
-    buildBSP();
+    buildRTree();
 }
 
 Obj2CDB::~Obj2CDB()
@@ -126,7 +126,7 @@ int Obj2CDB::getLODFromFilename(const std::string &filename)
     return 0;
 }
 
-void Obj2CDB::buildBSP()
+void Obj2CDB::buildRTree()
 {
     //objFiles
     for (auto&& fi : objFiles)
@@ -173,11 +173,11 @@ void Obj2CDB::buildBSP()
         aoi_poly->addRing(ring);
         //Keep track of the geometry and its associated file
         bestTileLOD[aoi_poly] = fi;
-        bsp.addGeometry(aoi_poly);
+        rtree.addGeometry(aoi_poly);
         delete scene;
     }
 
-    bsp.generate(envelopes);
+    rtree.generate();
     dbLeftLon = 0;
     dbRightLon = 0;
     dbBottomLat = 0;
@@ -246,14 +246,14 @@ renderJobList_t Obj2CDB::collectRenderJobs(cognitics::cdb::Dataset dataset, int
     for (auto&& tile : cdbTiles)
     {
         RenderJob renderJob(tile);
-        sfa::BSPCollectGeometriesVisitor bspVisitor;
+        sfa::RTreeCollectGeometriesVisitor rtreeVisitor;
         std::string absoluteFilePath = ccl::joinPaths(cdbOutputDir, tile.getFilename());
         ccl::FileInfo tileFi(absoluteFilePath);
         ccl::makeDirectory(tileFi.getDirName());
         renderJob.cdbFilename = absoluteFilePath;
         log << "\t" << absoluteFilePath << log.endl;
         //get all scenes that intersect with this tile.
-        //bsp.
+        //rtree.
         double tileLocalBottom = 0;
         double tileLocalTop = 0;
         double tileLocalLeft = 0;
@@ -283,13 +283,13 @@ renderJobList_t Obj2CDB::collectRenderJobs(cognitics::cdb::Dataset dataset, int
         log << "LL: " << tileLocalLeft << " , " << tileLocalBottom << log.endl;
         log << "UR: " << tileLocalRight << " , " << tileLocalTop << log.endl;
 
-        bspVisitor.setBounds(tileLocalLeft,
+        rtreeVisitor.setBounds(tileLocalLeft,
             tileLocalBottom,
             tileLocalRight,
             tileLocalTop);
-        bspVisitor.visiting(&bsp);
+        rtreeVisitor.visiting(&rtree);
         scenegraph::Scene *parentScene = new scenegraph::Scene();
-        for (auto&& geometry : bspVisitor.results)
+        for (auto&& geometry : rtreeVisitor.results)
         {
             std::string sourceOBJ = bestTileLOD[geometry].getFileName();
             log << "\t\tUsing " << sourceOBJ << " as source file." << log.endl;
@@ -3,7 +3,7 @@
 #include <string>
 #include <vector>
 #include <list>
-#include "sfa/BSP.h"
+#include "sfa/RTree.h"
 #include "ccl/ObjLog.h"
 #include "cdb_tile/Tile.h"
 #include "CoordinateSystems/EllipsoidTangentPlane.h"
@@ -60,14 +60,13 @@ class Obj2CDB
     double offsetZ;
 
     std::vector<ccl::FileInfo> objFiles;
-    sfa::BSP bsp;
-    std::map<sfa::Geometry *, sfa::LineString *> envelopes;
+    sfa::RTree rtree;
     std::map<sfa::Geometry *, ccl::FileInfo> bestTileLOD;
     Cognitics::CoordinateSystems::EllipsoidTangentPlane *ltp_ellipsoid;
 
     int getLODFromFilename(const std::string &filename);
     void collectHighestLODTiles();
-    void buildBSP();
+    void buildRTree();
     bool readMetadataXML(const std::string &sourceDir);
 public:
     Obj2CDB(const std::string &inputOBJDir,
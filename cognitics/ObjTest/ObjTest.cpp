@@ -8,7 +8,7 @@
 #include "Obj2CDB.h"
 #include "ccl/StringUtils.h"
 #include <scenegraph/ExtentsVisitor.h>
-#include "sfa/BSP.h"
+#include "sfa/RTree.h"
 #include "CoordinateSystems/EllipsoidTangentPlane.h"
 #include "cdb_tile/CoordinatesRange.h"
 #include "cdb_tile/Tile.h"
@@ -6,12 +6,16 @@
 #include <ccl/FileInfo.h>
 #include <ccl/ObjLog.h>
 #include <ccl/LogStream.h>
+#include <ccl/AsyncLog.h>
+#include <ccl/Trace.h>
+#include <ccl/Status.h>
 #include <ccl/ArgumentParser.h>
 #include <ccl/gdal.h>
 
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <memory>
 
 #if _WIN32
 #include <filesystem>
@@ -29,7 +33,10 @@ int main(int argc, char** argv)
     std::ios_base::sync_with_stdio(false);
     cognitics::gdal::init(argv[0]);
 
-    ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG)));
+    // workers log per tile; the async log keeps them from waiting on console and file output
+    ccl::AsyncLogSP async_log(new ccl::AsyncLog(ccl::LDEBUG));
+    async_log->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG, std::cout, false)));
+    ccl::Log::instance()->attach(async_log);
 
     auto args = cognitics::ArgumentParser();
     args.AddOption("logfile", 1, "<filename>", "filename for log output");
@@ -41,10 +48,16 @@ int main(int argc, char** argv)
     args.AddOption("dry-run", 0, "", "perform dry run");
     args.AddOption("count-tiles", 0, "", "perform a dry run, and only report the number of tiles");
     args.AddOption("build-overviews", 0, "", "perform LOD downsampling");
+    args.AddOption("trace", 1, "<filename>", "write a chrome://tracing timeline of the run");
+    args.AddOption("status", 1, "<filename>", "periodically log memory use and throughput, and write them to <filename> as JSON");
+    args.AddOption("status-interval", 1, "<seconds>", "status report interval (default 10)");
     args.AddArgument("CDB");
 
     if(args.Parse(argc, argv) == EXIT_FAILURE)
+    {
+        ccl::Log::instance()->detach(async_log);
         return EXIT_FAILURE;
+    }
 
     auto params = cognitics::cdb::cdb_inject_parameters();
     params.cdb = args.Arguments().at(0);
@@ -53,7 +66,7 @@ int main(int argc, char** argv)
     {
         auto logfn = args.Parameters("logfile").at(0);
         logfile.open(logfn.c_str(), std::ios::out);
-        ccl::Log::instance()->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG, logfile)));
+        async_log->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG, logfile, false)));
     }
     if(args.Option("workers"))
         params.workers = std::stoi(args.Parameters("workers").at(0));
@@ -72,6 +85,17 @@ int main(int argc, char** argv)
         params.east = std::stod(args.Parameters("bounds").at(3));
     }
 
+    if(args.Option("trace"))
+        ccl::Trace::enable();
+
+    std::unique_ptr<ccl::StatusReporter> status;
+    if(args.Option("status") || args.Option("status-interval"))
+    {
+        double interval = args.Option("status-interval") ? std::stod(args.Parameters("status-interval").at(0)) : 10.0;
+        std::string filename = args.Option("status") ? args.Parameters("status").at(0) : std::string();
+        status.reset(new ccl::StatusReporter(interval, filename));
+    }
+
     ccl::ObjLog log;
     log << ccl::LNOTICE << args.Report() << log.endl;
 
@@ -79,6 +103,12 @@ int main(int argc, char** argv)
     cognitics::cdb::cdb_inject(params);
     auto ts_stop = std::chrono::steady_clock::now();
     log << "ELAPSED: " << std::chrono::duration<double>(ts_stop - ts_start).count() << "s" << log.endl;
-    
+    if(args.Option("trace"))
+        ccl::Trace::writeChromeTrace(args.Parameters("trace").at(0));
+    status.reset();
+
+    // write out the queued messages while logfile is still open
+    ccl::Log::instance()->detach(async_log);
+    async_log->flush();
     return EXIT_SUCCESS;
 }
@@ -4,6 +4,8 @@
 #include <ccl/LogStream.h>
 #include <ccl/ObjLog.h>
 #include <ccl/ArgumentParser.h>
+#include <ccl/Trace.h>
+#include <ccl/Status.h>
 #include <cdb_util/cdb_util.h>
 
 #include <ccl/gdal.h>
@@ -11,6 +13,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <chrono>
+#include <memory>
 
 int main(int argc, char** argv)
 {
@@ -19,6 +22,9 @@ int main(int argc, char** argv)
     auto args = cognitics::ArgumentParser();
     args.AddOption("logfile", 1, "<filename>", "filename for log output");
     args.AddOption("workers", 1, "<N>", "number of worker threads (default 8)");
+    args.AddOption("trace", 1, "<filename>", "write a chrome://tracing timeline of the run");
+    args.AddOption("status", 1, "<filename>", "periodically log memory use and throughput, and write them to <filename> as JSON");
+    args.AddOption("status-interval", 1, "<seconds>", "status report interval (default 10)");
     args.AddArgument("CDB");
     if(args.Parse(argc, argv) == EXIT_FAILURE)
         return EXIT_FAILURE;
@@ -35,6 +41,16 @@ int main(int argc, char** argv)
     int workers = 8;
     if(args.Option("workers"))
         workers = std::stoi(args.Parameters("workers").at(0));
+    if(args.Option("trace"))
+        ccl::Trace::enable();
+
+    std::unique_ptr<ccl::StatusReporter> status;
+    if(args.Option("status") || args.Option("status-interval"))
+    {
+        double interval = args.Option("status-interval") ? std::stod(args.Parameters("status-interval").at(0)) : 10.0;
+        std::string filename = args.Option("status") ? args.Parameters("status").at(0) : std::string();
+        status.reset(new ccl::StatusReporter(interval, filename));
+    }
 
     ccl::ObjLog log;
     log << args.Report() << log.endl;
@@ -45,6 +61,9 @@ int main(int argc, char** argv)
 
     log << log.endl;
     log << "cdb-lod runtime: " << std::chrono::duration<double>(ts_stop - ts_start).count() << "s" << log.endl;
+    if(args.Option("trace"))
+        ccl::Trace::writeChromeTrace(args.Parameters("trace").at(0));
+    status.reset();
     
     return EXIT_SUCCESS;
 }
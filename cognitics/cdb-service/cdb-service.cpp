@@ -17,6 +17,8 @@ int main(int argc, char** argv)
     args.AddOption("logfile", 1, "<filename>", "filename for log output");
     args.AddOption("bind", 1, "<bind string>", "bind string (port or ip:port)");
     args.AddOption("cdb", 1, "<cdbpath>", "path to CDB");
+    args.AddOption("status", 1, "<filename>", "periodically log memory use and throughput, and write them to <filename> as JSON");
+    args.AddOption("status-interval", 1, "<seconds>", "status report interval (default 10); also served at /status");
     if(args.Parse(argc, argv) == EXIT_FAILURE)
         return EXIT_FAILURE;
 
@@ -33,6 +35,11 @@ int main(int argc, char** argv)
         params.cdb = args.Parameters("cdb").at(0);
     if(args.Option("bind"))
         params.bind = args.Parameters("bind").at(0);
+    if(args.Option("status"))
+        params.status_file = args.Parameters("status").at(0);
+    if(args.Option("status-interval"))
+        params.status_interval = std::stod(args.Parameters("status-interval").at(0));
+    params.status_log = args.Option("status") || args.Option("status-interval");
 
     ccl::ObjLog log;
     log << args.Report() << log.endl;
@@ -186,6 +186,7 @@ int usage_validate(const std::string& error = "")
     cout_global_options();
     std::cout << "    Command Options:\n";
     std::cout << "        -bounds <n> <s> <e> <w>  bounds for area of interest\n";
+    std::cout << "        -workers <#>             number of worker threads (default: 8)\n";
     std::cout << "    Supported Components (dataset cs1 cs2):\n";
     std::cout << "        GTFeature 001 001\n";
     std::cout << "        GTFeature 002 001\n";
@@ -761,6 +762,7 @@ int main_validate(size_t arg_start)
     double south { -DBL_MAX };
     double east { DBL_MAX };
     double west { -DBL_MAX };
+    int workers { 8 };
     int dataset { 0 };
     int cs1 { 0 };
     int cs2 { 0 };
@@ -780,6 +782,14 @@ int main_validate(size_t arg_start)
             west = to_double(args[argi], -DBL_MAX);
             continue;
         }
+        if(args[argi] == "-workers")
+        {
+            ++argi;
+            if(argi > argc - 1)
+                return usage_validate("Missing worker thread count");
+            workers = to_int(args[argi], 8);
+            continue;
+        }
         if(dataset == 0)
         {
             dataset = to_int(args[argi], 0);
@@ -806,17 +816,17 @@ int main_validate(size_t arg_start)
     }
     if((dataset == 100) && (cs1 == 1) && (cs2 == 1))    // GSFeature, Man-made, point features
     {
-        cognitics::cdb::ReportMissingGSFeatureData(cdb, std::make_tuple(north, south, east, west));
+        cognitics::cdb::ReportMissingGSFeatureData(cdb, std::make_tuple(north, south, east, west), workers);
         return EXIT_SUCCESS;
     }
     if((dataset == 101) && (cs1 == 1) && (cs2 == 1))    // GTFeature, Man-made, point features
     {
-        cognitics::cdb::ReportMissingGTFeatureData(cdb, std::make_tuple(north, south, east, west));
+        cognitics::cdb::ReportMissingGTFeatureData(cdb, std::make_tuple(north, south, east, west), workers);
         return EXIT_SUCCESS;
     }
     if((dataset == 101) && (cs1 == 2) && (cs2 == 1))    // GTFeature, Tree, point features
     {
-        cognitics::cdb::ReportMissingGTFeatureData(cdb, std::make_tuple(north, south, east, west));
+        cognitics::cdb::ReportMissingGTFeatureData(cdb, std::make_tuple(north, south, east, west), workers);
         return EXIT_SUCCESS;
     }
     else
@@ -61,6 +61,7 @@ int main(int argc, char** argv)
     args.AddOption("bounds", 4, "<south> <west> <north> <east>", "bounds for area of interest");
     args.AddOption("gtfeatures", 0, "", "test GTFeatures");
     args.AddOption("gsfeatures", 0, "", "test GSFeatures");
+    args.AddOption("workers", 1, "<#>", "number of worker threads (default: 8)");
     args.AddArgument("CDB");
 
     //if(args.Parse({ "cdbinfo.exe", "-logfile", "d:/cdbinfo.log", "-bounds", "12.8", "45.0", "13.0", "45.2", "D:/CDB/CDB_Yemen_4.0.0" }) == EXIT_FAILURE)
@@ -90,14 +91,18 @@ int main(int argc, char** argv)
         east = strtod(args.Parameters("bounds")[3].c_str(), nullptr);
     }
 
+    int workers = 8;
+    if(args.Option("workers"))
+        workers = std::max<int>(1, atoi(args.Parameters("workers").at(0).c_str()));
+
     ccl::ObjLog log;
     log << args.Report() << log.endl;
 
     auto ts_start = std::chrono::steady_clock::now();
     if(args.Option("gtfeatures"))
-        cognitics::cdb::ReportMissingGTFeatureData(cdb, std::make_tuple(north, south, east, west));
+        cognitics::cdb::ReportMissingGTFeatureData(cdb, std::make_tuple(north, south, east, west), workers);
     if(args.Option("gsfeatures"))
-        cognitics::cdb::ReportMissingGSFeatureData(cdb, std::make_tuple(north, south, east, west));
+        cognitics::cdb::ReportMissingGSFeatureData(cdb, std::make_tuple(north, south, east, west), workers);
     auto ts_stop = std::chrono::steady_clock::now();
     log << "ReportMissingFeatureData: " << std::chrono::duration<double>(ts_stop - ts_start).count() << "s" << log.endl;
     
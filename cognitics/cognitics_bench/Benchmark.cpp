@@ -0,0 +1,303 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#if _WIN32
+#include <filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#elif __GNUC__ && (__GNUC__ < 8)
+#include <experimental/filesystem>
+namespace std { namespace filesystem = std::experimental::filesystem; }
+#else
+#include <filesystem>
+#endif
+
+namespace
+{
+    const uint64_t MAX_ITERATIONS = 1000000000;
+
+    std::vector<std::unique_ptr<bench::Benchmark> > &registry(void)
+    {
+        static std::vector<std::unique_ptr<bench::Benchmark> > instance;
+        return instance;
+    }
+
+    std::string &scratchDirectory(void)
+    {
+        static std::string instance;
+        return instance;
+    }
+
+    std::string runName(const bench::Benchmark &benchmark, const std::vector<int64_t> &args)
+    {
+        std::string result = benchmark.name;
+        for(auto arg : args)
+            result += "/" + std::to_string(arg);
+        return result;
+    }
+
+    void writeJSONString(std::ostream &stream, const std::string &str)
+    {
+        stream << '"';
+        for(char c : str)
+        {
+            switch(c)
+            {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                case '\n': stream << "\\n"; break;
+                default:
+                    if((unsigned char)c < 0x20)
+                        stream << ' ';
+                    else
+                        stream << c;
+            }
+        }
+        stream << '"';
+    }
+
+    std::string humanRate(double value, const char *unit)
+    {
+        const char *prefixes[] = { "", "k", "M", "G", "T" };
+        int prefix = 0;
+        while((value >= 1000.0) && (prefix < 4))
+        {
+            value /= 1000.0;
+            ++prefix;
+        }
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(2) << value << prefixes[prefix] << unit;
+        return ss.str();
+    }
+}
+
+namespace bench
+{
+    State::State(const std::vector<int64_t> &args, uint64_t iterations)
+        : args(args), max_iterations(iterations), remaining(iterations), cpu_start(0), real_seconds(0), cpu_seconds(0), running(false), bytes_processed(0), items_processed(0)
+    {
+    }
+
+    void State::startTimer(void)
+    {
+        running = true;
+        cpu_start = std::clock();
+        real_start = std::chrono::steady_clock::now();
+    }
+
+    void State::stopTimer(void)
+    {
+        auto real_stop = std::chrono::steady_clock::now();
+        std::clock_t cpu_stop = std::clock();
+        real_seconds += std::chrono::duration<double>(real_stop - real_start).count();
+        cpu_seconds += double(cpu_stop - cpu_start) / CLOCKS_PER_SEC;
+        running = false;
+    }
+
+    bool State::keepRunning(void)
+    {
+        if(!skip_message.empty())
+            return false;
+        if((remaining == max_iterations) && !running)
+            startTimer();
+        if(remaining > 0)
+        {
+            --remaining;
+            return true;
+        }
+        if(running)
+            stopTimer();
+        return false;
+    }
+
+    void State::pauseTiming(void)
+    {
+        if(running)
+            stopTimer();
+    }
+
+    void State::resumeTiming(void)
+    {
+        if(!running)
+            startTimer();
+    }
+
+    Benchmark *Benchmark::arg(int64_t value)
+    {
+        arg_sets.push_back(std::vector<int64_t>(1, value));
+        return this;
+    }
+
+    Benchmark *Benchmark::args(const std::vector<int64_t> &values)
+    {
+        arg_sets.push_back(values);
+        return this;
+    }
+
+    Benchmark *Benchmark::range(int64_t start, int64_t end, int64_t multiplier)
+    {
+        for(int64_t value = start; value < end; value *= multiplier)
+            arg(value);
+        return arg(end);
+    }
+
+    Benchmark *registerBenchmark(const std::string &name, const Function &function)
+    {
+        registry().emplace_back(new Benchmark(name, function));
+        return registry().back().get();
+    }
+
+    std::vector<Result> Runner::run(std::ostream *console)
+    {
+        std::vector<Result> results;
+        for(auto &benchmark : registry())
+        {
+            auto arg_sets = benchmark->arg_sets;
+            if(arg_sets.empty())
+                arg_sets.push_back(std::vector<int64_t>());
+            for(auto &args : arg_sets)
+            {
+                Result result = Result();
+                result.name = runName(*benchmark, args);
+                if(!filter.empty() && (result.name.find(filter) == std::string::npos))
+                    continue;
+
+                // grow the iteration count until a run takes at least min_time, then report that run
+                uint64_t iterations = 1;
+                while(true)
+                {
+                    State state(args, iterations);
+                    benchmark->function(state);
+                    if(!state.skip_message.empty())
+                    {
+                        result.error = state.skip_message;
+                        break;
+                    }
+                    double seconds = state.real_seconds;
+                    if((seconds >= min_time) || (iterations >= MAX_ITERATIONS))
+                    {
+                        result.iterations = iterations;
+                        result.real_time_ns = state.real_seconds * 1e9 / iterations;
+                        result.cpu_time_ns = state.cpu_seconds * 1e9 / iterations;
+                        result.bytes_per_second = (seconds > 0) ? state.bytes_processed / seconds : 0;
+                        result.items_per_second = (seconds > 0) ? state.items_processed / seconds : 0;
+                        result.label = state.label;
+                        break;
+                    }
+                    double multiplier = (seconds > 0) ? (min_time * 1.4 / seconds) : 10.0;
+                    multiplier = std::min<double>(std::max<double>(multiplier, 1.0), 10.0);
+                    iterations = std::min<uint64_t>(std::max<uint64_t>(uint64_t(iterations * multiplier), iterations + 1), MAX_ITERATIONS);
+                }
+                if(console)
+                    writeConsole(*console, result);
+                results.push_back(result);
+            }
+        }
+        return results;
+    }
+
+    void Runner::list(std::ostream &stream)
+    {
+        for(auto &benchmark : registry())
+        {
+            if(benchmark->arg_sets.empty())
+                stream << benchmark->name << "\n";
+            for(auto &args : benchmark->arg_sets)
+                stream << runName(*benchmark, args) << "\n";
+        }
+    }
+
+    void Runner::writeConsole(std::ostream &stream, const Result &result)
+    {
+        stream << std::left << std::setw(48) << result.name << std::right;
+        if(!result.error.empty())
+        {
+            stream << " SKIPPED: " << result.error << "\n";
+            return;
+        }
+        stream << std::fixed << std::setprecision(0);
+        stream << std::setw(15) << result.real_time_ns << " ns" << std::setw(15) << result.cpu_time_ns << " ns" << std::setw(12) << result.iterations;
+        if(result.bytes_per_second > 0)
+            stream << "  " << humanRate(result.bytes_per_second, "B/s");
+        if(result.items_per_second > 0)
+            stream << "  " << humanRate(result.items_per_second, " items/s");
+        if(!result.label.empty())
+            stream << "  " << result.label;
+        stream << "\n";
+    }
+
+    void Runner::writeJSON(std::ostream &stream, const std::vector<Result> &results)
+    {
+        std::time_t now = std::time(NULL);
+        char date[64];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        stream << "{\n  \"context\": {\n";
+        stream << "    \"date\": \"" << date << "\",\n";
+        stream << "    \"executable\": \"cognitics_bench\",\n";
+        stream << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+        stream << "    \"library_build_type\": \"release\"\n";
+#else
+        stream << "    \"library_build_type\": \"debug\"\n";
+#endif
+        stream << "  },\n  \"benchmarks\": [";
+        for(size_t i = 0, c = results.size(); i < c; ++i)
+        {
+            const Result &result = results[i];
+            stream << (i ? ",\n" : "\n") << "    {\n      \"name\": ";
+            writeJSONString(stream, result.name);
+            stream << ",\n      \"run_type\": \"iteration\"";
+            if(!result.error.empty())
+            {
+                stream << ",\n      \"error_occurred\": true,\n      \"error_message\": ";
+                writeJSONString(stream, result.error);
+            }
+            else
+            {
+                stream << std::defaultfloat << std::setprecision(10);
+                stream << ",\n      \"iterations\": " << result.iterations;
+                stream << ",\n      \"real_time\": " << result.real_time_ns;
+                stream << ",\n      \"cpu_time\": " << result.cpu_time_ns;
+                stream << ",\n      \"time_unit\": \"ns\"";
+                if(result.bytes_per_second > 0)
+                    stream << ",\n      \"bytes_per_second\": " << result.bytes_per_second;
+                if(result.items_per_second > 0)
+                    stream << ",\n      \"items_per_second\": " << result.items_per_second;
+                if(!result.label.empty())
+                {
+                    stream << ",\n      \"label\": ";
+                    writeJSONString(stream, result.label);
+                }
+            }
+            stream << "\n    }";
+        }
+        stream << "\n  ]\n}\n";
+    }
+
+    std::string scratchPath(const std::string &filename)
+    {
+        std::string &dir = scratchDirectory();
+        if(dir.empty())
+        {
+            auto path = std::filesystem::temp_directory_path() / ("cognitics_bench." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+            std::filesystem::create_directories(path);
+            dir = path.string();
+        }
+        return (std::filesystem::path(dir) / filename).string();
+    }
+
+    void removeScratchDirectory(void)
+    {
+        std::string &dir = scratchDirectory();
+        if(dir.empty())
+            return;
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+        dir.clear();
+    }
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness for cognitics_bench.
+// Modeled on Google Benchmark (which is not part of ThirdParty) so the JSON output works with its compare tooling:
+//
+//      void BM_Something(bench::State &state)
+//      {
+//          auto input = makeInput(state.range(0));     // setup is not timed
+//          for(auto _ : state)
+//              doSomething(input);
+//          state.setItemsProcessed(state.iterations() * state.range(0));
+//      }
+//      COGNITICS_BENCHMARK(BM_Something)->arg(100)->arg(10000);
+
+namespace bench
+{
+    class State
+    {
+    private:
+        std::vector<int64_t> args;
+        uint64_t max_iterations;
+        uint64_t remaining;
+        std::chrono::steady_clock::time_point real_start;
+        std::clock_t cpu_start;
+        double real_seconds;
+        double cpu_seconds;
+        bool running;
+        int64_t bytes_processed;
+        int64_t items_processed;
+        std::string label;
+        std::string skip_message;
+
+        void startTimer(void);
+        void stopTimer(void);
+
+    public:
+        State(const std::vector<int64_t> &args, uint64_t iterations);
+
+        // for(auto _ : state) { ... } runs the body iterations() times
+        struct Value { };
+        struct Iterator
+        {
+            State *state;
+            bool operator!=(const Iterator &) const { return state->keepRunning(); }
+            Iterator &operator++(void) { return *this; }
+            Value operator*(void) const { return Value(); }
+        };
+        Iterator begin(void) { return Iterator{ this }; }
+        Iterator end(void) { return Iterator{ this }; }
+
+        // Loop condition; the time between the first call and the call that returns false is measured.
+        bool keepRunning(void);
+
+        // Excludes per-iteration setup from the measurement.
+        void pauseTiming(void);
+        void resumeTiming(void);
+
+        int64_t range(size_t index = 0) const { return args.at(index); }
+        uint64_t iterations(void) const { return max_iterations; }
+
+        void setBytesProcessed(int64_t bytes) { bytes_processed = bytes; }
+        void setItemsProcessed(int64_t items) { items_processed = items; }
+        void setLabel(const std::string &text) { label = text; }
+
+        // Reports the benchmark as skipped, e.g. when a GDAL driver is not available. Call before the loop.
+        void skipWithError(const std::string &message) { skip_message = message; }
+
+        friend class Runner;
+    };
+
+    typedef std::function<void(State &)> Function;
+
+    class Benchmark
+    {
+    public:
+        std::string name;
+        Function function;
+        std::vector<std::vector<int64_t> > arg_sets;
+
+        Benchmark(const std::string &name, const Function &function) : name(name), function(function) { }
+
+        Benchmark *arg(int64_t value);
+        Benchmark *args(const std::vector<int64_t> &values);
+        // arg() for start, start * multiplier, ... up to and including end
+        Benchmark *range(int64_t start, int64_t end, int64_t multiplier = 8);
+    };
+
+    Benchmark *registerBenchmark(const std::string &name, const Function &function);
+
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations;
+        double real_time_ns;        // per iteration
+        double cpu_time_ns;         // per iteration
+        double bytes_per_second;
+        double items_per_second;
+        std::string label;
+        std::string error;
+    };
+
+    class Runner
+    {
+    public:
+        std::string filter;         // substring match on the full benchmark name; empty runs everything
+        double min_time;            // seconds each benchmark runs for once the iteration count is calibrated
+
+        Runner(void) : min_time(0.5) { }
+
+        // Runs the matching benchmarks, writing each result to console (if given) as it completes.
+        std::vector<Result> run(std::ostream *console = NULL);
+        static void list(std::ostream &stream);
+        static void writeConsole(std::ostream &stream, const Result &result);
+        static void writeJSON(std::ostream &stream, const std::vector<Result> &results);
+    };
+
+    // Scratch directory for generated inputs, created on first use and removed by removeScratchDirectory().
+    std::string scratchPath(const std::string &filename);
+    void removeScratchDirectory(void);
+
+    // Keeps the optimizer from discarding a result.
+    template <typename T> inline void doNotOptimize(T const &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+}
+
+#define COGNITICS_BENCHMARK_CONCAT2(a, b) a##b
+#define COGNITICS_BENCHMARK_CONCAT(a, b) COGNITICS_BENCHMARK_CONCAT2(a, b)
+#define COGNITICS_BENCHMARK(fn) static bench::Benchmark *COGNITICS_BENCHMARK_CONCAT(fn##_registration_, __LINE__) = bench::registerBenchmark(#fn, fn)
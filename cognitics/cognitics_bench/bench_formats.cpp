@@ -0,0 +1,129 @@
+
+#include "Benchmark.h"
+
+#include <scenegraph/Scene.h>
+#include <scenegraphflt/scenegraphflt.h>
+#include <scenegraphobj/scenegraphobj.h>
+
+#include <cmath>
+#include <fstream>
+#include <memory>
+
+namespace
+{
+    // height field of size x size quads, two textured triangles each
+    scenegraph::Scene *gridScene(int size)
+    {
+        scenegraph::Scene *scene = new scenegraph::Scene;
+        scene->faces.reserve(size_t(size) * size * 2);
+        auto vertex = [](int x, int y) { return sfa::Point(x * 10.0, y * 10.0, 50.0 * sin(x * 0.1) * cos(y * 0.1)); };
+        auto uv = [size](int x, int y) { return sfa::Point(double(x) / size, double(y) / size); };
+        for(int y = 0; y < size; ++y)
+        {
+            for(int x = 0; x < size; ++x)
+            {
+                const int corners[2][3][2] = { { { x, y }, { x + 1, y }, { x + 1, y + 1 } }, { { x, y }, { x + 1, y + 1 }, { x, y + 1 } } };
+                for(int t = 0; t < 2; ++t)
+                {
+                    scenegraph::Face face;
+                    scenegraph::MappedTexture mt;
+                    mt.SetTextureName("grid.rgb");
+                    for(int c = 0; c < 3; ++c)
+                    {
+                        face.verts.push_back(vertex(corners[t][c][0], corners[t][c][1]));
+                        mt.uvs.push_back(uv(corners[t][c][0], corners[t][c][1]));
+                    }
+                    face.textures.push_back(mt);
+                    scene->faces.push_back(face);
+                }
+            }
+        }
+        return scene;
+    }
+
+    size_t fileSize(const std::string &filename)
+    {
+        std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+        return file ? size_t(file.tellg()) : 0;
+    }
+
+    // written directly rather than through buildObjFromScene, so the parse cost isn't tied to that writer's layout
+    std::string objFile(int size)
+    {
+        std::string filename = bench::scratchPath("grid" + std::to_string(size) + ".obj");
+        if(fileSize(filename) > 0)
+            return filename;
+        std::ofstream mtl(bench::scratchPath("material.mtl").c_str(), std::ios::out);
+        mtl << "newmtl grid\nKd 1 1 1\nmap_Kd grid.rgb\n";
+        std::ofstream obj(filename.c_str(), std::ios::out);
+        obj << "mtllib material.mtl\n";
+        for(int y = 0; y <= size; ++y)
+        {
+            for(int x = 0; x <= size; ++x)
+                obj << "v " << x * 10.0 << " " << y * 10.0 << " " << 50.0 * sin(x * 0.1) * cos(y * 0.1) << "\n";
+        }
+        for(int y = 0; y <= size; ++y)
+        {
+            for(int x = 0; x <= size; ++x)
+                obj << "vt " << double(x) / size << " " << double(y) / size << "\n";
+        }
+        obj << "usemtl grid\n";
+        for(int y = 0; y < size; ++y)
+        {
+            for(int x = 0; x < size; ++x)
+            {
+                int a = (y * (size + 1)) + x + 1;
+                int b = a + 1;
+                int c = a + size + 2;
+                int d = a + size + 1;
+                obj << "f " << a << "/" << a << " " << b << "/" << b << " " << c << "/" << c << "\n";
+                obj << "f " << a << "/" << a << " " << c << "/" << c << " " << d << "/" << d << "\n";
+            }
+        }
+        return filename;
+    }
+
+    std::string fltFile(int size)
+    {
+        std::string filename = bench::scratchPath("grid" + std::to_string(size) + ".flt");
+        if(fileSize(filename) > 0)
+            return filename;
+        std::unique_ptr<scenegraph::Scene> scene(gridScene(size));
+        scenegraph::buildOpenFlightFromScene(filename, scene.get());
+        return filename;
+    }
+
+    void BM_OBJ_Parse(bench::State &state)
+    {
+        int size = int(state.range(0));
+        std::string filename = objFile(size);
+        for(auto _ : state)
+        {
+            std::unique_ptr<scenegraph::Scene> scene(scenegraph::buildSceneFromOBJ(filename, false));
+            bench::doNotOptimize(scene);
+        }
+        state.setBytesProcessed(state.iterations() * fileSize(filename));
+        state.setItemsProcessed(state.iterations() * size * size * 2);
+    }
+    COGNITICS_BENCHMARK(BM_OBJ_Parse)->arg(64)->arg(256);
+
+    void BM_FLT_Read(bench::State &state)
+    {
+        int size = int(state.range(0));
+        std::string filename = fltFile(size);
+        if(fileSize(filename) == 0)
+        {
+            state.skipWithError("unable to write " + filename);
+            return;
+        }
+        for(auto _ : state)
+        {
+            std::unique_ptr<scenegraph::Scene> scene(scenegraph::buildSceneFromOpenFlight(filename));
+            bench::doNotOptimize(scene);
+        }
+        state.setBytesProcessed(state.iterations() * fileSize(filename));
+        state.setItemsProcessed(state.iterations() * size * size * 2);
+    }
+    COGNITICS_BENCHMARK(BM_FLT_Read)->arg(64)->arg(256);
+
+}
@@ -0,0 +1,112 @@
+
+#include "Benchmark.h"
+
+#include <ctl/DelaunayTriangulation.h>
+#include <ctl/QTriangulate.h>
+#include <sfa/LineString.h>
+#include <sfa/Polygon.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+namespace
+{
+    const double PI = 3.14159265358979323846;
+
+    // star outline with n vertices alternating between two radii: concave everywhere, so ear clipping can't shortcut it
+    ctl::PointList starContour(int64_t n)
+    {
+        ctl::PointList result;
+        result.reserve(size_t(n));
+        for(int64_t i = 0; i < n; ++i)
+        {
+            double angle = (2.0 * PI * i) / n;
+            double radius = (i % 2) ? 50.0 : 100.0;
+            result.push_back(ctl::Point(radius * cos(angle), radius * sin(angle), 0.0));
+        }
+        return result;
+    }
+
+    sfa::Polygon *circlePolygon(double x, double y, double radius, int64_t n)
+    {
+        sfa::LineString ring;
+        for(int64_t i = 0; i < n; ++i)
+        {
+            double angle = (2.0 * PI * i) / n;
+            ring.addPoint(sfa::Point(x + radius * cos(angle), y + radius * sin(angle)));
+        }
+        ring.addPoint(sfa::Point(x + radius, y));
+        sfa::Polygon *result = new sfa::Polygon;
+        result->addRing(ring);
+        return result;
+    }
+
+    void BM_DelaunayTriangulation_Insert(bench::State &state)
+    {
+        const double size = 1000.0;
+        ctl::PointList boundary;
+        boundary.push_back(ctl::Point(0, 0, 0));
+        boundary.push_back(ctl::Point(size, 0, 0));
+        boundary.push_back(ctl::Point(size, size, 0));
+        boundary.push_back(ctl::Point(0, size, 0));
+
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<double> xy(1.0, size - 1.0);
+        std::uniform_real_distribution<double> z(0.0, 100.0);
+        ctl::PointList points;
+        for(int64_t i = 0; i < state.range(0); ++i)
+            points.push_back(ctl::Point(xy(rng), xy(rng), z(rng)));
+
+        for(auto _ : state)
+        {
+            ctl::DelaunayTriangulation dt(boundary, int(points.size()));
+            for(auto &point : points)
+                dt.InsertWorkingPoint(point);
+            bench::doNotOptimize(dt);
+        }
+        state.setItemsProcessed(state.iterations() * state.range(0));
+    }
+    COGNITICS_BENCHMARK(BM_DelaunayTriangulation_Insert)->arg(1000)->arg(4000)->arg(16000);
+
+    void BM_QTriangulate_Star(bench::State &state)
+    {
+        ctl::PointList contour = starContour(state.range(0));
+        for(auto _ : state)
+        {
+            ctl::PointList triangles = ctl::QTriangulate::apply(contour);
+            bench::doNotOptimize(triangles);
+        }
+        state.setItemsProcessed(state.iterations() * state.range(0));
+    }
+    COGNITICS_BENCHMARK(BM_QTriangulate_Star)->arg(10)->arg(100)->arg(1000)->arg(10000)->arg(50000);
+
+    void BM_SFA_Intersection(bench::State &state)
+    {
+        std::unique_ptr<sfa::Polygon> a(circlePolygon(0.0, 0.0, 100.0, state.range(0)));
+        std::unique_ptr<sfa::Polygon> b(circlePolygon(50.0, 25.0, 100.0, state.range(0)));
+        for(auto _ : state)
+        {
+            std::unique_ptr<sfa::Geometry> result(a->intersection(b.get()));
+            bench::doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterations() * state.range(0) * 2);
+    }
+    COGNITICS_BENCHMARK(BM_SFA_Intersection)->range(16, 1024);
+
+    void BM_SFA_Buffer(bench::State &state)
+    {
+        // zig-zag road centerline
+        sfa::LineString line;
+        for(int64_t i = 0; i < state.range(0); ++i)
+            line.addPoint(sfa::Point(i * 10.0, (i % 2) ? 5.0 : -5.0));
+        for(auto _ : state)
+        {
+            std::unique_ptr<sfa::Geometry> result(line.buffer(4.0));
+            bench::doNotOptimize(result);
+        }
+        state.setItemsProcessed(state.iterations() * state.range(0));
+    }
+    COGNITICS_BENCHMARK(BM_SFA_Buffer)->arg(16)->arg(64)->arg(256);
+
+}
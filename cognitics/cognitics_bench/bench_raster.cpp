@@ -0,0 +1,224 @@
+
+#include "Benchmark.h"
+
+#include <cdb_util/cdb_util.h>
+#include <ccl/gdal.h>
+#include <elev/DataSourceManager.h>
+#include <elev/Elevation_DSM.h>
+#include <ip/GDALRasterSampler.h>
+#include <ip/jpgwrapper.h>
+#include <ip/pngwrapper.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // all generated rasters cover this one-degree cell
+    const double NORTH = 33.0;
+    const double SOUTH = 32.0;
+    const double EAST = -117.0;
+    const double WEST = -118.0;
+
+    // smooth gradient plus noise, so the encoders see something between a flat fill and random data
+    std::vector<unsigned char> syntheticRGB(int width, int height)
+    {
+        std::vector<unsigned char> result(size_t(width) * height * 3);
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<int> noise(-8, 8);
+        for(int y = 0; y < height; ++y)
+        {
+            for(int x = 0; x < width; ++x)
+            {
+                unsigned char *pixel = &result[((size_t(y) * width) + x) * 3];
+                pixel[0] = (unsigned char)std::min<int>(std::max<int>(((x * 255) / width) + noise(rng), 0), 255);
+                pixel[1] = (unsigned char)std::min<int>(std::max<int>(((y * 255) / height) + noise(rng), 0), 255);
+                pixel[2] = (unsigned char)std::min<int>(std::max<int>(128 + int(64 * sin(x * 0.05) * cos(y * 0.05)) + noise(rng), 0), 255);
+            }
+        }
+        return result;
+    }
+
+    std::vector<float> syntheticElevation(int width, int height)
+    {
+        std::vector<float> result(size_t(width) * height);
+        for(int y = 0; y < height; ++y)
+        {
+            for(int x = 0; x < width; ++x)
+                result[(size_t(y) * width) + x] = float(500.0 + 200.0 * sin(x * 0.01) * cos(y * 0.013) + 20.0 * sin(x * 0.17 + y * 0.11));
+        }
+        return result;
+    }
+
+    const std::string &imageryFile(void)
+    {
+        static std::string filename;
+        if(filename.empty())
+        {
+            const int size = 2048;
+            std::vector<unsigned char> pixels = syntheticRGB(size, size);
+            filename = bench::scratchPath("imagery.tif");
+            WriteTiffFile(filename, NORTH, SOUTH, EAST, WEST, size, size, &pixels[0]);
+        }
+        return filename;
+    }
+
+    const std::string &elevationFile(void)
+    {
+        static std::string filename;
+        if(filename.empty())
+        {
+            auto info = cognitics::cdb::RasterInfo();
+            info.Width = info.Height = 1024;
+            info.North = NORTH;
+            info.South = SOUTH;
+            info.East = EAST;
+            info.West = WEST;
+            info.PixelSizeX = (EAST - WEST) / info.Width;
+            info.PixelSizeY = -(NORTH - SOUTH) / info.Height;
+            info.OriginX = WEST;
+            info.OriginY = NORTH;
+            filename = bench::scratchPath("elevation.tif");
+            cognitics::cdb::WriteFloatsToTIF(filename, info, syntheticElevation(info.Width, info.Height));
+        }
+        return filename;
+    }
+
+    // a tile-sized window inside the generated cell
+    gdalsampler::GeoExtents sampleWindow(int size)
+    {
+        auto extents = gdalsampler::GeoExtents();
+        extents.north = NORTH - 0.25;
+        extents.south = SOUTH + 0.25;
+        extents.east = EAST - 0.25;
+        extents.west = WEST + 0.25;
+        extents.width = size;
+        extents.height = size;
+        return extents;
+    }
+
+    void BM_GDALRasterSampler_Sample(bench::State &state)
+    {
+        GDALRasterSampler sampler;
+        if(!sampler.AddFile(imageryFile()))
+        {
+            state.skipWithError("unable to open " + imageryFile());
+            return;
+        }
+        int size = int(state.range(0));
+        auto extents = sampleWindow(size);
+        std::vector<unsigned char> buffer(size_t(size) * size * 3);
+        for(auto _ : state)
+            sampler.Sample(extents, &buffer[0]);
+        state.setBytesProcessed(state.iterations() * buffer.size());
+    }
+    COGNITICS_BENCHMARK(BM_GDALRasterSampler_Sample)->arg(256)->arg(1024);
+
+    void BM_GDALRasterSampler_SampleElevation(bench::State &state)
+    {
+        GDALRasterSampler sampler;
+        if(!sampler.AddFile(elevationFile()))
+        {
+            state.skipWithError("unable to open " + elevationFile());
+            return;
+        }
+        int size = int(state.range(0));
+        auto extents = sampleWindow(size);
+        std::vector<float> buffer(size_t(size) * size);
+        for(auto _ : state)
+            sampler.Sample(extents, &buffer[0]);
+        state.setBytesProcessed(state.iterations() * buffer.size() * sizeof(float));
+    }
+    COGNITICS_BENCHMARK(BM_GDALRasterSampler_SampleElevation)->arg(256)->arg(1024);
+
+    // arg is the elev::elevation_strategy
+    void BM_Elevation_DSM_Get(bench::State &state)
+    {
+        elev::DataSourceManager dsm(50 * 1024 * 1024);
+        if(!dsm.AddFile_Raster_GDAL(elevationFile()))
+        {
+            state.skipWithError("unable to open " + elevationFile());
+            return;
+        }
+        dsm.generateBSP();
+        elev::Elevation_DSM edsm(&dsm, elev::elevation_strategy(state.range(0)));
+        state.setLabel((state.range(0) == elev::ELEVATION_BILINEAR) ? "bilinear" : "nearest");
+
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<double> lon(WEST + 0.01, EAST - 0.01);
+        std::uniform_real_distribution<double> lat(SOUTH + 0.01, NORTH - 0.01);
+        std::vector<sfa::Point> points;
+        for(int i = 0; i < 4096; ++i)
+            points.push_back(sfa::Point(lon(rng), lat(rng)));
+
+        size_t index = 0;
+        for(auto _ : state)
+        {
+            sfa::Point &p = points[index++ & 4095];
+            edsm.Get(&p);
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    COGNITICS_BENCHMARK(BM_Elevation_DSM_Get)->arg(elev::ELEVATION_NEAREST)->arg(elev::ELEVATION_BILINEAR);
+
+    ip::ImageInfo imageInfo(int size)
+    {
+        ip::ImageInfo info;
+        info.width = size;
+        info.height = size;
+        info.depth = 3;
+        info.dataType = ip::ImageInfo::UBYTE;
+        info.interleaved = true;
+        return info;
+    }
+
+    void BM_Encode_PNG(bench::State &state)
+    {
+        int size = int(state.range(0));
+        std::vector<unsigned char> pixels = syntheticRGB(size, size);
+        ccl::binary buffer(pixels.begin(), pixels.end());
+        ip::ImageInfo info = imageInfo(size);
+        std::string filename = bench::scratchPath("encode.png");
+        for(auto _ : state)
+            ip::WritePNG24(filename, info, buffer);
+        state.setBytesProcessed(state.iterations() * buffer.size());
+    }
+    COGNITICS_BENCHMARK(BM_Encode_PNG)->arg(256)->arg(1024);
+
+    void BM_Encode_JPG(bench::State &state)
+    {
+        int size = int(state.range(0));
+        std::vector<unsigned char> pixels = syntheticRGB(size, size);
+        ccl::binary buffer(pixels.begin(), pixels.end());
+        ip::ImageInfo info = imageInfo(size);
+        std::string filename = bench::scratchPath("encode.jpg");
+        for(auto _ : state)
+            ip::WriteJPG24(filename, info, buffer);
+        state.setBytesProcessed(state.iterations() * buffer.size());
+    }
+    COGNITICS_BENCHMARK(BM_Encode_JPG)->arg(256)->arg(1024);
+
+    void BM_Encode_JP2(bench::State &state)
+    {
+        if(GetGDALDriverManager()->GetDriverByName("JP2OpenJPEG") == NULL)
+        {
+            state.skipWithError("JP2OpenJPEG driver not available");
+            return;
+        }
+        int size = int(state.range(0));
+        std::vector<unsigned char> pixels = syntheticRGB(size, size);
+        auto info = cognitics::cdb::RasterInfo();
+        info.Width = info.Height = size;
+        info.OriginX = WEST;
+        info.OriginY = NORTH;
+        info.PixelSizeX = (EAST - WEST) / size;
+        info.PixelSizeY = -(NORTH - SOUTH) / size;
+        std::string filename = bench::scratchPath("encode.jp2");
+        for(auto _ : state)
+            cognitics::cdb::WriteBytesToJP2(filename, info, pixels);
+        state.setBytesProcessed(state.iterations() * pixels.size());
+    }
+    COGNITICS_BENCHMARK(BM_Encode_JP2)->arg(256)->arg(1024);
+
+}
@@ -0,0 +1,50 @@
+
+#include "Benchmark.h"
+
+#include <ccl/ArgumentParser.h>
+#include <ccl/gdal.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    cognitics::gdal::init(argv[0]);
+
+    auto args = cognitics::ArgumentParser();
+    args.AddOption("filter", 1, "<text>", "only run benchmarks whose name contains <text>");
+    args.AddOption("min-time", 1, "<seconds>", "minimum measured time per benchmark (default 0.5)");
+    args.AddOption("json", 1, "<filename>", "write the results as Google Benchmark compatible JSON");
+    args.AddOption("list", 0, "", "list the benchmarks and exit");
+    if(args.Parse(argc, argv) == EXIT_FAILURE)
+        return EXIT_FAILURE;
+
+    if(args.Option("list"))
+    {
+        bench::Runner::list(std::cout);
+        return EXIT_SUCCESS;
+    }
+
+    bench::Runner runner;
+    if(args.Option("filter"))
+        runner.filter = args.Parameters("filter").at(0);
+    if(args.Option("min-time"))
+        runner.min_time = std::stod(args.Parameters("min-time").at(0));
+
+    auto results = runner.run(&std::cout);
+    bench::removeScratchDirectory();
+
+    if(args.Option("json"))
+    {
+        std::ofstream json(args.Parameters("json").at(0).c_str(), std::ios::out);
+        if(!json)
+        {
+            std::cerr << "unable to write " << args.Parameters("json").at(0) << std::endl;
+            return EXIT_FAILURE;
+        }
+        bench::Runner::writeJSON(json, results);
+    }
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,175 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file ccl/Arena.h
+\headerfile ccl/Arena.h
+\brief Provides ccl::Arena and ccl::ArenaScope.
+*/
+#pragma once
+
+// ccl/inspection.h may already have redefined new
+#pragma push_macro("new")
+#undef new
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#pragma pop_macro("new")
+
+namespace ccl
+{
+    /*
+    Monotonic (bump) allocation for short-lived objects.
+
+    An Arena hands out memory from large chunks and never frees individual allocations; the memory comes
+    back all at once when the arena is reset or rewound. Chunks are kept for reuse, so a worker that resets
+    its arena after every job stops calling malloc once the first few jobs have sized it.
+
+    Arena is a std::pmr::memory_resource, so pmr containers can draw from it directly:
+
+        ccl::Arena arena;
+        std::pmr::vector<sfa::Point> points(&arena);
+
+    An ArenaScope makes an arena current for the calling thread until the scope ends, and rewinds it to
+    where it was when the scope started. Classes that route their operator new through
+    Arena::allocateObject() (sfa::Geometry does) are allocated from the current arena while a scope is
+    active; deleting them runs the destructor but leaves the memory to the rewind. Everything allocated
+    inside a scope must therefore be deleted (or abandoned) before the scope ends, on the same thread.
+    An ArenaScope over NULL sends allocations back to the heap, for objects that outlive the enclosing
+    scope. Allocations a long-lived object makes for itself on first use (sfa::Curve building its Points)
+    are made under such a scope, so reading geometry inside a scope doesn't put any of it in the arena.
+
+    Usage:
+        {
+            ccl::ArenaScope scope(ccl::Arena::forThread());
+            ... per-tile geometry ...
+        }   // all of it is released here
+
+    An Arena is not thread safe; use one per thread (forThread()).
+    */
+    class Arena : public std::pmr::memory_resource
+    {
+    public:
+        //! A position in the arena that it can be rewound to.
+        struct Mark
+        {
+            size_t chunk;
+            size_t offset;
+        };
+
+    private:
+        struct Chunk
+        {
+            unsigned char *data;
+            size_t size;
+            size_t used;            // bytes handed out from this chunk when allocation moved past it
+        };
+
+        std::vector<Chunk> chunks;
+        size_t chunkIndex;          // chunk currently allocated from
+        size_t offset;              // next free byte in that chunk
+        size_t chunkSize;           // size of the next chunk allocated
+        size_t maxChunkSize;
+
+        void *allocateSlow(size_t bytes, size_t alignment);
+
+        Arena(const Arena &);
+        Arena &operator=(const Arena &);
+
+    protected:
+        virtual void *do_allocate(size_t bytes, size_t alignment);
+        virtual void do_deallocate(void *p, size_t bytes, size_t alignment);
+        virtual bool do_is_equal(const std::pmr::memory_resource &other) const noexcept;
+
+    public:
+        explicit Arena(size_t initialChunkSize = 64 * 1024, size_t maxChunkSize = 16 * 1024 * 1024);
+        virtual ~Arena(void);
+
+        //! Allocates from the arena; the memory is valid until the arena is reset or rewound past it.
+        void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+        {
+            if(chunkIndex < chunks.size())
+            {
+                const Chunk &chunk = chunks[chunkIndex];
+                std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk.data);
+                size_t start = size_t(((base + offset + alignment - 1) & ~std::uintptr_t(alignment - 1)) - base);
+                if(start + bytes <= chunk.size)
+                {
+                    offset = start + bytes;
+                    return chunk.data + start;
+                }
+            }
+            return allocateSlow(bytes, alignment);
+        }
+
+        Mark mark(void) const;
+
+        //! Releases everything allocated after the mark was taken.
+        void rewind(const Mark &mark);
+
+        //! Releases everything; the chunks are kept for reuse.
+        void reset(void);
+
+        //! Releases everything and frees the chunks.
+        void release(void);
+
+        //! Identifies if the pointer is in memory allocated by this arena.
+        bool owns(const void *p) const;
+
+        //! Returns the number of bytes handed out (including alignment padding, but not chunk tails left unused).
+        size_t used(void) const;
+
+        //! Returns the total size of the chunks held.
+        size_t capacity(void) const;
+
+        //! Returns the arena of the innermost ArenaScope on this thread, or NULL.
+        static Arena *current(void);
+
+        //! Returns an arena owned by the calling thread.
+        static Arena &forThread(void);
+
+        //! Allocates size bytes from the current arena, or from the heap if there is none.
+        static void *allocateObject(size_t size);
+
+        //! Frees memory from allocateObject(); a no-op for memory in an arena of an active scope.
+        static void deallocateObject(void *p);
+    };
+
+    //! Makes an arena current for the calling thread, and rewinds it when the scope ends.
+    class ArenaScope
+    {
+        friend class Arena;
+
+    private:
+        Arena *arena;
+        ArenaScope *previous;
+        Arena::Mark start;
+
+        ArenaScope(const ArenaScope &);
+        ArenaScope &operator=(const ArenaScope &);
+
+    public:
+        explicit ArenaScope(Arena *arena);
+        explicit ArenaScope(Arena &arena);
+        ~ArenaScope(void);
+    };
+
+}
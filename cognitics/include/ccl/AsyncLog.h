@@ -0,0 +1,125 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file ccl/AsyncLog.h
+\headerfile ccl/AsyncLog.h
+\brief Provides ccl::AsyncLog
+*/
+#pragma once
+
+#include "Log.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccl
+{
+    class AsyncLog;
+    typedef std::shared_ptr<AsyncLog> AsyncLogSP;
+
+    //! Log observer that queues messages and writes them to its own observers on a background thread.
+    /*!
+    Each thread that logs gets its own bounded ring of messages, so threads don't contend with each other;
+    the background thread drains the rings every flush interval (or sooner when a ring fills up), orders the
+    batch by the time each message was logged, writes it to the observers and flushes them once.
+
+    When a ring is full, write() either blocks until the background thread has made room (BLOCK) or drops
+    the message (DROP); dropped messages are counted and reported in the next batch.
+
+    Messages are written to the observers on the background thread only, so the observers don't need to be
+    thread safe. Use LogStream with autoflush off so streams are flushed once per batch.
+    */
+    class AsyncLog : public LogObserver
+    {
+    public:
+        enum OverflowPolicy { BLOCK, DROP };
+
+        virtual ~AsyncLog(void);
+
+        //! Messages above level are filtered before they are queued.
+        /*! \param capacity messages per thread; rounded up to a power of two
+            \param flushInterval longest time a message waits before it is written
+            \param timestamps prefix messages with the time they were logged */
+        AsyncLog(struct LOGLEVEL level, size_t capacity = 4096, OverflowPolicy policy = BLOCK,
+            std::chrono::milliseconds flushInterval = std::chrono::milliseconds(50), bool timestamps = false);
+
+        //! Attach an observer that receives the queued messages.
+        void attach(LogObserverSP observer);
+
+        //! Detach an observer; messages already queued may still be written to it until the next flush().
+        void detach(LogObserverSP observer);
+
+        //! Queue a message.
+        virtual void write(struct LOGLEVEL level, const std::string &str);
+
+        virtual struct LOGLEVEL getLevel(void) const;
+
+        //! Wait until every message queued by the calling thread has been written and the observers are flushed.
+        virtual void flush(void);
+
+        //! Number of messages dropped because a ring was full.
+        size_t getDroppedCount(void) const;
+
+    private:
+        struct Entry;
+        struct Ring;
+
+        static std::atomic<size_t> next_id;
+        size_t id;                                  //!< distinguishes the rings of this log in a thread's ring cache
+        struct LOGLEVEL level;
+        size_t capacity;
+        OverflowPolicy policy;
+        std::chrono::milliseconds flushInterval;
+        bool timestamps;
+        std::atomic<size_t> dropped;
+        size_t droppedReported;
+
+        std::mutex rings_mutex;
+        std::vector<std::shared_ptr<Ring> > rings;
+
+        std::mutex observers_mutex;
+        std::set<LogObserverSP> observers;
+
+        std::mutex wake_mutex;
+        std::condition_variable wake_condition;     //!< wakes the background thread
+        std::condition_variable drained_condition;  //!< signalled after each batch
+        bool wakeRequested;
+        bool stopping;
+        size_t flushRequested;                      //!< flush requests and completed batches are numbered
+        size_t flushCompleted;
+
+        std::thread thread;
+
+        AsyncLog(const AsyncLog &);
+        AsyncLog &operator=(const AsyncLog &);
+
+        Ring *getRing(void);
+        void wake(void);
+        void run(void);
+        bool drain(std::vector<Entry> &batch);
+        void writeBatch(std::vector<Entry> &batch);
+    };
+
+}
+
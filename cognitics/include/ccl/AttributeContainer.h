@@ -37,15 +37,33 @@ namespace ccl
     class AttributeContainer
     {
         ccl::VariantMap attributes;
-        std::map<std::string,std::string> lowCaseAttributeMap;        
+        // Case insensitive hash index over the entries of attributes (open addressing, power of two size).
+        // It refers to the map's own nodes, so keys aren't copied and a lookup doesn't build a lower case key.
+        // Const lookups never change the index, so a container can be read from several threads at once.
+        std::vector<VariantMap::value_type *> keyIndex;
+        size_t keyIndexCount;
+        // set when the map may have been changed outside of the container; lookups scan the map until the index is rebuilt
+        bool keyIndexDirty;
+
+        VariantMap::value_type *findEntry(const std::string &key, bool ignoreCase) const;
+        void addToKeyIndex(VariantMap::value_type *entry);
+        void rebuildKeyIndex();
         
     public:
+        AttributeContainer();
+        AttributeContainer(const AttributeContainer &other);
+        AttributeContainer(AttributeContainer &&other);
+        AttributeContainer &operator=(const AttributeContainer &other);
+        AttributeContainer &operator=(AttributeContainer &&other);
+
         void clear();
         void updateLowerCaseMap();
-        //! Warning, if you modify the variantMap's contents, make sure you call
-        // updateLowerCaseMap() so the cached map of keys to lower case versions 
-        // gets updated.
+        //! Warning, if you add or remove keys in the variantMap, make sure you call
+        // updateLowerCaseMap() so the case insensitive key index gets rebuilt.
+        // Until then, case insensitive lookups fall back to scanning the map.
         VariantMap *getVariantMap(void);
+        //! Read only access; leaves the key index as it is.
+        const VariantMap *getVariantMap(void) const;
         void setAttribute(const std::string &key, ccl::Variant var, bool ignoreCase = true);
         bool getAttribute(const std::string &key, ccl::Variant &var, bool ignoreCase = true) const;
         bool hasAttribute(const std::string &key, bool ignoreCase = true) const;
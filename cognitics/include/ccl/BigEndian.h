@@ -39,6 +39,7 @@ namespace ccl
         virtual ~BigEndian(void) { }
         BigEndian(void) { }
         BigEndian(const BigEndian<T> &src) : Endian<T>(src) { }
+        BigEndian &operator=(const BigEndian<T> &rhs) = default;
         BigEndian(const T &v) : Endian<T>(v) { }
 
         //! Get a big endian value from an input stream.
@@ -55,6 +55,11 @@ outFile.open("myFile.out",std::ios_base::binary);
 ccl::BindStream outStream(outFile);
 bindData(outStream);
 outFile.close();
+
+// read from a buffer or memory mapping without copying it into a stream
+ccl::ByteReader reader(data, size);
+ccl::BindStream spanStream(reader);
+bindData(spanStream);
 \endcode
 
 */
@@ -64,6 +69,8 @@ outFile.close();
 #include <iostream>
 
 #include "binary.h"
+#include "ByteReader.h"
+#include "ByteWriter.h"
 
 namespace ccl
 {
@@ -73,19 +80,27 @@ namespace ccl
     private:
         std::istream *is;
         std::ostream *os;
+        ByteReader *reader;
+        ByteWriter *writer;
 
     public:
         ~BindStream(void) { }
-        BindStream(void) : is(NULL), os(NULL) { }
-        BindStream(std::istream &is) : is(&is), os(NULL) { }
-        BindStream(std::ostream &os) : is(NULL), os(&os) { }
+        BindStream(void) : is(NULL), os(NULL), reader(NULL), writer(NULL) { }
+        BindStream(std::istream &is) : is(&is), os(NULL), reader(NULL), writer(NULL) { }
+        BindStream(std::ostream &os) : is(NULL), os(&os), reader(NULL), writer(NULL) { }
+        BindStream(ByteReader &reader) : is(NULL), os(NULL), reader(&reader), writer(NULL) { }
+        BindStream(ByteWriter &writer) : is(NULL), os(NULL), reader(NULL), writer(&writer) { }
 
-        void setStream(std::istream &is) { this->is = &is; os = NULL; }
-        void setStream(std::ostream &os) { this->os = &os; is = NULL; }
+        void setStream(std::istream &is) { this->is = &is; os = NULL; reader = NULL; writer = NULL; }
+        void setStream(std::ostream &os) { this->os = &os; is = NULL; reader = NULL; writer = NULL; }
 
         //! Returns the stream position.
         int32_t pos(void)
         {
+            if(reader)
+                return int32_t(reader->pos());
+            if(writer)
+                return int32_t(writer->pos());
             if(is)
                 return is->tellg();
             if(os)
@@ -96,6 +111,10 @@ namespace ccl
         //! Seeks to the specified stream position.
         void seek(int32_t position)
         {
+            if(reader)
+                reader->seek(position);
+            if(writer)
+                writer->seek(position);
             if(is)
                 is->seekg(position);
             if(os)
@@ -105,13 +124,17 @@ namespace ccl
         //! Identifies if the stream is an output stream.
         bool writing(void)
         {
-            return (os != NULL);
+            return (os != NULL) || (writer != NULL);
         }
 
         //! Bind a variable (read or write the specified item).
         template <typename T>
         void bind(T &var)
         {
+            if(reader)
+                reader->read(var);
+            if(writer)
+                writer->write(var);
             if(is)
                 *is >> var;
             if(os)
@@ -121,6 +144,10 @@ namespace ccl
         //! Bind specialization for strings.
         void bind(std::string &var, int len)
         {
+            if(reader)
+                reader->read(var, len);
+            if(writer)
+                writer->write(var, len);
             if(is)
             {
                 var.resize(len, 0);
@@ -136,6 +163,10 @@ namespace ccl
         //! Bind specialization for binary.
         void bind(binary &var, int len)
         {
+            if(reader)
+                reader->read(var, len);
+            if(writer)
+                writer->write(var, len);
             if(is)
             {
                 var.resize(len, 0);
@@ -151,6 +182,10 @@ namespace ccl
         //! Fill a number of stream characters (in or out).
         void fill(int len, char ch = 0)
         {
+            if(reader)
+                reader->skip(len);
+            if(writer)
+                writer->fill(len, ch);
             if(is)
             {
                 std::streampos pos = is->tellg();
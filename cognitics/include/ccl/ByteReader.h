@@ -0,0 +1,292 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file ccl/ByteReader.h
+\headerfile ccl/ByteReader.h
+\brief Provides ccl::ByteReader.
+*/
+#pragma once
+
+#include "binary.h"
+#include "BigEndian.h"
+#include "LittleEndian.h"
+#include "LSBitField.h"
+#include "MSBitField.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace ccl
+{
+    namespace byteorder
+    {
+        template <size_t N> struct word { };
+        template <> struct word<1> { typedef uint8_t type; };
+        template <> struct word<2> { typedef uint16_t type; };
+        template <> struct word<4> { typedef uint32_t type; };
+        template <> struct word<8> { typedef uint64_t type; };
+
+        // assembled with shifts so the result doesn't depend on host order; compilers reduce these to a load and bswap
+        template <typename T>
+        inline T loadBigEndian(const unsigned char *p)
+        {
+            typedef typename word<sizeof(T)>::type W;
+            W w = 0;
+            for(size_t i = 0; i < sizeof(T); ++i)
+                w = W(w << 8) | W(p[i]);
+            T result;
+            memcpy(&result, &w, sizeof(T));
+            return result;
+        }
+
+        template <typename T>
+        inline T loadLittleEndian(const unsigned char *p)
+        {
+            typedef typename word<sizeof(T)>::type W;
+            W w = 0;
+            for(size_t i = sizeof(T); i > 0; --i)
+                w = W(w << 8) | W(p[i - 1]);
+            T result;
+            memcpy(&result, &w, sizeof(T));
+            return result;
+        }
+
+        template <typename T>
+        inline void storeBigEndian(unsigned char *p, T value)
+        {
+            typedef typename word<sizeof(T)>::type W;
+            W w;
+            memcpy(&w, &value, sizeof(T));
+            for(size_t i = sizeof(T); i > 0; --i, w = W(w >> 8))
+                p[i - 1] = (unsigned char)(w & 0xFF);
+        }
+
+        template <typename T>
+        inline void storeLittleEndian(unsigned char *p, T value)
+        {
+            typedef typename word<sizeof(T)>::type W;
+            W w;
+            memcpy(&w, &value, sizeof(T));
+            for(size_t i = 0; i < sizeof(T); ++i, w = W(w >> 8))
+                p[i] = (unsigned char)(w & 0xFF);
+        }
+    }
+
+    /**
+     * @class    ByteReader
+     *
+     * @brief    Bounds-checked decoding of a contiguous byte span.
+     *
+     * The reader does not own or copy the bytes; the span may be a ccl::binary, a record inside a
+     * ccl::MappedFile, or any other buffer that outlives the reader. Values are decoded straight from
+     * the span, and strings can be returned as views into it.
+     *
+     * A read past the end of the span moves the reader to the end, sets the failure flag and yields
+     * zero values (and empty views), so a truncated record decodes to defaults instead of garbage.
+     *
+     * ByteReader can back a ccl::BindStream, so existing bind() implementations decode from it unchanged.
+     */
+    class ByteReader
+    {
+    private:
+        const unsigned char *first;
+        const unsigned char *current;
+        const unsigned char *last;
+        bool failed;
+
+        // returns the next n bytes and advances, or NULL (and fails) if fewer remain
+        const unsigned char *take(size_t n)
+        {
+            if(n > size_t(last - current))
+            {
+                current = last;
+                failed = true;
+                return NULL;
+            }
+            const unsigned char *p = current;
+            current += n;
+            return p;
+        }
+
+    public:
+        ByteReader(void) : first(NULL), current(NULL), last(NULL), failed(false) { }
+        ByteReader(const void *data, size_t size) : first((const unsigned char *)data), current(first), last(first + size), failed(false) { }
+        explicit ByteReader(const binary &data) : first(data.data()), current(first), last(first + data.size()), failed(false) { }
+
+        const unsigned char *data(void) const { return first; }
+        size_t size(void) const { return size_t(last - first); }
+        size_t pos(void) const { return size_t(current - first); }
+        size_t remaining(void) const { return size_t(last - current); }
+        bool eof(void) const { return current == last; }
+
+        //! Returns false once a read or seek has gone past the end of the span.
+        bool good(void) const { return !failed; }
+
+        //! Seeks to the specified offset from the start of the span.
+        void seek(size_t position)
+        {
+            if(position > size())
+            {
+                position = size();
+                failed = true;
+            }
+            current = first + position;
+        }
+
+        //! Skips the specified number of bytes.
+        void skip(size_t n)
+        {
+            take(n);
+        }
+
+        //! Returns a pointer to the next n bytes and advances past them, or NULL if fewer remain.
+        const unsigned char *readBytes(size_t n)
+        {
+            return take(n);
+        }
+
+        //! Copies the next n bytes into dest; bytes past the end of the span are zeroed.
+        void readBytes(void *dest, size_t n)
+        {
+            size_t available = std::min<size_t>(n, remaining());
+            if(available)
+                memcpy(dest, current, available);
+            if(n > available)
+                memset((unsigned char *)dest + available, 0, n - available);
+            take(n);
+        }
+
+        //! Returns a reader over the next n bytes and advances past them.
+        ByteReader readSpan(size_t n)
+        {
+            const unsigned char *p = current;
+            size_t available = std::min<size_t>(n, remaining());
+            take(n);
+            return ByteReader(p, available);
+        }
+
+        template <typename T>
+        T readBigEndian(void)
+        {
+            const unsigned char *p = take(sizeof(T));
+            return p ? byteorder::loadBigEndian<T>(p) : T(0);
+        }
+
+        template <typename T>
+        T readLittleEndian(void)
+        {
+            const unsigned char *p = take(sizeof(T));
+            return p ? byteorder::loadLittleEndian<T>(p) : T(0);
+        }
+
+        uint8_t readUInt8(void)
+        {
+            const unsigned char *p = take(1);
+            return p ? *p : 0;
+        }
+
+        int8_t readInt8(void)
+        {
+            return int8_t(readUInt8());
+        }
+
+        //! Returns a view of the next n bytes, which may include padding NULs.
+        std::string_view readStringView(size_t n)
+        {
+            const unsigned char *p = current;
+            size_t available = std::min<size_t>(n, remaining());
+            take(n);
+            return std::string_view((const char *)p, available);
+        }
+
+        //! Returns a view of a NUL padded field of n bytes, up to the first NUL.
+        std::string_view readCString(size_t n)
+        {
+            std::string_view field = readStringView(n);
+            size_t end = field.find('\0');
+            return (end == std::string_view::npos) ? field : field.substr(0, end);
+        }
+
+        //! Reads a field of n bytes into a string of length n (padded with NULs).
+        std::string readString(size_t n)
+        {
+            std::string result(n, '\0');
+            readBytes(&result[0], n);
+            return result;
+        }
+
+        // targets for BindStream::bind()
+        template <typename T>
+        void read(BigEndian<T> &value)
+        {
+            value = readBigEndian<T>();
+        }
+
+        template <typename T>
+        void read(LittleEndian<T> &value)
+        {
+            value = readLittleEndian<T>();
+        }
+
+        template <size_t B>
+        void read(LSBitField<B> &value)
+        {
+            for(size_t i = 0; i < (B + 7) / 8; ++i)
+            {
+                uint8_t data = readUInt8();
+                for(size_t j = 0; (j < 8) && (i * 8 + j < B); ++j)
+                    value.set(i * 8 + j, (data & (1 << (7 - j))) != 0);
+            }
+        }
+
+        template <size_t B>
+        void read(MSBitField<B> &value)
+        {
+            for(size_t i = (B + 7) / 8; i > 0; --i)
+            {
+                uint8_t data = readUInt8();
+                for(size_t j = 0; (j < 8) && ((i - 1) * 8 + j < B); ++j)
+                    value.set((i - 1) * 8 + j, (data & (1 << j)) != 0);
+            }
+        }
+
+        void read(char &value) { value = char(readUInt8()); }
+        void read(signed char &value) { value = (signed char)(readUInt8()); }
+        void read(unsigned char &value) { value = readUInt8(); }
+
+        void read(std::string &value, size_t n)
+        {
+            value.resize(n);
+            readBytes(&value[0], n);
+        }
+
+        void read(binary &value, size_t n)
+        {
+            value.resize(n);
+            readBytes(&value[0], n);
+        }
+
+    };
+
+}
@@ -0,0 +1,204 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file ccl/ByteWriter.h
+\headerfile ccl/ByteWriter.h
+\brief Provides ccl::ByteWriter.
+*/
+#pragma once
+
+#include "ByteReader.h"
+
+namespace ccl
+{
+    /**
+     * @class    ByteWriter
+     *
+     * @brief    Encoding into a growable ccl::binary or a fixed byte span.
+     *
+     * A writer over a ccl::binary starts at the end of its current contents and grows it as needed. A
+     * writer over a fixed span never writes past the end; a write that doesn't fit is dropped and sets the
+     * failure flag.
+     *
+     * ByteWriter can back a ccl::BindStream, so existing bind() implementations encode into it unchanged.
+     */
+    class ByteWriter
+    {
+    private:
+        binary *buffer;
+        unsigned char *first;
+        size_t capacity;
+        size_t position;
+        bool failed;
+
+        // returns space for the next n bytes and advances, or NULL (and fails) if a fixed span is full
+        unsigned char *take(size_t n)
+        {
+            if(buffer)
+            {
+                if(position + n > buffer->size())
+                    buffer->resize(position + n);
+                unsigned char *p = &(*buffer)[0] + position;
+                position += n;
+                return p;
+            }
+            if(n > capacity - position)
+            {
+                failed = true;
+                return NULL;
+            }
+            unsigned char *p = first + position;
+            position += n;
+            return p;
+        }
+
+    public:
+        explicit ByteWriter(binary &buffer) : buffer(&buffer), first(NULL), capacity(0), position(buffer.size()), failed(false) { }
+        ByteWriter(void *data, size_t size) : buffer(NULL), first((unsigned char *)data), capacity(size), position(0), failed(false) { }
+
+        size_t pos(void) const { return position; }
+
+        //! Returns false once a write or seek did not fit a fixed span.
+        bool good(void) const { return !failed; }
+
+        //! Seeks to the specified offset; a growable buffer is extended with NULs if needed.
+        void seek(size_t pos)
+        {
+            if(buffer)
+            {
+                if(pos > buffer->size())
+                    buffer->resize(pos);
+            }
+            else if(pos > capacity)
+            {
+                pos = capacity;
+                failed = true;
+            }
+            position = pos;
+        }
+
+        void writeBytes(const void *data, size_t n)
+        {
+            unsigned char *p = take(n);
+            if(p && n)
+                memcpy(p, data, n);
+        }
+
+        //! Writes n copies of ch.
+        void fill(size_t n, unsigned char ch = 0)
+        {
+            unsigned char *p = take(n);
+            if(p && n)
+                memset(p, ch, n);
+        }
+
+        template <typename T>
+        void writeBigEndian(T value)
+        {
+            unsigned char *p = take(sizeof(T));
+            if(p)
+                byteorder::storeBigEndian<T>(p, value);
+        }
+
+        template <typename T>
+        void writeLittleEndian(T value)
+        {
+            unsigned char *p = take(sizeof(T));
+            if(p)
+                byteorder::storeLittleEndian<T>(p, value);
+        }
+
+        void writeUInt8(uint8_t value)
+        {
+            unsigned char *p = take(1);
+            if(p)
+                *p = value;
+        }
+
+        void writeInt8(int8_t value)
+        {
+            writeUInt8(uint8_t(value));
+        }
+
+        //! Writes a field of exactly n bytes, truncating or padding the string with NULs.
+        void writeString(const std::string &value, size_t n)
+        {
+            size_t count = std::min<size_t>(n, value.size());
+            writeBytes(value.data(), count);
+            fill(n - count);
+        }
+
+        // targets for BindStream::bind()
+        template <typename T>
+        void write(BigEndian<T> &value)
+        {
+            writeBigEndian<T>(value);
+        }
+
+        template <typename T>
+        void write(LittleEndian<T> &value)
+        {
+            writeLittleEndian<T>(value);
+        }
+
+        template <size_t B>
+        void write(LSBitField<B> &value)
+        {
+            for(size_t i = 0; i < (B + 7) / 8; ++i)
+            {
+                uint8_t data = 0;
+                for(size_t j = 0; (j < 8) && (i * 8 + j < B); ++j)
+                    data |= value.get(i * 8 + j) ? (1 << (7 - j)) : 0;
+                writeUInt8(data);
+            }
+        }
+
+        template <size_t B>
+        void write(MSBitField<B> &value)
+        {
+            for(size_t i = (B + 7) / 8; i > 0; --i)
+            {
+                uint8_t data = 0;
+                for(size_t j = 0; (j < 8) && ((i - 1) * 8 + j < B); ++j)
+                    data |= value.get((i - 1) * 8 + j) ? (1 << j) : 0;
+                writeUInt8(data);
+            }
+        }
+
+        void write(char &value) { writeUInt8(uint8_t(value)); }
+        void write(signed char &value) { writeUInt8(uint8_t(value)); }
+        void write(unsigned char &value) { writeUInt8(value); }
+
+        void write(std::string &value, size_t n)
+        {
+            writeString(value, n);
+        }
+
+        void write(binary &value, size_t n)
+        {
+            size_t count = std::min<size_t>(n, value.size());
+            writeBytes(value.data(), count);
+            fill(n - count);
+        }
+
+    };
+
+}
@@ -8,10 +8,17 @@ Copyright (c) 2016 Cognitics, Inc.
 #include "ccl/sem.h"
 #include "ccl/ProgressObserver.h"
 #include "ccl/ObjLog.h"
+#include "ccl/Status.h"
 #include <list>
 #include <set>
 #include <deque>
+#include <vector>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <float.h>
 
 /*
@@ -40,21 +47,32 @@ namespace ccl
     class JobManager;
     class Job;
 
-    class JobWorker : public Runnable
+    class JobWorker
     {
         friend class JobManager;
 
     private:
         JobManager *manager;
+        size_t index;
         ccl::ObjLog log;
+        std::thread thread;
+        std::atomic<bool> stopping;
+        std::atomic<bool> done;
 
-        void finishJob(Job *job);
+        std::mutex jobs_mutex;
+        std::deque<Job *> jobs;             // the worker takes jobs from the front; other workers steal from the back
+
+        void pushJob(Job *job, bool front);
+        Job *popJob(void);
+        Job *stealJob(void);
 
     public:
         virtual ~JobWorker(void);
-        JobWorker(JobManager *manager);
+        JobWorker(JobManager *manager, size_t index);
+        virtual bool start(void);
         virtual bool stop(void);
         virtual int run(void);
+        bool isFinished(void) const { return done; }
     };
 
     class Job
@@ -63,8 +81,8 @@ namespace ccl
         friend class JobWorker;
 
     private:
-        int task_count;
-        ccl::mutex task_count_mutex;
+        std::atomic<int> task_count;
+        bool delete_on_finish;                // set for jobs created by JobManager::submitFunction()
 
     protected:
         ccl::ObjLog log;
@@ -114,21 +132,42 @@ namespace ccl
         ProgressObserver *progressObserver;
 
         ccl::semaphore workers_semaphore;
-        std::list<JobWorker *> workers;
+        std::vector<JobWorker *> workers;
 
-        ccl::mutex open_mutex;
-        std::deque<Job *> pending_jobs;        // pending jobs include all jobs that are waiting to be executed
-        std::set<Job *> open_jobs;            // open jobs include all jobs that are pending or running
+        std::mutex pending_mutex;
+        std::deque<Job *> pending_jobs;        // jobs submitted from outside of the workers, waiting to be executed
+        std::atomic<size_t> pending_count;    // jobs waiting in pending_jobs or in any worker's deque
+        std::atomic<size_t> open_count;        // open jobs include all jobs that are pending or running
         ccl::mutex finished_mutex;
         std::list<Job *> finished_jobs;        // finished jobs include all jobs that are complete and waiting for cleanup
 
+        std::mutex wake_mutex;
+        std::condition_variable wake_condition;        // signalled when a job is submitted or the workers are stopped
+        std::atomic<size_t> idle_workers;
+        std::atomic<bool> waking;                        // a wake-up is in flight; workers clear it when they go idle or wake
+        std::mutex completion_mutex;
+        std::condition_variable completion_condition;    // signalled when open_count drops to zero
+
         ThreadDataManager *threadDataManager;
 
-        // used by workers to fetch a job from pending_jobs in a thread-safe manner
-        Job *getNextJob(void);
+        // report pending_count and open_count when the status is sampled, so jobs don't update them twice
+        StatusCounter pending_status;
+        StatusCounter open_status;
+
+        // used by workers to fetch a job: their own deque first, then pending_jobs, then other workers' deques
+        Job *getNextJob(JobWorker *worker);
+
+        // used by workers to block until a job may be available
+        void waitForJob(JobWorker *worker);
+
+        // wakes an idle worker unless one is already being woken
+        void wakeWorker(void);
 
-        // used by workers to set a job to finished status
-        void finishJob(JobWorker *worker, Job *job);
+        // executes a job taken by getNextJob() and finishes it (and its owners) if it has no open sub-jobs
+        void executeJob(Job *job);
+
+        // sets a job to finished status
+        void finishJob(Job *job);
 
     public:
         // destructor ensures that all threads have been completed
@@ -136,9 +175,18 @@ namespace ccl
 
         JobManager(size_t num_threads, ProgressObserver *progressObserver = NULL, ThreadDataManager *threadDataManager = NULL);
 
-        // submit a job (asynchronously)
+        // submit a job (asynchronously); jobs submitted to the front are taken before those submitted to the back
         void submitJob(Job *job, bool front = true);
 
+        // submit a function to be run by a worker; the job wrapping it is deleted as soon as it has run
+        void submitFunction(const std::function<void(void)> &function, bool front = true);
+
+        // run one pending job on the calling thread; returns false if there was none
+        // a thread waiting on jobs it submitted can call this to help instead of blocking a worker
+        bool executeNextJob(void);
+
+        size_t getNumWorkers(void) const { return workers.size(); }
+
         // wait for an idle worker
         void waitForSemaphore(int32_t msec = 0xFFFFFFFF);
 
@@ -152,7 +200,7 @@ namespace ccl
         // unowned jobs are the responsibility of the application (this allows the application to pull the data it needs)
         void cleanup(void);
 
-        // wait for all jobs to finish
+        // wait for all jobs to finish; the workers keep running, so more jobs can be submitted afterwards
         // returns time elapsed; if all jobs are finished, it will return negative
         float waitForCompletion(float seconds = FLT_MAX);
 
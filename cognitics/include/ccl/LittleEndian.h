@@ -39,6 +39,7 @@ namespace ccl
         virtual ~LittleEndian(void) { }
         LittleEndian(void) { }
         LittleEndian(const LittleEndian<T> &src) : Endian<T>(src) { }
+        LittleEndian &operator=(const LittleEndian<T> &rhs) = default;
         LittleEndian(const T &v) : Endian<T>(v) { }
 
         //! Get a little endian value from an input stream.
@@ -85,9 +85,20 @@ public:
 };
 \endcode
 
+The AsyncLog class is an observer that queues messages and writes them to its own observers on a background thread,
+so threads that log don't wait on console or file output:
+\code
+#include <AsyncLog.h>
+
+ccl::AsyncLogSP async(new ccl::AsyncLog(ccl::LDEBUG));
+async->attach(ccl::LogObserverSP(new ccl::LogStream(ccl::LDEBUG, std::cout, false)));
+ccl::Log::instance()->attach(async);
+\endcode
+
 \section Notes
 
 It is the responsibility of observer implementations to handle filtering by log level.
+Observers report the most verbose level they write through getLevel(); ObjLog skips formatting messages that no attached observer would write.
 
 */
 #pragma once
@@ -95,6 +106,8 @@ It is the responsibility of observer implementations to handle filtering by log
 #include <set>
 #include <string>
 #include <memory>
+#include <atomic>
+#include <algorithm>
 
 #if defined(WIN32) && defined(COG_DEBUG)
 #include <windows.h>
@@ -130,6 +143,12 @@ namespace ccl
 
         //! Log event handler.
         virtual void write(struct LOGLEVEL level, const std::string &str) = 0;
+
+        //! Most verbose level written by this observer.
+        virtual struct LOGLEVEL getLevel(void) const { return LDEBUG; }
+
+        //! Write out any buffered messages.
+        virtual void flush(void) { }
     };
 
     //! Singleton class for distributing log messages to registered observers.
@@ -137,8 +156,17 @@ namespace ccl
     {
     private:
         static LogSP _instance;
+        static std::atomic<int> max_level;
         std::set<LogObserverSP> observers;
 
+        void updateLevel(void)
+        {
+            int level = -1;
+            for(std::set<LogObserverSP>::iterator it = observers.begin(), end = observers.end(); it != end; it++)
+                level = std::max<int>(level, (*it)->getLevel().value);
+            max_level = level;
+        }
+
     protected:
         Log(void) { }
 
@@ -160,12 +188,27 @@ namespace ccl
         void attach(LogObserverSP observer)
         {
             observers.insert(observer);
+            updateLevel();
         }
 
         //! Detach an observer from the log.
         void detach(LogObserverSP observer)
         {
             observers.erase(observers.find(observer));
+            updateLevel();
+        }
+
+        //! Returns true if an attached observer writes messages of the given level.
+        static bool isEnabled(struct LOGLEVEL level)
+        {
+            return level.value <= max_level.load(std::memory_order_relaxed);
+        }
+
+        //! Flush all attached observers.
+        void flush(void)
+        {
+            for(std::set<LogObserverSP>::iterator it = observers.begin(), end = observers.end(); it != end; it++)
+                (*it)->flush();
         }
 
         //! Send a log string to all attached observers.
@@ -51,6 +51,7 @@ namespace ccl
         virtual ~LogBuffer(void);
         LogBuffer(struct LOGLEVEL level);
         virtual void write(struct LOGLEVEL level, const std::string &str);
+        virtual struct LOGLEVEL getLevel(void) const { return level; }
         LogEntry getNextEntry(void);
 
     };
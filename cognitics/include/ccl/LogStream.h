@@ -38,15 +38,21 @@ namespace ccl
     private:
         struct LOGLEVEL level;        //!< maximum log level for stream output
         std::ostream *stream;        //!< output stream
+        bool autoflush;                //!< flush the stream after every message
 
     public:
         virtual ~LogStream(void);
-        LogStream(struct LOGLEVEL level, std::ostream &stream = std::cout);
+        LogStream(struct LOGLEVEL level, std::ostream &stream = std::cout, bool autoflush = true);
 
         //! Log event handler.
         /*! This sends the log string to the output stream if the event log level is less than (more critical) than the level property. */
         virtual void write(struct LOGLEVEL level, const std::string &str);
 
+        virtual struct LOGLEVEL getLevel(void) const;
+
+        //! Flush the output stream; used by AsyncLog once per batch when autoflush is off.
+        virtual void flush(void);
+
     };
 
 
@@ -0,0 +1,105 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file ccl/MappedFile.h
+\headerfile ccl/MappedFile.h
+\brief Provides ccl::MappedFile.
+*/
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace ccl
+{
+    /**
+     * @class    MappedFile
+     *
+     * @brief    Memory mapping of an entire file.
+     *
+     * The file contents are paged in by the operating system on access instead of being copied into a heap
+     * buffer, so large inputs (textures, databases, model files) don't need a second resident copy. The
+     * mapping is released on close() or destruction. An empty file opens successfully with size() of zero
+     * and a NULL data().
+     *
+     * Files are mapped read-only by default. A READ_WRITE mapping (or one made with create()) is shared
+     * with the file, so stores through writableData() reach it; flush() writes them back synchronously.
+     * Files larger than 4GB are supported by 64-bit builds; a file that doesn't fit the address space
+     * fails to open.
+     *
+     * advise() passes the expected access pattern on to the pager: ACCESS_SEQUENTIAL for single pass
+     * readers (more read-ahead, pages dropped sooner), ACCESS_RANDOM for lookups into large files, and
+     * ACCESS_WILLNEED to start reading the whole file in ahead of use.
+     */
+    class MappedFile
+    {
+    public:
+        enum Mode
+        {
+            READ_ONLY,
+            READ_WRITE
+        };
+
+        enum Access
+        {
+            ACCESS_NORMAL,
+            ACCESS_SEQUENTIAL,
+            ACCESS_RANDOM,
+            ACCESS_WILLNEED
+        };
+
+    private:
+        unsigned char *_data;
+        size_t _size;
+        void *_file;        // platform file handle (Win32)
+        void *_mapping;     // platform mapping handle (Win32)
+        bool _open;
+        bool _writable;
+
+        MappedFile(const MappedFile &);
+        MappedFile &operator=(const MappedFile &);
+
+    public:
+        MappedFile(void);
+        explicit MappedFile(const std::string &filename, Mode mode = READ_ONLY);
+        ~MappedFile(void);
+
+        bool open(const std::string &filename, Mode mode = READ_ONLY);
+
+        //! Creates (or truncates) a file of the specified size and maps it READ_WRITE.
+        bool create(const std::string &filename, size_t size);
+
+        void close(void);
+
+        //! Writes modified pages of a READ_WRITE mapping back to the file.
+        bool flush(void);
+
+        //! Hints the expected access pattern for the whole mapping.
+        void advise(Access access);
+
+        bool isOpen(void) const { return _open; }
+        bool isWritable(void) const { return _writable; }
+        const unsigned char *data(void) const { return _data; }
+        unsigned char *writableData(void) { return _writable ? _data : NULL; }
+        size_t size(void) const { return _size; }
+    };
+
+}
@@ -54,9 +54,12 @@ namespace ccl
         ObjLog(const char *name, void *obj = NULL);
 
         //! << template for stream output.
+        /*! Values are only formatted if an attached observer writes messages of the current level. */
         template<typename T>
         ObjLog &operator<<(const T &t)
         {
+            if(!Log::isEnabled(level))
+                return *this;
             _mutex.lock();
             str << t;
             _mutex.unlock();
@@ -72,6 +75,8 @@ namespace ccl
         template<typename T>
         ObjLog &operator<<(ccl::LittleEndian<T> &value)
         {
+            if(!Log::isEnabled(level))
+                return *this;
             str << T(value);
             return *this;
         }
@@ -79,6 +84,8 @@ namespace ccl
         template<typename T>
         ObjLog &operator<<(ccl::BigEndian<T> &value)
         {
+            if(!Log::isEnabled(level))
+                return *this;
             str << T(value);
             return *this;
         }
@@ -0,0 +1,320 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file ccl/Parallel.h
+\headerfile ccl/Parallel.h
+\brief Provides ccl::parallel_for, ccl::parallel_reduce and ccl::Task.
+*/
+#pragma once
+
+#include "ccl/JobManager.h"
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Data parallel loops and small task graphs on top of a JobManager, without a Job subclass per call site.
+
+parallel_for splits [begin, end) into ranges of grain items. Workers and the calling thread claim ranges
+one at a time until none are left, so uneven ranges balance themselves. The call returns when every range
+has run, and rethrows the first exception thrown by the function (ranges not yet claimed are skipped).
+Loops may be nested and may be called from inside jobs: the caller only ever waits for ranges that are
+already running on another thread.
+
+Tasks are futures: submit_task() runs a function on a worker and returns a Task for its result, then()
+chains a continuation that is submitted when the task finishes, and when_all() joins a set of tasks.
+Waiting on a task from a worker runs other pending jobs in the meantime.
+
+The overloads without a JobManager use sharedJobManager(), a pool with one worker per hardware thread.
+*/
+
+namespace ccl
+{
+    // pool used by the overloads without a JobManager; created on first use
+    JobManager &sharedJobManager(void);
+
+    // number of ranges parallel_for uses for [begin, end) with the given grain
+    size_t parallelRangeCount(size_t begin, size_t end, size_t grain);
+
+    // calls function(range_begin, range_end) for each range of up to grain items in [begin, end)
+    void parallel_for_ranges(JobManager &manager, size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &function);
+
+    inline void parallel_for_ranges(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &function)
+    {
+        parallel_for_ranges(sharedJobManager(), begin, end, grain, function);
+    }
+
+    // calls function(i) for each i in [begin, end), grain items per range
+    template <typename Function>
+    void parallel_for(JobManager &manager, size_t begin, size_t end, size_t grain, Function function)
+    {
+        parallel_for_ranges(manager, begin, end, grain, [&function](size_t range_begin, size_t range_end)
+        {
+            for(size_t i = range_begin; i < range_end; ++i)
+                function(i);
+        });
+    }
+
+    template <typename Function>
+    void parallel_for(size_t begin, size_t end, size_t grain, Function function)
+    {
+        parallel_for(sharedJobManager(), begin, end, grain, function);
+    }
+
+    // reduces [begin, end): each range is mapped with range_function(range_begin, range_end, identity) and the
+    // results are combined with reduce(a, b) in range order, so the result doesn't depend on scheduling
+    template <typename T, typename RangeFunction, typename Reduce>
+    T parallel_reduce(JobManager &manager, size_t begin, size_t end, size_t grain, const T &identity, RangeFunction range_function, Reduce reduce)
+    {
+        struct Slot { T value; };        // std::vector<bool> elements can't be written concurrently
+        grain = std::max<size_t>(grain, 1);
+        std::vector<Slot> partial(parallelRangeCount(begin, end, grain), Slot{ identity });
+        parallel_for_ranges(manager, begin, end, grain, [&](size_t range_begin, size_t range_end)
+        {
+            partial[(range_begin - begin) / grain].value = range_function(range_begin, range_end, identity);
+        });
+        T result = identity;
+        for(auto &slot : partial)
+            result = reduce(result, slot.value);
+        return result;
+    }
+
+    template <typename T, typename RangeFunction, typename Reduce>
+    T parallel_reduce(size_t begin, size_t end, size_t grain, const T &identity, RangeFunction range_function, Reduce reduce)
+    {
+        return parallel_reduce(sharedJobManager(), begin, end, grain, identity, range_function, reduce);
+    }
+
+    template <typename T> class Task;
+
+    namespace detail
+    {
+        template <typename T>
+        struct TaskState
+        {
+            JobManager *manager;
+            std::promise<T> promise;
+            std::shared_future<T> future;
+            std::mutex mutex;
+            bool finished;
+            std::vector<std::function<void(void)> > continuations;
+
+            TaskState(JobManager *manager) : manager(manager), future(promise.get_future().share()), finished(false) { }
+
+            template <typename Function, typename... Args>
+            void run(Function &function, Args &&... args)
+            {
+                try
+                {
+                    if constexpr (std::is_void<T>::value)
+                    {
+                        function(std::forward<Args>(args)...);
+                        promise.set_value();
+                    }
+                    else
+                        promise.set_value(function(std::forward<Args>(args)...));
+                }
+                catch(...)
+                {
+                    promise.set_exception(std::current_exception());
+                }
+                std::vector<std::function<void(void)> > ready;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished = true;
+                    ready.swap(continuations);
+                }
+                for(auto &continuation : ready)
+                    continuation();
+            }
+
+            // calls continuation once the result is set (immediately if it already is)
+            void onFinished(const std::function<void(void)> &continuation)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(!finished)
+                    {
+                        continuations.push_back(continuation);
+                        return;
+                    }
+                }
+                continuation();
+            }
+
+            bool isReady(void) const
+            {
+                return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }
+
+            void wait(void) const
+            {
+                // help with pending jobs rather than block a worker the task may be queued behind
+                while(!isReady())
+                {
+                    if(!manager->executeNextJob())
+                        future.wait_for(std::chrono::milliseconds(1));
+                }
+            }
+        };
+
+        template <typename T, typename Function>
+        struct ContinuationResult
+        {
+            typedef typename std::invoke_result<Function &, const T &>::type type;
+        };
+
+        template <typename Function>
+        struct ContinuationResult<void, Function>
+        {
+            typedef typename std::invoke_result<Function &>::type type;
+        };
+
+        struct TaskAccess
+        {
+            template <typename T>
+            static const std::shared_ptr<TaskState<T> > &state(const Task<T> &task) { return task.state; }
+
+            template <typename T>
+            static Task<T> create(JobManager *manager)
+            {
+                Task<T> task;
+                task.state = std::make_shared<TaskState<T> >(manager);
+                return task;
+            }
+        };
+    }
+
+    /**
+     * @class    Task
+     *
+     * @brief    Shared handle to the result of a function submitted with submit_task() or then().
+     *
+     * Copies refer to the same result. get() waits for the task and returns its value or rethrows its exception.
+     */
+    template <typename T>
+    class Task
+    {
+        friend struct detail::TaskAccess;
+
+    private:
+        std::shared_ptr<detail::TaskState<T> > state;
+
+    public:
+        Task(void) { }
+
+        bool valid(void) const { return state != nullptr; }
+        bool isReady(void) const { return state->isReady(); }
+        void wait(void) const { state->wait(); }
+
+        // waits and returns the result; rethrows the exception thrown by the task
+        T get(void) const
+        {
+            state->wait();
+            return state->future.get();
+        }
+
+        // submits function(result) (or function() for a void task) when this task finishes
+        // if this task throws, the continuation isn't called and the returned task rethrows the same exception
+        template <typename Function>
+        Task<typename detail::ContinuationResult<T, Function>::type> then(Function function) const
+        {
+            typedef typename detail::ContinuationResult<T, Function>::type R;
+            Task<R> result = detail::TaskAccess::create<R>(state->manager);
+            auto source = state;
+            auto target = detail::TaskAccess::state(result);
+            state->onFinished([source, target, function]()
+            {
+                source->manager->submitFunction([source, target, function]() mutable
+                {
+                    auto continuation = [&source, &function]() -> R
+                    {
+                        if constexpr (std::is_void<T>::value)
+                        {
+                            source->future.get();
+                            return function();
+                        }
+                        else
+                            return function(source->future.get());
+                    };
+                    target->run(continuation);
+                });
+            });
+            return result;
+        }
+    };
+
+    // runs function() on a worker of manager; the returned task holds its result
+    template <typename Function>
+    Task<typename std::invoke_result<Function &>::type> submit_task(JobManager &manager, Function function)
+    {
+        typedef typename std::invoke_result<Function &>::type R;
+        Task<R> result = detail::TaskAccess::create<R>(&manager);
+        auto target = detail::TaskAccess::state(result);
+        manager.submitFunction([target, function]() mutable { target->run(function); });
+        return result;
+    }
+
+    template <typename Function>
+    Task<typename std::invoke_result<Function &>::type> submit_task(Function function)
+    {
+        return submit_task(sharedJobManager(), function);
+    }
+
+    // returns a task that finishes when all of the given tasks have finished, successfully or not;
+    // the results (and exceptions) are read from the tasks themselves
+    template <typename T>
+    Task<void> when_all(JobManager &manager, const std::vector<Task<T> > &tasks)
+    {
+        Task<void> result = detail::TaskAccess::create<void>(&manager);
+        auto target = detail::TaskAccess::state(result);
+        auto remaining = std::make_shared<std::atomic<size_t> >(tasks.size());
+        auto finish = [target]()
+        {
+            auto nothing = []() { };
+            target->run(nothing);
+        };
+        if(tasks.empty())
+            finish();
+        for(auto &task : tasks)
+        {
+            detail::TaskAccess::state(task)->onFinished([remaining, finish]()
+            {
+                if(--*remaining == 0)
+                    finish();
+            });
+        }
+        return result;
+    }
+
+    template <typename T>
+    Task<void> when_all(const std::vector<Task<T> > &tasks)
+    {
+        return when_all(sharedJobManager(), tasks);
+    }
+}
@@ -29,9 +29,11 @@ DEALINGS IN THE SOFTWARE.
 
 #include "Timer.h"
 #include "ObjLog.h"
+#include "Trace.h"
 
 namespace ccl
 {
+    // logs the time spent in a scope; while ccl::Trace is enabled, the scope is also recorded as a span named by the title
     class ScopedTimer
     {
     private:
@@ -39,6 +41,10 @@ namespace ccl
         ObjLog *objLog;
         Timer timer;
         Timer progressTimer;
+        const char *traceName;
+        uint64_t traceBegin;
+
+        void startTrace(void);
 
     public:
         ~ScopedTimer(void);
@@ -0,0 +1,179 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file ccl/Status.h
+\headerfile ccl/Status.h
+\brief Provides ccl::StatusCounter, ccl::Status and ccl::StatusReporter.
+*/
+#pragma once
+
+#include "ResourceUsage.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ccl
+{
+    /*
+    Process status for long running jobs: memory use, cache and queue levels, and running totals per stage.
+
+    A StatusCounter is a named value that registers itself for the life of the counter. A TOTAL only grows
+    (tiles written, bytes decoded) and is reported with its rate per second; a LEVEL goes up and down (queue
+    depth, bytes held by a cache). Counters with the same name are summed, so each instance of a cache can
+    keep its own counter while the report shows the process wide level.
+
+    Adding to a counter is one relaxed atomic add and takes no lock. Code that counts per pixel or per lookup
+    should count locally and add in batches. A level that an object already keeps (the JobManager's pending
+    and open job counts) is better reported by a counter with a source, which reads it only when sampled.
+
+    Caches report "<cache> hits" and "<cache> misses" totals; the report includes the hit rate of each pair.
+
+    Status::sample() takes a snapshot; StatusReporter samples on a background thread, logs a summary line and
+    rewrites a JSON status file for monitoring.
+
+    Usage:
+        COGNITICS_STATUS_COUNT("tiles encoded", 1);
+        COGNITICS_STATUS_LEVEL("elev cache bytes", int64_t(size));
+        ...
+        ccl::StatusReporter reporter(10.0, "status.json");
+    */
+    class StatusCounter
+    {
+    public:
+        enum Kind { TOTAL, LEVEL };
+
+    private:
+        const char *name;
+        Kind kind;
+        std::atomic<int64_t> value;
+        std::function<int64_t(void)> source;
+
+        StatusCounter(const StatusCounter &);
+        StatusCounter &operator=(const StatusCounter &);
+
+    public:
+        // name must stay valid for the life of the counter (a literal or Trace::intern())
+        explicit StatusCounter(const char *name, Kind kind = TOTAL);
+
+        // a LEVEL read from source whenever the status is sampled; source must stay valid for the life of the counter
+        StatusCounter(const char *name, const std::function<int64_t(void)> &source);
+
+        ~StatusCounter(void);
+
+        // returns the new value
+        int64_t add(int64_t delta) { return value.fetch_add(delta, std::memory_order_relaxed) + delta; }
+
+        int64_t get(void) const { return value.load(std::memory_order_relaxed); }
+
+        // the value reported by Status::sample()
+        int64_t sample(void) const { return source ? source() : get(); }
+
+        const char *getName(void) const { return name; }
+        Kind getKind(void) const { return kind; }
+    };
+
+    class Status
+    {
+    public:
+        struct Value
+        {
+            std::string name;
+            StatusCounter::Kind kind;
+            int64_t value;
+            double rate;            // per second, for TOTAL counters
+        };
+
+        struct Sample
+        {
+            std::chrono::system_clock::time_point time;
+            double uptime;          // seconds since the status clock started
+            ResourceUsage memory;
+            std::vector<Value> values;      // ordered by name
+        };
+
+        // rates are since previous, or averages since the status clock started when previous is NULL
+        static Sample sample(const Sample *previous = NULL);
+
+        // hits / (hits + misses) of the "<cache> hits" and "<cache> misses" totals; negative if there were none
+        static double hitRate(const Sample &sample, const std::string &cache);
+
+        // one line summary for the log
+        static std::string summary(const Sample &sample);
+
+        static void writeJSON(std::ostream &stream, const Sample &sample);
+
+        // replaces the file in one step, so readers never see a partial status
+        static bool writeJSON(const std::string &filename, const Sample &sample);
+    };
+
+    // samples the status every interval on a background thread, logs the summary and writes the status file
+    class StatusReporter
+    {
+    private:
+        double interval;
+        std::string filename;
+        bool logging;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping;
+        Status::Sample latest;
+
+        std::thread thread;
+
+        StatusReporter(const StatusReporter &);
+        StatusReporter &operator=(const StatusReporter &);
+
+        void run(void);
+        void publish(const Status::Sample &sample);
+
+    public:
+        // interval in seconds; an empty filename writes no file, logging false only keeps the latest sample
+        explicit StatusReporter(double interval, const std::string &filename = std::string(), bool logging = true);
+
+        // publishes a final sample
+        ~StatusReporter(void);
+
+        // the most recent sample; rates are over the last interval
+        Status::Sample getLatest(void);
+    };
+
+}
+
+#ifndef COGNITICS_STATUS_DISABLED
+
+// the empty literals only compile with a literal name, so the name can be stored by pointer
+#define COGNITICS_STATUS_COUNT(name, value)         { static ccl::StatusCounter counter("" name ""); counter.add(int64_t(value)); }
+#define COGNITICS_STATUS_LEVEL(name, delta)         { static ccl::StatusCounter counter("" name "", ccl::StatusCounter::LEVEL); counter.add(int64_t(delta)); }
+
+#else
+
+#define COGNITICS_STATUS_COUNT(name, value)
+#define COGNITICS_STATUS_LEVEL(name, delta)
+
+#endif
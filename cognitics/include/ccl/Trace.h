@@ -0,0 +1,151 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file ccl/Trace.h
+\headerfile ccl/Trace.h
+\brief Provides ccl::Trace, ccl::TraceSpan and ccl::TraceCounter.
+*/
+#pragma once
+
+#include "Status.h"
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ccl
+{
+    /*
+    Timeline tracing for hot paths.
+
+    Unlike ccl::Profiling, which totals times by name in a shared map, tracing records every span as an event
+    in a buffer owned by the thread that recorded it. Recording takes no lock, so spans can stay in production
+    code; when tracing is disabled a span costs one relaxed atomic load.
+
+    Span and counter names are string literals (enforced by the macros below) and are stored as pointers.
+    Names built at runtime have to be interned with Trace::intern() first.
+
+    The events are exported in the Chrome trace event format, which chrome://tracing and the Perfetto UI
+    (ui.perfetto.dev) open directly. Spans nest by time, so a span inside another shows up under it.
+
+    Usage:
+        ccl::Trace::enable();
+        {
+            COGNITICS_TRACE_SPAN("sample");
+            ...
+            COGNITICS_TRACE_COUNT("bytes decoded", bytes.size());
+        }
+        ccl::Trace::writeChromeTrace("trace.json");
+    */
+    class Trace
+    {
+    private:
+        static std::atomic<bool> _enabled;
+
+    public:
+        // start/stop recording (disabled by default)
+        static void enable(void);
+        static void disable(void);
+        static bool enabled(void) { return _enabled.load(std::memory_order_relaxed); }
+
+        // maximum number of events kept per thread; later events are dropped and counted (default 1M)
+        static void setCapacity(size_t eventsPerThread);
+        static size_t getDroppedCount(void);
+
+        // returns a pointer that stays valid for the life of the process; equal names return the same pointer
+        static const char *intern(const std::string &name);
+
+        // names the calling thread in the exported trace
+        static void setThreadName(const std::string &name);
+
+        // nanoseconds since the trace clock started
+        static uint64_t now(void);
+
+        // record a span or a counter value for the calling thread; name must stay valid (a literal or interned)
+        static void span(const char *name, uint64_t begin, uint64_t end);
+        static void counter(const char *name, int64_t value);
+
+        // write the events recorded so far as Chrome trace JSON
+        static void writeChromeTrace(std::ostream &stream);
+        static bool writeChromeTrace(const std::string &filename);
+    };
+
+    // records a span from construction to destruction
+    class TraceSpan
+    {
+    private:
+        const char *name;
+        uint64_t begin;
+
+        TraceSpan(const TraceSpan &);
+        TraceSpan &operator=(const TraceSpan &);
+
+    public:
+        explicit TraceSpan(const char *name) : name(Trace::enabled() ? name : NULL), begin(this->name ? Trace::now() : 0) { }
+
+        ~TraceSpan(void)
+        {
+            if(name)
+                Trace::span(name, begin, Trace::now());
+        }
+    };
+
+    // process wide running total (e.g. bytes decoded); the total is kept even when tracing is disabled
+    // and shows up in ccl::Status reports
+    // there is one counter per name, so every call site counting "bytes decoded" adds to the same total
+    // and the trace shows that total rather than one series per call site
+    class TraceCounter : public StatusCounter
+    {
+    private:
+        explicit TraceCounter(const char *name) : StatusCounter(name) { }
+
+    public:
+        // the counter for name, created on first use and kept for the life of the process
+        static TraceCounter &named(const char *name);
+
+        void add(int64_t value)
+        {
+            int64_t result = StatusCounter::add(value);
+            if(Trace::enabled())
+                Trace::counter(getName(), result);
+        }
+
+        int64_t getTotal(void) const { return get(); }
+    };
+
+}
+
+#ifndef COGNITICS_TRACING_DISABLED
+
+#define COGNITICS_TRACE_CONCAT_(a, b)               a##b
+#define COGNITICS_TRACE_CONCAT(a, b)                COGNITICS_TRACE_CONCAT_(a, b)
+#define COGNITICS_TRACE_VAR                         COGNITICS_TRACE_CONCAT(cognitics_trace_line_, __LINE__)
+
+// the empty literals only compile with a literal name, so the name can be stored by pointer
+#define COGNITICS_TRACE_SPAN(name)                  ccl::TraceSpan COGNITICS_TRACE_VAR("" name "");
+#define COGNITICS_TRACE_COUNT(name, value)          { static ccl::TraceCounter &counter = ccl::TraceCounter::named("" name ""); counter.add(int64_t(value)); }
+
+#else
+
+#define COGNITICS_TRACE_SPAN(name)
+#define COGNITICS_TRACE_COUNT(name, value)
+
+#endif
@@ -33,6 +33,9 @@ The purpose of this class is to provide a limited set of types that are enumerab
 
 Conversions between numeric values and date/time values are done with POSIX time ("unixtime"). 
 
+Values are held in place: numbers, UUIDs and short strings don't allocate, so copying attributes is cheap.
+Only long strings, wide strings and binary values are stored on the heap.
+
 \section Usage
 
 
@@ -62,8 +65,6 @@ Conversions between numeric values and date/time values are done with POSIX time
 
 namespace ccl
 {
-    class VariantType;
-
     std::wstring wstring(const std::string &value);
     std::string string(const std::wstring &value);
 
@@ -71,8 +72,35 @@ namespace ccl
     class Variant
     {
     private:
-        VariantType *content;
-        VariantType *clone(void) const;
+        // strings of up to SHORT_STRING_SIZE characters are stored in place, like numbers and uuids
+        static const size_t SHORT_STRING_SIZE = 23;
+
+        union Content
+        {
+            int32_t i;
+            int64_t bigint;
+            double d;
+            unsigned char uuid[16];
+            char str[SHORT_STRING_SIZE + 1];
+            std::string *longString;
+            std::wstring *wideString;
+            binary *bytes;
+        };
+
+        Content content;
+        uint8_t kind;
+        bool shortString;
+        uint8_t shortSize;
+
+        void reset(void);
+        void setInt(int32_t value);
+        void setBigInt(int64_t value);
+        void setDouble(double value);
+        void setUUID(const boost::uuids::uuid &value);
+        void setString(const char *value, size_t size);
+        void setWideString(const std::wstring &value);
+        void setBinary(const binary &value);
+        const char *stringData(size_t &size) const;
 
     public:
         static int precision;
@@ -109,6 +137,7 @@ namespace ccl
         static const int ENDIAN_HOST        = 2;
 
         Variant(const Variant &value);
+        Variant(Variant &&value);
         Variant(const boost::uuids::uuid &value);
         Variant(const char *value);
         Variant(const std::string &value);
@@ -129,6 +158,7 @@ namespace ccl
         Variant(const binary &value);
 
         Variant &operator=(const Variant &value);
+        Variant &operator=(Variant &&value);
         Variant &operator=(const boost::uuids::uuid &value);
         Variant &operator=(const char *value);
         Variant &operator=(const std::string &value);
@@ -63,6 +63,11 @@ The library consists of the following components:
 #include "Value.h"
 #include "Action.h"
 #include "LogStream.h"
+#include "AsyncLog.h"
+#include "ResourceUsage.h"
+#include "Status.h"
+#include "Trace.h"
+#include "Arena.h"
 #include "ObjLog.h"
 #include "md5.h"
 #include "Timer.h"
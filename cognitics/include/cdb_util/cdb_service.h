@@ -10,6 +10,9 @@ struct cdb_service_parameters
 {
     std::string cdb;
     std::string bind { "8080" };
+    std::string status_file;            // JSON status file rewritten every status_interval seconds
+    double status_interval { 10.0 };
+    bool status_log { false };          // log the status every status_interval seconds
 };
 
 bool cdb_service(cdb_service_parameters& params);
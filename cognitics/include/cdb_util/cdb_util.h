@@ -8,6 +8,9 @@
 #include <elev/Elevation_DSM.h>
 
 #include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_set>
 
 namespace cognitics {
 namespace cdb {
@@ -84,6 +87,19 @@ std::map<std::string, ccl::AttributeContainer> AttributesByCNAM(const std::vecto
 
 std::pair<bool, std::vector<std::string>> TextureFileNamesForModel(const std::string& filename);
 
+// Same as TextureFileNamesForModel() for each filename, in order. Models are grouped by parent directory or zip
+// archive and each group is read by one job, so an archive is opened once for all of its models.
+std::vector<std::pair<bool, std::vector<std::string>>> TextureFileNamesForModels(const std::vector<std::string>& filenames, int workers = 8);
+
+// Lowercase member names of a zip archive (null if it can't be read). The central directory is parsed the first
+// time an archive is requested and cached for the rest of the process; the cache is safe to use from jobs.
+std::shared_ptr<const std::unordered_set<std::string>> ZipArchiveMembers(const std::string& zip_filename);
+void ClearZipArchiveCache();
+
+// Opens zip_filename once and calls visitor(index, data, size) for each members[index] found in it; the data is
+// only valid during the call. Members are matched case insensitively. Returns false if the archive can't be opened.
+bool ExtractZipArchiveMembers(const std::string& zip_filename, const std::vector<std::string>& members, const std::function<void(size_t, const unsigned char*, size_t)>& visitor);
+
 std::vector<std::string> GSModelReferencesForTile(const std::string& cdb, const TileInfo& tileinfo, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX) );
 std::vector<std::string> GTModelReferencesForTile(const std::string& cdb, const TileInfo& tileinfo, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX) );
 
@@ -126,8 +142,8 @@ bool InjectFeatures(const std::string& cdb, int dataset, int cs1, int cs2, int l
 
 std::vector<sfa::Feature*> FeaturesForTileCroppedFeature(const TileInfo& tile_info, const sfa::Feature& feature);
 
-void ReportMissingGSFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX));
-void ReportMissingGTFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX));
+void ReportMissingGSFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX), int workers = 8);
+void ReportMissingGTFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew = std::make_tuple(DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX), int workers = 8);
 
 void InjectGTModels(const std::string& cdb, const std::vector<sfa::Feature*>& features, const std::string& source_model_path, const std::string& source_textures_path);
 bool WriteFeaturesToOGRFile(const std::string& filename, const std::vector<sfa::Feature*> features);
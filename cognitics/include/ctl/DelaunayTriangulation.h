@@ -297,6 +297,12 @@ namespace ctl {
             CORRUPTION_DETECTED        = 0x02,            //    An unknown error has cased the graph to become corrupt
         };
 
+        enum SimplifyMetric
+        {
+            AVERAGE_PLANE_ERROR        = 0,            //    Distance from a Vertex to the area weighted average plane of its triangles.
+            QUADRIC_ERROR            = 1            //    Area weighted RMS distance from a Vertex to the planes of the surface left by its removal.
+        };
+
     protected:
         Point                                origin_;
         PointList                            boundary_;
@@ -599,11 +605,15 @@ namespace ctl {
 *******************************************************************************************************/
     private:
         float ComputeVertexError(Vertex* vert) const;
+        float ComputeQuadricError(Vertex* vert) const;
+        float ComputeVertexError(Vertex* vert, SimplifyMetric metric) const;
 
     public:
 //!    Simplify this DelaunayTriangulation by removing working points until the targetFaces have been reached
 //!    or until no other points can be removed. (No points with a saliency greater than threshold will be removed).
-        void Simplify(int targetFaces, float threshold);
+//!    Points are removed lowest error first from an indexed priority queue, and the errors of the neighbors of each
+//!    removed point are recomputed, so a single call reaches the target without repeated passes.
+        void Simplify(int targetFaces, float threshold, SimplifyMetric metric = AVERAGE_PLANE_ERROR);
 
     };
 
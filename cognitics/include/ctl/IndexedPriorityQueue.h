@@ -0,0 +1,170 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*!    \file ctl/IndexedPriorityQueue.h
+\headerfile ctl/IndexedPriorityQueue.h
+\brief Provides ctl::IndexedPriorityQueue.
+*/
+#pragma once
+
+#include "ID.h"
+#include <vector>
+
+namespace ctl {
+
+/*!    \class ctl::IndexedPriorityQueue ctl/IndexedPriorityQueue.h ctl/IndexedPriorityQueue.h
+     \brief IndexedPriorityQueue
+
+     A binary min-heap of ID values ordered by a priority of type T. Each ID can appear at most once and its
+    position in the heap is tracked, so the priority of an entry can be changed or the entry removed in O(log n)
+    without rebuilding the heap. ID values are used directly as indices (see ctl::IDGenerator), so the queue is
+    sized to the largest ID it will hold.
+*/
+    template <typename T>
+    class IndexedPriorityQueue
+    {
+    private:
+        enum : size_t { npos = size_t(-1) };
+
+        std::vector<ID>        heap;                    //!< heap ordered IDs
+        std::vector<T>        priorities;                //!< priority of each ID (indexed by ID)
+        std::vector<size_t>    positions;                //!< position of each ID in the heap or npos (indexed by ID)
+
+        void swap(size_t a, size_t b)
+        {
+            ID t = heap[a];
+            heap[a] = heap[b];
+            heap[b] = t;
+            positions[heap[a]] = a;
+            positions[heap[b]] = b;
+        }
+
+        void siftUp(size_t i)
+        {
+            while (i > 0)
+            {
+                size_t parent = (i - 1) / 2;
+                if (!(priorities[heap[i]] < priorities[heap[parent]]))
+                    break;
+                swap(i, parent);
+                i = parent;
+            }
+        }
+
+        void siftDown(size_t i)
+        {
+            size_t count = heap.size();
+            while (true)
+            {
+                size_t smallest = i;
+                size_t left = (2 * i) + 1;
+                size_t right = left + 1;
+                if ((left < count) && (priorities[heap[left]] < priorities[heap[smallest]]))
+                    smallest = left;
+                if ((right < count) && (priorities[heap[right]] < priorities[heap[smallest]]))
+                    smallest = right;
+                if (smallest == i)
+                    break;
+                swap(i, smallest);
+                i = smallest;
+            }
+        }
+
+    public:
+        IndexedPriorityQueue(size_t maxID = 0) : priorities(maxID), positions(maxID, npos) { }
+        ~IndexedPriorityQueue(void) { }
+
+        bool empty(void) const { return heap.empty(); }
+        size_t size(void) const { return heap.size(); }
+
+//!    \return TRUE if the ID is currently in the queue.
+        bool contains(ID id) const
+        {
+            return (id < positions.size()) && (positions[id] != npos);
+        }
+
+//!    \return The ID with the lowest priority. The queue must not be empty.
+        ID top(void) const { return heap.front(); }
+
+//!    \return The lowest priority in the queue. The queue must not be empty.
+        const T& topPriority(void) const { return priorities[heap.front()]; }
+
+//!    \return The priority of an ID in the queue.
+        const T& priority(ID id) const { return priorities[id]; }
+
+//!    \brief Insert an ID or change its priority if it is already in the queue.
+        void push(ID id, const T& priority)
+        {
+            if (id >= positions.size())
+            {
+                priorities.resize(id + 1);
+                positions.resize(id + 1, npos);
+            }
+            if (positions[id] != npos)
+            {
+                update(id, priority);
+                return;
+            }
+            priorities[id] = priority;
+            positions[id] = heap.size();
+            heap.push_back(id);
+            siftUp(heap.size() - 1);
+        }
+
+//!    \brief Change the priority of an ID that is already in the queue.
+        void update(ID id, const T& priority)
+        {
+            bool decreased = priority < priorities[id];
+            priorities[id] = priority;
+            if (decreased)
+                siftUp(positions[id]);
+            else
+                siftDown(positions[id]);
+        }
+
+//!    \brief Remove an ID from the queue. Does nothing if the ID is not in the queue.
+        void remove(ID id)
+        {
+            if (!contains(id))
+                return;
+            size_t i = positions[id];
+            size_t last = heap.size() - 1;
+            if (i != last)
+                swap(i, last);
+            heap.pop_back();
+            positions[id] = npos;
+            if (i < heap.size())
+            {
+                siftUp(i);
+                siftDown(i);
+            }
+        }
+
+//!    \brief Remove and return the ID with the lowest priority. The queue must not be empty.
+        ID pop(void)
+        {
+            ID id = heap.front();
+            remove(id);
+            return id;
+        }
+    };
+
+}
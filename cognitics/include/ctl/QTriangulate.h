@@ -28,15 +28,22 @@ namespace ctl {
     \brief QTriangulate
 
     Provides a fast algorithm for simple polygon triangulation. This triangulation is not Delaunay and 
-    not dynamic. If you simply need to construct a triangulation of a Polygon with no holes once and be
-    done, use this instead of DelaunayTriangulation.
+    not dynamic. If you simply need to construct a triangulation of a Polygon once and be done, use this
+    instead of DelaunayTriangulation.
+
+    The polygon is projected onto the plane of its dominant normal axis and triangulated by ear clipping.
+    Candidate ears are only tested against the vertices whose z-order (Morton) codes fall within the ear's
+    bounding box, and holes are bridged into the outer contour before clipping, so large contours with
+    holes triangulate in roughly O(n log n) instead of O(n^2).
+
+    The result is a list of triangles (three points per triangle) wound in the same direction as the contour.
+    An empty list is returned if the contour is degenerate.
 */
     class QTriangulate
     {
-        static bool snip(PointList contour, int u, int v, int w, int n, const std::vector<int>& V, const Point& normal);
-
     public:
         static PointList apply(PointList contour);
+        static PointList apply(const PointList& contour, const std::vector<PointList>& holes);
     };
 
 }
\ No newline at end of file
@@ -55,7 +55,7 @@ namespace ctl {
 /******************************************************************************************************
     POLYGON OPERATIONS
 *******************************************************************************************************/
-    bool    PointInPolygon(Point p, PointList polygon, double epsilon = 1e-10);
+    bool    PointInPolygon(const Point& p, const PointList& polygon, double epsilon = 1e-10);
     PointList ClipToLine(PointList polygon, Point a, Point b, double epsilon);
 
 /*
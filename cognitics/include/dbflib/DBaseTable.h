@@ -0,0 +1,107 @@
+#ifndef DBASETABLE_H
+#define DBASETABLE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <ccl/MappedFile.h>
+
+#include "DBaseColDef.h"
+#include "DBaseFile.h"
+
+/**< Bytes of one field in the mapped file; space padded and not NUL terminated */
+struct DBaseCell
+{
+        const char* m_data = nullptr;
+        size_t m_length = 0;
+
+        DBaseCell() {}
+        DBaseCell(const char* data, size_t length) : m_data(data), m_length(length) {}
+        explicit DBaseCell(const std::string& str) : m_data(str.data()), m_length(str.size()) {}
+
+        /**< Cell without leading and trailing whitespace (and NUL padding) */
+        DBaseCell trimmed() const;
+        std::string str() const { return std::string(m_data, m_length); }
+        bool empty() const { return m_length == 0; }
+
+        bool operator==(const DBaseCell& other) const;
+};
+
+struct DBaseCellHash
+{
+        size_t operator()(const DBaseCell& cell) const;
+};
+
+struct DBaseTable;
+
+/**< Typed access to one column of a DBaseTable */
+struct DBaseColumn
+{
+        const DBaseTable* m_table = nullptr;
+        size_t m_column = 0;
+
+        DBaseColumn(const DBaseTable* table, size_t column) : m_table(table), m_column(column) {}
+
+        size_t size() const;
+        const DBaseColDef& definition() const;
+        DBaseCell cell(size_t record) const;
+        std::string getString(size_t record) const;
+        double getDouble(size_t record, double defaultValue = 0.0) const;
+        long long getInteger(size_t record, long long defaultValue = 0) const;
+};
+
+/**
+ * \brief   Memory mapped, read only view of a .dbf file.
+ *
+ * Unlike DBaseFile, opening a table only parses the header and column definitions. Fields are read from the
+ * mapping on request, so looking up a few columns of a few records doesn't copy the rest of the file.
+ */
+struct DBaseTable
+{
+        DBaseTable();
+        ~DBaseTable();
+
+        /**< Map file and parse header and column definitions. Throws the DBaseFile exceptions on failure */
+        bool openFile(const std::string& fileName);
+        void close();
+
+        size_t numRecords() const { return m_numRecords; }
+        size_t numColumns() const { return m_colDef.size(); }
+        /**< Index of the named column, or -1 */
+        int columnIndex(const std::string& name) const;
+        DBaseColumn column(size_t index) const { return DBaseColumn(this, index); }
+
+        /**< Records marked as deleted (or otherwise not starting with a space) are skipped by DBaseFile */
+        bool isDeleted(size_t record) const;
+        DBaseCell cell(size_t record, size_t column) const;
+        /**< Field with leading and trailing whitespace removed */
+        std::string getString(size_t record, size_t column) const;
+        /**< Numeric value of a numeric, float, currency, integer, double or logical field */
+        double getDouble(size_t record, size_t column, double defaultValue = 0.0) const;
+        long long getInteger(size_t record, size_t column, long long defaultValue = 0) const;
+
+        /**< Hash index over the trimmed values of a column (e.g. CNAM); later records replace earlier ones with the same key */
+        bool buildIndex(const std::string& columnName);
+        /**< Record with the given key in the index, or -1 */
+        long long find(const std::string& key) const;
+
+        /**< Column defintion / field descriptors / subrecord structure */
+        std::vector<DBaseColDef> m_colDef;
+
+    private:
+        DBaseTable(const DBaseTable&);
+        DBaseTable& operator=(const DBaseTable&);
+
+        ccl::MappedFile m_file;
+        /**< First record in the mapping */
+        const char* m_records = nullptr;
+        size_t m_numRecords = 0;
+        size_t m_recordLength = 0;
+        /**< Offset of each column within a record (after the deletion flag) */
+        std::vector<size_t> m_columnOffsets;
+        /**< Keys point into the mapping */
+        std::unordered_map<DBaseCell, size_t, DBaseCellHash> m_index;
+};
+
+#endif // DBASETABLE_H
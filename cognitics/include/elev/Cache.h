@@ -53,11 +53,15 @@ elev::Cache *cache = new elev::Cache(32 * 1024 * 1024);
         unsigned int size;                        //!< current size in bytes
         unsigned int hits;                        //!< cache hits
         unsigned int misses;                    //!< cache misses
+        unsigned int published_hits;            //!< hits already added to the ccl::Status totals
         std::list<CacheEntry *> entries;        //!< list of elev::CacheEntry objects
 
+        //! Add the hits since the last call to the ccl::Status totals.
+        void PublishHits(void);
+
     public:
         //! Create a new cache of maxsize bytes.
-        Cache(unsigned int maxsize) : maxsize(maxsize), size(0), hits(0), misses(0) { }
+        Cache(unsigned int maxsize) : maxsize(maxsize), size(0), hits(0), misses(0), published_hits(0) { }
 
         //! Destroy the cache and all entries.
         ~Cache();
@@ -11,33 +11,16 @@ Copyright 2017 Cognitics, Inc.
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <unordered_map>
 
 #include <ccl/Log.h>
 #include <elev/Cache.h>
+#include <sfa/RTree.h>
 
 
 namespace elev
 {
-    class ElevationBSP
-    {
-    public:
-        bool generated;
-        size_t depth;
-        bool vertical;
-        double split;
-        ElevationBSP *minChild;
-        ElevationBSP *maxChild;
-        std::list<DataSource_Raster *> sources;
-
-        ~ElevationBSP(void);
-        ElevationBSP(size_t depth = 0, bool vertical = true);
-
-        bool generate(void);
-
-        void getSourcesForPoint(double x, double y, std::list<DataSource_Raster *> &result);
-    };
-
-
     class DataSourceManager
     {
         ccl::ObjLog log;                            //!< ObjLog instance
@@ -45,7 +28,9 @@ namespace elev
         Cache *cache;                        //!< Cache instance
         std::string reftype;                //!< application reference (projection) type (default is "WGS84")
         std::vector<DataSource *> sources;    //!< DataSource instance list
-        ElevationBSP bsp;
+        std::vector<std::unique_ptr<sfa::LineString> > sourceEnvelopes;    //!< padded envelope of each indexed raster source
+        std::unordered_map<const sfa::Geometry *, size_t> sourceByEnvelope;    //!< index into sources of each envelope
+        sfa::RTree sourceIndex;                //!< spatial index over sourceEnvelopes
 
     public:
         bool generate_debug_features;
@@ -73,6 +58,7 @@ namespace elev
         /*!    Returns the number of elev::DataPost objects created. */
         int GetPostsForPoint(double x, double y, std::vector<DataPost*> &posts);
 
+        //! Build the spatial index used by GetPostsForPoint. Sources added afterwards are not indexed until this is called again.
         void generateBSP(void);
 
         bool getElevationBounds(double &elevation_min, double &elevation_max);
@@ -26,6 +26,9 @@ DEALINGS IN THE SOFTWARE.
 
 namespace flt
 {
+    //! Creates an empty record for the opcode, or an Unknown record for unrecognized opcodes.
+    Record *createRecordForOpcode(int opcode);
+
     class OpenFlight
     {
     private:
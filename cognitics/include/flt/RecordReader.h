@@ -0,0 +1,166 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \file flt/RecordReader.h
+\headerfile flt/RecordReader.h
+\brief Provides flt::RecordReader
+*/
+#pragma once
+
+#include "Record.h"
+#include <ccl/MappedFile.h>
+#include <string>
+#include <vector>
+
+namespace flt
+{
+    /**
+     * @brief    A record as stored in a mapped file: its opcode and a view of its bytes.
+     *
+     * Field accessors take the same record offsets as the bind() comments of the Record classes (the 4 byte
+     * opcode/length header is offset 0) and read big endian values straight from the mapping. Offsets past
+     * the first part of a continued record are not visible here; use decode() for those.
+     *
+     * A view is only valid while the RecordReader that produced it is open (and its buffer, if any, is alive).
+     */
+    struct RecordView
+    {
+        int opcode;
+        ccl::uint32_t position;         // file offset of the record
+        const unsigned char *data;      // first part, including the opcode/length header
+        size_t length;                  // length of the first part
+        size_t totalLength;             // length including the headers of any continuation records
+
+        RecordView(void) : opcode(Record::FLT_INVALID), position(0), data(NULL), length(0), totalLength(0) { }
+
+        bool isContinued(void) const { return totalLength > length; }
+
+        ccl::uint8_t getUInt8(size_t offset) const;
+        ccl::int16_t getInt16(size_t offset) const;
+        ccl::uint16_t getUInt16(size_t offset) const;
+        ccl::int32_t getInt32(size_t offset) const;
+        ccl::uint32_t getUInt32(size_t offset) const;
+        float getFloat(size_t offset) const;
+        double getDouble(size_t offset) const;
+
+        //! Returns the NUL terminated string stored in a fixed size field of the given length.
+        std::string getString(size_t offset, size_t fieldLength) const;
+
+        //! Fully decodes the record (including continuations) into a new Record; the caller owns the result.
+        Record *decode(int revision) const;
+    };
+
+    /**
+     * @class    RecordReader
+     *
+     * @brief    Forward iterator over the records of a memory mapped (or in-memory) OpenFlight file.
+     *
+     * Unlike OpenFlight::getNextRecord(), next() doesn't copy the record or create a Record object; it only
+     * locates the record in the mapping. Callers inspect the fields they need through the view and decode()
+     * the records they want as objects.
+     */
+    class RecordReader
+    {
+    private:
+        ccl::MappedFile file;
+        const unsigned char *data;
+        size_t size;
+        size_t offset;
+        int revision;
+
+        RecordReader(const RecordReader &);
+        RecordReader &operator=(const RecordReader &);
+
+        bool readHeader(void);
+
+    public:
+        RecordReader(void);
+        ~RecordReader(void);
+
+        //! Maps the file and validates the header record; also reads the format revision.
+        bool open(const std::string &filename);
+
+        //! Reads from a buffer owned by the caller, e.g. a model extracted from a zip archive.
+        bool open(const void *buffer, size_t length);
+
+        void close(void);
+        bool isOpen(void) const { return data != NULL; }
+
+        int getRevision(void) const { return revision; }
+
+        //! Moves back to the header record.
+        void rewind(void);
+
+        //! Gets the next record, skipping over its continuations. Returns false at the end of the file or if the remaining data is truncated.
+        bool next(RecordView &record);
+
+        /**
+         * @brief    Rewinds and calls visitor(opcode, x, y, z) for every vertex palette entry (opcodes 68-71).
+         *
+         * The vertex records all follow the vertex palette record, so the scan stops at the first other
+         * record after them instead of walking the hierarchy.
+         *
+         * @return    The number of vertices visited.
+         */
+        template <typename Visitor>
+        size_t scanVertices(Visitor visitor)
+        {
+            rewind();
+            size_t count = 0;
+            bool inPalette = false;
+            RecordView record;
+            while(next(record))
+            {
+                switch(record.opcode)
+                {
+                    case Record::FLT_VERTEXPALETTE:
+                        inPalette = true;
+                        break;
+                    case Record::FLT_VERTEXWITHCOLOR:
+                    case Record::FLT_VERTEXWITHCOLORNORMAL:
+                    case Record::FLT_VERTEXWITHCOLORNORMALUV:
+                    case Record::FLT_VERTEXWITHCOLORUV:
+                        if(record.length >= 32)
+                        {
+                            visitor(record.opcode, record.getDouble(8), record.getDouble(16), record.getDouble(24));
+                            ++count;
+                        }
+                        break;
+                    default:
+                        if(inPalette)
+                            return count;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * @brief    Rewinds and appends the non-empty file names of the texture palette records to filenames.
+         *
+         * Palettes precede the hierarchy, so the scan stops at the first push level.
+         *
+         * @return    The number of file names appended.
+         */
+        size_t getTexturePaletteFilenames(std::vector<std::string> &filenames);
+
+    };
+
+}
@@ -1,39 +1,91 @@
 #pragma once
 #include "gltf/GltfInfo.h"
+#include <ccl/MappedFile.h>
 #include <vector>
+#include <memory>
 
 namespace gltf
 {
+	const int GLTF_BYTE = 5120;
+	const int GLTF_UNSIGNED_BYTE = 5121;
+	const int GLTF_SHORT = 5122;
+	const int GLTF_UNSIGNED_SHORT = 5123;
+	const int GLTF_UNSIGNED_INT = 5125;
+	const int GLTF_FLOAT = 5126;
 
+	const int GLTF_ARRAY_BUFFER = 34962;
+	const int GLTF_ELEMENT_ARRAY_BUFFER = 34963;
+
+	// A range of the single binary buffer; views are laid out in order, each starting on a 4 byte boundary.
+	struct GltfBufferView
+	{
+		const char* data;
+		int byteOffset;
+		int byteLength;
+		int byteStride;		// 0 for tightly packed
+		int target;			// 0 for none (images)
+
+		GltfBufferView(const char* dataA, int byteLengthA, int byteStrideA, int targetA) :
+			data(dataA), byteOffset(0), byteLength(byteLengthA), byteStride(byteStrideA), target(targetA)
+		{}
+	};
+
+	struct GltfAccessor
+	{
+		int bufferView;
+		int componentType;
+		std::string type;
+		int count;
+		bool normalized;
+		std::vector<double> min;	// left empty when min/max are not written
+		std::vector<double> max;
+
+		GltfAccessor(int bufferViewA, int componentTypeA, const std::string& typeA, int countA, bool normalizedA = false) :
+			bufferView(bufferViewA), componentType(componentTypeA), type(typeA), count(countA), normalized(normalizedA)
+		{}
+	};
+
+	// Faces sharing a texture, welded into an indexed triangle list.
 	struct GltfPrimitive
 	{
 		int numVerts;
-		float* vertexBuffer;
-		float* normalsBuffer;
-		float* uvBuffer;
-		unsigned short* batchBuffer;
-		char* textureBuffer;
-		int vertexBufferLength;
-		int normalsBufferLength;
-		int uvBufferLength;
-		int batchBufferLength;
+		int numIndices;
+		std::vector<char> vertexBuffer;
+		std::vector<char> normalsBuffer;
+		std::vector<char> uvBuffer;
+		std::vector<char> batchBuffer;
+		std::vector<char> indexBuffer;
+		std::shared_ptr<ccl::MappedFile> textureFile;
+		const char* textureBuffer;
 		int textureBufferLength;
 
-		std::vector<float> maxVertexValues;
-		std::vector<float> minVertexValues;
-		std::vector<float> maxNormalValues;
-		std::vector<float> minNormalValues;
-		std::vector<float> maxUvValues;
-		std::vector<float> minUvValues;
+		int positionComponentType;
+		int normalComponentType;
+		int uvComponentType;
+		int indexComponentType;
+
+		std::vector<double> maxVertexValues;
+		std::vector<double> minVertexValues;
+		std::vector<double> maxNormalValues;
+		std::vector<double> minNormalValues;
+		std::vector<double> maxUvValues;
+		std::vector<double> minUvValues;
 
-		std::vector<scenegraph::Face> faces;
+		// accessor and buffer view indices assigned by defineBufferViews()
+		int positionAccessor;
+		int normalAccessor;
+		int uvAccessor;
+		int batchAccessor;
+		int indexAccessor;
+		int imageBufferView;
+
+		std::vector<size_t> faces;		// indices into GltfData::mesh.faces
 		std::string textureName;
 
 		GltfPrimitive() :
-			numVerts(-1), vertexBuffer(NULL), normalsBuffer(NULL), 
-			uvBuffer(NULL), batchBuffer(NULL), textureBuffer(NULL),
-			vertexBufferLength(-1), normalsBufferLength(-1), uvBufferLength(-1), 
-			batchBufferLength(-1), textureBufferLength(-1)
+			numVerts(0), numIndices(0), textureBuffer(NULL), textureBufferLength(-1),
+			positionComponentType(GLTF_FLOAT), normalComponentType(GLTF_FLOAT), uvComponentType(GLTF_FLOAT), indexComponentType(GLTF_UNSIGNED_SHORT),
+			positionAccessor(-1), normalAccessor(-1), uvAccessor(-1), batchAccessor(-1), indexAccessor(-1), imageBufferView(-1)
 		{}
 	};
 
@@ -42,28 +94,40 @@ namespace gltf
 	{
 	public:
 		scenegraph::Scene* scene;
-				
+		scenegraph::IndexedMesh mesh;	// the scene's faces; transformed in place of the scene
+
 		GltfInfo& info;
 		std::vector<GltfPrimitive> primitives;
-		
+		std::vector<GltfBufferView> bufferViews;
+		std::vector<GltfAccessor> accessors;
+		int bufferLength;
+
+		// With KHR_mesh_quantization, positions are stored as int16 relative to the mesh bounds;
+		// the node matrix applies positionScale and positionOffset to restore them.
+		bool quantized;
+		double positionScale[3];
+		double positionOffset[3];
+
 		GltfData(scenegraph::Scene* sceneA, GltfInfo& infoA);
 		~GltfData();
 
 		void init();
 		void applyRotation();
-		void convertLocalToEcef(sfa::Point& p);
+		void convertLocalToEcef(double* p);
 		bool convertSceneToEcef();
-		void initMinMaxs();
 		void definePrimitives();
-		void initPrimitivesBuffers();
 		bool fillBuffers();
 		void initTextureBuffers();
-		void write();
-		void getBase64BufferData(std::string& out_data);
+		void defineBufferViews();
+		void writeBuffer(std::ostream& out);
+		bool writeBufferFile(const std::string& filename);
+		void writeGlb(std::ostream& out, const std::string& json);
 
 	private:
 		void setUpRotationMatrix(float angle, float u, float v, float w);
 		void multiplyMatrix();
+		void initQuantization();
+		void fillPrimitiveBuffers(GltfPrimitive& prim);
 
 		float rotationMatrix[4][4];
 		float inputMatrix[4][1];
@@ -29,6 +29,8 @@ namespace gltf
 		double angle;
 		bool gltfBinary;
 		bool embedTextures;
+		bool quantize;		// write KHR_mesh_quantization attributes (int16 positions/normals, uint16 uvs)
+		bool base64Buffers;	// .gltf only: embed the buffer as a base64 data uri instead of writing a .bin next to the file
 		sfa::Point rtcCenter;
 
 		OGRSpatialReference wgs;
@@ -45,25 +47,15 @@ namespace gltf
 		void writeB3dmHeader();
 		void writeI3dmHeader();
 		void finalizeB3dmSizes();
-		void writeGltfBinaryHeader();
-		void finalizeJsonChunk();
-		void beginBinaryChunk();
-		void finalizeBinaryChunk();
-		void finalizeGltfBinarySizes();
 		bool init();
 		void setPath();
 		void createFile();
 		void finalizeFile();
+		std::string getBufferFileName(bool fullPath) const;
 
 	private:
 		std::streampos tileSizePos;
 		std::streampos tileStart;
-		std::streampos gltfSizePos;
-		std::streampos gltfStart;
-		std::streampos jsonChunkSizePos;
-		std::streampos jsonChunkStart;
-		std::streampos binChunkSizePos;
-		std::streampos binChunkStart;
 
 		std::streampos featureJsonSizePos;
 		std::streampos featureJsonStart;
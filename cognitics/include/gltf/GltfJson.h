@@ -1,30 +1,36 @@
 #pragma once
 #include "gltf/GltfData.h"
+#include "rapidjson/stringbuffer.h"
 
 namespace gltf
 {
 	class GltfJson
 	{
 	private:
-		void writeScenes(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeNodes(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeMeshes(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeMaterials(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeTextures(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeImages(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeBuffers(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeBufferViews(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeBufferView(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter, int offset, int length, int target);
-		void writeAccessors(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
-		void writeAccessor(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter, int bufferViewIndex, int componentType, std::string type, int numVerts);
-		void writeAccessorMinMax(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter, std::vector<float>& min, std::vector<float>& max);
-		void writeAccessorMinMax(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter, std::vector<unsigned short>& min, std::vector<unsigned short>& max);
-		void writeAsset(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter);
+		typedef rapidjson::Writer<rapidjson::StringBuffer> JsonWriter;
+
+		void writeScenes(JsonWriter& jsonWriter);
+		void writeNodes(JsonWriter& jsonWriter);
+		void writeMeshes(JsonWriter& jsonWriter);
+		void writeMaterials(JsonWriter& jsonWriter);
+		void writeTextures(JsonWriter& jsonWriter);
+		void writeImages(JsonWriter& jsonWriter);
+		void writeBuffers(JsonWriter& jsonWriter);
+		void writeBufferViews(JsonWriter& jsonWriter);
+		void writeBufferView(JsonWriter& jsonWriter, const GltfBufferView& view);
+		void writeAccessors(JsonWriter& jsonWriter);
+		void writeAccessor(JsonWriter& jsonWriter, const GltfAccessor& accessor);
+		void writeAccessorMinMax(JsonWriter& jsonWriter, const GltfAccessor& accessor);
+		void writeExtensions(JsonWriter& jsonWriter);
+		void writeAsset(JsonWriter& jsonWriter);
+		void writeBase64Uri(JsonWriter& jsonWriter, rapidjson::StringBuffer& jsonBuffer);
 
 		GltfData& data;
+		rapidjson::StringBuffer* jsonBuffer;
 	public:
-		GltfJson(GltfData& dataA) : data(dataA) {	}
-		bool write();
+		GltfJson(GltfData& dataA) : data(dataA), jsonBuffer(NULL) {	}
+		// Builds the document in memory; binary buffers stay in GltfData and are written by the caller.
+		bool write(std::string& out_json);
 	};
 
 }
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 #include <string>
+#include "gltf/GltfInfo.h"
 #include "scenegraph/Scene.h"
 #include "scenegraph/ExternalReference.h"
 #include "rapidjson/prettywriter.h"
 #include <map>
+#include <vector>
 
 namespace gltf
 {
@@ -23,23 +25,23 @@ namespace gltf
 		{}
 	};
 
+	// Writes tileset.json for the tiles of one generation run; the first tile is the root terrain tile.
 	class Tileset
 	{
 		std::string name;
 		scenegraph::Scene* scene;
-		GeoRect& bounds;
-		std::map<std::string, TileInfo&> tileLods;
+		GeoRect bounds;
+		const std::vector<TileInfo>& tiles;
+		std::map<std::string, const TileInfo&> tileLods;
 		bool removeTextures;
 
 	public:
-		Tileset(std::string filename, scenegraph::Scene* sceneA, GeoRect boundsA) :
-			name(filename), scene(sceneA), bounds(boundsA), removeTextures(true)
+		Tileset(std::string filename, scenegraph::Scene* sceneA, GeoRect boundsA, const std::vector<TileInfo>& tilesA) :
+			name(filename), scene(sceneA), bounds(boundsA), tiles(tilesA), removeTextures(true)
 		{}
-		void GetRadianRectFromExtRef(TileInfo& ref, GeoRect& out_rect);
-		void writeLeafChild(rapidjson::PrettyWriter<rapidjson::FileWriteStream>& writer, TileInfo& ref, int geometricError);
-		void writeLods(rapidjson::PrettyWriter<rapidjson::FileWriteStream>& writer, TileInfo& ref, int geometricError);
+		void GetRadianRectFromExtRef(const TileInfo& ref, GeoRect& out_rect);
+		void writeLeafChild(rapidjson::PrettyWriter<rapidjson::FileWriteStream>& writer, const TileInfo& ref, int geometricError);
+		void writeLods(rapidjson::PrettyWriter<rapidjson::FileWriteStream>& writer, const TileInfo& ref, int geometricError);
 		void write();
-
-		static std::vector<TileInfo> tiles;
 	};
 }
\ No newline at end of file
@@ -38,6 +38,7 @@ DEALINGS IN THE SOFTWARE.
 #include <list>
 #include <map>
 #include <sfa/sfa.h>
+#include <sfa/PreparedGeometry.h>
 #include <ccl/mutex.h>
 #include <ccl/cstdint.h>
 #include <ccl/FileInfo.h>
@@ -580,8 +581,10 @@ namespace gdalsampler
 
         static const int CACHE_MAX_MEMORY = 100 * 1024 * 1024;
         CachedRasterBlockList _altBlockCache; // this block cache pages in and out entire blocks but keeps the pointer around.
+        int _publishedMemory; // memory in use as last added to the ccl::Status level
 
         bool MakeCacheRoom(int size);
+        void PublishMemoryInUse();
         int GetMemoryInUse()
         {
             int memory_in_use = 0;
@@ -616,6 +619,7 @@ namespace gdalsampler
                 
             }
             _altBlockCache.clear();
+            PublishMemoryInUse();
         }
         
         bool PageBlock(CachedRasterBlockPtr &block);
@@ -661,6 +665,7 @@ namespace gdalsampler
 
         std::string _filename;
         sfa::Polygon _validArea;
+        sfa::PreparedGeometry _preparedValidArea;
         int _fileWidth;
         int _fileHeight;
         double _origEWConst;
@@ -31,19 +31,19 @@ typedef unsigned int u_int;
 #include "GDALRasterReader.h"
 #include <ccl/ObjLog.h>
 #include <ccl/mutex.h>
-#include <sfa/BSP.h>
+#include <sfa/RTree.h>
 
 class GDALRasterSampler
 {
     ccl::ObjLog log;
-    // BSP of all the AOIs as polygon pointers
-    sfa::BSP *bsp;
-    //Map back to the file objects so when we get BSP hits we can get the associated files
+    // R-tree of all the AOIs as polygon pointers
+    sfa::RTree *rtree;
+    //Map back to the file objects so when we get R-tree hits we can get the associated files
     typedef std::map<sfa::Polygon *, gdalsampler::GDALRasterFilePtr> aoimap_t;
     aoimap_t aoiFileMap;
-    ccl::mutex bspMutex;
+    ccl::mutex rtreeMutex;
 
-    bool BuildBSP(bool rebuild);
+    bool BuildRTree(bool rebuild);
     gdalsampler::GDALRasterFileList GetFilesInAOI(gdalsampler::Quad &aoi);
 
     void CopyNonBlackPixels(u_char *src, u_char *dest, int len)
@@ -60,6 +60,8 @@ This class encapsulates the functionality of OGRDataSource.
 		bool isSpatialite;
 		int transactionLevel;//0 means no pending transactions, 1 means one, etc.
 		File(const std::string &filename, OGRDataSource *dataSource, bool update);
+		// finds the layer for the geometry type, creating it if necessary
+		sfa::Layer *getLayerForGeometry(sfa::Geometry *geometry);
 
 	public:
 		File();
@@ -78,6 +80,8 @@ This class encapsulates the functionality of OGRDataSource.
 
 		// this will call the appropriate layer addFeature() for the geometry type, creating the layer if necessary
 		sfa::Feature *addFeature(sfa::Feature *feature);
+		// writes through the layers' bulk addFeatures(); the caller keeps ownership of the features
+		size_t addFeatures(const std::vector<sfa::Feature *> &features);
 
 		virtual sfa::Layer *addLayer(std::string name,sfa::WKBGeometryType type, cts::CS_CoordinateSystem *coordinateSystem = NULL);
 
@@ -70,6 +70,36 @@ This class encapsulates the functionality of OGRLayer.
 		bool writeOGRFeature(ogr::Feature *feature, OGRFeature *ogrFeature);
 		bool readOGRFeature(ogr::Feature *feature, OGRFeature *ogr_native);
 		int getFieldIndex(const std::string &name);
+//! \brief Return the (possibly shortened) field name used for an attribute key, recording it in fieldNameMap.
+		std::string getMappedFieldName(const std::string &name);
+
+		// Field layout for getNextFeatures(), resolved once instead of per feature.
+		// readPrototype holds every attribute key; readSlots gives the field index for each key in map order (-1 for the FID key).
+		size_t readSchemaFields;
+		ccl::AttributeContainer readPrototype;
+		std::vector<int> readSlots;
+		std::vector<unsigned char> wkbBuffer;
+		bool arrowStreamReading;
+		struct ArrowReader;
+		ArrowReader *arrowReader;
+
+		void prepareReadSchema(void);
+//! \brief Convert through a reused WKB buffer into packed sfa coordinates.
+		sfa::Geometry *getGeometryFromWKB(OGRGeometry *ogr_geometry);
+		size_t getNextArrowFeatures(std::vector<sfa::Feature *> &features, size_t count);
+		void closeArrowStream(void);
+
+		// Field layout for addFeatures(), keyed by attribute name and resolved the first time each key is seen.
+		// An index of -1 marks a key that is ignored or whose field could not be created.
+		struct WriteSlot
+		{
+			int index;
+			OGRFieldType type;
+		};
+		std::map<std::string, WriteSlot> writeSlots;
+		size_t transactionSize;
+
+		const WriteSlot &getWriteSlot(const std::string &key, const ccl::Variant &value);
 
 	public:
 		FieldList getOGRFields(void);
@@ -101,7 +131,9 @@ This class encapsulates the functionality of OGRLayer.
 
 		virtual void resetReading(int cursorId=0);
 		virtual sfa::Feature *getNextFeature(int cursorId=0);
+		virtual size_t getNextFeatures(std::vector<sfa::Feature *> &features, size_t count, int cursorId=0);
 		virtual sfa::Feature *addFeature(sfa::Feature *feature);
+		virtual size_t addFeatures(const std::vector<sfa::Feature *> &features);
 		virtual bool updateFeature(sfa::Feature *feature);
 		virtual bool deleteFeature(sfa::Feature *feature);
 
@@ -114,6 +146,15 @@ This class encapsulates the functionality of OGRLayer.
 
 		void setMaxFieldLength(int maxFieldNameLenth) { this->maxFieldNameLenth = maxFieldNameLenth;}
 
+		// Number of features addFeatures() writes per transaction on drivers that support them (GeoPackage, SQLite, ...).
+		// Zero writes without transactions. Drivers without transaction support (Shapefile) ignore this.
+		void setTransactionSize(size_t transactionSize) { this->transactionSize = transactionSize; }
+
+		// Read getNextFeatures() batches through GDAL's columnar Arrow stream (GDAL 3.6+). Only drivers with a native
+		// Arrow implementation (GeoPackage, FlatGeobuf, Parquet, ...) gain from this; features read this way have no ogr_native.
+		// Returns false if the stream is not available in this GDAL build.
+		bool setArrowStreamReading(bool enable);
+
 		virtual void deleteFeaturesWhere(const std::string &whereClause);
 	};
 
@@ -0,0 +1,151 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <ccl/cstdint.h>
+#include "Face.h"
+#include "Material.h"
+
+namespace scenegraph
+{
+    /**
+     * @class    IndexedMesh
+     *
+     * @brief    Faces flattened into shared vertex attribute arrays.
+     *
+     * Positions, normals and texture coordinates are welded on exact values and stored once; each face
+     * corner refers to them by index, and each face refers to its texture and material through a palette.
+     * Only the first texture layer and first material of a face are kept. Other per-face state (colors,
+     * attributes, ids) stays on the source Face, which is found through IndexedFace::source.
+     */
+    class IndexedMesh
+    {
+    public:
+        static const ccl::uint32_t NONE = 0xFFFFFFFF;
+
+        struct Corner
+        {
+            ccl::uint32_t position;
+            ccl::uint32_t normal;       // NONE if the face has no vertex normals
+            ccl::uint32_t uv;           // NONE if the face has no texture coordinates
+
+            bool operator==(const Corner &rhs) const
+            {
+                return (position == rhs.position) && (normal == rhs.normal) && (uv == rhs.uv);
+            }
+        };
+
+        struct CornerHash
+        {
+            size_t operator()(const Corner &corner) const
+            {
+                return size_t(corner.position) * 73856093u ^ size_t(corner.normal) * 19349663u ^ size_t(corner.uv) * 83492791u;
+            }
+        };
+
+        struct IndexedFace
+        {
+            ccl::uint32_t firstCorner;
+            ccl::uint32_t numCorners;
+            int texture;                // index into textures, -1 if untextured
+            int material;               // index into materials, -1 if none
+            size_t source;              // index of the Face this was built from in its FaceList
+        };
+
+        std::vector<double> positions;      // x, y, z
+        std::vector<double> normals;        // i, j, k
+        std::vector<double> uvs;            // u, v
+        std::vector<Corner> corners;
+        std::vector<IndexedFace> faces;
+        std::vector<std::string> textures;
+        std::vector<Material> materials;
+
+        IndexedMesh(void);
+
+        void clear(void);
+
+        size_t getNumPositions(void) const { return positions.size() / 3; }
+        size_t getNumNormals(void) const { return normals.size() / 3; }
+        size_t getNumUVs(void) const { return uvs.size() / 2; }
+
+        /**
+         * @brief    Appends a face. Every call adds exactly one IndexedFace, even for degenerate faces,
+         *           so mesh faces stay parallel to the FaceList they were built from.
+         *
+         * @param    face      The face to add.
+         * @param    source    The index recorded in IndexedFace::source.
+         */
+        void addFace(const Face &face, size_t source);
+
+        /**
+         * @brief    Appends every face in the list; face i of the list becomes mesh face (faces.size() + i)
+         *           with a source of i.
+         */
+        void addFaces(const FaceList &faceList);
+
+        /**
+         * @brief    Builds a Face holding the geometry, texture and material of mesh face n.
+         */
+        Face getFace(size_t n) const;
+
+        /**
+         * @brief    Appends a Face for every mesh face to faceList.
+         */
+        void toFaces(FaceList &faceList) const;
+
+        /**
+         * @brief    Replaces the normals with area weighted vertex normals, matching Scene::setVertexNormals().
+         *
+         * @param    sharpEdges    Use the face normal for every corner instead of averaging across faces.
+         */
+        void computeVertexNormals(bool sharpEdges = false);
+
+        /**
+         * @brief    Computes the unit normal of mesh face n from its first three corners.
+         */
+        void getFaceNormal(size_t n, double normal[3]) const;
+
+    private:
+        // Open addressed index into one of the value arrays; slots hold value indices, NONE when empty.
+        struct WeldTable
+        {
+            std::vector<ccl::uint32_t> slots;
+            size_t count;
+            WeldTable(void) : count(0) {}
+        };
+
+        WeldTable positionIndex;
+        WeldTable normalIndex;
+        WeldTable uvIndex;
+        std::unordered_map<int, int> textureIndex;
+        std::map<Material, int> materialIndex;
+
+        static void resetTable(WeldTable &table, size_t capacity);
+        static void growTable(WeldTable &table, const std::vector<double> &values, int count);
+        static ccl::uint32_t addValue(WeldTable &table, std::vector<double> &values, const double *value, int count);
+    };
+
+}
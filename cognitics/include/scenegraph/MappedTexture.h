@@ -44,6 +44,7 @@ namespace scenegraph
         void RemapTextureCoords(unsigned int a_idx, unsigned int b_idx, unsigned int c_idx);    
         void SetTextureName(const std::string &name);
         std::string GetTextureName() const;
+        int GetTextureID() const;
     
     };
 
@@ -24,6 +24,7 @@ DEALINGS IN THE SOFTWARE.
 #include <sfa/Matrix.h>
 #include <sfa/Polygon.h>
 #include "Face.h"
+#include "IndexedMesh.h"
 #include "LineString.h"
 #include "LightPoint.h"
 #include "ExternalReference.h"
@@ -87,6 +88,16 @@ namespace scenegraph
 
         bool buildStateFaces(void);
 
+        /**
+         * @brief    Appends this scene's faces (not its children's) to an indexed mesh.
+         */
+        void buildIndexedMesh(IndexedMesh &mesh) const;
+
+        /**
+         * @brief    Replaces the faces with those of an indexed mesh.
+         */
+        void setFacesFromIndexedMesh(const IndexedMesh &mesh);
+
         double InterpolateZForXY(const double x, const double y) const            // TODO: visitor
         {
             sfa::Point pt(x,y,0);
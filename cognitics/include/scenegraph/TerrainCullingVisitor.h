@@ -24,6 +24,7 @@ DEALINGS IN THE SOFTWARE.
 #include "Visitor.h"
 #include "Scene.h"
 #include <sfa/Polygon.h>
+#include <sfa/PreparedGeometry.h>
 
 namespace scenegraph
 {
@@ -32,6 +33,9 @@ namespace scenegraph
     {
     private:
         std::vector<sfa::Polygon> polygons;
+        std::vector<sfa::PreparedGeometry> prepared;
+
+        void prepare(void);
 
     public:
         virtual ~TerrainCullingVisitor(void);
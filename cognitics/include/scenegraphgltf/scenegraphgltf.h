@@ -1,10 +1,17 @@
 #pragma once
 
 #include <scenegraph/Scene.h>
+#include <vector>
+
+namespace gltf
+{
+	struct TileInfo;
+}
 
 namespace scenegraph
 {
+	// tileInfo, when given, receives the entry for the written file so the caller can add it to a tileset
 	bool buildGltfFromScene(std::string &filename, Scene *scene,
-		double north, double south, double east, double west, double minElev = 0.0, double maxElev = 1.0, int id = 0, double angle = 0.0);
-	bool buildTilesetFromScene(const std::string &filename, Scene *scene, double north, double south, double east, double west);
+		double north, double south, double east, double west, double minElev = 0.0, double maxElev = 1.0, int id = 0, double angle = 0.0, bool quantize = false, gltf::TileInfo *tileInfo = NULL);
+	bool buildTilesetFromScene(const std::string &filename, Scene *scene, double north, double south, double east, double west, const std::vector<gltf::TileInfo> &tiles);
 }
\ No newline at end of file
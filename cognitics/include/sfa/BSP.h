@@ -36,6 +36,10 @@ namespace sfa
         double density;
     } BSP_NODE_AREA;
 
+    /*
+    For read-only geometry queries prefer sfa::RTree, which is bulk loaded into a flat node array and supports polygon and
+    nearest neighbour queries. BSP remains for callers that edit the tree through BSPEditVisitor.
+    */
     class BSP
     {
         std::map<Geometry *, LineString> envelopeMap;
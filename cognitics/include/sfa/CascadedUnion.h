@@ -0,0 +1,84 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \brief Provides sfa::CascadedUnion
+\sa OpenGIS Implementation Specification for Geographic Information - Simple Feature Access (OGC 06-103r3 Version 1.2.0)
+*/
+#pragma once
+
+#include "Polygon.h"
+#include "MultiPolygon.h"
+
+namespace sfa {
+
+/*!\class CascadedUnion CascadedUnion.h CascadedUnion.h
+\brief CascadedUnion
+
+Constructs the union of a large set of Polygons (building footprints, land cover, etc).
+
+Folding Geometry::Union over the list rebuilds a graph of the whole accumulated result at every step. CascadedUnion
+instead sorts the Polygons into spatially local groups (Sort-Tile-Recursive order on their envelope centers) and merges
+them as a binary tree, so each Union only involves neighbouring pieces of similar size. When two pieces are merged,
+only the Polygons whose envelopes overlap the other piece take part in the overlay; the rest are passed through.
+
+With more than one thread, the leaves of the tree are split into chunks that are unioned on a ccl::JobManager pool,
+and the remaining levels of the tree are merged a level at a time, each pair on its own job.
+
+Usage:
+\code
+    sfa::PolygonList list;
+    sfa::Geometry *merged = sfa::CascadedUnion::apply(list, 8);
+    ...
+    delete merged;
+\endcode
+
+Note that this is a 2D method. The input Polygons are not modified.
+
+\note This is an extension to the specification.
+*/
+    class CascadedUnion
+    {
+    protected:
+        CascadedUnion(void) {}
+        ~CascadedUnion(void) {}
+
+    public:
+
+/*!\brief apply
+
+Constructs the union of a PolygonList.
+\param list The Polygons to merge; null and empty Polygons are ignored.
+\param numThreads The number of worker threads to use; 1 runs on the calling thread.
+\return A new Polygon or MultiPolygon, or NULL if the list has no area. The caller owns the result.
+*/
+        static Geometry* apply(const PolygonList& list, size_t numThreads = 1);
+
+/*!\brief apply
+
+Dissolves the Polygons of a MultiPolygon whose members may overlap.
+\param multiPolygon The MultiPolygon to process.
+\param numThreads The number of worker threads to use; 1 runs on the calling thread.
+\return A new Polygon or MultiPolygon, or NULL if the MultiPolygon has no area. The caller owns the result.
+*/
+        static Geometry* apply(const MultiPolygon* multiPolygon, size_t numThreads = 1);
+    };
+
+}
@@ -0,0 +1,90 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \brief Provides sfa::CoordinateSequence.
+\sa OpenGIS Implementation Specification for Geographic Information - Simple Feature Access (OGC 06-103r3 Version 1.2.0)
+*/
+#pragma once
+
+#include "Point.h"
+#include <vector>
+
+namespace sfa
+{
+/*! \class sfa::CoordinateSequence CoordinateSequence.h CoordinateSequence.h
+\brief CoordinateSequence
+
+A CoordinateSequence stores the vertices of a Curve as a single packed array of doubles (x y [z] [m] per vertex).
+The Z and M flags apply to the whole sequence. Adding a vertex with a dimension the sequence does not have yet widens
+every existing vertex (with 0 for the new ordinate), so a sequence never mixes 2D and 3D vertices.
+
+\note This is an extension to the specification.
+*/
+    class CoordinateSequence
+    {
+    private:
+        std::vector<double> values;
+        bool hasZ;
+        bool hasM;
+
+        size_t stride(void) const { return 2 + (hasZ ? 1 : 0) + (hasM ? 1 : 0); }
+
+    public:
+        ~CoordinateSequence(void);
+        CoordinateSequence(void);
+        CoordinateSequence(bool hasZ, bool hasM);
+
+        bool is3D(void) const { return hasZ; }
+        bool isMeasured(void) const { return hasM; }
+
+        //! Change the dimension of the sequence, widening or narrowing every vertex.
+        void setDimension(bool hasZ, bool hasM);
+
+        size_t size(void) const { return values.size() / stride(); }
+        bool empty(void) const { return values.empty(); }
+        void clear(void) { values.clear(); }
+        void reserve(size_t count) { values.reserve(count * stride()); }
+        void swap(CoordinateSequence &other);
+        //! Replace the sequence with count vertices of packed host-order doubles (x y [z] [m]); the buffer need not be aligned.
+        void assign(const void *packed, size_t count, bool hasZ, bool hasM);
+
+        double X(size_t i) const { return values[i * stride()]; }
+        double Y(size_t i) const { return values[(i * stride()) + 1]; }
+        double Z(size_t i) const { return hasZ ? values[(i * stride()) + 2] : 0.0; }
+        double M(size_t i) const { return hasM ? values[(i * stride()) + (hasZ ? 3 : 2)] : 0.0; }
+
+        //! Raw access to the packed values; vertex i starts at data()[i * getStride()].
+        const double *data(void) const { return values.empty() ? NULL : &values[0]; }
+        size_t getStride(void) const { return stride(); }
+
+        //! Get vertex i as a Point with the dimension of the sequence.
+        Point getPoint(size_t i) const;
+        void setPoint(size_t i, const Point &point);
+
+        void addPoint(double x, double y);
+        void addPoint(double x, double y, double z);
+        void addPoint(const Point &point);
+        void insertPoint(size_t pos, const Point &point);
+        void removePoint(size_t pos);
+        void reverse(void);
+    };
+
+}
@@ -28,6 +28,9 @@ DEALINGS IN THE SOFTWARE.
 
 #include "Geometry.h"
 #include "Point.h"
+#include "CoordinateSequence.h"
+#include <atomic>
+#include <mutex>
 
 namespace sfa
 {
@@ -52,12 +55,34 @@ The boundary of a non-closed Curve consists of its two end Points.
 
 A Curve is defined as topologically closed, that is, it contains its endpoints.
 
+The vertices are stored packed in a CoordinateSequence. Point objects are only created the first time a caller asks for
+a Point pointer (getPointN(), getStartPoint(), addPoint(Point*), ...); from then on the curve keeps its vertices as Points.
+Algorithms that only read vertices should use getCoordinateN() so the curve stays packed.
+
+Const accessors build the Points once per curve (other threads asking at the same time wait for them) and leave the
+packed coordinates in place, so const reads of a curve shared between threads stay safe. The packed copy is released
+by the first edit of the Point list, which needs exclusive access anyway.
+
 \sa OpenGIS Implementation Specification for Geographic Information - Simple Feature Access (OGC 06-103r3 Version 1.2.0) 6.1.6
 */
     class Curve : public Geometry
     {
     protected:
-        PointList points;
+        CoordinateSequence coordinates;
+        mutable PointList points;
+        mutable std::atomic<bool> materialized;
+        mutable std::once_flag materializeOnce;
+
+//!    Build the Point list from the packed coordinates, which are kept for readers that checked isPacked() first.
+        void materialize(void) const;
+//!    Materialize and release the packed coordinates; used before editing the Point list directly.
+        void unpack(void);
+//!    Replace the vertices of this curve with a packed copy of the vertices of another curve.
+        void assignCoordinates(const Curve& other);
+        bool isPacked(void) const { return !materialized.load(std::memory_order_acquire); }
+        size_t numVertices(void) const { return isPacked() ? coordinates.size() : points.size(); }
+//!    Get vertex i by value without creating Point objects.
+        Point vertex(size_t i) const { return isPacked() ? coordinates.getPoint(i) : Point(*points[i]); }
 
     public:
         virtual ~Curve(void);
@@ -68,6 +93,8 @@ A Curve is defined as topologically closed, that is, it contains its endpoints.
 
         // accessors
         virtual void clearPoints(void);
+//!    Replace the vertices with the given sequence; other receives the previous (released) contents.
+        void swapCoordinates(CoordinateSequence& other);
 //!    Takes ownership of the Point.
         virtual void addPoint(Point* point);
 //!    Copies the Point.
@@ -35,6 +35,9 @@ namespace sfa
 
     Geometry* getGeometryFromBinary(const ccl::binary wkb);
 
+//!    Decode WKB (ISO or extended 2.5D) directly from a buffer; curve vertices are copied into packed coordinates in bulk.
+    Geometry* getGeometryFromBinary(const unsigned char *wkb, size_t size);
+
 }
 
 
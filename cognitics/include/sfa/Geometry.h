@@ -124,6 +124,19 @@ namespace sfa
         virtual ~Geometry(void);
         Geometry(void);
 
+#pragma push_macro("new")
+#undef new
+        //! Geometry is allocated from the current ccl::Arena while a ccl::ArenaScope is active (see ccl/Arena.h).
+        static void *operator new(size_t size) { return ccl::Arena::allocateObject(size); }
+        static void operator delete(void *p) { ccl::Arena::deallocateObject(p); }
+        static void *operator new(size_t, void *where) { return where; }
+        static void operator delete(void *, void *) { }
+#ifdef COGNITICS_INSPECTION
+        static void *operator new(size_t size, const char *, int) { return ccl::Arena::allocateObject(size); }
+        static void operator delete(void *p, const char *, int) { ccl::Arena::deallocateObject(p); }
+#endif
+#pragma pop_macro("new")
+
         Geometry* copy(void) const;
         static GeometrySP getShared(Geometry* geometry);
 
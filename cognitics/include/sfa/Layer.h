@@ -101,10 +101,20 @@ Other forms may store the data in a file or SQL database.
         virtual bool rollbackUpdates();
         virtual void resetReading(int cursorId=0);
         virtual sfa::Feature *getNextFeature(int cursorId=0);
+        /*! \brief Read up to count features.
+\param features The features read are appended to this list; the caller owns them.
+\return The number of features appended. Zero means the end of the layer has been reached.
+*/
+        virtual size_t getNextFeatures(std::vector<sfa::Feature *> &features, size_t count, int cursorId=0);
         /*! \brief Add a feature to the layer.
 \param feature A pointer to an sfa::Feature object. The layer copies the feature and returns a pointer to the copy.
 */
         virtual sfa::Feature *addFeature(sfa::Feature *feature);
+        /*! \brief Add a list of features to the layer.
+\param features The features to write. The caller keeps ownership and no copies are returned.
+\return The number of features written.
+*/
+        virtual size_t addFeatures(const std::vector<sfa::Feature *> &features);
         virtual bool updateFeature(sfa::Feature *feature);
         virtual bool deleteFeature(sfa::Feature *feature);
 
@@ -66,6 +66,9 @@ A LinearRing is a LineString that is both closed and simple.
 //! Get the specified Point n in this LineString. Never delete this Point.
         virtual Point* getPointN(int n) const;
 
+//! Get a copy of Point n in this LineString. Unlike getPointN(), this reads the packed coordinates without creating Point objects.
+        Point getCoordinateN(int n) const;
+
 //! Get the length of the LineString using linear interpolation.
         virtual double getLength(void) const;
 
@@ -78,6 +81,8 @@ A LinearRing is a LineString that is both closed and simple.
         virtual void fromText(std::istream &is, bool tag, bool withZ, bool withM);
         virtual void toBinary(std::ostream &os, WKBByteOrder byteOrder, bool withZ, bool withM) const;
         virtual void fromBinary(std::istream &is, WKBByteOrder byteOrder, bool withZ, bool withM);
+//! True if child is one of the Points owned by this LineString. Points only exist once they have been handed out
+//! (getPointN(), getStartPoint(), ...), so a LineString that is still packed is never the parent and isn't materialized.
         virtual bool isParentOf(const GeometryBase *child) const;
         virtual GeometryBase *getParentOf(const GeometryBase *child) const;
         virtual int getNumChildren(void) const;
@@ -0,0 +1,105 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \brief Provides sfa::PreparedGeometry.
+\sa OpenGIS Implementation Specification for Geographic Information - Simple Feature Access (OGC 06-103r3 Version 1.2.0)
+*/
+#pragma once
+
+#include "Geometry.h"
+#include "Label.h"
+#include <vector>
+
+namespace sfa
+{
+/*! \class sfa::PreparedGeometry PreparedGeometry.h PreparedGeometry.h
+\brief PreparedGeometry
+
+A PreparedGeometry wraps a geometry that is tested against many other geometries (a footprint, a valid area, a clip
+polygon). It computes the envelope once and, for Polygons and MultiPolygons, indexes the ring segments by y-interval,
+so a point-in-polygon test only walks the few segments crossing the row of the query point instead of every edge.
+
+contains(), covers() and intersects() answer most cases from the index. Cases the index cannot settle (a test
+geometry touching the boundary, for example) fall back to the full Relate computation, so the results always match the
+unprepared predicates. Non-areal geometries only get the envelope rejection.
+
+Usage:
+\code
+    sfa::PreparedGeometry prepared(&footprint);
+    for(each point)
+        if(prepared.covers(x, y))
+            ...
+    prepared.covers(xs, ys, count, results);    // batch version
+\endcode
+
+Note that this is a 2D method. Z and M values are ignored.
+
+\note This is an extension to the specification.
+*/
+    class PreparedGeometry
+    {
+    private:
+        struct Segment
+        {
+            double x1, y1, x2, y2;
+        };
+
+        GeometrySP geometry;
+        bool areal;
+        double minX, minY, maxX, maxY;
+        std::vector<Segment> segments;
+        std::vector<double> ringStarts;          //!< first vertex (x, y) of each ring
+        std::vector<size_t> binStart;            //!< bin b holds binSegments[binStart[b]] .. binSegments[binStart[b + 1] - 1]
+        std::vector<size_t> binSegments;
+        double binHeight;
+
+        void buildIndex(void);
+        size_t getBin(double y) const;
+        bool intersectsBoundary(const Segment &segment) const;
+        bool ringVertexInside(const Geometry *other) const;
+
+    public:
+        ~PreparedGeometry(void);
+        PreparedGeometry(void);
+//!    Prepare a copy of the geometry.
+        PreparedGeometry(const Geometry *geometry);
+
+        void setGeometry(const Geometry *geometry);
+        const Geometry *getGeometry(void) const { return geometry.get(); }
+        bool isEmpty(void) const { return !geometry; }
+
+//!    Get the location of (x, y) relative to the prepared geometry.
+        Location locate(double x, double y) const;
+        bool contains(double x, double y) const { return locate(x, y) == INTERIOR; }
+        bool covers(double x, double y) const { return locate(x, y) != EXTERIOR; }
+        bool intersects(double x, double y) const { return covers(x, y); }
+
+        bool contains(const Geometry *another) const;
+        bool covers(const Geometry *another) const;
+        bool intersects(const Geometry *another) const;
+
+//!    Locate count points given as separate x and y arrays.
+        void locate(const double *x, const double *y, size_t count, Location *results) const;
+//!    Test count points given as separate x and y arrays; returns the number of covered points.
+        size_t covers(const double *x, const double *y, size_t count, bool *results) const;
+    };
+
+}
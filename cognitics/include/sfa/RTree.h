@@ -0,0 +1,196 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+/*! \brief Provides sfa::RTree.
+\sa OpenGIS Implementation Specification for Geographic Information - Simple Feature Access (OGC 06-103r3 Version 1.2.0)
+*/
+#pragma once
+
+#include <float.h>
+#include "Geometry.h"
+#include "Polygon.h"
+#include <list>
+#include <vector>
+
+namespace sfa
+{
+//! Axis aligned 2D bounding box used by RTree.
+    struct RTreeBounds
+    {
+        double minX, minY, maxX, maxY;
+
+        RTreeBounds(void) : minX(DBL_MAX), minY(DBL_MAX), maxX(-DBL_MAX), maxY(-DBL_MAX) { }
+        RTreeBounds(double minX, double minY, double maxX, double maxY) : minX(minX), minY(minY), maxX(maxX), maxY(maxY) { }
+
+        bool isValid(void) const { return (minX <= maxX) && (minY <= maxY); }
+        bool intersects(const RTreeBounds &other) const { return (minX <= other.maxX) && (maxX >= other.minX) && (minY <= other.maxY) && (maxY >= other.minY); }
+        double centerX(void) const { return minX + ((maxX - minX) / 2); }
+        double centerY(void) const { return minY + ((maxY - minY) / 2); }
+        void expand(const RTreeBounds &other);
+//! Squared distance from (x, y) to the box; 0 if the point is inside.
+        double distance2(double x, double y) const;
+    };
+
+    class RTreeVisitor;
+
+/*! \class sfa::RTree RTree.h RTree.h
+\brief RTree
+
+A 2D spatial index over Geometry pointers, bulk loaded with the Sort-Tile-Recursive (STR) algorithm.
+
+Geometries are added with addGeometry() and the tree is packed once with generate(). The packed nodes are stored in a
+single flat array (children of a node are contiguous), so a query is an O(log n) walk over a few cache friendly arrays.
+The tree does not own the geometries; each envelope is computed once when the geometry is added.
+
+Geometries that have not been packed yet are kept in an unpacked list that queries scan linearly. insert() repacks the
+tree automatically when that list grows past a fraction of the packed size; addGeometry() leaves it to generate().
+
+Usage:
+\code
+    sfa::RTree tree;
+    for(each geometry)
+        tree.addGeometry(geometry);
+    tree.generate();
+
+    sfa::RTreeCollectGeometriesVisitor visitor;
+    visitor.setBounds(minX, minY, maxX, maxY);
+    visitor.visiting(&tree);
+    // visitor.results holds the geometries whose envelopes touch the window
+\endcode
+
+\note This is an extension to the specification. It supersedes sfa::BSP for geometry queries.
+*/
+    class RTree
+    {
+    public:
+        struct Entry
+        {
+            RTreeBounds bounds;
+            Geometry *geometry;
+        };
+
+        struct Node
+        {
+            RTreeBounds bounds;
+            size_t first;        //!< first child index (into the entries if leaf, into the nodes otherwise)
+            size_t count;        //!< number of children
+            bool leaf;
+        };
+
+    private:
+        size_t nodeCapacity;
+        std::vector<Entry> entries;
+        std::vector<Node> nodes;
+        std::vector<Entry> pending;
+        size_t removedCount;
+        bool generated;
+
+        void pack(void);
+
+    public:
+        ~RTree(void);
+        RTree(size_t nodeCapacity = 16);
+
+//!    Add a geometry using its envelope. It is found by queries immediately, but linearly until generate() is called.
+        void addGeometry(Geometry *geometry);
+//!    Add a geometry with precomputed bounds.
+        void addGeometry(Geometry *geometry, double minX, double minY, double maxX, double maxY);
+//!    Bulk load all added geometries into the packed node array.
+        void generate(void);
+//!    Add a geometry and repack the tree if the unpacked list has grown too large.
+        void insert(Geometry *geometry);
+        void insert(Geometry *geometry, double minX, double minY, double maxX, double maxY);
+//!    Remove a geometry from the tree. Returns false if the geometry is not in the tree.
+        bool removeGeometry(Geometry *geometry);
+        void clear(void);
+
+        size_t size(void) const;
+        bool empty(void) const { return size() == 0; }
+        bool isGenerated(void) const { return generated; }
+        RTreeBounds getBounds(void) const;
+
+//!    Append the geometries whose envelopes touch the window to results.
+        void search(double minX, double minY, double maxX, double maxY, std::vector<Geometry *> &results) const;
+//!    Append the geometries that intersect the polygon to results.
+        void search(const Polygon &window, std::vector<Geometry *> &results) const;
+//!    Get the geometry closest to (x, y), or NULL if the tree is empty or nothing is within maxDistance.
+        Geometry *nearest(double x, double y, double maxDistance = DBL_MAX) const;
+//!    Get up to k geometries closest to (x, y), ordered by increasing distance.
+        std::vector<Geometry *> nearestN(double x, double y, size_t k, double maxDistance = DBL_MAX) const;
+
+//!    Walk the tree, descending only into the nodes the visitor accepts.
+        void accept(RTreeVisitor &visitor) const;
+    };
+
+/*! \class sfa::RTreeVisitor RTree.h RTree.h
+\brief RTreeVisitor
+
+Base class for RTree visitors. It has the same calling convention as sfa::BSPVisitor (visitor.visiting(&tree)); derived
+classes select which nodes to descend into with acceptBounds() and receive each candidate with visitGeometry().
+*/
+    class RTreeVisitor
+    {
+    public:
+        virtual ~RTreeVisitor(void);
+        RTreeVisitor(void);
+
+        void visit(RTree *tree);
+        virtual void visiting(RTree *tree);
+
+//!    Return true to descend into a node (or test an entry) with these bounds. The default accepts everything.
+        virtual bool acceptBounds(const RTreeBounds &bounds);
+        virtual void visitGeometry(Geometry *geometry, const RTreeBounds &bounds);
+    };
+
+/*! \class sfa::RTreeCollectGeometriesVisitor RTree.h RTree.h
+\brief Collects the geometries whose envelopes touch an axis aligned search window. Replaces BSPCollectGeometriesVisitor.
+*/
+    class RTreeCollectGeometriesVisitor : public RTreeVisitor
+    {
+    public:
+        std::list<Geometry *> results;
+        double minX, maxX, minY, maxY;
+        void setBounds(double minX, double minY, double maxX, double maxY);
+
+        virtual ~RTreeCollectGeometriesVisitor(void);
+        RTreeCollectGeometriesVisitor(void);
+        virtual bool acceptBounds(const RTreeBounds &bounds);
+        virtual void visitGeometry(Geometry *geometry, const RTreeBounds &bounds);
+    };
+
+/*! \class sfa::RTreeCollectGeometriesInPolygonVisitor RTree.h RTree.h
+\brief Collects the geometries that intersect a search polygon. Replaces BSPCollectGeometriesInPolygonVisitor.
+*/
+    class RTreeCollectGeometriesInPolygonVisitor : public RTreeVisitor
+    {
+    public:
+        std::list<Geometry *> results;
+        RTreeBounds windowBounds;
+        Polygon window;
+        void setBoundingPolygon(const Polygon &proposedWindow);
+
+        virtual ~RTreeCollectGeometriesInPolygonVisitor(void);
+        RTreeCollectGeometriesInPolygonVisitor(void);
+        virtual bool acceptBounds(const RTreeBounds &bounds);
+        virtual void visitGeometry(Geometry *geometry, const RTreeBounds &bounds);
+    };
+
+}
@@ -31,6 +31,7 @@ DEALINGS IN THE SOFTWARE.
 #include <dom/dom.h>
 #include <features/GsBuildings.h>
 #include "features/GMLParser.h"
+#include "gltf/Tileset.h"
 
 
 namespace cognitics
@@ -71,6 +72,8 @@ namespace cognitics
 		void setOutputFormat(std::string format);
         void setTextureSize(int width, int height);
         void setTexelSize(double texelSize);
+        void setMeshQuantization(bool meshQuantization);
+        void setWorkers(int workers);
 		void ComputeCenterPosition(std::vector<TileInfo>& infos, double originlat, double originLon);
         //void generate(int row = -1, int col = -1);
 		void createFeatures(elev::Elevation_DSM& edsm);
@@ -110,6 +113,13 @@ namespace cognitics
 		void WriteLODfile(std::vector<TileInfo>& infos, std::string outputFilename, int nLODs);
 		void SetBuildingElevations(elev::Elevation_DSM& edsm);
 
+		// Reads the RGB bands of imgFile and writes them as a jpg.
+		static bool writeTileTexture(const std::string& imgFile, const std::string& jpgFilename);
+		// Samples elevation over the extents and builds the textured TIN for one tile in the projection's local space.
+		// It does not touch generator state, so tiles can be built concurrently as long as each has its own edsm.
+		static scenegraph::Scene* buildTileScene(const std::string& textureName, const std::string& format, elev::Elevation_DSM& edsm, const cts::FlatEarthProjection& projection, double north, double south, double east, double west, unsigned int seed);
+		static void getElevationRange(elev::Elevation_DSM& edsm, double north, double south, double east, double west, int nSamples, double& minElev, double& maxElev);
+
     protected:
         ccl::ObjLog logger;
         cts::FlatEarthProjection flatEarth;
@@ -131,7 +141,10 @@ namespace cognitics
         int textureHeight;                // 1024
         int textureWidth;                // 1024
         double texelSize;                // 5.0f
+        bool meshQuantization;          // false
+        int workers;                    // hardware concurrency
         scenegraph::Scene master;
+        std::vector<gltf::TileInfo> tilesetTiles;    // glTF tiles written this run, for tileset.json
         dom::DocumentSP cerDocument;
         GsBuildings buildings;
         std::vector<ManMadePoints_FootprintsFeature> footprints;
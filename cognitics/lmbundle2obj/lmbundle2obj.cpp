@@ -1,6 +1,8 @@
 #include <ccl/ObjLog.h>
 #include <ccl/LogStream.h>
 #include <ccl/FileInfo.h>
+#include <ccl/MappedFile.h>
+#include <ccl/ByteReader.h>
 #include "fstream"
 #include "ccl/StringUtils.h"
 #include "sfa/Point.h"
@@ -74,16 +76,13 @@ std::string getTileString(const std::string& fileName)
     return ".";
 }
 
-void convert(FILE* f, const std::string& texturePath, std::string outputPath)
+void convert(ccl::ByteReader& reader, const std::string& texturePath, std::string outputPath)
 {
     //Read texture length
-    unsigned char texture_name_len;
-    fread(&texture_name_len, 1, 1, f);
+    unsigned char texture_name_len = reader.readUInt8();
 
     //Read texture name
-    char* texname = new char[texture_name_len + 1];
-    texname[texture_name_len] = 0;
-    fread(texname, 1, texture_name_len, f);
+    const std::string texname(reader.readCString(texture_name_len));
 
     const std::string subdir = getTileString(texname);
     outputPath = ccl::joinPaths(outputPath, subdir);
@@ -103,18 +102,16 @@ void convert(FILE* f, const std::string& texturePath, std::string outputPath)
     std::cout << "Copying texture: " << texbase << std::endl;
 
     //Read vert count
-    unsigned short num_verts = 0;
+    unsigned short num_verts = reader.readLittleEndian<unsigned short>();
 
     //Read verts
-    fread(&num_verts, 2, 1, f);
-
     std::vector<sfa::Point> verts;
+    verts.reserve(num_verts);
     for (int i = 0; i < num_verts; i++)
     {
-        float x, y, z = 0;
-        fread(&x, 4, 1, f);
-        fread(&y, 4, 1, f);
-        fread(&z, 4, 1, f);
+        float x = reader.readLittleEndian<float>();
+        float y = reader.readLittleEndian<float>();
+        float z = reader.readLittleEndian<float>();
 
         //Flip z and y, since the ENU projection expects Z to be up
         verts.push_back(sfa::Point(x, z, y));
@@ -122,33 +119,32 @@ void convert(FILE* f, const std::string& texturePath, std::string outputPath)
 
     //Read UVs
     std::vector<sfa::Point> uvs;
+    uvs.reserve(num_verts);
     for (int i = 0; i < num_verts; i++)
     {
-        float u, v;
-        fread(&u, 4, 1, f);
-        fread(&v, 4, 1, f);
+        float u = reader.readLittleEndian<float>();
+        float v = reader.readLittleEndian<float>();
         uvs.push_back(sfa::Point(u, v));
     }
 
     //Read faces
     typedef std::vector<unsigned short> face_vec_t;
     std::vector<face_vec_t> faces;
-    short num_faces;
-    fread(&num_faces, 2, 1, f);
+    short num_faces = reader.readLittleEndian<short>();
+    if (num_faces > 0)
+        faces.reserve(num_faces);
 
     for (int i = 0; i < num_faces; i++)
     {
         face_vec_t face;
         for (int b = 0; b < 3; b++)
         {
-            unsigned short idx;
-            fread(&idx, 2, 1, f);
+            unsigned short idx = reader.readLittleEndian<unsigned short>();
             face.push_back(idx + 1); //Verts start at 1, not 0
         }
         faces.push_back(face);
     }
-    int b_read = ftell(f);
-    std::cout << "Read position: " << b_read << "\n";
+    std::cout << "Read position: " << reader.pos() << "\n";
     std::string textureBase = textureFileInfo.getBaseName(true);
     std::string mtlPath = textureBase + ".mtl";
     std::cout << "Creating : " << objPath << std::endl;
@@ -181,20 +177,22 @@ int main(int argc, char** argv)
         std::cout << "Warning: No metadata.xml exists in input path.\n";
     }
 
-    FILE* f = fopen(input_lmab.c_str(), "rb");
-    if (!f)
+    ccl::MappedFile file;
+    if (!file.open(input_lmab))
     {
         std::cout << "Can't open the file.\n";
         return 1;
     }
-    unsigned short num_meshes = 0;
-    fread(&num_meshes, 2, 1, f);
+    file.advise(ccl::MappedFile::ACCESS_SEQUENTIAL);
+    ccl::ByteReader reader(file.data(), file.size());
+    unsigned short num_meshes = reader.readLittleEndian<unsigned short>();
 
-    for (int i = 0; i < num_meshes; i++)
+    for (int i = 0; i < num_meshes && reader.good(); i++)
     {
-        convert(f, texture_path,
+        convert(reader, texture_path,
                 output_path);
     }
-    fclose(f);
+    if (!reader.good())
+        std::cout << "Warning: " << input_lmab << " is truncated.\n";
     return 0;
 }
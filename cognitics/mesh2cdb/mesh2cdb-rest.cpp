@@ -9,7 +9,7 @@
 #include "ccl/StringUtils.h"
 #include "ccl/ArgumentParser.h"
 #include <scenegraph/ExtentsVisitor.h>
-#include "sfa/BSP.h"
+#include "sfa/RTree.h"
 #include "CoordinateSystems/EllipsoidTangentPlane.h"
 #include "cdb_tile/CoordinatesRange.h"
 #include "cdb_tile/Tile.h"
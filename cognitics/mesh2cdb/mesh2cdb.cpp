@@ -1,6 +1,7 @@
 #include <ccl/ObjLog.h>
 #include <ccl/LogStream.h>
 #include <ccl/Timer.h>
+#include <ccl/Trace.h>
 
 #include "ip/pngwrapper.h"
 #include "MeshRender.h"
@@ -8,7 +9,7 @@
 #include "ccl/StringUtils.h"
 #include "ccl/ArgumentParser.h"
 #include <scenegraph/ExtentsVisitor.h>
-#include "sfa/BSP.h"
+#include "sfa/RTree.h"
 #include "CoordinateSystems/EllipsoidTangentPlane.h"
 #include "cdb_tile/CoordinatesRange.h"
 #include "cdb_tile/Tile.h"
@@ -50,6 +51,7 @@ int main(int argc, char **argv)
     //args.AddOption("lod", 1, "<LOD>", "Maximum LOD to create, range is -10 through 20 for CDB");
     args.AddOption("cdb", 1, "<output path>", "Use the specified path, ignoring the contents of the config file.");
     args.AddOption("help",0,"","Display help, including sample xml file");
+    args.AddOption("trace",1,"<filename>","Write a chrome://tracing timeline of the run");
 
     if(args.Parse(argc,argv)==EXIT_FAILURE)
     {
@@ -122,6 +124,9 @@ int main(int argc, char **argv)
     //Obj2CDB obj2_cdb(objRootDir, rootCDBOutput, srs,metadataXML,hiveMapperMode);
     Obj2CDB obj2_cdb(parms);
 
+    if (args.Option("trace"))
+        ccl::Trace::enable();
+
     CPLSetConfigOption("LODMIN", "-10");
     CPLSetConfigOption("LODMAX", argv[3]);
 
@@ -139,6 +144,8 @@ int main(int argc, char **argv)
         if (renderJobs.size() > 0)
            renderInit(argc, argv, renderJobs, parms.outputDirectory);
     }
+    if (args.Option("trace"))
+        ccl::Trace::writeChromeTrace(args.Parameters("trace")[0]);
 
     return 0;
 
@@ -3,7 +3,7 @@
 #include <string>
 #include <vector>
 #include <list>
-#include "sfa/BSP.h"
+#include "sfa/RTree.h"
 #include "ccl/ObjLog.h"
 #include "cdb_tile/Tile.h"
 #include "CoordinateSystems/EllipsoidTangentPlane.h"
@@ -218,14 +218,13 @@ class Obj2CDB
     Mesh2CDBParams parms;
 
     std::vector<ObjFileInfo> objFiles;
-    sfa::BSP bsp;
-    std::map<sfa::Geometry *, sfa::LineString *> envelopes;
+    sfa::RTree rtree;
     std::map<sfa::Geometry *, ObjFileInfo> bestTileLOD;
     Cognitics::CoordinateSystems::EllipsoidTangentPlane *ltp_ellipsoid;
 
     int getLODFromFilename(const std::string &filename);
     void collectHighestLODTiles();
-    void buildBSP();    
+    void buildRTree();    
 public:
     Obj2CDB(const Mesh2CDBParams &_parms);
     ~Obj2CDB();
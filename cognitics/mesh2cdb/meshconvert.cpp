@@ -10,7 +10,7 @@
 #include "mesh2cdb.h"
 #include "MeshRender.h"
 #include "ip/pngwrapper.h"
-#include "sfa/BSP.h"
+#include "sfa/RTree.h"
 #include "rapidxml/rapidxml.hpp"
 #include "quickobj.h"
 
@@ -172,7 +172,7 @@ Obj2CDB::Obj2CDB(const Mesh2CDBParams &_parms) : parms(_parms)
             }
         }
     }
-    buildBSP();
+    buildRTree();
 }
 
 Obj2CDB::~Obj2CDB()
@@ -199,7 +199,7 @@ int Obj2CDB::getLODFromFilename(const std::string &filename)
     return 0;
 }
 
-void Obj2CDB::buildBSP()
+void Obj2CDB::buildRTree()
 {
     int loop = 0;
     //objFiles
@@ -275,11 +275,11 @@ void Obj2CDB::buildBSP()
         aoi_poly->addRing(ring);
         //Keep track of the geometry and its associated file
         bestTileLOD[aoi_poly] = ofi;
-        bsp.addGeometry(aoi_poly);
+        rtree.addGeometry(aoi_poly);
         //delete scene;
     }
 
-    bsp.generate(envelopes);
+    rtree.generate();
     dbLeftLon = 0;
     dbRightLon = 0;
     dbBottomLat = 0;
@@ -357,7 +357,7 @@ renderJobList_t Obj2CDB::collectRenderJobs(cognitics::cdb::Dataset dataset, int
     for (auto&& tile : cdbTiles)
     {
         RenderJob renderJob(tile, srs);
-        sfa::BSPCollectGeometriesVisitor bspVisitor;
+        sfa::RTreeCollectGeometriesVisitor rtreeVisitor;
         std::string absoluteFilePath = ccl::joinPaths(parms.outputDirectory, tile.getFilename());
         if(ccl::fileExists(absoluteFilePath))
         {
@@ -369,7 +369,7 @@ renderJobList_t Obj2CDB::collectRenderJobs(cognitics::cdb::Dataset dataset, int
         renderJob.cdbFilename = absoluteFilePath;
         log << "\t" << absoluteFilePath << log.endl;
         //get all scenes that intersect with this tile.
-        //bsp.
+        //rtree.
         double tileLocalBottom = 0;
         double tileLocalTop = 0;
         double tileLocalLeft = 0;
@@ -398,12 +398,12 @@ renderJobList_t Obj2CDB::collectRenderJobs(cognitics::cdb::Dataset dataset, int
         log << "LL: " << tileLocalLeft << " , " << tileLocalBottom << log.endl;
         log << "UR: " << tileLocalRight << " , " << tileLocalTop << log.endl;
 
-        bspVisitor.setBounds(tileLocalLeft,
+        rtreeVisitor.setBounds(tileLocalLeft,
             tileLocalBottom,
             tileLocalRight,
             tileLocalTop);
-        bspVisitor.visiting(&bsp);
-        for (auto&& geometry : bspVisitor.results)
+        rtreeVisitor.visiting(&rtree);
+        for (auto&& geometry : rtreeVisitor.results)
         {
             std::string sourceOBJ = bestTileLOD[geometry].fi.getFileName();
             log << "\t\tUsing " << sourceOBJ << " as source file." << log.endl;
@@ -5,13 +5,18 @@
 #include <ccl/ObjLog.h>
 #include <ccl/LogStream.h>
 #include <ccl/Timer.h>
+#include <ccl/Trace.h>
+#include <ccl/Status.h>
 #include <cdb_util/cdb_lod.h>
+#include <algorithm>
 #include <chrono>
+#include <functional>
+#include <vector>
 
 #include "scenegraphobj/scenegraphobj.h"
 //#include "ip/pngwrapper.h"
 #include <scenegraph/ExtentsVisitor.h>
-#include <ccl/JobManager.h>
+#include <ccl/Parallel.h>
 #ifdef USE_EGL
 #define GLEW_EGL 1
 #endif //USE_EGL
@@ -105,111 +110,37 @@ void setAOI(double llx, double lly, double urx, double  ury)
 }
 
 void writeJP2(RenderJob &job, unsigned char *pixels, int width, int height);
-
-class JP2WriterThreadDataManager : public ccl::ThreadDataManager
-{
-public:
-
-    virtual void onThreadFinished(void)
-    {
-    }
-
-};
-
 bool writeDEM(RenderJob &job, float *grid, int width, int height);
-class DEMWriteJob : public ccl::Job
-{
-    float *grid;
-    RenderJob renderJob;
-    int width;
-    int height;
-protected:
-    virtual int onChildFinished(ccl::Job *job, int result)
-    {
-        return 0;
-    }
 
-public:
-    virtual ~DEMWriteJob() {}
-    DEMWriteJob(ccl::JobManager *manager,
-        const RenderJob &job,
-        float *grid,
-        int width,
-        int height) :
-        ccl::Job(manager, NULL),
-        renderJob(job),
-        grid(grid),
-        width(width),
-        height(height)
-    {
-
-    }
+// tile writes run on the shared pool while the next tile renders; finishBuild() waits for them
+std::vector<ccl::Task<void> > writeTasks;
 
-    int execute(void)
-    {
-        writeDEM(renderJob, grid, width, height);
-        delete[] grid;
-        grid = NULL;
-        return 0;
-    }
-};
-
-
-
-class JP2WriteJob : public ccl::Job
+void queueWrite(const std::function<void(void)> &write)
 {
-    unsigned char *pixels;
-    RenderJob renderJob;
-    int width;
-    int height;
-protected:
-    virtual int onChildFinished(ccl::Job *job, int result)
-    {
-        return 0;
-    }
-
-public:
-    virtual ~JP2WriteJob() {}
-    JP2WriteJob(ccl::JobManager *manager, 
-        const RenderJob &job, 
-        unsigned char *pixels, 
-        int width, 
-        int height) :
-            ccl::Job(manager, NULL),
-            renderJob(job),
-            pixels(pixels),
-            width(width),
-            height(height)
-    {
-        
-    }
-
-    int execute(void)
-    {
-        writeJP2(renderJob, pixels, width, height);
-        delete[] pixels;
-        pixels = NULL;
-        return 0;
-    }
-};
-
-JP2WriterThreadDataManager jp2ThreadDataManager;
-int num_threads = 4;
-ccl::JobManager jobManager(num_threads, NULL, &jp2ThreadDataManager);
-
-ccl::JobManager DEMJobManager(num_threads, NULL);
-
+    writeTasks.erase(std::remove_if(writeTasks.begin(), writeTasks.end(), [](const ccl::Task<void> &task) { return task.isReady(); }), writeTasks.end());
+    writeTasks.push_back(ccl::submit_task(write));
+}
 
 void queueDEMJob(RenderJob &job, float *grid, int width, int height)
 {
-    DEMWriteJob *demJob = new DEMWriteJob(&DEMJobManager, job, grid, width, height);
-    jobManager.submitJob(demJob);
+    queueWrite([job, grid, width, height]() mutable
+    {
+        COGNITICS_TRACE_SPAN("write dem");
+        writeDEM(job, grid, width, height);
+        COGNITICS_STATUS_COUNT("dem tiles written", 1);
+        delete[] grid;
+    });
 }
 
 void queueJP2Job(RenderJob &job, unsigned char *pixels, int width, int height)
 {
-    JP2WriteJob *jp2Job = new JP2WriteJob(&jobManager,job,pixels,width,height);
-    jobManager.submitJob(jp2Job);
+    queueWrite([job, pixels, width, height]() mutable
+    {
+        COGNITICS_TRACE_SPAN("write jp2");
+        writeJP2(job, pixels, width, height);
+        COGNITICS_STATUS_COUNT("jp2 tiles written", 1);
+        delete[] pixels;
+    });
 }
 
 void writeJP2(RenderJob &job, unsigned char *pixels, int width, int height)
@@ -269,37 +200,24 @@ void writeJP2(RenderJob &job, unsigned char *pixels, int width, int height)
 
 void FlipVertically(unsigned char *pixels, int width, int height, int depth)
 {
-    unsigned char *copy = new unsigned char[width * height * depth];
-    memcpy(copy, pixels, width * height * depth);
-    for (int i = 0; i < height; i++)
+    // swap the rows of the top half with the bottom half in place
+    size_t row_len = size_t(width) * depth;
+    ccl::parallel_for(0, size_t(height / 2), 64, [&](size_t i)
     {
-        int row_len = width * depth;
-        int ii = ((height - 1) - i);
-        // copy the row
-        for (int j = 0; j < row_len; j++)
-        {
-            pixels[(i*row_len) + j] = copy[(ii*row_len) + j];
-        }
-    }
-    delete []copy;
+        unsigned char *row = pixels + (i * row_len);
+        std::swap_ranges(row, row + row_len, pixels + ((height - 1 - i) * row_len));
+    });
 }
 
 
 void FlipVertically(float *grid, int width, int height)
 {
-    float *copy = new float[width * height];
-    memcpy(copy, grid, width * height * sizeof(float));
-    for (int i = 0; i < height; i++)
+    size_t row_len = size_t(width);
+    ccl::parallel_for(0, size_t(height / 2), 64, [&](size_t i)
     {
-        int row_len = width;
-        int ii = ((height - 1) - i);
-        // copy the row
-        for (int j = 0; j < row_len; j++)
-        {
-            grid[(i*row_len) + j] = copy[(ii*row_len) + j];
-        }
-    }
-    delete []copy;
+        float *row = grid + (i * row_len);
+        std::swap_ranges(row, row + row_len, grid + ((height - 1 - i) * row_len));
+    });
 }
 
 bool replace(std::string& str, const std::string& from, const std::string& to)
@@ -375,6 +293,7 @@ struct objinfo_compare
 #define QUICK_OBJ
 void renderToFile(RenderJob &job)
 {
+    COGNITICS_TRACE_SPAN("render tile");
     int width = 1024;
     int height = 1024;
     int depth = 3;
@@ -524,20 +443,24 @@ void renderToFile(RenderJob &job)
     glReadPixels(0, 0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, grid);
     double zFar = 5000;
     double zNear = -5000;
-    for (int i = 0, ic = width * height; i < ic; i++)
+    ccl::parallel_for(0, size_t(height), 16, [&](size_t row)
     {
-        if (grid[i] == 1)
-            grid[i] = -32767.0;
-        else
+        for (size_t i = row * width, ic = i + width; i < ic; i++)
         {
-            grid[i] = -1 * (zNear + (grid[i] * (zFar - zNear)));
+            if (grid[i] == 1)
+                grid[i] = -32767.0;
+            else
+            {
+                grid[i] = -1 * (zNear + (grid[i] * (zFar - zNear)));
+            }
         }
-    }
+    });
     glDeleteTextures(1, &depth_texture);
     glDeleteTextures(1, &renderedTexture);
     FlipVertically(grid, width, height);
     queueDEMJob(job, grid, width, height);
     queueJP2Job(job, pixels, width, height);
+    COGNITICS_STATUS_COUNT("tiles rendered", 1);
     delete scene;
     scene = NULL;
 }
@@ -722,7 +645,9 @@ int CPL_STDCALL GDALProgressObserver(CPL_UNUSED double dfComplete,
 void finishBuild()
 {
     logger << "Waiting for compression of JP2 files to complete..." << logger.endl;
-    jobManager.waitForCompletion();
+    for(auto &task : writeTasks)
+        task.wait();
+    writeTasks.clear();
     logger << "============================" << logger.endl;
     logger << "\nBuilding Imagery LODs" << logger.endl;
 
@@ -9,6 +9,9 @@
 #include <float.h>
 #include <ccl/FileInfo.h>
 #include <ccl/StringUtils.h>
+#include <ccl/MappedFile.h>
+#include <ccl/Status.h>
+#include <ccl/Parallel.h>
 
 #include <fstream>
 #include <GL/glew.h>
@@ -85,26 +88,19 @@ namespace cognitics {
         log.init("QuickObj", this);
         ccl::FileInfo fi(objFilename);
         std::string objFilePath = fi.getDirName();
-        //Get the file size
-        auto fileSize = ccl::getFileSize(objFilename);
-        if (fileSize > (1024 * 1024 * 1024))
+        //Map the file; lines are copied out one at a time, so even multi-GB files are never resident twice
+        ccl::MappedFile file;
+        if (!file.open(objFilename))
         {
-            log << "File size of " << fileSize << " for " << objFilename << " exceeds the max of 1gb" << log.endl;
-            return false;
-        }
-        //Make a buffer for the text
-        char *fileContents = new char[fileSize + 1];
-        //Open the file
-        FILE *f = fopen(objFilename.c_str(), "rb");
-        if (!f)
-        {
-            delete[] fileContents;
             log << "Unable to open " << objFilename << ". error: " << strerror(errno) << log.endl;
             return false;
         }
-        //Read the entire file
-        fread(fileContents, 1, fileSize, f);
-        int pos = 0;
+        file.advise(ccl::MappedFile::ACCESS_SEQUENTIAL);
+        const char *fileContents = reinterpret_cast<const char *>(file.data());
+        size_t fileSize = file.size();
+        size_t pos = 0;
+        //strtok needs a writable, null terminated line
+        std::vector<char> line;
 
         //OBJ indexes start at 1, so we put a placeholder in 0
         QuickVert placeholder3;
@@ -115,19 +111,26 @@ namespace cognitics {
 
         while (pos < fileSize)
         {
-            int lineStart = pos;
+            //Skip cr/lf and blank lines
+            if (fileContents[pos] == 0x0a || fileContents[pos] == 0x0d || fileContents[pos] == 0)
+            {
+                pos++;
+                continue;
+            }
+            size_t lineStart = pos;
 
             //line by line
-            while (fileContents[pos] != 0x0a && fileContents[pos] != 0x0d && fileContents[pos] != 0 && pos < fileSize)
+            while (pos < fileSize && fileContents[pos] != 0x0a && fileContents[pos] != 0x0d && fileContents[pos] != 0)
             {
                 pos++;
             }
-            //Null terminate the line
-            fileContents[pos] = 0;
+            line.assign(fileContents + lineStart, fileContents + pos);
+            line.push_back(0);
 
-            int lineEnd = pos;
-            //Process between lineStart and lineEnd
-            char *tok = strtok(fileContents + lineStart, " ");
+            //Process the line
+            char *tok = strtok(line.data(), " ");
+            if (!tok)
+                continue;
             if (strcmp(tok, "v") == 0)
             {
                 char *x = strtok(NULL, " ");
@@ -257,17 +260,9 @@ namespace cognitics {
                 subMeshes.push_back(submesh);
                 auto lastMesh = subMeshes.back();
             }
-            //Skip and remaining cr/lf
-            while ((pos < fileSize) &&
-                (fileContents[pos] == 0x0a || fileContents[pos] == 0x0d || fileContents[pos] == 0))
-            {
-                pos++;
-            }
-
         }//end of while parsing lines
-        fclose(f);
+        file.close();
         _isValid = true;
-        delete[] fileContents;
         //Transform if needed. If there is no WKT, assume it's already in ENU
         if (srs.srsWKT.size() > 0 && srs.srsWKT != "ENU")
         {
@@ -311,11 +306,22 @@ namespace cognitics {
 
             double local_x = 0, local_y = 0, local_z = 0;
 
-            for (int i = 1, ic = verts.size(); i < ic; i++)
+            // an OGRCoordinateTransformation can't be shared between threads, so each range gets its own
+            const size_t grain = 16384;
+            std::vector<OGRCoordinateTransformation *> rangeTrans(ccl::parallelRangeCount(1, verts.size(), grain));
+            for (auto &trans : rangeTrans)
+                trans = OGRCreateCoordinateTransformation(file_srs, &wgs);
+            ccl::parallel_for_ranges(1, verts.size(), grain, [&](size_t range_begin, size_t range_end)
             {
-                QuickVert &vert = verts[i];
-                fileToENU(ltp_ellipsoid, coordTrans, vert.x, vert.y, vert.z);
-            }
+                OGRCoordinateTransformation *trans = rangeTrans[(range_begin - 1) / grain];
+                for (size_t i = range_begin; i < range_end; i++)
+                {
+                    QuickVert &vert = verts[i];
+                    fileToENU(ltp_ellipsoid, trans, vert.x, vert.y, vert.z);
+                }
+            });
+            for (auto trans : rangeTrans)
+                OGRCoordinateTransformation::DestroyCT(trans);
             fileToENU(ltp_ellipsoid, coordTrans, minX, minY, minZ);
             fileToENU(ltp_ellipsoid, coordTrans, maxX, maxY, maxZ);
         }
@@ -1053,12 +1059,14 @@ namespace cognitics {
         if (!obj)
             return;
         mut.lock();
+        size_t count = objs.size();
         if (objs.size() > max_objs)
         {
             removeOldest();
         }
         objAge[obj->objFilename] = 0;
         objs[obj->objFilename] = obj;
+        COGNITICS_STATUS_LEVEL("obj cache entries", int64_t(objs.size()) - int64_t(count));
         mut.unlock();
     }
 
@@ -1070,8 +1078,10 @@ namespace cognitics {
         if (iter == objs.end())
         {
             mut.unlock();
+            COGNITICS_STATUS_COUNT("obj cache misses", 1);
             return NULL;
         }
+        COGNITICS_STATUS_COUNT("obj cache hits", 1);
         increaseAge();
         resetAge(objFilename);
         obj = iter->second;
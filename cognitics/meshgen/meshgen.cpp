@@ -48,6 +48,8 @@ int usage(const std::string &error = std::string())
 	std::cout << "\t-endLOD <lod>\tspecifies the higher LOD of the desired export (default: 8)" << std::endl;
 	std::cout << "\t-projection <projection>\tspecifies the projection of the extents" << std::endl;
 	std::cout << "\t-combineMeshes \tindicates that the feature meshes should be combined with the terrain mesh" << std::endl;
+	std::cout << "\t-quantize \tindicates that glTF/3D Tiles meshes should use KHR_mesh_quantization" << std::endl;
+	std::cout << "\t-workers <#>\tnumber of worker threads for LOD tile generation (default: number of cores)" << std::endl;
     if (error.size())
         std::cerr << "ERROR: " << error << std::endl;
     return (error.size()) ? -1 : 0;
@@ -93,6 +95,8 @@ int main(int argc, char **argv)
 	int startLOD = 8;
 	int endLOD = 8;
 	bool combineMeshes = false;
+	bool quantize = false;
+	int workers = 0;
 
     if (argc <= 1)
         return usage();
@@ -292,6 +296,19 @@ int main(int argc, char **argv)
 			combineMeshes = true;
 			continue;
 		}
+		if (param == "-quantize")
+		{
+			quantize = true;
+			continue;
+		}
+		if (param == "-workers")
+		{
+			++argi;
+			if (argi >= argc)
+				return usage("missing worker count");
+			workers = atoi(argv[argi]);
+			continue;
+		}
 
         if (param == "-text")
             return usage("Invalid parameters");
@@ -375,6 +392,9 @@ int main(int argc, char **argv)
 		terrainGenerator->setTextureSize(textureWidth, textureHeight);
 		terrainGenerator->setTexelSize(texelSize);
 	}
+	terrainGenerator->setMeshQuantization(quantize);
+	if (workers > 0)
+		terrainGenerator->setWorkers(workers);
 
     //ws::generateFixedGridSofprep(north, south, west, east, geoServerURL, outputTmpPath, outputPath, outputFormat);
     //return 0;
@@ -17,6 +17,7 @@
 //#include <direct.h>
 //#include <filesystem>
 #include <ccl/FileInfo.h>
+#include <ccl/Parallel.h>
 #include <elev/DataSourceManager.h>
 #include <thread>
 #include <atomic>
@@ -292,23 +293,11 @@ namespace ws
         ComputeCenterPosition(infos, centerLat, centerLon);
 
 
-        int nthreads = std::thread::hardware_concurrency();
-        std::vector<std::thread> threads(nthreads);
-        int span = infos.size() / nthreads;
-        int index = 0;
-        for (int t = 0; t < nthreads; t++)
+        // one tile per range: the downloads take very different times, so the pool balances them
+        ccl::parallel_for(0, infos.size(), 1, [&](size_t i)
         {
-            int begin = index;
-            int end = index + span;
-            if (t == nthreads - 1)
-            {
-                end = infos.size() - 1;
-            }
-            threads[t] = std::thread(GetData, geoServerURL, begin, end, &infos);
-            index = end + 1;
-        }
-
-        std::for_each(threads.begin(), threads.end(), [](std::thread& x) {x.join(); });
+            GetData(geoServerURL, int(i), int(i) + 1, &infos);
+        });
 
         cout << "DONE" << endl;
 
@@ -1782,23 +1771,10 @@ namespace ws
 		ComputeCenterPosition(infos, centerLat, centerLon);
 
 
-		int nthreads = std::thread::hardware_concurrency();
-		std::vector<std::thread> threads(nthreads);
-		int span = infos.size() / nthreads;
-		int index = 0;
-		for (int t = 0; t < nthreads; t++)
+		ccl::parallel_for(0, infos.size(), 1, [&](size_t i)
 		{
-			int begin = index;
-			int end = index + span;
-			if (t == nthreads - 1)
-			{
-				end = infos.size() - 1;
-			}
-			threads[t] = std::thread(GetData, geoServerURL, begin, end, &infos);
-			index = end + 1;
-		}
-
-		std::for_each(threads.begin(), threads.end(), [](std::thread& x) {x.join(); });
+			GetData(geoServerURL, int(i), int(i) + 1, &infos);
+		});
 
 		cout << "Finished getting LOD data." << endl;
 
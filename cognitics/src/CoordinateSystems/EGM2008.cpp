@@ -1,7 +1,6 @@
-
 #include "CoordinateSystems/EGM2008.h"
-#include <memory>
-#include <fstream>
+#include <ccl/MappedFile.h>
+#include <cstring>
 
 namespace Cognitics
 {
@@ -11,23 +10,24 @@ namespace Cognitics
 
         EGM2008* EGM2008::CreateFromNGA(const char* filename)
         {
-            std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
-            size_t len = ifs.tellg();
-            std::unique_ptr<char> bytes(new char[len]);
-            char* bytes_ptr = bytes.get();
-            ifs.seekg(0, std::ios::beg);
-            ifs.read(bytes_ptr, len);
+            // mapped rather than read into a buffer, so the grid isn't resident twice while it is copied
+            ccl::MappedFile file;
+            if (!file.open(filename))
+                return nullptr;
+            file.advise(ccl::MappedFile::ACCESS_SEQUENTIAL);
 
             auto egm = new EGM2008();
-            for (int row = 0, row_count = egm->Rows; row < row_count; ++row)
+            // each row is a Fortran record, with a 4-byte marker before and after the values
+            size_t col_count = egm->Columns;
+            size_t row_stride = col_count + 2;
+            if (file.size() < egm->Rows * row_stride * sizeof(float))
             {
-                for (int col = 0, col_count = egm->Columns; col < col_count; ++col)
-                {
-                    int img_index = (row * col_count) + col;
-                    int src_index = 1 + (row * (col_count + 2)) + col;
-                    egm->_Image.Data[img_index] = *(float*)&bytes_ptr[src_index * sizeof(float)];
-                }
+                delete egm;
+                return nullptr;
             }
+            const unsigned char* bytes = file.data();
+            for (size_t row = 0, row_count = egm->Rows; row < row_count; ++row)
+                memcpy(&egm->_Image.Data[row * col_count], bytes + (1 + (row * row_stride)) * sizeof(float), col_count * sizeof(float));
             return egm;
         }
 
@@ -0,0 +1,194 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "ccl/Arena.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local ccl::ArenaScope *current_scope = NULL;
+}
+
+namespace ccl
+{
+    Arena::Arena(size_t initialChunkSize, size_t maxChunkSize) : chunkIndex(0), offset(0), chunkSize(initialChunkSize), maxChunkSize(std::max<size_t>(maxChunkSize, initialChunkSize))
+    {
+    }
+
+    Arena::~Arena(void)
+    {
+        release();
+    }
+
+    void *Arena::allocateSlow(size_t bytes, size_t alignment)
+    {
+        size_t needed = bytes + alignment;
+        if(chunkIndex < chunks.size())
+            chunks[chunkIndex].used = offset;
+        // move on to the next kept chunk that is large enough, or append a new one after the kept ones
+        while(++chunkIndex < chunks.size())
+        {
+            if(chunks[chunkIndex].size >= needed)
+                break;
+            chunks[chunkIndex].used = 0;
+        }
+        if(chunkIndex >= chunks.size())
+        {
+            chunkIndex = chunks.size();
+            Chunk chunk;
+            chunk.size = std::max<size_t>(chunkSize, needed);
+            chunk.used = 0;
+            chunk.data = static_cast<unsigned char *>(malloc(chunk.size));
+            if(!chunk.data)
+                throw std::bad_alloc();
+            chunks.push_back(chunk);
+            chunkSize = std::min<size_t>(chunkSize * 2, maxChunkSize);
+        }
+        const Chunk &chunk = chunks[chunkIndex];
+        size_t start = (size_t(-reinterpret_cast<std::uintptr_t>(chunk.data))) & (alignment - 1);
+        offset = start + bytes;
+        return chunk.data + start;
+    }
+
+    void *Arena::do_allocate(size_t bytes, size_t alignment)
+    {
+        return allocate(bytes, alignment);
+    }
+
+    void Arena::do_deallocate(void *, size_t, size_t)
+    {
+    }
+
+    bool Arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+    {
+        return this == &other;
+    }
+
+    Arena::Mark Arena::mark(void) const
+    {
+        Mark result;
+        result.chunk = chunkIndex;
+        result.offset = offset;
+        return result;
+    }
+
+    void Arena::rewind(const Mark &mark)
+    {
+        chunkIndex = mark.chunk;
+        offset = mark.offset;
+    }
+
+    void Arena::reset(void)
+    {
+        chunkIndex = 0;
+        offset = 0;
+    }
+
+    void Arena::release(void)
+    {
+        for(size_t i = 0, c = chunks.size(); i < c; ++i)
+            free(chunks[i].data);
+        chunks.clear();
+        chunkIndex = 0;
+        offset = 0;
+    }
+
+    bool Arena::owns(const void *p) const
+    {
+        const unsigned char *ptr = static_cast<const unsigned char *>(p);
+        for(size_t i = 0, c = chunks.size(); i < c; ++i)
+        {
+            if((ptr >= chunks[i].data) && (ptr < chunks[i].data + chunks[i].size))
+                return true;
+        }
+        return false;
+    }
+
+    size_t Arena::used(void) const
+    {
+        size_t result = 0;
+        for(size_t i = 0, c = std::min<size_t>(chunkIndex, chunks.size()); i < c; ++i)
+            result += chunks[i].used;
+        return result + offset;
+    }
+
+    size_t Arena::capacity(void) const
+    {
+        size_t result = 0;
+        for(size_t i = 0, c = chunks.size(); i < c; ++i)
+            result += chunks[i].size;
+        return result;
+    }
+
+    Arena *Arena::current(void)
+    {
+        return current_scope ? current_scope->arena : NULL;
+    }
+
+    Arena &Arena::forThread(void)
+    {
+        thread_local Arena arena;
+        return arena;
+    }
+
+    void *Arena::allocateObject(size_t size)
+    {
+        Arena *arena = current();
+        return arena ? arena->allocate(size) : ::operator new(size);
+    }
+
+    void Arena::deallocateObject(void *p)
+    {
+        if(!p)
+            return;
+        for(ArenaScope *scope = current_scope; scope; scope = scope->previous)
+        {
+            if(scope->arena && scope->arena->owns(p))
+                return;
+        }
+        ::operator delete(p);
+    }
+
+    ArenaScope::ArenaScope(Arena *arena) : arena(arena), previous(current_scope)
+    {
+        start.chunk = 0;
+        start.offset = 0;
+        if(arena)
+            start = arena->mark();
+        current_scope = this;
+    }
+
+    ArenaScope::ArenaScope(Arena &arena) : arena(&arena), previous(current_scope), start(arena.mark())
+    {
+        current_scope = this;
+    }
+
+    ArenaScope::~ArenaScope(void)
+    {
+        current_scope = previous;
+        if(arena)
+            arena->rewind(start);
+    }
+
+}
@@ -0,0 +1,287 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "ccl/AsyncLog.h"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    // set on the background thread, so observers that log don't block on a ring only they can drain
+    thread_local bool draining = false;
+}
+
+namespace ccl
+{
+    struct AsyncLog::Entry
+    {
+        std::chrono::system_clock::time_point time;
+        struct LOGLEVEL level;
+        std::string str;
+    };
+
+    // single producer (the thread that owns it), single consumer (the background thread)
+    struct AsyncLog::Ring
+    {
+        std::vector<Entry> entries;
+        size_t mask;
+        std::atomic<size_t> head;       // next entry to write; only advanced by the producer
+        std::atomic<size_t> tail;       // next entry to read; only advanced by the consumer
+
+        Ring(size_t capacity) : entries(capacity), mask(capacity - 1), head(0), tail(0) { }
+
+        // returns the number of queued entries after the push, or zero if the ring is full
+        size_t push(Entry &entry)
+        {
+            size_t h = head.load(std::memory_order_relaxed);
+            if(h - tail.load(std::memory_order_acquire) > mask)
+                return 0;
+            entries[h & mask] = std::move(entry);
+            head.store(h + 1, std::memory_order_release);
+            return h + 1 - tail.load(std::memory_order_relaxed);
+        }
+
+        bool pop(std::vector<Entry> &batch)
+        {
+            size_t t = tail.load(std::memory_order_relaxed);
+            size_t h = head.load(std::memory_order_acquire);
+            if(t == h)
+                return false;
+            for(; t != h; ++t)
+                batch.push_back(std::move(entries[t & mask]));
+            tail.store(t, std::memory_order_release);
+            return true;
+        }
+    };
+
+    std::atomic<size_t> AsyncLog::next_id(0);
+
+    AsyncLog::~AsyncLog(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake_condition.notify_all();
+        if(thread.joinable())
+            thread.join();
+    }
+
+    AsyncLog::AsyncLog(struct LOGLEVEL level, size_t capacity, OverflowPolicy policy, std::chrono::milliseconds flushInterval, bool timestamps)
+        : LogObserver(), id(++next_id), level(level), capacity(2), policy(policy), flushInterval(flushInterval), timestamps(timestamps),
+        dropped(0), droppedReported(0), wakeRequested(false), stopping(false), flushRequested(0), flushCompleted(0)
+    {
+        while(this->capacity < capacity)
+            this->capacity *= 2;
+        thread = std::thread([this]() { run(); });
+    }
+
+    void AsyncLog::attach(LogObserverSP observer)
+    {
+        std::lock_guard<std::mutex> lock(observers_mutex);
+        observers.insert(observer);
+    }
+
+    void AsyncLog::detach(LogObserverSP observer)
+    {
+        std::lock_guard<std::mutex> lock(observers_mutex);
+        observers.erase(observer);
+    }
+
+    struct LOGLEVEL AsyncLog::getLevel(void) const
+    {
+        return level;
+    }
+
+    size_t AsyncLog::getDroppedCount(void) const
+    {
+        return dropped;
+    }
+
+    AsyncLog::Ring *AsyncLog::getRing(void)
+    {
+        // rings are looked up by log id; a ring stays registered with its log after the thread exits until it has been drained
+        thread_local std::vector<std::pair<size_t, std::shared_ptr<Ring> > > thread_rings;
+        for(size_t i = 0, c = thread_rings.size(); i < c; ++i)
+        {
+            if(thread_rings[i].first == id)
+                return thread_rings[i].second.get();
+        }
+        std::shared_ptr<Ring> ring(new Ring(capacity));
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            rings.push_back(ring);
+        }
+        thread_rings.push_back(std::make_pair(id, ring));
+        return ring.get();
+    }
+
+    void AsyncLog::wake(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            wakeRequested = true;
+        }
+        wake_condition.notify_one();
+    }
+
+    void AsyncLog::write(struct LOGLEVEL level, const std::string &str)
+    {
+        if(level.value > this->level.value)
+            return;
+        Entry entry;
+        entry.time = std::chrono::system_clock::now();
+        entry.level = level;
+        entry.str = str;
+        Ring *ring = getRing();
+        while(true)
+        {
+            size_t queued = ring->push(entry);
+            if(queued)
+            {
+                // wake the background thread early once a ring is half full instead of on every message
+                if(queued == (capacity / 2))
+                    wake();
+                return;
+            }
+            if((policy == DROP) || draining)
+            {
+                ++dropped;
+                return;
+            }
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wakeRequested = true;
+            wake_condition.notify_one();
+            drained_condition.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+
+    void AsyncLog::flush(void)
+    {
+        if(draining)
+            return;
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        size_t request = ++flushRequested;
+        wakeRequested = true;
+        wake_condition.notify_one();
+        drained_condition.wait(lock, [this, request]() { return (flushCompleted >= request) || stopping; });
+    }
+
+    bool AsyncLog::drain(std::vector<Entry> &batch)
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        bool result = false;
+        for(size_t i = 0; i < rings.size(); )
+        {
+            result |= rings[i]->pop(batch);
+            // the log holds the last reference once the thread that owned the ring has exited
+            if(rings[i].use_count() == 1)
+            {
+                rings[i]->pop(batch);
+                rings[i] = rings.back();
+                rings.pop_back();
+                continue;
+            }
+            ++i;
+        }
+        return result;
+    }
+
+    void AsyncLog::writeBatch(std::vector<Entry> &batch)
+    {
+        size_t droppedNow = dropped;
+        if(droppedNow != droppedReported)
+        {
+            std::stringstream ss;
+            ss << "AsyncLog: " << (droppedNow - droppedReported) << " log messages dropped";
+            Entry entry;
+            entry.time = std::chrono::system_clock::now();
+            entry.level = LWARNING;
+            entry.str = ss.str();
+            batch.push_back(std::move(entry));
+            droppedReported = droppedNow;
+        }
+        // the rings are drained one after another, so restore the order the messages were logged in
+        std::stable_sort(batch.begin(), batch.end(), [](const Entry &a, const Entry &b) { return a.time < b.time; });
+
+        std::lock_guard<std::mutex> lock(observers_mutex);
+        for(size_t i = 0, c = batch.size(); i < c; ++i)
+        {
+            if(timestamps)
+            {
+                std::time_t seconds = std::chrono::system_clock::to_time_t(batch[i].time);
+                long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(batch[i].time.time_since_epoch()).count() % 1000;
+                std::tm tm;
+#ifdef WIN32
+                localtime_s(&tm, &seconds);
+#else
+                localtime_r(&seconds, &tm);
+#endif
+                std::stringstream ss;
+                ss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "." << std::setw(3) << std::setfill('0') << milliseconds << " " << batch[i].str;
+                batch[i].str = ss.str();
+            }
+            for(std::set<LogObserverSP>::iterator it = observers.begin(), end = observers.end(); it != end; it++)
+                (*it)->write(batch[i].level, batch[i].str);
+        }
+        if(!batch.empty())
+        {
+            for(std::set<LogObserverSP>::iterator it = observers.begin(), end = observers.end(); it != end; it++)
+                (*it)->flush();
+        }
+        batch.clear();
+    }
+
+    void AsyncLog::run(void)
+    {
+        draining = true;
+        std::vector<Entry> batch;
+        bool busy = false;
+        while(true)
+        {
+            size_t request;
+            bool stop;
+            {
+                // while the rings keep delivering messages, drain again right away
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                if(!busy)
+                    wake_condition.wait_for(lock, flushInterval, [this]() { return wakeRequested || stopping; });
+                wakeRequested = false;
+                request = flushRequested;
+                stop = stopping;
+            }
+            busy = drain(batch);
+            if(busy || (dropped != droppedReported))
+                writeBatch(batch);
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex);
+                flushCompleted = request;
+            }
+            drained_condition.notify_all();
+            if(stop && !busy)
+                break;
+        }
+    }
+
+}
@@ -27,74 +27,174 @@ DEALINGS IN THE SOFTWARE.
 #include <sstream>
 #include "ccl/AttributeContainer.h"
 #include <algorithm>
+#include <cctype>
 
-namespace ccl
+namespace
 {
-    void AttributeContainer::setAttribute(const std::string &key, ccl::Variant var, bool ignoreCase)
-    {    
-        if(!ignoreCase)
+    // FNV-1a over the lower case key
+    size_t hashIgnoreCase(const std::string &key)
+    {
+        size_t hash = size_t(14695981039346656037ULL);
+        for(size_t i = 0, c = key.size(); i < c; ++i)
         {
-            if(attributes.find(key)==attributes.end())
-                return;
-            attributes[key] = var;
-            return;
-        }        
-        std::string lowerkey = key;        
-        std::transform(lowerkey.begin(), lowerkey.end(), lowerkey.begin(), ::tolower); 
-        std::map<std::string,std::string>::const_iterator iter = lowCaseAttributeMap.find(lowerkey);
-        if(iter!=lowCaseAttributeMap.end())
-        {            
-            attributes[iter->second] = var;
-            return;
+            hash ^= size_t(std::tolower((unsigned char)key[i]));
+            hash *= size_t(1099511628211ULL);
         }
-        //If we didn't find one, make the new one
-        attributes[key] = var;
-        lowCaseAttributeMap[lowerkey] = key;
+        return hash;
     }
 
-    bool AttributeContainer::getAttribute(const std::string &key, ccl::Variant &var, bool ignoreCase) const
+    bool equalIgnoreCase(const std::string &a, const std::string &b)
     {
-        if(!ignoreCase)
+        if(a.size() != b.size())
+            return false;
+        for(size_t i = 0, c = a.size(); i < c; ++i)
         {
-            if(attributes.find(key)==attributes.end())
+            if(std::tolower((unsigned char)a[i]) != std::tolower((unsigned char)b[i]))
                 return false;
-            var = attributes.find(key)->second;
-            return true;
         }
-        
-        std::string lowerkey = key;        
-        std::transform(lowerkey.begin(), lowerkey.end(), lowerkey.begin(), ::tolower); 
-        std::map<std::string,std::string>::const_iterator iter = lowCaseAttributeMap.find(lowerkey);
-        if(iter!=lowCaseAttributeMap.end())
+        return true;
+    }
+}
+
+namespace ccl
+{
+    AttributeContainer::AttributeContainer() : keyIndexCount(0), keyIndexDirty(false)
+    {
+    }
+
+    // the index refers to the other container's nodes, so a copy builds its own
+    AttributeContainer::AttributeContainer(const AttributeContainer &other) : attributes(other.attributes), keyIndexCount(0), keyIndexDirty(false)
+    {
+        if(!attributes.empty())
+            rebuildKeyIndex();
+    }
+
+    AttributeContainer::AttributeContainer(AttributeContainer &&other) : attributes(std::move(other.attributes)), keyIndex(std::move(other.keyIndex)), keyIndexCount(other.keyIndexCount), keyIndexDirty(other.keyIndexDirty)
+    {
+        other.clear();
+    }
+
+    AttributeContainer &AttributeContainer::operator=(const AttributeContainer &other)
+    {
+        if(this == &other)
+            return *this;
+        attributes = other.attributes;
+        keyIndex.clear();
+        keyIndexCount = 0;
+        keyIndexDirty = false;
+        if(!attributes.empty())
+            rebuildKeyIndex();
+        return *this;
+    }
+
+    AttributeContainer &AttributeContainer::operator=(AttributeContainer &&other)
+    {
+        if(this == &other)
+            return *this;
+        // moving a map keeps its nodes, so the index stays valid
+        attributes = std::move(other.attributes);
+        keyIndex = std::move(other.keyIndex);
+        keyIndexCount = other.keyIndexCount;
+        keyIndexDirty = other.keyIndexDirty;
+        other.clear();
+        return *this;
+    }
+
+    VariantMap::value_type *AttributeContainer::findEntry(const std::string &key, bool ignoreCase) const
+    {
+        VariantMap &map = const_cast<VariantMap &>(attributes);
+        VariantMap::iterator it = map.find(key);
+        if(it != map.end())
+            return &*it;
+        if(!ignoreCase)
+            return NULL;
+        if(keyIndexDirty)
         {
-            var = attributes.find(iter->second)->second;
-            return true;
+            for(it = map.begin(); it != map.end(); ++it)
+            {
+                if(equalIgnoreCase(it->first, key))
+                    return &*it;
+            }
+            return NULL;
         }
-        
-        return false;
+        if(keyIndex.empty())
+            return NULL;
+        size_t mask = keyIndex.size() - 1;
+        for(size_t i = hashIgnoreCase(key) & mask; keyIndex[i]; i = (i + 1) & mask)
+        {
+            if(equalIgnoreCase(keyIndex[i]->first, key))
+                return keyIndex[i];
+        }
+        return NULL;
     }
-    bool AttributeContainer::hasAttribute(const std::string &key, bool ignoreCase) const
+
+    // the first key stays indexed if several only differ in case
+    void AttributeContainer::addToKeyIndex(VariantMap::value_type *entry)
     {
-        if(!ignoreCase)
+        if((keyIndexCount + 1) * 2 > keyIndex.size())
         {
-            if(attributes.find(key)==attributes.end())
-                return false;
-            else
-                return true;
+            rebuildKeyIndex();
+            return;
         }
-        std::string lowerkey = key;        
-        std::transform(lowerkey.begin(), lowerkey.end(), lowerkey.begin(), ::tolower); 
-        std::map<std::string,std::string>::const_iterator iter = lowCaseAttributeMap.find(lowerkey);
-        if(iter!=lowCaseAttributeMap.end())
+        size_t mask = keyIndex.size() - 1;
+        size_t i = hashIgnoreCase(entry->first) & mask;
+        for(; keyIndex[i]; i = (i + 1) & mask)
         {
-            return true;
+            if(equalIgnoreCase(keyIndex[i]->first, entry->first))
+                return;
         }
-        return false;
+        keyIndex[i] = entry;
+        ++keyIndexCount;
+    }
+
+    void AttributeContainer::rebuildKeyIndex()
+    {
+        size_t size = 8;
+        while(size < attributes.size() * 2)
+            size *= 2;
+        keyIndex.assign(size, NULL);
+        keyIndexCount = 0;
+        keyIndexDirty = false;
+        for(VariantMap::iterator it = attributes.begin(), end = attributes.end(); it != end; ++it)
+            addToKeyIndex(&*it);
+    }
+
+    void AttributeContainer::setAttribute(const std::string &key, ccl::Variant var, bool ignoreCase)
+    {    
+        VariantMap::value_type *entry = findEntry(key, ignoreCase);
+        if(entry)
+        {
+            entry->second = std::move(var);
+            return;
+        }
+        if(!ignoreCase)
+            return;
+        //If we didn't find one, make the new one
+        entry = &*attributes.insert(std::make_pair(key, std::move(var))).first;
+        if(keyIndexDirty)
+            rebuildKeyIndex();
+        else
+            addToKeyIndex(entry);
+    }
+
+    bool AttributeContainer::getAttribute(const std::string &key, ccl::Variant &var, bool ignoreCase) const
+    {
+        VariantMap::value_type *entry = findEntry(key, ignoreCase);
+        if(!entry)
+            return false;
+        var = entry->second;
+        return true;
+    }
+
+    bool AttributeContainer::hasAttribute(const std::string &key, bool ignoreCase) const
+    {
+        return findEntry(key, ignoreCase) != NULL;
     }
 
     std::vector<std::string> AttributeContainer::getKeys() const
     {
         std::vector<std::string> ret;
+        ret.reserve(attributes.size());
         VariantMap::const_iterator iter = attributes.begin();
         while(iter!=attributes.end())
         {
@@ -225,44 +325,25 @@ namespace ccl
 
     void AttributeContainer::removeAttribute(const std::string &key,bool ignoreCase)
     {
-        if(!ignoreCase)
-        {
-            if(attributes.find(key)==attributes.end())
-                return;
-            attributes.erase(attributes.find(key));
+        VariantMap::value_type *entry = findEntry(key, ignoreCase);
+        if(!entry)
             return;
-        }
-        std::string lowerkey = key;        
-        std::transform(lowerkey.begin(), lowerkey.end(), lowerkey.begin(), ::tolower); 
-        std::map<std::string,std::string>::const_iterator iter = lowCaseAttributeMap.find(lowerkey);
-        if(iter!=lowCaseAttributeMap.end())
-        {            
-            attributes.erase(attributes.find(iter->second));
-            lowCaseAttributeMap.erase(lowCaseAttributeMap.find(iter->first));
-            return;
-        }
-
+        attributes.erase(attributes.find(entry->first));
+        rebuildKeyIndex();
     }
 
     void AttributeContainer::updateLowerCaseMap()
     {        
-        if(lowCaseAttributeMap.size()!=attributes.size())
-        {
-            ccl::VariantMap::const_iterator iter = attributes.begin();
-            while(iter!=attributes.end())
-            {
-                std::string lowerkey = iter->first;        
-                std::transform(lowerkey.begin(), lowerkey.end(), lowerkey.begin(), ::tolower); 
-                if(lowCaseAttributeMap.find(lowerkey)==lowCaseAttributeMap.end())
-                {
-                    lowCaseAttributeMap[lowerkey] = iter->first;
-                }
-                iter++;
-            }
-        }
+        rebuildKeyIndex();
     }
 
     VariantMap *AttributeContainer::getVariantMap(void)
+    {
+        keyIndexDirty = true;
+        return &attributes;
+    }
+
+    const VariantMap *AttributeContainer::getVariantMap(void) const
     {
         return &attributes;
     }
@@ -335,40 +416,34 @@ namespace ccl
                 ccl::binary::iterator bin_iter = bin.begin();
                 ccl::Variant var = ccl::Variant::decode(bin_iter);
                 attributes[key] = var;
-                std::string lowerkey = key;        
-                std::transform(lowerkey.begin(), lowerkey.end(), lowerkey.begin(), ::tolower); 
-                lowCaseAttributeMap[lowerkey] = key;
             }
+            rebuildKeyIndex();
         }
 
     }
 
     ccl::binary AttributeContainer::toBinary()
-    {        
-        std::ostringstream ss;
-        ccl::BindStream bs;
-        bs.setStream(ss);
-        bindData(bs);
-        ccl::binary ret(bin(ss.str()));
-        int lenret = int(ret.size());
+    {
+        ccl::binary ret;
+        ccl::ByteWriter writer(ret);
+        bindData(ccl::BindStream(writer));
         return ret;
     }
 
     AttributeContainer AttributeContainer::fromBinary(ccl::binary const &input)
     {
         AttributeContainer ret;
-        //std::string s(input);
-        ccl::binaryistringstream ss(input);
-        ccl::BindStream bs;
-        bs.setStream((std::istream &)ss);        
-        ret.bindData(bs);
+        ccl::ByteReader reader(input);
+        ret.bindData(ccl::BindStream(reader));
         return ret;
     }
 
     void AttributeContainer::clear()
     {
         attributes.clear();
-        lowCaseAttributeMap.clear();
+        keyIndex.clear();
+        keyIndexCount = 0;
+        keyIndexDirty = false;
     }
 
     std::string AttributeContainer::toString(void)
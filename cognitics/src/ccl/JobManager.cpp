@@ -6,93 +6,129 @@ Copyright (c) 2016 Cognitics, Inc.
 
 #include "ccl/JobManager.h"
 #include "ccl/Timer.h"
+#include "ccl/Trace.h"
 #include <ccl/inspection.h>
 
 //#define VERBOSE_DEBUG
 
 #ifdef VERBOSE_DEBUG
-#include <Windows.h>
-#include <psapi.h>
-#pragma comment(lib,"psapi.lib")
-static size_t ccl_JobManager_mem_initial = 0;
-static size_t ccl_JobManager_mem_peak = 0;
-size_t ccl_JobManager_mem(void)
-{
-    PROCESS_MEMORY_COUNTERS memCounter;
-    BOOL result = GetProcessMemoryInfo(GetCurrentProcess(), &memCounter, sizeof( memCounter ));
-    if(ccl_JobManager_mem_initial == 0)
-        ccl_JobManager_mem_initial = memCounter.WorkingSetSize;
-    ccl_JobManager_mem_peak = std::max<size_t>(ccl_JobManager_mem_peak, memCounter.WorkingSetSize);
-    return memCounter.WorkingSetSize;
-}
-#define VERBOSE_JOB_LOG log << ccl::LDEBUG << "[" << __FUNCSIG__ << "] OWNER:" << owner << "  ARBITRARY:" << getArbitraryCounter() << "  MEMORY:" << ccl_JobManager_mem() << "  PEAK:" << ccl_JobManager_mem_peak << log.endl;
-#define VERBOSE_JOBWORKER_LOG log << ccl::LDEBUG << "[" << __FUNCSIG__ << "] MEMORY:" << ccl_JobManager_mem() << "  PEAK:" << ccl_JobManager_mem_peak << log.endl;
-#define VERBOSE_JOBMANAGER_LOG log << ccl::LDEBUG << "[" << __FUNCSIG__ << "] MEMORY:" << ccl_JobManager_mem() << "  PEAK:" << ccl_JobManager_mem_peak << log.endl;
+#include "ccl/ResourceUsage.h"
+#define VERBOSE_JOB_LOG { ccl::ResourceUsage usage = ccl::ResourceUsage::current(); log << ccl::LDEBUG << "[" << __FUNCTION__ << "] OWNER:" << owner << "  ARBITRARY:" << getArbitraryCounter() << "  MEMORY:" << usage.residentBytes << "  PEAK:" << usage.peakResidentBytes << log.endl; }
+#define VERBOSE_JOBWORKER_LOG { ccl::ResourceUsage usage = ccl::ResourceUsage::current(); log << ccl::LDEBUG << "[" << __FUNCTION__ << "] MEMORY:" << usage.residentBytes << "  PEAK:" << usage.peakResidentBytes << log.endl; }
+#define VERBOSE_JOBMANAGER_LOG { ccl::ResourceUsage usage = ccl::ResourceUsage::current(); log << ccl::LDEBUG << "[" << __FUNCTION__ << "] MEMORY:" << usage.residentBytes << "  PEAK:" << usage.peakResidentBytes << log.endl; }
 #else
 #define VERBOSE_JOB_LOG void(0);
 #define VERBOSE_JOBWORKER_LOG void(0);
 #define VERBOSE_JOBMANAGER_LOG void(0);
 #endif
 
+namespace
+{
+    // the worker running on the current thread, if any; sub-jobs are queued on it
+    thread_local ccl::JobWorker *current_worker = NULL;
+
+    class FunctionJob : public ccl::Job
+    {
+    private:
+        std::function<void(void)> function;
+
+    public:
+        FunctionJob(ccl::JobManager *manager, const std::function<void(void)> &function) : ccl::Job(manager), function(function) { }
+
+        virtual int execute(void)
+        {
+            function();
+            return 0;
+        }
+    };
+}
+
 namespace ccl
 {
     JobWorker::~JobWorker(void)
     {
+        stop();
+        if(thread.joinable())
+            thread.join();
         VERBOSE_JOBWORKER_LOG
     }
 
-    JobWorker::JobWorker(JobManager *manager) : manager(manager)
+    JobWorker::JobWorker(JobManager *manager, size_t index) : manager(manager), index(index), stopping(false), done(false)
     {
         log.init("JobWorker", this);
         VERBOSE_JOBWORKER_LOG
     }
 
+    bool JobWorker::start(void)
+    {
+        thread = std::thread([this]() { run(); });
+        return true;
+    }
+
     bool JobWorker::stop(void)
     {
-        if(state != FINISHED)
-            state = PENDING_STOP;
+        stopping = true;
+        {
+            std::lock_guard<std::mutex> lock(manager->wake_mutex);
+        }
+        manager->wake_condition.notify_all();
         return true;
     }
 
     int JobWorker::run(void)
     {
-        if(state != PENDING_STOP)
-            state = RUNNING;
+        current_worker = this;
+        if(Trace::enabled())
+            Trace::setThreadName("JobWorker " + std::to_string(index));
         if(manager->threadDataManager)
         {
             if(!manager->threadDataManager->onThreadStarted())
-                state = PENDING_STOP;
+                stopping = true;
         }
-        while(state == RUNNING)
+        while(!stopping)
         {
-            Job *job = manager->getNextJob();
+            Job *job = manager->getNextJob(this);
             if(job)
-            {
-                job->incrementTaskCount();
-                job->execute();
-                if(job->decrementTaskCount() <= 0)
-                    finishJob(job);
-            }
+                manager->executeJob(job);
             else
             {
-                ccl::sleep(50);
+                manager->waitForJob(this);
             }
         }
         if(manager->threadDataManager)
             manager->threadDataManager->onThreadFinished();
-        state = FINISHED;
+        current_worker = NULL;
+        done = true;
         return 1;
     }
 
-    void JobWorker::finishJob(Job *job)
+    void JobWorker::pushJob(Job *job, bool front)
     {
-        if(job->owner)
-        {
-            job->owner->onChildFinished(job, 0);
-            if(job->owner->decrementTaskCount() <= 0)
-                finishJob(job->owner);
-        }
-        manager->finishJob(this, job);
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        if(front)
+            jobs.push_front(job);
+        else
+            jobs.push_back(job);
+    }
+
+    Job *JobWorker::popJob(void)
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        if(jobs.empty())
+            return NULL;
+        Job *job = jobs.front();
+        jobs.pop_front();
+        return job;
+    }
+
+    Job *JobWorker::stealJob(void)
+    {
+        std::lock_guard<std::mutex> lock(jobs_mutex);
+        if(jobs.empty())
+            return NULL;
+        Job *job = jobs.back();
+        jobs.pop_back();
+        return job;
     }
 
     Job::~Job(void)
@@ -103,7 +139,7 @@ namespace ccl
     int Job::arbitrary_counter = 0;
     ccl::mutex Job::arbitrary_counter_mutex;
 
-    Job::Job(JobManager *manager, Job *owner) : manager(manager), owner(owner), task_count(0)
+    Job::Job(JobManager *manager, Job *owner) : task_count(0), delete_on_finish(false), manager(manager), owner(owner)
     {
         log.init("Job", this);
         VERBOSE_JOB_LOG
@@ -116,26 +152,17 @@ namespace ccl
 
     int Job::incrementTaskCount(void)
     {
-        task_count_mutex.lock();
-        int result = ++task_count;
-        task_count_mutex.unlock();
-        return result;
+        return ++task_count;
     }
 
     int Job::decrementTaskCount(void)
     {
-        task_count_mutex.lock();
-        int result = --task_count;
-        task_count_mutex.unlock();
-        return result;
+        return --task_count;
     }
 
     int Job::getTaskCount(void)
     {
-        task_count_mutex.lock();
-        int result = task_count;
-        task_count_mutex.unlock();
-        return result;
+        return task_count;
     }
 
     int Job::incrementArbitraryCounter(void)
@@ -182,62 +209,158 @@ namespace ccl
     JobManager::~JobManager(void)
     {
         waitForCompletion();
-        for(std::list<JobWorker *>::iterator it = workers.begin(), end = workers.end(); it != end; ++it)
+        finish();
+        for(std::vector<JobWorker *>::iterator it = workers.begin(), end = workers.end(); it != end; ++it)
             delete *it;
         VERBOSE_JOBMANAGER_LOG
     }
 
-    JobManager::JobManager(size_t num_threads, ProgressObserver *progressObserver, ThreadDataManager *threadDataManager) : progressObserver(progressObserver), threadDataManager(threadDataManager)
+    JobManager::JobManager(size_t num_threads, ProgressObserver *progressObserver, ThreadDataManager *threadDataManager)
+        : progressObserver(progressObserver), pending_count(0), open_count(0), idle_workers(0), waking(false), threadDataManager(threadDataManager),
+          pending_status("jobs pending", [this]() { return int64_t(pending_count.load()); }),
+          open_status("jobs open", [this]() { return int64_t(open_count.load()); })
     {
         log.init("JobManager", this);
         VERBOSE_JOBMANAGER_LOG
+        // all workers exist before any of them starts stealing
         for(size_t i = 0; i < num_threads; ++i)
-        {
-            JobWorker *worker = new JobWorker(this);
-            worker->start();
-            workers.push_back(worker);
-        }
+            workers.push_back(new JobWorker(this, i));
+        for(size_t i = 0; i < num_threads; ++i)
+            workers[i]->start();
         for(size_t i = 0; i < num_threads * 4; ++i)
             workers_semaphore.signal();
     }
 
-    Job *JobManager::getNextJob(void)
+    Job *JobManager::getNextJob(JobWorker *worker)
     {
-        Job *job = NULL;
-        open_mutex.lock();
-        if(!pending_jobs.empty())
+        if(pending_count == 0)
+            return NULL;
+        Job *job = worker ? worker->popJob() : NULL;
+        if(!job)
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            if(!pending_jobs.empty())
+            {
+                job = pending_jobs.front();
+                pending_jobs.pop_front();
+            }
+        }
+        size_t first = worker ? worker->index + 1 : 0;
+        for(size_t i = 0, c = workers.size(); !job && (i < c); ++i)
+        {
+            JobWorker *victim = workers[(first + i) % c];
+            if(victim != worker)
+                job = victim->stealJob();
+        }
+        if(job)
         {
-            job = pending_jobs.front();
-            pending_jobs.pop_front();
+            // pass the wake-up on while there is more work, so idle workers ramp up one at a time
+            if(--pending_count > 0)
+                wakeWorker();
         }
-        open_mutex.unlock();
         return job;
     }
 
-    void JobManager::finishJob(JobWorker *worker, Job *job)
+    void JobManager::waitForJob(JobWorker *worker)
+    {
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        ++idle_workers;
+        // clear the flag before every check: a wake-up whose job was taken by a running worker must not block the next one
+        while(true)
+        {
+            waking = false;
+            if((pending_count > 0) || worker->stopping)
+                break;
+            wake_condition.wait(lock);
+        }
+        --idle_workers;
+    }
+
+    void JobManager::wakeWorker(void)
     {
+        // a worker going idle counts itself before checking pending_count, so either it sees the job or it is woken here
+        if((idle_workers == 0) || waking.exchange(true))
+            return;
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+        }
+        wake_condition.notify_one();
+    }
+
+    void JobManager::executeJob(Job *job)
+    {
+        job->incrementTaskCount();
+        job->execute();
+        if(job->decrementTaskCount() <= 0)
+            finishJob(job);
+    }
+
+    void JobManager::finishJob(Job *job)
+    {
+        if(job->owner)
+        {
+            job->owner->onChildFinished(job, 0);
+            if(job->owner->decrementTaskCount() <= 0)
+                finishJob(job->owner);
+        }
         if(progressObserver)
             progressObserver->update();
-        open_mutex.lock();
-        open_jobs.erase(job);
-        open_mutex.unlock();
-        finished_mutex.lock();
-        finished_jobs.push_back(job);
-        finished_mutex.unlock();
+        if(job->delete_on_finish)
+        {
+            delete job;
+        }
+        else
+        {
+            finished_mutex.lock();
+            finished_jobs.push_back(job);
+            finished_mutex.unlock();
+        }
         workers_semaphore.signal();
+        if(--open_count == 0)
+        {
+            std::lock_guard<std::mutex> lock(completion_mutex);
+            completion_condition.notify_all();
+        }
     }
 
     void JobManager::submitJob(Job *job, bool front)
     {
-        open_mutex.lock();
         if (job->owner)
             job->owner->incrementTaskCount();
-        open_jobs.insert(job);
-        if(front)
-            pending_jobs.push_front(job);
+        ++open_count;
+        // count the job before publishing it: a worker may take it (and decrement the count) as soon as it is visible
+        ++pending_count;
+        JobWorker *worker = current_worker;
+        if(worker && (worker->manager == this))
+        {
+            worker->pushJob(job, front);
+        }
         else
-            pending_jobs.push_back(job);
-        open_mutex.unlock();
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            if(front)
+                pending_jobs.push_front(job);
+            else
+                pending_jobs.push_back(job);
+        }
+        wakeWorker();
+    }
+
+    void JobManager::submitFunction(const std::function<void(void)> &function, bool front)
+    {
+        FunctionJob *job = new FunctionJob(this, function);
+        job->delete_on_finish = true;
+        submitJob(job, front);
+    }
+
+    bool JobManager::executeNextJob(void)
+    {
+        JobWorker *worker = current_worker;
+        Job *job = getNextJob((worker && (worker->manager == this)) ? worker : NULL);
+        if(!job)
+            return false;
+        executeJob(job);
+        return true;
     }
 
     void JobManager::waitForSemaphore(int32_t msec)
@@ -247,19 +370,16 @@ namespace ccl
 
     void JobManager::finish(void)
     {
-        for(std::list<JobWorker *>::iterator it = workers.begin(), end = workers.end(); it != end; ++it)
+        for(std::vector<JobWorker *>::iterator it = workers.begin(), end = workers.end(); it != end; ++it)
             (*it)->stop();
     }
 
     bool JobManager::finished(void)
     {
-        for(std::list<JobWorker *>::iterator it = workers.begin(), end = workers.end(); it != end; ++it)
+        for(std::vector<JobWorker *>::iterator it = workers.begin(), end = workers.end(); it != end; ++it)
         {
-            if((*it)->getState() != ccl::Runnable::FINISHED)
-            {
+            if(!(*it)->isFinished())
                 return false;
-                break;
-            }
         }
         return true;
     }
@@ -276,38 +396,27 @@ namespace ccl
                 delete delete_list.back();
             delete_list.pop_back();
         }
-        for(std::list<Job *>::iterator it = delete_list.begin(), end = delete_list.end(); it != end; ++it)
-            if((*it)->owner)
-                delete *it;
     }
 
     float JobManager::waitForCompletion(float seconds)
     {
         ccl::Timer timer;
         timer.startTimer();
-        bool jobs_are_open = true;
-        while(jobs_are_open)
-        {
-            cleanup();
-            ccl::sleep(50);
-            open_mutex.lock();
-            jobs_are_open = !open_jobs.empty();
-            open_mutex.unlock();
-            float elapsed = timer.getElapsedTime();
-            if(elapsed > seconds)
-                return elapsed;
-        }
-        finish();
-        while(!finished())
+        while(true)
         {
-            ccl::sleep(50);
+            // finished jobs are cleaned up periodically while waiting, so long runs don't accumulate them
             cleanup();
+            std::unique_lock<std::mutex> lock(completion_mutex);
+            if(open_count == 0)
+                break;
             float elapsed = timer.getElapsedTime();
             if(elapsed > seconds)
                 return elapsed;
+            float timeout = std::min<float>(seconds - elapsed, 0.1f);
+            completion_condition.wait_for(lock, std::chrono::duration<float>(timeout), [this]() { return open_count == 0; });
         }
         cleanup();
         return -FLT_MAX;
     }
 
-}
\ No newline at end of file
+}
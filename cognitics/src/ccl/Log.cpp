@@ -25,4 +25,5 @@ DEALINGS IN THE SOFTWARE.
 namespace ccl
 {
     LogSP Log::_instance = LogSP();
+    std::atomic<int> Log::max_level(-1);
 }
\ No newline at end of file
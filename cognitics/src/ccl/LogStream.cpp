@@ -28,7 +28,7 @@ namespace ccl
     {
     }
 
-    LogStream::LogStream(struct LOGLEVEL level, std::ostream &stream) : LogObserver(), level(level), stream(&stream)
+    LogStream::LogStream(struct LOGLEVEL level, std::ostream &stream, bool autoflush) : LogObserver(), level(level), stream(&stream), autoflush(autoflush)
     {
     }
 
@@ -36,12 +36,23 @@ namespace ccl
     {
         if (this->level.value >= level.value)
         {
-            *stream << str + "\n";
-            stream->flush();
+            *stream << str << '\n';
+            if(autoflush)
+                stream->flush();
         }
 
     }
 
+    struct LOGLEVEL LogStream::getLevel(void) const
+    {
+        return level;
+    }
+
+    void LogStream::flush(void)
+    {
+        stream->flush();
+    }
+
 
 }
 
@@ -42,6 +42,13 @@ namespace ccl
     ObjLog &ObjLog::operator<<(const nl &)
     {
         _mutex.lock();
+        if(!Log::isEnabled(this->level))
+        {
+            test = "";
+            str.str("");
+            _mutex.unlock();
+            return *this;
+        }
         std::string prestr = prefix;
         if(test.size())
             prestr += "\t" + test + "\t";
@@ -0,0 +1,120 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "ccl/Parallel.h"
+#include <condition_variable>
+
+namespace
+{
+    // ranges of one parallel_for_ranges() call; helpers hold a reference, so the state outlives a helper job
+    // that only starts after the call has returned (it then finds no range left to claim)
+    struct RangeLoop
+    {
+        const std::function<void(size_t, size_t)> *function;
+        size_t begin;
+        size_t end;
+        size_t grain;
+        size_t count;
+        std::atomic<size_t> next;
+        std::atomic<size_t> completed;
+        std::atomic<bool> failed;
+        std::exception_ptr exception;
+        std::mutex mutex;
+        std::condition_variable condition;
+
+        RangeLoop(const std::function<void(size_t, size_t)> *function, size_t begin, size_t end, size_t grain, size_t count)
+            : function(function), begin(begin), end(end), grain(grain), count(count), next(0), completed(0), failed(false)
+        {
+        }
+
+        // claims ranges until none are left
+        void run(void)
+        {
+            for(size_t range = next++; range < count; range = next++)
+            {
+                if(!failed)
+                {
+                    size_t range_begin = begin + range * grain;
+                    try
+                    {
+                        (*function)(range_begin, std::min(range_begin + grain, end));
+                    }
+                    catch(...)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if(!exception)
+                            exception = std::current_exception();
+                        failed = true;
+                    }
+                }
+                if(++completed == count)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    condition.notify_all();
+                }
+            }
+        }
+    };
+}
+
+namespace ccl
+{
+    JobManager &sharedJobManager(void)
+    {
+        static JobManager manager(std::max<size_t>(std::thread::hardware_concurrency(), 1));
+        return manager;
+    }
+
+    size_t parallelRangeCount(size_t begin, size_t end, size_t grain)
+    {
+        grain = std::max<size_t>(grain, 1);
+        return (end > begin) ? (end - begin + grain - 1) / grain : 0;
+    }
+
+    void parallel_for_ranges(JobManager &manager, size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &function)
+    {
+        grain = std::max<size_t>(grain, 1);
+        size_t count = parallelRangeCount(begin, end, grain);
+        if(count == 0)
+            return;
+        if((count == 1) || (manager.getNumWorkers() == 0))
+        {
+            function(begin, end);
+            return;
+        }
+
+        auto loop = std::make_shared<RangeLoop>(&function, begin, end, grain, count);
+        size_t helpers = std::min(manager.getNumWorkers(), count - 1);
+        for(size_t i = 0; i < helpers; ++i)
+            manager.submitFunction([loop]() { loop->run(); });
+        loop->run();
+
+        // the remaining ranges are running on workers that have already claimed them
+        {
+            std::unique_lock<std::mutex> lock(loop->mutex);
+            loop->condition.wait(lock, [&loop]() { return loop->completed == loop->count; });
+        }
+        if(loop->exception)
+            std::rethrow_exception(loop->exception);
+    }
+
+}
@@ -26,24 +26,34 @@ namespace ccl
 {
     ScopedTimer::~ScopedTimer(void)
     {
+        if(traceName)
+            Trace::span(traceName, traceBegin, Trace::now());
         if(objLog)
             *objLog << ccl::LDEBUG << title << " (" << timer.getElapsedTime() << "s)" << (*objLog).endl;
     }
 
-    ScopedTimer::ScopedTimer(const std::string &title) : title(title)
+    ScopedTimer::ScopedTimer(const std::string &title) : title(title), objLog(NULL)
     {
         timer.startTimer();
         progressTimer.startTimer();
+        startTrace();
     }
 
-    ScopedTimer::ScopedTimer(ObjLog *objLog, const std::string &title) : objLog(objLog), title(title)
+    ScopedTimer::ScopedTimer(ObjLog *objLog, const std::string &title) : title(title), objLog(objLog)
     {
         timer.startTimer();
         progressTimer.startTimer();
+        startTrace();
         if(objLog)
             *objLog << ccl::LDEBUG << title << (*objLog).endl;
     }
 
+    void ScopedTimer::startTrace(void)
+    {
+        traceName = (Trace::enabled() && !title.empty()) ? Trace::intern(title) : NULL;
+        traceBegin = traceName ? Trace::now() : 0;
+    }
+
     float ScopedTimer::next(const std::string &message)
     {
         float elapsed = progressTimer.getElapsedTime();
@@ -0,0 +1,349 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "ccl/Status.h"
+#include "ccl/ObjLog.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace
+{
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<ccl::StatusCounter *> counters;
+        std::chrono::steady_clock::time_point start;
+
+        Registry(void) : start(std::chrono::steady_clock::now()) { }
+    };
+
+    // constructed by the first counter, so it outlives every static counter
+    Registry &registry(void)
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    const char *HITS_SUFFIX = " hits";
+    const char *MISSES_SUFFIX = " misses";
+
+    bool endsWith(const std::string &str, const std::string &suffix)
+    {
+        return (str.size() >= suffix.size()) && (str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0);
+    }
+
+    // caches with both a hits and a misses total
+    std::vector<std::string> cacheNames(const ccl::Status::Sample &sample)
+    {
+        std::vector<std::string> result;
+        for(auto &value : sample.values)
+        {
+            if(!endsWith(value.name, HITS_SUFFIX))
+                continue;
+            std::string cache = value.name.substr(0, value.name.size() - strlen(HITS_SUFFIX));
+            for(auto &other : sample.values)
+            {
+                if(other.name == cache + MISSES_SUFFIX)
+                    result.push_back(cache);
+            }
+        }
+        return result;
+    }
+
+    std::string humanBytes(double value)
+    {
+        const char *units[] = { "B", "KB", "MB", "GB", "TB" };
+        int unit = 0;
+        while((value >= 1024.0) && (unit < 4))
+        {
+            value /= 1024.0;
+            ++unit;
+        }
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision((unit > 0) ? 1 : 0) << value << units[unit];
+        return ss.str();
+    }
+
+    void writeJSONString(std::ostream &stream, const std::string &str)
+    {
+        stream << '"';
+        for(char c : str)
+        {
+            switch(c)
+            {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                default:
+                    if((unsigned char)c < 0x20)
+                        stream << ' ';
+                    else
+                        stream << c;
+            }
+        }
+        stream << '"';
+    }
+}
+
+namespace ccl
+{
+    StatusCounter::StatusCounter(const char *name, Kind kind) : name(name), kind(kind), value(0)
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.counters.push_back(this);
+    }
+
+    StatusCounter::StatusCounter(const char *name, const std::function<int64_t(void)> &source) : name(name), kind(LEVEL), value(0), source(source)
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.counters.push_back(this);
+    }
+
+    StatusCounter::~StatusCounter(void)
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for(auto it = reg.counters.begin(), end = reg.counters.end(); it != end; ++it)
+        {
+            if(*it == this)
+            {
+                reg.counters.erase(it);
+                break;
+            }
+        }
+    }
+
+    Status::Sample Status::sample(const Sample *previous)
+    {
+        Sample result;
+        result.time = std::chrono::system_clock::now();
+        result.memory = ResourceUsage::current();
+
+        std::map<std::string, Value> values;
+        {
+            Registry &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            result.uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - reg.start).count();
+            for(auto counter : reg.counters)
+            {
+                Value &value = values[counter->getName()];
+                if(value.name.empty())
+                {
+                    value.name = counter->getName();
+                    value.kind = counter->getKind();
+                    value.value = 0;
+                    value.rate = 0;
+                }
+                value.value += counter->sample();
+            }
+        }
+
+        size_t p = 0;
+        double elapsed = previous ? (result.uptime - previous->uptime) : result.uptime;
+        for(auto &entry : values)
+        {
+            Value &value = entry.second;
+            if(value.kind == StatusCounter::TOTAL)
+            {
+                int64_t base = 0;
+                if(previous)
+                {
+                    // both lists are ordered by name
+                    while((p < previous->values.size()) && (previous->values[p].name < value.name))
+                        ++p;
+                    if((p < previous->values.size()) && (previous->values[p].name == value.name))
+                        base = previous->values[p].value;
+                }
+                value.rate = (elapsed > 0) ? (value.value - base) / elapsed : 0;
+            }
+            result.values.push_back(value);
+        }
+        return result;
+    }
+
+    double Status::hitRate(const Sample &sample, const std::string &cache)
+    {
+        int64_t hits = 0;
+        int64_t misses = 0;
+        for(auto &value : sample.values)
+        {
+            if(value.name == cache + HITS_SUFFIX)
+                hits = value.value;
+            else if(value.name == cache + MISSES_SUFFIX)
+                misses = value.value;
+        }
+        return (hits + misses > 0) ? double(hits) / (hits + misses) : -1.0;
+    }
+
+    std::string Status::summary(const Sample &sample)
+    {
+        std::ostringstream ss;
+        ss << "rss " << humanBytes(double(sample.memory.residentBytes)) << " (peak " << humanBytes(double(sample.memory.peakResidentBytes)) << ")";
+        ss << std::fixed << std::setprecision(1);
+        for(auto &value : sample.values)
+        {
+            bool bytes = (value.name.find("bytes") != std::string::npos);
+            ss << ", " << value.name << " " << (bytes ? humanBytes(double(value.value)) : std::to_string(value.value));
+            if(value.kind == StatusCounter::TOTAL)
+                ss << " (" << (bytes ? humanBytes(value.rate) : std::to_string(int64_t(value.rate + 0.5))) << "/s)";
+        }
+        for(auto &cache : cacheNames(sample))
+        {
+            double rate = hitRate(sample, cache);
+            if(rate >= 0)
+                ss << ", " << cache << " hit rate " << (rate * 100.0) << "%";
+        }
+        return ss.str();
+    }
+
+    void Status::writeJSON(std::ostream &stream, const Sample &sample)
+    {
+        std::time_t now = std::chrono::system_clock::to_time_t(sample.time);
+        char date[64];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        stream << std::defaultfloat << std::setprecision(10);
+        stream << "{\n  \"time\": \"" << date << "\",\n";
+        stream << "  \"uptime\": " << sample.uptime << ",\n";
+        stream << "  \"memory\": {\n";
+        stream << "    \"resident_bytes\": " << sample.memory.residentBytes << ",\n";
+        stream << "    \"peak_resident_bytes\": " << sample.memory.peakResidentBytes << "\n  },\n";
+
+        stream << "  \"totals\": {";
+        bool first = true;
+        for(auto &value : sample.values)
+        {
+            if(value.kind != StatusCounter::TOTAL)
+                continue;
+            stream << (first ? "\n    " : ",\n    ");
+            writeJSONString(stream, value.name);
+            stream << ": { \"value\": " << value.value << ", \"per_second\": " << value.rate << " }";
+            first = false;
+        }
+        stream << (first ? "},\n" : "\n  },\n");
+
+        stream << "  \"levels\": {";
+        first = true;
+        for(auto &value : sample.values)
+        {
+            if(value.kind != StatusCounter::LEVEL)
+                continue;
+            stream << (first ? "\n    " : ",\n    ");
+            writeJSONString(stream, value.name);
+            stream << ": " << value.value;
+            first = false;
+        }
+        stream << (first ? "},\n" : "\n  },\n");
+
+        stream << "  \"hit_rates\": {";
+        first = true;
+        for(auto &cache : cacheNames(sample))
+        {
+            double rate = hitRate(sample, cache);
+            if(rate < 0)
+                continue;
+            stream << (first ? "\n    " : ",\n    ");
+            writeJSONString(stream, cache);
+            stream << ": " << rate;
+            first = false;
+        }
+        stream << (first ? "}\n" : "\n  }\n");
+        stream << "}\n";
+    }
+
+    bool Status::writeJSON(const std::string &filename, const Sample &sample)
+    {
+        std::string tmp = filename + ".tmp";
+        {
+            std::ofstream file(tmp.c_str(), std::ios::out | std::ios::trunc);
+            if(!file)
+                return false;
+            writeJSON(file, sample);
+            if(!file.flush())
+                return false;
+        }
+#ifdef WIN32
+        // rename() doesn't replace an existing file on Windows
+        std::remove(filename.c_str());
+#endif
+        return std::rename(tmp.c_str(), filename.c_str()) == 0;
+    }
+
+    StatusReporter::StatusReporter(double interval, const std::string &filename, bool logging)
+        : interval(interval), filename(filename), logging(logging), stopping(false)
+    {
+        latest = Status::sample();
+        thread = std::thread(&StatusReporter::run, this);
+    }
+
+    StatusReporter::~StatusReporter(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        thread.join();
+    }
+
+    Status::Sample StatusReporter::getLatest(void)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return latest;
+    }
+
+    void StatusReporter::run(void)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            bool stop = condition.wait_for(lock, std::chrono::duration<double>(interval), [this]() { return stopping; });
+            Status::Sample sample = Status::sample(&latest);
+            latest = sample;
+            lock.unlock();
+            publish(sample);
+            if(stop)
+                break;
+            lock.lock();
+        }
+    }
+
+    void StatusReporter::publish(const Status::Sample &sample)
+    {
+        if(logging)
+        {
+            ObjLog log("Status");
+            log << LINFO << Status::summary(sample) << log.endl;
+        }
+        if(!filename.empty() && !Status::writeJSON(filename, sample))
+        {
+            ObjLog log("Status");
+            log << LWARNING << "unable to write " << filename << log.endl;
+        }
+    }
+
+}
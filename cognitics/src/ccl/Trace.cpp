@@ -0,0 +1,279 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "ccl/Trace.h"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    const size_t CHUNK_SIZE = 4096;
+
+    struct TraceEvent
+    {
+        const char *name;
+        uint64_t time;
+        int64_t value;          // duration of a span, value of a counter
+        char type;              // 'X' span, 'C' counter
+    };
+
+    // filled by the owning thread only; count is published after each event so exports can run while tracing
+    struct TraceChunk
+    {
+        TraceEvent events[CHUNK_SIZE];
+        std::atomic<size_t> count;
+        std::atomic<TraceChunk *> next;
+
+        TraceChunk(void) : count(0), next(NULL) { }
+    };
+
+    struct TraceBuffer
+    {
+        size_t tid;
+        std::string name;       // guarded by the registry mutex
+        TraceChunk *first;
+        TraceChunk *last;
+        size_t events;
+
+        TraceBuffer(size_t tid) : tid(tid), first(new TraceChunk), last(first), events(0) { }
+
+        ~TraceBuffer(void)
+        {
+            for(TraceChunk *chunk = first; chunk; )
+            {
+                TraceChunk *next = chunk->next;
+                delete chunk;
+                chunk = next;
+            }
+        }
+    };
+
+    // buffers outlive their threads, so a trace can be written after the workers have exited
+    struct TraceRegistry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<TraceBuffer> > buffers;
+        std::unordered_set<std::string> names;
+        std::unordered_map<const char *, ccl::TraceCounter *> counters;     // by interned name, never freed
+        std::atomic<size_t> capacity;
+        std::atomic<size_t> dropped;
+        std::chrono::steady_clock::time_point epoch;
+
+        TraceRegistry(void) : capacity(size_t(1) << 20), dropped(0), epoch(std::chrono::steady_clock::now()) { }
+    };
+
+    TraceRegistry &registry(void)
+    {
+        static TraceRegistry instance;
+        return instance;
+    }
+
+    TraceBuffer *threadBuffer(void)
+    {
+        thread_local TraceBuffer *buffer = NULL;
+        if(!buffer)
+        {
+            TraceRegistry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.buffers.emplace_back(new TraceBuffer(r.buffers.size() + 1));
+            buffer = r.buffers.back().get();
+        }
+        return buffer;
+    }
+
+    void record(const char *name, uint64_t time, int64_t value, char type)
+    {
+        TraceBuffer *buffer = threadBuffer();
+        TraceRegistry &r = registry();
+        if(buffer->events >= r.capacity.load(std::memory_order_relaxed))
+        {
+            ++r.dropped;
+            return;
+        }
+        TraceChunk *chunk = buffer->last;
+        size_t index = chunk->count.load(std::memory_order_relaxed);
+        if(index == CHUNK_SIZE)
+        {
+            TraceChunk *next = new TraceChunk;
+            chunk->next.store(next, std::memory_order_release);
+            buffer->last = chunk = next;
+            index = 0;
+        }
+        TraceEvent &event = chunk->events[index];
+        event.name = name;
+        event.time = time;
+        event.value = value;
+        event.type = type;
+        chunk->count.store(index + 1, std::memory_order_release);
+        ++buffer->events;
+    }
+
+    void writeJSONString(std::ostream &stream, const char *str)
+    {
+        stream << '"';
+        for(const char *c = str; *c; ++c)
+        {
+            switch(*c)
+            {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                case '\n': stream << "\\n"; break;
+                case '\t': stream << "\\t"; break;
+                default:
+                    if((unsigned char)(*c) < 0x20)
+                        stream << ' ';
+                    else
+                        stream << *c;
+            }
+        }
+        stream << '"';
+    }
+
+    // microseconds with nanosecond precision, as the format expects
+    void writeMicroseconds(std::ostream &stream, uint64_t nanoseconds)
+    {
+        stream << (nanoseconds / 1000) << '.';
+        uint64_t fraction = nanoseconds % 1000;
+        stream << char('0' + fraction / 100) << char('0' + (fraction / 10) % 10) << char('0' + fraction % 10);
+    }
+}
+
+namespace ccl
+{
+    std::atomic<bool> Trace::_enabled(false);
+
+    void Trace::enable(void)
+    {
+        registry();     // start the clock
+        _enabled = true;
+    }
+
+    void Trace::disable(void)
+    {
+        _enabled = false;
+    }
+
+    void Trace::setCapacity(size_t eventsPerThread)
+    {
+        registry().capacity = eventsPerThread;
+    }
+
+    size_t Trace::getDroppedCount(void)
+    {
+        return registry().dropped;
+    }
+
+    const char *Trace::intern(const std::string &name)
+    {
+        TraceRegistry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        return r.names.insert(name).first->c_str();
+    }
+
+    TraceCounter &TraceCounter::named(const char *name)
+    {
+        TraceRegistry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        const char *key = r.names.insert(name).first->c_str();
+        TraceCounter *&counter = r.counters[key];
+        if(!counter)
+            counter = new TraceCounter(key);
+        return *counter;
+    }
+
+    void Trace::setThreadName(const std::string &name)
+    {
+        TraceBuffer *buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        buffer->name = name;
+    }
+
+    uint64_t Trace::now(void)
+    {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - registry().epoch).count());
+    }
+
+    void Trace::span(const char *name, uint64_t begin, uint64_t end)
+    {
+        record(name, begin, int64_t(end - begin), 'X');
+    }
+
+    void Trace::counter(const char *name, int64_t value)
+    {
+        record(name, now(), value, 'C');
+    }
+
+    void Trace::writeChromeTrace(std::ostream &stream)
+    {
+        TraceRegistry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        for(size_t i = 0, c = r.buffers.size(); i < c; ++i)
+        {
+            const TraceBuffer &buffer = *r.buffers[i];
+            if(!buffer.name.empty())
+            {
+                stream << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.tid << ",\"args\":{\"name\":";
+                writeJSONString(stream, buffer.name.c_str());
+                stream << "}}";
+                first = false;
+            }
+            for(const TraceChunk *chunk = buffer.first; chunk; chunk = chunk->next.load(std::memory_order_acquire))
+            {
+                for(size_t e = 0, ec = chunk->count.load(std::memory_order_acquire); e < ec; ++e)
+                {
+                    const TraceEvent &event = chunk->events[e];
+                    stream << (first ? "" : ",\n") << "{\"name\":";
+                    writeJSONString(stream, event.name);
+                    stream << ",\"ph\":\"" << event.type << "\",\"pid\":1,\"tid\":" << buffer.tid << ",\"ts\":";
+                    writeMicroseconds(stream, event.time);
+                    if(event.type == 'X')
+                    {
+                        stream << ",\"dur\":";
+                        writeMicroseconds(stream, uint64_t(event.value));
+                    }
+                    else
+                        stream << ",\"args\":{\"value\":" << event.value << "}";
+                    stream << "}";
+                    first = false;
+                }
+            }
+        }
+        stream << "\n]}\n";
+    }
+
+    bool Trace::writeChromeTrace(const std::string &filename)
+    {
+        std::ofstream stream(filename.c_str(), std::ios::out | std::ios::binary);
+        if(!stream)
+            return false;
+        writeChromeTrace(stream);
+        return bool(stream);
+    }
+
+}
@@ -0,0 +1,142 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+// 64-bit file offsets on 32-bit builds, so fstat reports the size of large files
+#ifndef _FILE_OFFSET_BITS
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "ccl/MappedFile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdint>
+
+namespace
+{
+    // maps an open file descriptor; the descriptor can be closed afterwards
+    unsigned char *mapFile(int fd, size_t size, bool writable)
+    {
+        if(size == 0)
+            return NULL;
+        void *ptr = mmap(NULL, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+        return (ptr == MAP_FAILED) ? NULL : static_cast<unsigned char *>(ptr);
+    }
+}
+
+namespace ccl
+{
+    MappedFile::MappedFile(void) : _data(NULL), _size(0), _file(NULL), _mapping(NULL), _open(false), _writable(false)
+    {
+    }
+
+    MappedFile::MappedFile(const std::string &filename, Mode mode) : _data(NULL), _size(0), _file(NULL), _mapping(NULL), _open(false), _writable(false)
+    {
+        open(filename, mode);
+    }
+
+    MappedFile::~MappedFile(void)
+    {
+        close();
+    }
+
+    bool MappedFile::open(const std::string &filename, Mode mode)
+    {
+        close();
+        bool writable = (mode == READ_WRITE);
+        int fd = ::open(filename.c_str(), writable ? O_RDWR : O_RDONLY);
+        if(fd < 0)
+            return false;
+        struct stat st;
+        if((fstat(fd, &st) != 0) || (uint64_t(st.st_size) > uint64_t(SIZE_MAX)))
+        {
+            ::close(fd);
+            return false;
+        }
+        size_t size = size_t(st.st_size);
+        _data = mapFile(fd, size, writable);
+        // the mapping keeps its own reference to the file
+        ::close(fd);
+        if((size > 0) && !_data)
+            return false;
+        _size = size;
+        _writable = writable;
+        _open = true;
+        return true;
+    }
+
+    bool MappedFile::create(const std::string &filename, size_t size)
+    {
+        close();
+        int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0)
+            return false;
+        if(ftruncate(fd, off_t(size)) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        _data = mapFile(fd, size, true);
+        ::close(fd);
+        if((size > 0) && !_data)
+            return false;
+        _size = size;
+        _writable = true;
+        _open = true;
+        return true;
+    }
+
+    void MappedFile::close(void)
+    {
+        if(_data)
+            munmap(_data, _size);
+        _data = NULL;
+        _size = 0;
+        _open = false;
+        _writable = false;
+    }
+
+    bool MappedFile::flush(void)
+    {
+        if(!_writable || !_data)
+            return _open;
+        return msync(_data, _size, MS_SYNC) == 0;
+    }
+
+    void MappedFile::advise(Access access)
+    {
+        if(!_data)
+            return;
+        int advice = MADV_NORMAL;
+        switch(access)
+        {
+            case ACCESS_SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+            case ACCESS_RANDOM: advice = MADV_RANDOM; break;
+            case ACCESS_WILLNEED: advice = MADV_WILLNEED; break;
+            default: break;
+        }
+        madvise(_data, _size, advice);
+    }
+
+}
@@ -0,0 +1,73 @@
+/****************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "ccl/ResourceUsage.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+namespace ccl
+{
+    ResourceUsage ResourceUsage::current(void)
+    {
+        ResourceUsage result = ResourceUsage();
+
+#ifdef __APPLE__
+        mach_task_basic_info_data_t info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+            result.residentBytes = size_t(info.resident_size);
+#else
+        // second field is the resident set in pages
+        FILE *statm = fopen("/proc/self/statm", "r");
+        if(statm)
+        {
+            unsigned long size = 0;
+            unsigned long resident = 0;
+            if(fscanf(statm, "%lu %lu", &size, &resident) == 2)
+                result.residentBytes = size_t(resident) * size_t(sysconf(_SC_PAGESIZE));
+            fclose(statm);
+        }
+#endif
+
+        struct rusage usage;
+        if(getrusage(RUSAGE_SELF, &usage) == 0)
+        {
+#ifdef __APPLE__
+            result.peakResidentBytes = size_t(usage.ru_maxrss);
+#else
+            result.peakResidentBytes = size_t(usage.ru_maxrss) * 1024;
+#endif
+        }
+
+        // the peak is sampled by the kernel, so it can trail a current value read just now
+        if(result.peakResidentBytes < result.residentBytes)
+            result.peakResidentBytes = result.residentBytes;
+        return result;
+    }
+
+}
@@ -77,737 +77,324 @@ namespace ccl
         return ss.str();
     }
 
-    class VariantType
+    namespace
     {
-    public:
-        virtual ~VariantType(void) { }
-        virtual uint8_t type(void) const = 0;
-        virtual std::string typeString(void) const = 0;
-        virtual const std::type_info &typeinfo(void) const = 0;
-        virtual VariantType *clone(void) const = 0;
-        virtual void *ptr(void) = 0;
-        virtual boost::uuids::uuid as_uuid(void) const = 0;
-        virtual std::string as_string(void) const = 0;
-        virtual std::wstring as_wstring(void) const = 0;
-        virtual int32_t as_int(void) const = 0;
-        virtual int64_t as_bigint(void) const = 0;
-        virtual double as_double(void) const = 0;
-        virtual binary as_binary(uint8_t byteOrder) const = 0;
-    };
-
-    class VariantUUID : public VariantType
-    {
-    private:
-        boost::uuids::uuid value;
-
-    public:
-        virtual ~VariantUUID(void) { }
-        VariantUUID(const boost::uuids::uuid &value) : value(value) { }
-
-        virtual uint8_t type(void) const
-        {
-            return Variant::TYPE_UUID;
-        }
-
-        virtual std::string typeString(void) const
-        {
-            return "uuid";
-        }
-
-        virtual const std::type_info &typeinfo(void) const
-        {
-            return typeid(boost::uuids::uuid);
-        }
-
-        virtual VariantType *clone(void) const
-        {
-            return new VariantUUID(value);
-        }
-
-        virtual void *ptr(void)
-        {
-            return &value;
-        }
-
-        virtual boost::uuids::uuid as_uuid(void) const
-        {
-            return value;
-        }
-
-        virtual std::string as_string(void) const
-        {
-            return boost::uuids::to_string(value);
-        }
-
-        virtual std::wstring as_wstring(void) const
-        {
-            return boost::uuids::to_wstring(value);
-        }
-
-        virtual int32_t as_int(void) const
-        {
-            throw VariantException("uuid", "int");
-        }
-
-        virtual int64_t as_bigint(void) const
-        {
-            throw VariantException("uuid", "bigint");
-        }
-
-        virtual double as_double(void) const
-        {
-            throw VariantException("uuid", "double");
-        }
-        virtual binary as_binary(uint8_t byteOrder) const
-        {
-            binary result;
-            result.resize(sizeof(boost::uuids::uuid));
-            memcpy(&(result[0]), &value, sizeof(boost::uuids::uuid));
-            return result;
-        }
-    };
-
-    class VariantString : public VariantType
-    {
-    private:
-        std::string value;
-
-    public:
-        virtual ~VariantString(void) { }
-        VariantString(const std::string &value) : value(value) { }
-
-        virtual uint8_t type(void) const
-        {
-            return Variant::TYPE_STRING;
-        }
-
-        virtual std::string typeString(void) const
-        {
-            return "string";
-        }
-
-        virtual const std::type_info &typeinfo(void) const
-        {
-            return typeid(std::string);
-        }
-
-        virtual VariantType *clone(void) const
-        {
-            return new VariantString(value);
-        }
-
-        virtual void *ptr(void)
-        {
-            return (void *)value.c_str();
-        } 
-
-        virtual boost::uuids::uuid as_uuid(void) const
-        {
-            return boost::uuids::string_generator()(value);
-        } 
-
-        virtual std::string as_string(void) const
-        {
-            return value;
-        }
-
-        virtual std::wstring as_wstring(void) const
-        {
-            return ccl::wstring(value);
-        }
-
-        virtual int32_t as_int(void) const
-        {
-            std::istringstream is(value);
-            int32_t result;
-            return (is >> result) ? result : 0;
-        }
-
-        virtual int64_t as_bigint(void) const
-        {
-            std::istringstream is(value);
-            int64_t result;
-            return (is >> result) ? result : 0;
-        }
-
-        virtual double as_double(void) const
-        {
-            std::istringstream is(value);
-            double result;
-            return (is >> result) ? result : 0;
-        }
-
-        virtual binary as_binary(uint8_t byteOrder) const
-        {
-            if(value.size() == 0)
-                return binary();
-            binary result;
-            result.resize(value.size());
-            memcpy(&(result[0]), &(value[0]), value.size());
-            return result;
-        }
-    };
-
-    class VariantWideString : public VariantType
-    {
-    private:
-        std::wstring value;
-
-    public:
-        virtual ~VariantWideString(void) { }
-        VariantWideString(const std::wstring &value) : value(value) { }
-
-        virtual uint8_t type(void) const
-        {
-            return Variant::TYPE_WSTRING;
-        }
-
-        virtual std::string typeString(void) const
-        {
-            return "wstring";
-        }
-
-        virtual const std::type_info &typeinfo(void) const
-        {
-            return typeid(std::wstring);
-        }
-
-        virtual VariantType *clone(void) const
-        {
-            return new VariantWideString(value);
-        }
-
-        virtual void *ptr(void)
-        {
-            return (void *)value.c_str();
-        }
-
-        virtual boost::uuids::uuid as_uuid(void) const
-        {
-            return boost::uuids::string_generator()(value);
-        }
-
-        virtual std::string as_string(void) const
-        {
-            return ccl::string(value);
-        }
-
-        virtual std::wstring as_wstring(void) const
-        {
-            return value;
-        }
-
-        virtual int32_t as_int(void) const
-        {
-            std::wistringstream is(value);
-            int32_t result;
-            return (is >> result) ? result : 0;
-        }
-
-        virtual int64_t as_bigint(void) const
-        {
-            std::wistringstream is(value);
-            int64_t result;
-            return (is >> result) ? result : 0;
-        }
-
-        virtual double as_double(void) const
+        template <class T, class S>
+        T parseNumber(const S &value)
         {
-            std::wistringstream is(value);
-            double result;
+            std::basic_istringstream<typename S::value_type> is(value);
+            T result;
             return (is >> result) ? result : 0;
         }
 
-        virtual binary as_binary(uint8_t byteOrder) const
-        {
-            binary result;
-            result.resize(value.size() * sizeof(wchar_t));
-            memcpy(&(result[0]), &(value[0]), value.size() * sizeof(wchar_t));
-            return result;
-        }
-    };
-
-    class VariantInteger : public VariantType
-    {
-    private:
-        int32_t value;
-
-    public:
-        virtual ~VariantInteger(void) { }
-        VariantInteger(const int32_t &value) : value(value) { }
-
-        virtual uint8_t type(void) const
-        {
-            return Variant::TYPE_INT32;
-        } 
-
-        virtual std::string typeString(void) const
-        {
-            return "int";
-        }
-
-        virtual const std::type_info &typeinfo(void) const
-        {
-            return typeid(int32_t);
-        }
-
-        virtual VariantType *clone(void) const
-        {
-            return new VariantInteger(value);
-        }
-
-        virtual void *ptr(void)
-        {
-            return &value;
-        }
-
-        virtual boost::uuids::uuid as_uuid(void) const
-        {
-            throw VariantException("int", "uuid");
-        }
-
-        virtual std::string as_string(void) const
+        template <class S, class T>
+        S formatNumber(const T &value, int precision = 0)
         {
-            std::stringstream ss;
+            std::basic_stringstream<typename S::value_type> ss;
+            if(precision)
+                ss.precision(precision);
             ss << value;
             return ss.str();
         }
 
-        virtual std::wstring as_wstring(void) const
+        template <class T>
+        T numberFromBinary(const binary &value)
         {
-            std::wstringstream ss;
-            ss << value;
-            return ss.str();
-        }
-
-        virtual int32_t as_int(void) const
-        {
-            return value;
+            if(value.size() < sizeof(T))
+                return 0;
+            LittleEndian<T> v(0);
+            return (v.from_binary(value)) ? T(v) : 0;
         }
 
-        virtual int64_t as_bigint(void) const
+        const char *typeName(uint8_t type)
         {
-            return value;
+            switch(type)
+            {
+                case Variant::TYPE_UUID:        return "uuid";
+                case Variant::TYPE_STRING:        return "string";
+                case Variant::TYPE_WSTRING:        return "wstring";
+                case Variant::TYPE_INT:            return "int";
+                case Variant::TYPE_BIGINT:        return "bigint";
+                case Variant::TYPE_DOUBLE:        return "double";
+                case Variant::TYPE_BINARY:        return "binary";
+            }
+            return "";
         }
+    }
 
-        virtual double as_double(void) const
-        {
-            return value;
-        }
+//----------------------------------------------------------------------
 
-        virtual binary as_binary(uint8_t byteOrder) const
-        {
-            LittleEndian<int32_t> l(value);
-            BigEndian<int32_t> b(value);
-            return (byteOrder == Variant::ENDIAN_LITTLE) ? l.as_binary() : b.as_binary();
-        }
-    };
+    int Variant::precision = 16;
 
-    class VariantBigInteger : public VariantType
+    Variant::~Variant(void)
     {
-    private:
-        int64_t value;
-
-    public:
-        virtual ~VariantBigInteger(void) { }
-        VariantBigInteger(const int64_t &value) : value(value) { }
-
-        virtual uint8_t type(void) const
-        {
-            return Variant::TYPE_INT64;
-        }
-
-        virtual std::string typeString(void) const
-        {
-            return "bigint";
-        }
-
-        virtual const std::type_info &typeinfo(void) const
-        {
-            return typeid(int64_t);
-        }
-
-        virtual VariantType *clone(void) const
-        {
-            return new VariantBigInteger(value);
-        }
-
-        virtual void *ptr(void)
-        {
-            return &value;
-        }
-
-        virtual boost::uuids::uuid as_uuid(void) const
-        {
-            throw VariantException("bigint", "uuid");
-        }
-
-        virtual std::string as_string(void) const
-        {
-            std::stringstream ss;
-            ss << value;
-            return ss.str();
-        }
-
-        virtual std::wstring as_wstring(void) const
-        {
-            std::wstringstream ss;
-            ss << value;
-            return ss.str();
-        }
-
-        virtual int32_t as_int(void) const
-        {
-            return value;
-        }
-
-        virtual int64_t as_bigint(void) const
-        {
-            return value;
-        }
-
-        virtual double as_double(void) const
-        {
-            return value;
-        }
-
-        virtual binary as_binary(uint8_t byteOrder) const
+        reset();
+    }
+
+    Variant::Variant(void) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { }
+    Variant::Variant(const Variant &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { *this = value; }
+    Variant::Variant(Variant &&value) : content(value.content), kind(value.kind), shortString(value.shortString), shortSize(value.shortSize) { value.kind = TYPE_EMPTY; }
+    Variant::Variant(const boost::uuids::uuid &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setUUID(value); }
+    Variant::Variant(const char *value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setString(value, strlen(value)); }
+    Variant::Variant(const std::string &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setString(value.data(), value.size()); }
+    Variant::Variant(const wchar_t *value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setWideString(std::wstring(value)); }
+    Variant::Variant(const std::wstring &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setWideString(value); }
+    Variant::Variant(const bool &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setInt(value); }
+    Variant::Variant(const int8_t &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setInt(value); }
+    Variant::Variant(const uint8_t &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setInt(value); }
+    Variant::Variant(const int16_t &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setInt(value); }
+    Variant::Variant(const uint16_t &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setInt(value); }
+    Variant::Variant(const int32_t &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setInt(value); }
+    Variant::Variant(const uint32_t &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setInt(value); }
+    Variant::Variant(const int64_t &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setBigInt(value); }
+    Variant::Variant(const uint64_t &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setBigInt(value); }
+    Variant::Variant(const float &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setDouble(value); }
+    Variant::Variant(const double &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setDouble(value); }
+    Variant::Variant(const long double &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setDouble(value); }
+    Variant::Variant(const binary &value) : kind(TYPE_EMPTY), shortString(false), shortSize(0) { setBinary(value); }
+
+    void Variant::reset(void)
+    {
+        switch(kind)
         {
-            LittleEndian<int64_t> l(value);
-            BigEndian<int64_t> b(value);
-            return (byteOrder == Variant::ENDIAN_LITTLE) ? l.as_binary() : b.as_binary();
+            case TYPE_STRING:
+                if(!shortString)
+                    delete content.longString;
+                break;
+            case TYPE_WSTRING:
+                delete content.wideString;
+                break;
+            case TYPE_BINARY:
+                delete content.bytes;
+                break;
         }
-    };
+        kind = TYPE_EMPTY;
+        shortString = false;
+        shortSize = 0;
+    }
 
-    class VariantDouble : public VariantType
+    void Variant::setInt(int32_t value)
     {
-    private:
-        double value;
-
-    public:
-        virtual ~VariantDouble(void) { } 
-        VariantDouble(const double &value) : value(value) { }
-
-        virtual uint8_t type(void) const
-        {
-            return Variant::TYPE_DOUBLE;
-        }
-
-        virtual std::string typeString(void) const
-        {
-            return "double";
-        }
-
-        virtual const std::type_info &typeinfo(void) const
-        {
-            return typeid(double);
-        }
-
-        virtual VariantType *clone(void) const
-        {
-            return new VariantDouble(value);
-        }
-
-        virtual void *ptr(void)
-        {
-            return &value;
-        }
-
-        virtual boost::uuids::uuid as_uuid(void) const
-        {
-            throw VariantException("double", "uuid");
-        }
-
-        virtual std::string as_string(void) const
-        {
-            std::stringstream ss;
-            ss.precision(Variant::precision);
-            //ss << std::fixed << value;
-            ss << value;
-            return ss.str();
-        }
-
-        virtual std::wstring as_wstring(void) const
-        {
-            std::wstringstream ss;
-            ss.precision(Variant::precision);
-            //ss << std::fixed << value;
-            ss << value;
-            return ss.str();
-        }
-
-        virtual int32_t as_int(void) const
-        {
-            return value;
-        }
-
-        virtual int64_t as_bigint(void) const
-        {
-            return value;
-        }
-
-        virtual double as_double(void) const
-        {
-            return value;
-        }
-
-        virtual binary as_binary(uint8_t byteOrder) const
-        {
-            LittleEndian<double> v(value);
-            return v.as_binary();
-        }
-    };
+        reset();
+        content.i = value;
+        kind = TYPE_INT32;
+    }
 
-    class VariantBinary : public VariantType
+    void Variant::setBigInt(int64_t value)
     {
-    private:
-        binary value;
-
-    public:
-        virtual ~VariantBinary(void) { }
-        VariantBinary(const binary &value) : value(value) { }
-
-        virtual uint8_t type(void) const
-        {
-            return Variant::TYPE_BINARY;
-        }
-
-        virtual std::string typeString(void) const
-        {
-            return "binary";
-        }
-
-        virtual const std::type_info &typeinfo(void) const
-        {
-            return typeid(binary);
-        }
-
-        virtual VariantType *clone(void) const
-        {
-            return new VariantBinary(value);
-        }
+        reset();
+        content.bigint = value;
+        kind = TYPE_INT64;
+    }
 
-        virtual void *ptr(void)
-        {
-            return &value;
-        }
+    void Variant::setDouble(double value)
+    {
+        reset();
+        content.d = value;
+        kind = TYPE_DOUBLE;
+    }
 
-        virtual boost::uuids::uuid as_uuid(void) const
-        {
-            if(value.size() < sizeof(boost::uuids::uuid))
-                return boost::uuids::nil_generator()();
-            boost::uuids::uuid result;
-            memcpy(&result, &(value[0]), sizeof(boost::uuids::uuid));
-            return result;
-        }
+    void Variant::setUUID(const boost::uuids::uuid &value)
+    {
+        reset();
+        memcpy(content.uuid, &value, sizeof(content.uuid));
+        kind = TYPE_UUID;
+    }
 
-        virtual std::string as_string(void) const
+    void Variant::setString(const char *value, size_t size)
+    {
+        // the value may be our own content, so it is copied before the old content is released
+        if(size <= SHORT_STRING_SIZE)
         {
-            if(value.size() == 0)
-                return std::string();
-            std::string result;
-            result.resize(value.size());
-            memcpy(&(result[0]), &(value[0]), value.size());
-            return result;
+            char buffer[SHORT_STRING_SIZE + 1];
+            memcpy(buffer, value, size);
+            reset();
+            memcpy(content.str, buffer, size);
+            content.str[size] = 0;
+            shortString = true;
+            shortSize = uint8_t(size);
         }
-
-        virtual std::wstring as_wstring(void) const
+        else
         {
-            std::wstring result;
-            result.resize(value.size() / sizeof(wchar_t));
-            memcpy(&(result[0]), &(value[0]), value.size());
-            return result;
+            std::string *copy = new std::string(value, size);
+            reset();
+            content.longString = copy;
         }
+        kind = TYPE_STRING;
+    }
 
-        virtual int32_t as_int(void) const
-        {
-            if(value.size() < sizeof(int32_t))
-                return 0;
-            LittleEndian<int32_t> v(0);
-            return (v.from_binary(value)) ? int32_t(v) : 0;
-        }
+    void Variant::setWideString(const std::wstring &value)
+    {
+        std::wstring *copy = new std::wstring(value);
+        reset();
+        content.wideString = copy;
+        kind = TYPE_WSTRING;
+    }
 
-        virtual int64_t as_bigint(void) const
-        {
-            if(value.size() < sizeof(int64_t))
-                return 0;
-            LittleEndian<int64_t> v(0);
-            return (v.from_binary(value)) ? int64_t(v) : 0;
-        }
+    void Variant::setBinary(const binary &value)
+    {
+        binary *copy = new binary(value);
+        reset();
+        content.bytes = copy;
+        kind = TYPE_BINARY;
+    }
 
-        virtual double as_double(void) const
+    const char *Variant::stringData(size_t &size) const
+    {
+        if(shortString)
         {
-            if(value.size() < sizeof(double))
-                return 0;
-            LittleEndian<double> v(0);
-            return (v.from_binary(value)) ? double(v) : 0;
+            size = shortSize;
+            return content.str;
         }
+        size = content.longString->size();
+        return content.longString->data();
+    }
 
-        virtual binary as_binary(uint8_t byteOrder) const
+    Variant &Variant::operator=(const Variant &value)
+    {
+        if(this == &value)
+            return *this;
+        switch(value.kind)
         {
-            return value;
+            case TYPE_STRING:
+            {
+                size_t size;
+                const char *data = value.stringData(size);
+                setString(data, size);
+                break;
+            }
+            case TYPE_WSTRING:
+                setWideString(*value.content.wideString);
+                break;
+            case TYPE_BINARY:
+                setBinary(*value.content.bytes);
+                break;
+            default:
+                reset();
+                content = value.content;
+                kind = value.kind;
         }
-    };
-
-//----------------------------------------------------------------------
-
-    int Variant::precision = 16;
-
-    Variant::~Variant(void)
-    {
-        delete content;
+        return *this;
     }
 
-    Variant::Variant(void) : content(NULL) { }
-    Variant::Variant(const Variant &value) : content(value.clone()) { }
-    Variant::Variant(const boost::uuids::uuid &value) : content(new VariantUUID(value)) { }
-    Variant::Variant(const char *value) : content(new VariantString(std::string(value))) { }
-    Variant::Variant(const std::string &value) : content(new VariantString(value)) { }
-    Variant::Variant(const wchar_t *value) : content(new VariantWideString(std::wstring(value))) { }
-    Variant::Variant(const std::wstring &value) : content(new VariantWideString(value)) { }
-    Variant::Variant(const bool &value) : content(new VariantInteger(value)) { }
-    Variant::Variant(const int8_t &value) : content(new VariantInteger(value)) { }
-    Variant::Variant(const uint8_t &value) : content(new VariantInteger(value)) { }
-    Variant::Variant(const int16_t &value) : content(new VariantInteger(value)) { }
-    Variant::Variant(const uint16_t &value) : content(new VariantInteger(value)) { }
-    Variant::Variant(const int32_t &value) : content(new VariantInteger(value)) { }
-    Variant::Variant(const uint32_t &value) : content(new VariantInteger(value)) { }
-    Variant::Variant(const int64_t &value) : content(new VariantBigInteger(value)) { }
-    Variant::Variant(const uint64_t &value) : content(new VariantBigInteger(value)) { }
-    Variant::Variant(const float &value) : content(new VariantDouble(value)) { }
-    Variant::Variant(const double &value) : content(new VariantDouble(value)) { }
-    Variant::Variant(const long double &value) : content(new VariantDouble(value)) { }
-    Variant::Variant(const binary &value) : content(new VariantBinary(value)) { }
-
-    Variant &Variant::operator=(const Variant &value)
+    Variant &Variant::operator=(Variant &&value)
     {
-        delete content;
-        content = value.clone();
+        if(this == &value)
+            return *this;
+        reset();
+        content = value.content;
+        kind = value.kind;
+        shortString = value.shortString;
+        shortSize = value.shortSize;
+        value.kind = TYPE_EMPTY;
         return *this;
     }
-    
+
     Variant &Variant::operator=(const boost::uuids::uuid &value)
     {
-        delete content;
-        content = new VariantUUID(value);
+        setUUID(value);
         return *this;
     }
 
     Variant &Variant::operator=(const char *value)
     {
-        delete content;
-        content = new VariantString(std::string(value));
+        setString(value, strlen(value));
         return *this;
     }
 
     Variant &Variant::operator=(const std::string &value)
     {
-        delete content;
-        content = new VariantString(value);
+        setString(value.data(), value.size());
         return *this;
     }
 
     Variant &Variant::operator=(const wchar_t *value)
     {
-        delete content;
-        content = new VariantWideString(std::wstring(value));
+        setWideString(std::wstring(value));
         return *this;
     }
 
     Variant &Variant::operator=(const std::wstring &value)
     {
-        delete content;
-        content = new VariantWideString(value);
+        setWideString(value);
         return *this;
     }
 
     Variant &Variant::operator=(const bool &value)
     {
-        delete content;
-        content = new VariantInteger(value);
+        setInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const int8_t &value)
     {
-        delete content;
-        content = new VariantInteger(value);
+        setInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const uint8_t &value)
     {
-        delete content;
-        content = new VariantInteger(value);
+        setInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const int16_t &value)
     {
-        delete content;
-        content = new VariantInteger(value);
+        setInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const uint16_t &value)
     {
-        delete content;
-        content = new VariantInteger(value);
+        setInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const int32_t &value)
     {
-        delete content;
-        content = new VariantInteger(value);
+        setInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const uint32_t &value)
     {
-        delete content;
-        content = new VariantInteger(value);
+        setInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const int64_t &value)
     {
-        delete content;
-        content = new VariantBigInteger(value);
+        setBigInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const uint64_t &value)
     {
-        delete content;
-        content = new VariantBigInteger(value);
+        setBigInt(value);
         return *this;
     }
 
     Variant &Variant::operator=(const float &value)
     {
-        delete content;
-        content = new VariantDouble(value);
+        setDouble(value);
         return *this;
     }
 
     Variant &Variant::operator=(const double &value)
     {
-        delete content;
-        content = new VariantDouble(value);
+        setDouble(value);
         return *this;
     }
 
     Variant &Variant::operator=(const long double &value)
     {
-        delete content;
-        content = new VariantDouble(value);
+        setDouble(value);
         return *this;
     }
+
     Variant &Variant::operator=(const binary &value)
     {
-        delete content;
-        content = new VariantBinary(value);
+        setBinary(value);
         return *this;
     }
 
@@ -819,29 +406,23 @@ namespace ccl
         {
             case TYPE_EMPTY:
                 return true;
-            case TYPE_INT8:
-            case TYPE_UINT8:
-            case TYPE_INT16:
-            case TYPE_UINT16:
             case TYPE_INT32:
-            case TYPE_UINT32:
-            case TYPE_DATETIME:
-            case TYPE_DATE:
-            case TYPE_TIME:
-                return (as_int() == rhs.as_int());
+                return (content.i == rhs.content.i);
             case TYPE_INT64:
-            case TYPE_UINT64:
-                return (as_bigint() == rhs.as_bigint());
-            case TYPE_FLOAT:
+                return (content.bigint == rhs.content.bigint);
             case TYPE_DOUBLE:
-            case TYPE_LONGDOUBLE:
-                return (as_double() == rhs.as_double());
+                return (content.d == rhs.content.d);
             case TYPE_UUID:
-                return (as_uuid() == rhs.as_uuid());
+                return (memcmp(content.uuid, rhs.content.uuid, sizeof(content.uuid)) == 0);
             case TYPE_STRING:
-                return (as_string() == rhs.as_string());
+            {
+                size_t size, rhs_size;
+                const char *data = stringData(size);
+                const char *rhs_data = rhs.stringData(rhs_size);
+                return (size == rhs_size) && (memcmp(data, rhs_data, size) == 0);
+            }
             case TYPE_WSTRING:
-                return (as_wstring() == rhs.as_wstring());
+                return (*content.wideString == *rhs.content.wideString);
             //case TYPE_BINARY:
 
         }
@@ -862,29 +443,25 @@ namespace ccl
         {
             case TYPE_EMPTY:
                 return false;
-            case TYPE_INT8:
-            case TYPE_UINT8:
-            case TYPE_INT16:
-            case TYPE_UINT16:
             case TYPE_INT32:
-            case TYPE_UINT32:
-            case TYPE_DATETIME:
-            case TYPE_DATE:
-            case TYPE_TIME:
-                return (as_int() < rhs.as_int());
+                return (content.i < rhs.content.i);
             case TYPE_INT64:
-            case TYPE_UINT64:
-                return (as_bigint() < rhs.as_bigint());
-            case TYPE_FLOAT:
+                return (content.bigint < rhs.content.bigint);
             case TYPE_DOUBLE:
-            case TYPE_LONGDOUBLE:
-                return (as_double() < rhs.as_double());
+                return (content.d < rhs.content.d);
             case TYPE_UUID:
                 return (as_uuid() < rhs.as_uuid());
             case TYPE_STRING:
-                return (as_string() < rhs.as_string());
+            {
+                // same ordering as std::string::compare
+                size_t size, rhs_size;
+                const char *data = stringData(size);
+                const char *rhs_data = rhs.stringData(rhs_size);
+                int result = std::char_traits<char>::compare(data, rhs_data, std::min(size, rhs_size));
+                return (result != 0) ? (result < 0) : (size < rhs_size);
+            }
             case TYPE_WSTRING:
-                return (as_wstring() < rhs.as_wstring());
+                return (*content.wideString < *rhs.content.wideString);
             //case TYPE_BINARY:
 
         }
@@ -908,12 +485,12 @@ namespace ccl
 
     uint8_t Variant::type(void) const
     {
-        return content ? content->type() : Variant::TYPE_EMPTY;
+        return kind;
     }
 
     std::string Variant::typeString(void) const
     {
-        return content ? content->typeString() : std::string();
+        return typeName(kind);
     }
 
     Variant Variant::convert(uint8_t type) const
@@ -952,65 +529,195 @@ namespace ccl
 
     const std::type_info &Variant::typeinfo(void) const
     {
-        return content ? content->typeinfo() : typeid(void);
-    }
-
-    VariantType *Variant::clone(void) const
-    {
-        return content ? content->clone() : NULL;
+        switch(kind)
+        {
+            case TYPE_UUID:            return typeid(boost::uuids::uuid);
+            case TYPE_STRING:        return typeid(std::string);
+            case TYPE_WSTRING:        return typeid(std::wstring);
+            case TYPE_INT32:        return typeid(int32_t);
+            case TYPE_INT64:        return typeid(int64_t);
+            case TYPE_DOUBLE:        return typeid(double);
+            case TYPE_BINARY:        return typeid(binary);
+        }
+        return typeid(void);
     }
 
     void *Variant::ptr(void) const
     {
-        return content ? content->ptr() : NULL;
+        Content &value = const_cast<Content &>(content);
+        switch(kind)
+        {
+            case TYPE_UUID:            return value.uuid;
+            case TYPE_STRING:        return shortString ? (void *)value.str : (void *)value.longString->c_str();
+            case TYPE_WSTRING:        return (void *)value.wideString->c_str();
+            case TYPE_INT32:        return &value.i;
+            case TYPE_INT64:        return &value.bigint;
+            case TYPE_DOUBLE:        return &value.d;
+            case TYPE_BINARY:        return value.bytes;
+        }
+        return NULL;
     }
 
     bool Variant::empty(void) const
     {
-        return (content == NULL);
+        return (kind == TYPE_EMPTY);
     }
 
     boost::uuids::uuid Variant::as_uuid(void) const
     {
-        return content ? content->as_uuid() : boost::uuids::uuid();
+        boost::uuids::uuid result = boost::uuids::uuid();
+        switch(kind)
+        {
+            case TYPE_UUID:
+                memcpy(&result, content.uuid, sizeof(result));
+                return result;
+            case TYPE_STRING:
+                return boost::uuids::string_generator()(as_string());
+            case TYPE_WSTRING:
+                return boost::uuids::string_generator()(*content.wideString);
+            case TYPE_INT32:
+            case TYPE_INT64:
+            case TYPE_DOUBLE:
+                throw VariantException(typeName(kind), "uuid");
+            case TYPE_BINARY:
+                if(content.bytes->size() < sizeof(boost::uuids::uuid))
+                    return boost::uuids::nil_generator()();
+                memcpy(&result, &((*content.bytes)[0]), sizeof(boost::uuids::uuid));
+                return result;
+        }
+        return result;
     }
 
     std::string Variant::as_string(void) const
     {
-        return content ? content->as_string() : std::string();
+        switch(kind)
+        {
+            case TYPE_UUID:
+                return boost::uuids::to_string(as_uuid());
+            case TYPE_STRING:
+            {
+                size_t size;
+                const char *data = stringData(size);
+                return std::string(data, size);
+            }
+            case TYPE_WSTRING:
+                return ccl::string(*content.wideString);
+            case TYPE_INT32:
+                return formatNumber<std::string>(content.i);
+            case TYPE_INT64:
+                return formatNumber<std::string>(content.bigint);
+            case TYPE_DOUBLE:
+                return formatNumber<std::string>(content.d, Variant::precision);
+            case TYPE_BINARY:
+                return std::string(content.bytes->begin(), content.bytes->end());
+        }
+        return std::string();
     }
 
     std::wstring Variant::as_wstring(void) const
     {
-        return content ? content->as_wstring() : std::wstring();
+        switch(kind)
+        {
+            case TYPE_UUID:
+                return boost::uuids::to_wstring(as_uuid());
+            case TYPE_STRING:
+                return ccl::wstring(as_string());
+            case TYPE_WSTRING:
+                return *content.wideString;
+            case TYPE_INT32:
+                return formatNumber<std::wstring>(content.i);
+            case TYPE_INT64:
+                return formatNumber<std::wstring>(content.bigint);
+            case TYPE_DOUBLE:
+                return formatNumber<std::wstring>(content.d, Variant::precision);
+            case TYPE_BINARY:
+            {
+                std::wstring result;
+                result.resize(content.bytes->size() / sizeof(wchar_t));
+                if(!result.empty())
+                    memcpy(&(result[0]), &((*content.bytes)[0]), result.size() * sizeof(wchar_t));
+                return result;
+            }
+        }
+        return std::wstring();
     }
     
     int32_t Variant::as_int(void) const
     {        
-        return content ? content->as_int() : 0;
+        switch(kind)
+        {
+            case TYPE_UUID:            throw VariantException("uuid", "int");
+            case TYPE_STRING:        return parseNumber<int32_t>(as_string());
+            case TYPE_WSTRING:        return parseNumber<int32_t>(*content.wideString);
+            case TYPE_INT32:        return content.i;
+            case TYPE_INT64:        return int32_t(content.bigint);
+            case TYPE_DOUBLE:        return int32_t(content.d);
+            case TYPE_BINARY:        return numberFromBinary<int32_t>(*content.bytes);
+        }
+        return 0;
     }
 
     int64_t Variant::as_bigint(void) const
     {
-        return content ? content->as_bigint() : 0;
+        switch(kind)
+        {
+            case TYPE_UUID:            throw VariantException("uuid", "bigint");
+            case TYPE_STRING:        return parseNumber<int64_t>(as_string());
+            case TYPE_WSTRING:        return parseNumber<int64_t>(*content.wideString);
+            case TYPE_INT32:        return content.i;
+            case TYPE_INT64:        return content.bigint;
+            case TYPE_DOUBLE:        return int64_t(content.d);
+            case TYPE_BINARY:        return numberFromBinary<int64_t>(*content.bytes);
+        }
+        return 0;
     }
 
     double Variant::as_double(void) const
     {
-        return content ? content->as_double() : 0;
+        switch(kind)
+        {
+            case TYPE_UUID:            throw VariantException("uuid", "double");
+            case TYPE_STRING:        return parseNumber<double>(as_string());
+            case TYPE_WSTRING:        return parseNumber<double>(*content.wideString);
+            case TYPE_INT32:        return content.i;
+            case TYPE_INT64:        return double(content.bigint);
+            case TYPE_DOUBLE:        return content.d;
+            case TYPE_BINARY:        return numberFromBinary<double>(*content.bytes);
+        }
+        return 0;
     }
+
     binary Variant::as_binary(uint8_t byteOrder) const
     {
-        if(!content)
-            return binary();
         if(byteOrder == Variant::ENDIAN_HOST)
             byteOrder = machLittleEndian() ? Variant::ENDIAN_LITTLE : Variant::ENDIAN_BIG;
-        return content->as_binary(byteOrder);
+        switch(kind)
+        {
+            case TYPE_UUID:
+                return binary(content.uuid, sizeof(content.uuid));
+            case TYPE_STRING:
+            {
+                size_t size;
+                const char *data = stringData(size);
+                return binary((const unsigned char *)data, size);
+            }
+            case TYPE_WSTRING:
+                return binary((const unsigned char *)content.wideString->data(), content.wideString->size() * sizeof(wchar_t));
+            case TYPE_INT32:
+                return (byteOrder == Variant::ENDIAN_LITTLE) ? LittleEndian<int32_t>(content.i).as_binary() : BigEndian<int32_t>(content.i).as_binary();
+            case TYPE_INT64:
+                return (byteOrder == Variant::ENDIAN_LITTLE) ? LittleEndian<int64_t>(content.bigint).as_binary() : BigEndian<int64_t>(content.bigint).as_binary();
+            case TYPE_DOUBLE:
+                return LittleEndian<double>(content.d).as_binary();
+            case TYPE_BINARY:
+                return *content.bytes;
+        }
+        return binary();
     }
 
     binary Variant::encode(uint8_t byteOrder) const
     {
-        if(!content)
+        if(empty())
             return binary();
         if(byteOrder == Variant::ENDIAN_HOST)
             byteOrder = machLittleEndian() ? Variant::ENDIAN_LITTLE : Variant::ENDIAN_BIG;
@@ -1111,7 +818,7 @@ namespace ccl
     {
         try
         {
-            boost::lexical_cast<t>(content->as_string());
+            boost::lexical_cast<t>(as_string());
             return true;
         }
         catch(boost::bad_lexical_cast &)
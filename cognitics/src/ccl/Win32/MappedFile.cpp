@@ -0,0 +1,141 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "ccl/MappedFile.h"
+
+#include <windows.h>
+
+namespace
+{
+    // maps the whole file; size must match the file (or the size it is being extended to)
+    bool mapFile(HANDLE file, size_t size, bool writable, void *&mapping, unsigned char *&data)
+    {
+        ULARGE_INTEGER mappingSize;
+        mappingSize.QuadPart = size;
+        mapping = CreateFileMappingA(file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, mappingSize.HighPart, mappingSize.LowPart, NULL);
+        if(mapping == NULL)
+            return false;
+        data = static_cast<unsigned char *>(MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0));
+        return data != NULL;
+    }
+}
+
+namespace ccl
+{
+    MappedFile::MappedFile(void) : _data(NULL), _size(0), _file(NULL), _mapping(NULL), _open(false), _writable(false)
+    {
+    }
+
+    MappedFile::MappedFile(const std::string &filename, Mode mode) : _data(NULL), _size(0), _file(NULL), _mapping(NULL), _open(false), _writable(false)
+    {
+        open(filename, mode);
+    }
+
+    MappedFile::~MappedFile(void)
+    {
+        close();
+    }
+
+    bool MappedFile::open(const std::string &filename, Mode mode)
+    {
+        close();
+        bool writable = (mode == READ_WRITE);
+        HANDLE file = CreateFileA(filename.c_str(), writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize) || (ULONGLONG(fileSize.QuadPart) > ULONGLONG(SIZE_MAX)))
+        {
+            CloseHandle(file);
+            return false;
+        }
+        _file = file;
+        _size = size_t(fileSize.QuadPart);
+        if((_size > 0) && !mapFile(file, _size, writable, _mapping, _data))
+        {
+            close();
+            return false;
+        }
+        _writable = writable;
+        _open = true;
+        return true;
+    }
+
+    bool MappedFile::create(const std::string &filename, size_t size)
+    {
+        close();
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(file == INVALID_HANDLE_VALUE)
+            return false;
+        _file = file;
+        _size = size;
+        // mapping a larger size than the file extends it
+        if((_size > 0) && !mapFile(file, _size, true, _mapping, _data))
+        {
+            close();
+            return false;
+        }
+        _writable = true;
+        _open = true;
+        return true;
+    }
+
+    void MappedFile::close(void)
+    {
+        if(_data)
+            UnmapViewOfFile(_data);
+        if(_mapping)
+            CloseHandle(_mapping);
+        if(_file)
+            CloseHandle(_file);
+        _data = NULL;
+        _size = 0;
+        _mapping = NULL;
+        _file = NULL;
+        _open = false;
+        _writable = false;
+    }
+
+    bool MappedFile::flush(void)
+    {
+        if(!_writable || !_data)
+            return _open;
+        return FlushViewOfFile(_data, 0) && FlushFileBuffers(_file);
+    }
+
+    void MappedFile::advise(Access access)
+    {
+        if(!_data)
+            return;
+#if _WIN32_WINNT >= 0x0602
+        // Windows only takes a prefetch hint; the other patterns are left to the cache manager
+        if(access == ACCESS_WILLNEED)
+        {
+            WIN32_MEMORY_RANGE_ENTRY range;
+            range.VirtualAddress = _data;
+            range.NumberOfBytes = _size;
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+#endif
+    }
+
+}
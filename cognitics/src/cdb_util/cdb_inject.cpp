@@ -9,6 +9,8 @@
 #include <ccl/LogStream.h>
 #include <ccl/ArgumentParser.h>
 #include <ccl/JobManager.h>
+#include <ccl/Trace.h>
+#include <ccl/Status.h>
 
 #include <iostream>
 #include <fstream>
@@ -109,6 +111,7 @@ public:
 
     int execute(void)
     {
+        COGNITICS_TRACE_SPAN("tile job");
         ccl::ObjLog log;
         log << "Processing " << cognitics::cdb::FileNameForTileInfo(tileinfo) << log.endl;
         if (isElevation)
@@ -120,6 +123,7 @@ public:
             cognitics::cdb::BuildImageryTileFromSampler(cdb, sampler, tileinfo);
         }
         reporter.reportCompletedJob("");
+        COGNITICS_STATUS_COUNT("tile jobs", 1);
 
         //log << "Finished " << cognitics::cdb::FileNameForTileInfo(tileinfo) << log.endl;
 
@@ -5,6 +5,8 @@
 
 #include <ccl/FileInfo.h>
 #include <ccl/JobManager.h>
+#include <ccl/Trace.h>
+#include <ccl/Status.h>
 
 #include <cstdlib>
 #include <fstream>
@@ -36,6 +38,7 @@ public:
 
     virtual int execute(void)
     {
+        COGNITICS_TRACE_SPAN("tile job");
         auto stem = std::filesystem::path(filename).stem().string();
         log << "    " << stem << log.endl;
         try
@@ -64,6 +67,7 @@ public:
             if(tile_info.dataset == 4)
                 cognitics::cdb::BuildImageryTileFromSampler(cdb, sampler, tile_info);
             gdalsampler::CacheManager::getInstance()->Unload();
+            COGNITICS_STATUS_COUNT("tile jobs", 1);
         }
         catch(std::exception& e)
         {
@@ -4,6 +4,7 @@
 #include <cdb_util/cdb_util.h>
 #include <cdb_util/cdb_sample.h>
 #include <ip/jpgwrapper.h>
+#include <ccl/Status.h>
 
 #include <civetweb/CivetServer.h>
 
@@ -424,10 +425,34 @@ public:
 
     bool handleGet(CivetServer* server, struct mg_connection* connection)
     {
+        COGNITICS_STATUS_COUNT("wms requests", 1);
         return WMSRequestHandler::HandleRequest(cdb, server, connection, blue_marble, population);
     }
 };
 
+class StatusHandler : public CivetHandler
+{
+public:
+    ccl::StatusReporter& reporter;
+    StatusHandler(ccl::StatusReporter& reporter) : reporter(reporter) { }
+    bool handleGet(CivetServer* server, struct mg_connection* connection)
+    {
+        auto json = std::stringstream();
+        ccl::Status::writeJSON(json, reporter.getLatest());
+        auto body = json.str();
+        auto ss = std::stringstream();
+        ss << "HTTP/1.1 200 OK\r\n";
+        ss << "Content-Type: application/json\r\n";
+        ss << "Cache-Control: no-cache\r\n";
+        ss << "Content-Length: " << body.size() << "\r\n";
+        ss << "\r\n";
+        ss << body;
+        auto str = ss.str();
+        mg_write(connection, str.c_str(), str.size());
+        return true;
+    }
+};
+
 class WebHandler : public CivetHandler
 {
 public:
@@ -470,7 +495,10 @@ bool cdb_service(cdb_service_parameters& params)
     if(!params.cdb.empty())
         wms_handler.SetCDB(params.cdb);
     auto web_handler = WebHandler(wms_handler);
+    auto status_reporter = ccl::StatusReporter(params.status_interval, params.status_file, params.status_log);
+    auto status_handler = StatusHandler(status_reporter);
     web_server.addHandler("/wms", wms_handler);
+    web_server.addHandler("/status", status_handler);
     web_server.addHandler("", web_handler);
     while(true)
         ccl::sleep(100);
@@ -7,14 +7,22 @@
 #include <cdb_tile/TileLatitude.h>
 #include <ccl/miniz.h>
 
-#include <dbflib/DBaseFile.h>
+#include <dbflib/DBaseTable.h>
 
 #include <ogr/File.h>
 #include <flt/OpenFlight.h>
 #include <flt/TexturePalette.h>
 #include <flt/Header.h>
+#include <flt/RecordReader.h>
+
+#include <ccl/Parallel.h>
+#include <ccl/Trace.h>
+#include <ccl/Status.h>
+#include <ccl/Arena.h>
 
 #include <array>
+#include <mutex>
+#include <unordered_map>
 #include <cctype>
 #include <locale>
 #include <iomanip>
@@ -331,8 +339,8 @@ std::vector<sfa::Feature*> FeaturesForOGRFile(const std::string& filename, std::
         if(std::get<0>(nsew) != DBL_MAX)
             layer->setSpatialFilter(std::get<3>(nsew), std::get<1>(nsew), std::get<2>(nsew), std::get<0>(nsew));
         layer->resetReading();
-        while (sfa::Feature *feature = layer->getNextFeature())
-            result.push_back(feature);
+        while(layer->getNextFeatures(result, 1024) > 0)
+            ;
     }
     file.close();
     return result;
@@ -345,23 +353,18 @@ std::vector<ccl::AttributeContainer> AttributesForDBF(const std::string& filenam
     {
         if(!ccl::fileExists(filename))
             return result;
-        auto dbf = DBaseFile();
+        auto dbf = DBaseTable();
         if(!dbf.openFile(filename))
             return result;
-        for(DBaseRecord& record : dbf.m_records)
+        result.reserve(dbf.numRecords());
+        for(size_t record = 0, c = dbf.numRecords(); record < c; ++record)
         {
-            auto attributes = ccl::AttributeContainer();
-            if(record.m_recordData.size() != dbf.m_colDef.size())
+            if(dbf.isDeleted(record))
                 continue;
-            for(size_t i = 0, c = dbf.m_colDef.size(); i < c; ++i)
-            {
-                auto key = dbf.m_colDef[i].m_fieldName;
-                auto value = *record.m_recordData[i];
-                value.erase(value.begin(), std::find_if(value.begin(), value.end(), [](int ch) { return !std::isspace(ch); }));
-                value.erase(std::find_if(value.rbegin(), value.rend(), [](int ch) { return !std::isspace(ch); }).base(), value.end());
-                attributes.setAttribute(key, value);
-            }
-            result.push_back(attributes);
+            auto attributes = ccl::AttributeContainer();
+            for(size_t i = 0, n = dbf.numColumns(); i < n; ++i)
+                attributes.setAttribute(dbf.m_colDef[i].m_fieldName, dbf.getString(record, i));
+            result.push_back(std::move(attributes));
         }
     }
     catch(...)
@@ -382,45 +385,215 @@ std::map<std::string, ccl::AttributeContainer> AttributesByCNAM(const std::vecto
     return result;
 }
 
-std::pair<bool, std::vector<std::string>> TextureFileNamesForModel(const std::string& filename)
+namespace {
+
+// Calls function(begin, end) on ranges of up to grain items covering [0, count), spread over workers threads.
+// Exceptions are logged so that one bad tile or model doesn't abort a report.
+void ParallelForRanges(size_t count, size_t grain, int workers, const std::function<void(size_t, size_t)>& function)
+{
+    auto guarded = [&function](size_t begin, size_t end)
+    {
+        try
+        {
+            function(begin, end);
+        }
+        catch(std::exception& e)
+        {
+            ccl::ObjLog log;
+            log << "EXCEPTION: " << e.what() << log.endl;
+        }
+    };
+    if((workers <= 1) || (count <= grain))
+    {
+        guarded(0, count);
+        return;
+    }
+    ccl::JobManager job_manager(workers);
+    ccl::parallel_for_ranges(job_manager, 0, count, grain, guarded);
+}
+
+// miniz compares member names case insensitively (ASCII only)
+std::string ZipMemberKey(const std::string& name)
+{
+    auto result = name;
+    for(auto& c : result)
+    {
+        if((c >= 'A') && (c <= 'Z'))
+            c = char(c - 'A' + 'a');
+    }
+    return result;
+}
+
+std::pair<bool, std::vector<std::string>> TextureFileNamesForFLT(flt::RecordReader& reader)
 {
     auto result = std::vector<std::string>();
+    reader.getTexturePaletteFilenames(result);
+    return std::make_pair(true, result);
+}
 
-    auto flt = (flt::OpenFlight*)nullptr;
+}
 
-    auto parent_path = ccl::FileInfo(filename).getDirName();
-    if(ccl::FileInfo(parent_path).getSuffix() == "zip")
+std::pair<bool, std::vector<std::string>> TextureFileNamesForModel(const std::string& filename)
+{
+    return TextureFileNamesForModels(std::vector<std::string>(1, filename), 1).front();
+}
+
+std::vector<std::pair<bool, std::vector<std::string>>> TextureFileNamesForModels(const std::vector<std::string>& filenames, int workers)
+{
+    auto result = std::vector<std::pair<bool, std::vector<std::string>>>(filenames.size(), std::make_pair(false, std::vector<std::string>()));
+
+    auto indices_by_parent = std::map<std::string, std::vector<size_t>>();
+    for(size_t i = 0, c = filenames.size(); i < c; ++i)
+        indices_by_parent[ccl::FileInfo(filenames[i]).getDirName()].push_back(i);
+    auto groups = std::vector<std::pair<std::string, std::vector<size_t>>>(indices_by_parent.begin(), indices_by_parent.end());
+
+    ParallelForRanges(groups.size(), 1, workers, [&](size_t begin, size_t end)
     {
-        auto model_filename = ccl::FileInfo(filename).getBaseName();
-        auto flt_size = size_t(0);
-        auto flt_data = mz_zip_extract_archive_file_to_heap(parent_path.c_str(), model_filename.c_str(), &flt_size, 0);
-        if(!flt_data)
-            return std::make_pair(false, result);
-        auto flt_str = std::string((char*)flt_data, flt_size);
-        auto flt_ss = std::stringstream(flt_str, std::stringstream::binary | std::stringstream::in);
-        flt = flt::OpenFlight::open(flt_ss);
-        if (!flt)
-            return std::make_pair(false, result);
-        while (auto record = flt->getNextRecord())
+        flt::RecordReader reader;
+        for(size_t g = begin; g < end; ++g)
         {
-            if (record->getRecordType() != flt::Record::FLT_TEXTUREPALETTE)
+            const auto& parent_path = groups[g].first;
+            const auto& indices = groups[g].second;
+            if(ccl::FileInfo(parent_path).getSuffix() == "zip")
+            {
+                auto members = std::vector<std::string>();
+                for(auto index : indices)
+                    members.push_back(ccl::FileInfo(filenames[index]).getBaseName());
+                ExtractZipArchiveMembers(parent_path, members, [&](size_t member, const unsigned char* data, size_t size)
+                {
+                    if(reader.open(data, size))
+                        result[indices[member]] = TextureFileNamesForFLT(reader);
+                    reader.close();
+                });
                 continue;
-            result.push_back(dynamic_cast<flt::TexturePalette*>(record)->fileName);
+            }
+            for(auto index : indices)
+            {
+                if(reader.open(filenames[index]))
+                    result[index] = TextureFileNamesForFLT(reader);
+                reader.close();
+            }
         }
-        flt::OpenFlight::destroy(flt);
-        return std::make_pair(true, result);
+    });
+
+    return result;
+}
+
+namespace {
+
+class ZipArchiveCache
+{
+public:
+    static ZipArchiveCache& instance()
+    {
+        static ZipArchiveCache cache;
+        return cache;
     }
-    flt = flt::OpenFlight::open(filename);
-    if (!flt)
-        return std::make_pair(false, result);
-    while (auto record = flt->getNextRecord())
+
+    std::shared_ptr<const std::unordered_set<std::string>> members(const std::string& zip_filename)
     {
-        if (record->getRecordType() != flt::Record::FLT_TEXTUREPALETTE)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = directories.find(zip_filename);
+            if(it != directories.end())
+                return it->second;
+        }
+        // parse outside the lock; if another job got there first, keep its entry
+        auto result = read(zip_filename);
+        std::lock_guard<std::mutex> lock(mutex);
+        return directories.emplace(zip_filename, result).first->second;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        directories.clear();
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const std::unordered_set<std::string>>> directories;
+
+    static std::shared_ptr<const std::unordered_set<std::string>> read(const std::string& zip_filename)
+    {
+        mz_zip_archive zip;
+        memset(&zip, 0, sizeof(zip));
+        if(!mz_zip_reader_init_file(&zip, zip_filename.c_str(), 0))
+            return nullptr;
+        auto result = std::make_shared<std::unordered_set<std::string>>();
+        auto num_files = mz_zip_reader_get_num_files(&zip);
+        result->reserve(num_files);
+        char name[MZ_ZIP_MAX_ARCHIVE_FILENAME_SIZE];
+        for(mz_uint i = 0; i < num_files; ++i)
+        {
+            if(mz_zip_reader_get_filename(&zip, i, name, sizeof(name)) > 0)
+                result->insert(ZipMemberKey(name));
+        }
+        mz_zip_reader_end(&zip);
+        return result;
+    }
+};
+
+}
+
+std::shared_ptr<const std::unordered_set<std::string>> ZipArchiveMembers(const std::string& zip_filename)
+{
+    return ZipArchiveCache::instance().members(zip_filename);
+}
+
+void ClearZipArchiveCache()
+{
+    ZipArchiveCache::instance().clear();
+}
+
+bool ExtractZipArchiveMembers(const std::string& zip_filename, const std::vector<std::string>& members, const std::function<void(size_t, const unsigned char*, size_t)>& visitor)
+{
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(zip));
+    if(!mz_zip_reader_init_file(&zip, zip_filename.c_str(), 0))
+        return false;
+    auto buffer = std::vector<unsigned char>();
+    for(size_t i = 0, c = members.size(); i < c; ++i)
+    {
+        // the central directory is sorted when the archive is opened, so this is a binary search
+        int file_index = mz_zip_reader_locate_file(&zip, members[i].c_str(), nullptr, 0);
+        if(file_index < 0)
+            continue;
+        mz_zip_archive_file_stat stat;
+        if(!mz_zip_reader_file_stat(&zip, mz_uint(file_index), &stat))
+            continue;
+        buffer.resize(size_t(stat.m_uncomp_size));
+        if(!buffer.empty() && !mz_zip_reader_extract_to_mem(&zip, mz_uint(file_index), buffer.data(), buffer.size(), 0))
             continue;
-        result.push_back(dynamic_cast<flt::TexturePalette*>(record)->fileName);
+        COGNITICS_TRACE_COUNT("bytes read", stat.m_comp_size);
+        visitor(i, buffer.data(), buffer.size());
     }
-    flt::OpenFlight::destroy(flt);
-    return std::make_pair(true, result);
+    mz_zip_reader_end(&zip);
+    return true;
+}
+
+namespace {
+
+// Opens the class-level attributes of a feature tile, indexed by CNAM; returns false if they can't be read.
+bool OpenClassAttributes(DBaseTable& table, const std::string& filename)
+{
+    try
+    {
+        return ccl::fileExists(filename) && table.openFile(filename) && table.buildIndex("CNAM");
+    }
+    catch(...)
+    {
+        std::cerr << "  bad dbf: " << filename << std::endl;
+    }
+    return false;
+}
+
+std::string ClassAttribute(const DBaseTable& table, long long record, const std::string& name)
+{
+    auto column = table.columnIndex(name);
+    return (column < 0) ? std::string() : table.getString(size_t(record), size_t(column));
+}
+
 }
 
 std::vector<std::string> GSModelReferencesForTile(const std::string& cdb, const TileInfo& tileinfo, std::tuple<double, double, double, double> nsew)
@@ -439,10 +612,13 @@ std::vector<std::string> GSModelReferencesForTile(const std::string& cdb, const
     auto dbf_filename = FileNameForTileInfo(dbf_tile);
     auto dbf = cdb + "/Tiles/" + dbf_filepath + "/" + dbf_filename + ".dbf";
 
-    auto attrvec = AttributesForDBF(dbf);
-    auto attrmap = AttributesByCNAM(attrvec);
-    if(attrmap.empty())
+    auto table = DBaseTable();
+    if(!OpenClassAttributes(table, dbf))
+    {
+        for(auto feature : features)
+            delete feature;
         return result;
+    }
 
     auto zip_tile = tileinfo;
     zip_tile.dataset = 300;
@@ -454,18 +630,20 @@ std::vector<std::string> GSModelReferencesForTile(const std::string& cdb, const
 
     for (auto feature : features)
     {
-        auto cnam = feature->attributes.getAttributeAsString("CNAM");
-        if(attrmap.find(cnam) == attrmap.end())
+        auto record = table.find(feature->attributes.getAttributeAsString("CNAM"));
+        if(record < 0)
             continue;
-        auto facc = attrmap[cnam].getAttributeAsString("FACC");
-        auto fsc = attrmap[cnam].getAttributeAsString("FSC");
+        auto facc = ClassAttribute(table, record, "FACC");
+        auto fsc = ClassAttribute(table, record, "FSC");
         while (fsc.size() < 3)
             fsc = "0" + fsc;
-        auto modl = attrmap[cnam].getAttributeAsString("MODL");
+        auto modl = ClassAttribute(table, record, "MODL");
         auto model_filename = zip + "/" + zip_filename + "_" + facc + "_" + fsc + "_" + modl + ".flt";
         result.push_back(model_filename);
     }
 
+    for(auto feature : features)
+        delete feature;
     return result;
 }
 
@@ -485,48 +663,43 @@ std::vector<std::string> GTModelReferencesForTile(const std::string& cdb, const
     auto dbf_filename = FileNameForTileInfo(dbf_tile);
     auto dbf = cdb + "/Tiles/" + dbf_filepath + "/" + dbf_filename + ".dbf";
 
-    auto attrvec = AttributesForDBF(dbf);
-    auto attrmap = AttributesByCNAM(attrvec);
-    if(attrmap.empty())
+    auto table = DBaseTable();
+    if(!OpenClassAttributes(table, dbf))
+    {
+        for(auto feature : features)
+            delete feature;
         return result;
+    }
 
     auto fdd = FeatureDataDictionary();
 
     for (auto feature : features)
     {
-        auto cnam = feature->attributes.getAttributeAsString("CNAM");
-        if(attrmap.find(cnam) == attrmap.end())
+        auto record = table.find(feature->attributes.getAttributeAsString("CNAM"));
+        if(record < 0)
             continue;
-        auto facc = attrmap[cnam].getAttributeAsString("FACC");
-        auto fsc = attrmap[cnam].getAttributeAsString("FSC");
+        auto facc = ClassAttribute(table, record, "FACC");
+        auto fsc = ClassAttribute(table, record, "FSC");
         while (fsc.size() < 3)
             fsc = "0" + fsc;
-        auto modl = attrmap[cnam].getAttributeAsString("MODL");
+        auto modl = ClassAttribute(table, record, "MODL");
         auto model_filename = cdb + "/GTModel/500_GTModelGeometry/" + fdd.Subdirectory(facc) + "/D500_S001_T001_" + facc + "_" + fsc + "_" + modl + ".flt";
         result.push_back(model_filename);
     }
 
+    for(auto feature : features)
+        delete feature;
     return result;
 }
 
 
 bool TextureExists(const std::string& filename)
 {
-    //you can iterate through all the files in an archive(using mz_zip_reader_get_num_files()) and retrieve detailed info on each file by calling mz_zip_reader_file_stat().
-
     auto parent_path = ccl::FileInfo(filename).getDirName();
     if(ccl::FileInfo(parent_path).getSuffix() == "zip")
     {
-        auto texture_filename = ccl::FileInfo(filename).getBaseName();
-        mz_zip_archive zip;
-        memset(&zip, 0, sizeof(zip));
-        //auto z = "D:/CDB/LosAngeles_CDB/Tiles/N34/W118/301_GSModelTexture/L06/U0/N34W118_D301_S001_T001_L06_U0_R1.zip";
-        //if(!mz_zip_reader_init_file(&zip, z, 0))
-        if(!mz_zip_reader_init_file(&zip, parent_path.c_str(), 0))
-            return false;
-        bool result = (mz_zip_reader_locate_file(&zip, texture_filename.c_str(), nullptr, 0) >= 0);
-        mz_zip_reader_end(&zip);
-        return result;
+        auto members = ZipArchiveMembers(parent_path);
+        return members && (members->count(ZipMemberKey(ccl::FileInfo(filename).getBaseName())) > 0);
     }
 
     return ccl::FileInfo::fileExists(filename);
@@ -534,15 +707,18 @@ bool TextureExists(const std::string& filename)
 
 bool BuildImageryTileBytesFromSampler(GDALRasterSampler& sampler, const TileInfo& tileinfo, std::vector<unsigned char>& bytes)
 {
+    COGNITICS_TRACE_SPAN("sample imagery");
     auto extents = gdalsampler::GeoExtents();
     std::tie(extents.north, extents.south, extents.east, extents.west) = NSEWBoundsForTileInfo(tileinfo);
     extents.width = TileDimensionForLod(tileinfo.lod);
     extents.height = extents.width;
+    COGNITICS_STATUS_COUNT("tiles sampled", 1);
     return sampler.Sample(extents, &bytes[0]);
 }
 
 bool BuildElevationTileFloatsFromSampler(GDALRasterSampler& sampler, const TileInfo& tileinfo, std::vector<float>& floats)
 {
+    COGNITICS_TRACE_SPAN("sample elevation");
     auto extents = gdalsampler::GeoExtents();
     std::tie(extents.north, extents.south, extents.east, extents.west) = NSEWBoundsForTileInfo(tileinfo);
     extents.width = TileDimensionForLod(tileinfo.lod);
@@ -553,11 +729,13 @@ bool BuildElevationTileFloatsFromSampler(GDALRasterSampler& sampler, const TileI
     extents.south -= (spacing_y * 0.5);
     extents.east -= (spacing_x * 0.5);
     extents.west -= (spacing_x * 0.5);
+    COGNITICS_STATUS_COUNT("tiles sampled", 1);
     return sampler.Sample(extents, &floats[0]);
 }
 
 bool BuildElevationTileFloatsFromSampler2(elev::Elevation_DSM& sampler, const TileInfo& tileinfo, std::vector<float>& floats)
 {
+    COGNITICS_TRACE_SPAN("sample elevation");
     auto extents = gdalsampler::GeoExtents();
     std::tie(extents.north, extents.south, extents.east, extents.west) = NSEWBoundsForTileInfo(tileinfo);
     extents.width = TileDimensionForLod(tileinfo.lod);
@@ -575,6 +753,7 @@ bool BuildElevationTileFloatsFromSampler2(elev::Elevation_DSM& sampler, const Ti
                 floats[(y * extents.width) + x] = point.Z();
         }
     }
+    COGNITICS_STATUS_COUNT("tiles sampled", 1);
     return true;
 }
 
@@ -680,11 +859,13 @@ RasterInfo ReadRasterInfo(const std::string& filename)
 
 std::vector<float> FloatsFromTIF(const std::string& filename)
 {
+    COGNITICS_TRACE_SPAN("decode tif");
     auto result = std::vector<float>();
 
     auto dataset = (GDALDataset*)GDALOpen(filename.c_str(), GA_ReadOnly);
     if(!dataset)
         return result;
+    COGNITICS_TRACE_COUNT("bytes read", ccl::getFileSize(filename));
 
     auto width = dataset->GetRasterXSize();
     auto height = dataset->GetRasterYSize();
@@ -699,6 +880,8 @@ std::vector<float> FloatsFromTIF(const std::string& filename)
 
     result.resize(width * height);
     auto discard = dataset->GetRasterBand(1)->RasterIO(GF_Read, 0, 0, width, height, (unsigned char*)&result[0], width, height, GDT_Float32, 0, 0);
+    COGNITICS_TRACE_COUNT("bytes decoded", result.size() * sizeof(float));
+    COGNITICS_STATUS_COUNT("tiles decoded", 1);
 
     GDALClose(dataset);
 
@@ -707,11 +890,13 @@ std::vector<float> FloatsFromTIF(const std::string& filename)
 
 std::vector<unsigned char> BytesFromJP2(const std::string& filename)
 {
+    COGNITICS_TRACE_SPAN("decode jp2");
     auto result = std::vector<unsigned char>();
 
     auto dataset = (GDALDataset*)GDALOpen(filename.c_str(), GA_ReadOnly);
     if(!dataset)
         return result;
+    COGNITICS_TRACE_COUNT("bytes read", ccl::getFileSize(filename));
 
     auto width = dataset->GetRasterXSize();
     auto height = dataset->GetRasterYSize();
@@ -728,6 +913,8 @@ std::vector<unsigned char> BytesFromJP2(const std::string& filename)
     auto discard1 = dataset->GetRasterBand(1)->RasterIO(GF_Read, 0, 0, width, height, (unsigned char*)&result[0], width, height, GDT_Byte, 3, width * 3);
     auto discard2 = dataset->GetRasterBand(2)->RasterIO(GF_Read, 0, 0, width, height, (unsigned char*)&result[1], width, height, GDT_Byte, 3, width * 3);
     auto discard3 = dataset->GetRasterBand(3)->RasterIO(GF_Read, 0, 0, width, height, (unsigned char*)&result[2], width, height, GDT_Byte, 3, width * 3);
+    COGNITICS_TRACE_COUNT("bytes decoded", result.size());
+    COGNITICS_STATUS_COUNT("tiles decoded", 1);
 
     GDALClose(dataset);
 
@@ -737,6 +924,7 @@ std::vector<unsigned char> BytesFromJP2(const std::string& filename)
 
 bool WriteBytesToJP2(const std::string& filename, const RasterInfo& rasterinfo, const std::vector<unsigned char>& bytes)
 {
+    COGNITICS_TRACE_SPAN("encode jp2");
     auto mem = GetGDALDriverManager()->GetDriverByName("MEM");
     if(mem == NULL)
         return false;
@@ -762,6 +950,8 @@ bool WriteBytesToJP2(const std::string& filename, const RasterInfo& rasterinfo,
 
     auto out_ds = jp2->CreateCopy(filename.c_str(), mem_ds, 1, NULL, NULL, NULL);
     GDALClose(out_ds);
+    COGNITICS_TRACE_COUNT("bytes encoded", bytes.size());
+    COGNITICS_STATUS_COUNT("tiles encoded", 1);
 
     GDALClose(mem_ds);
 
@@ -783,6 +973,7 @@ void WriteFloatsToText(const std::string& filename, const RasterInfo& rasterinfo
 
 bool WriteFloatsToTIF(const std::string& filename, const RasterInfo& rasterinfo, const std::vector<float>& floats)
 {
+    COGNITICS_TRACE_SPAN("encode tif");
     auto tif_driver = GetGDALDriverManager()->GetDriverByName("GTiff");
     if(tif_driver == NULL)
         return false;
@@ -805,6 +996,8 @@ bool WriteFloatsToTIF(const std::string& filename, const RasterInfo& rasterinfo,
     auto discard = tif_band->RasterIO(GF_Write, 0, 0, rasterinfo.Width, rasterinfo.Height, (float*)&floats[0], rasterinfo.Width, rasterinfo.Height, GDT_Float32, 0, 0);
 
     GDALClose(tif_ds);
+    COGNITICS_TRACE_COUNT("bytes encoded", floats.size() * sizeof(float));
+    COGNITICS_STATUS_COUNT("tiles encoded", 1);
 
     return true;
 }
@@ -1180,6 +1373,8 @@ bool InjectFeatures(const std::string& cdb, int dataset, int cs1, int cs2, int l
     log << "INJECT " << filename << " ((" << west << ", " << south << ") (" << east << ", " << north << ")) : " << tiles.size() << " tiles" << log.endl;
     for(auto tile : tiles)
     {
+        // envelopes and cropped geometry only live for this tile
+        ccl::ArenaScope scope(ccl::Arena::forThread());
         auto tile_info = TileInfoForTile(tile);
         double tile_north, tile_south, tile_east, tile_west;
         std::tie(tile_north, tile_south, tile_east, tile_west) = NSEWBoundsForTileInfo(tile_info);
@@ -1188,16 +1383,19 @@ bool InjectFeatures(const std::string& cdb, int dataset, int cs1, int cs2, int l
         {
             if(!feature->geometry)
                 continue;
-            auto envelope = std::make_unique<sfa::LineString>(dynamic_cast<sfa::LineString*>(feature->geometry->getEnvelope()));
-            auto point_min = envelope->getPointN(0);
-            auto point_max = envelope->getPointN(1);
-            if(point_min->Y() > tile_north)
+            std::unique_ptr<sfa::Geometry> envelope_geometry(feature->geometry->getEnvelope());
+            auto envelope = dynamic_cast<sfa::LineString*>(envelope_geometry.get());
+            if(!envelope)
+                continue;
+            auto point_min = envelope->getCoordinateN(0);
+            auto point_max = envelope->getCoordinateN(1);
+            if(point_min.Y() > tile_north)
                 continue;
-            if(point_min->X() > tile_east)
+            if(point_min.X() > tile_east)
                 continue;
-            if(point_max->Y() < tile_south)
+            if(point_max.Y() < tile_south)
                 continue;
-            if(point_max->X() < tile_west)
+            if(point_max.X() < tile_west)
                 continue;
             tile_features.push_back(feature);
         }
@@ -1215,17 +1413,17 @@ bool InjectFeatures(const std::string& cdb, int dataset, int cs1, int cs2, int l
                 return false;
             // TODO: create layer?
         }
+        auto cropped_features = std::vector<sfa::Feature*>();
         for(auto feature : tile_features)
         {
             // TODO: attribute handling
 
             auto new_features = FeaturesForTileCroppedFeature(tile_info, *feature);
-            for(auto new_feature : new_features)
-            {
-                delete file.addFeature(new_feature);
-                delete new_feature;
-            }
+            cropped_features.insert(cropped_features.end(), new_features.begin(), new_features.end());
         }
+        file.addFeatures(cropped_features);
+        for(auto new_feature : cropped_features)
+            delete new_feature;
         file.close();
     }
     if(!models_path.empty())
@@ -1255,11 +1453,11 @@ std::vector<sfa::Feature*> FeaturesForTileCroppedFeature(const TileInfo& tile_in
     double tile_north, tile_south, tile_east, tile_west;
     std::tie(tile_north, tile_south, tile_east, tile_west) = NSEWBoundsForTileInfo(tile_info);
     auto tile_ring = new sfa::LineString;
-    tile_ring->addPoint(new sfa::Point(tile_west, tile_south));
-    tile_ring->addPoint(new sfa::Point(tile_east, tile_south));
-    tile_ring->addPoint(new sfa::Point(tile_east, tile_north));
-    tile_ring->addPoint(new sfa::Point(tile_west, tile_north));
-    tile_ring->addPoint(new sfa::Point(tile_west, tile_south));
+    tile_ring->addPoint(sfa::Point(tile_west, tile_south));
+    tile_ring->addPoint(sfa::Point(tile_east, tile_south));
+    tile_ring->addPoint(sfa::Point(tile_east, tile_north));
+    tile_ring->addPoint(sfa::Point(tile_west, tile_north));
+    tile_ring->addPoint(sfa::Point(tile_west, tile_south));
     sfa::Polygon tile_aabb;
     tile_aabb.addRing(tile_ring);
     auto isect_geometry = tile_aabb.intersection(feature.geometry);
@@ -1286,104 +1484,137 @@ std::vector<sfa::Feature*> FeaturesForTileCroppedFeature(const TileInfo& tile_in
     return result;
 }
 
-void ReportMissingGSFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew)
+void ReportMissingGSFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew, int workers)
 {
     ccl::ObjLog log;
     auto tiles = FeatureTileInfoForTiledDataset(cdb, 100, nsew);
+    auto tile_models = std::vector<std::vector<std::string>>(tiles.size());
+    ParallelForRanges(tiles.size(), 1, workers, [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; ++i)
+            tile_models[i] = GSModelReferencesForTile(cdb, tiles[i], nsew);
+    });
+
     auto model_filenames = std::vector<std::string>();
-    for(auto tile : tiles)
+    for(size_t i = 0, c = tiles.size(); i < c; ++i)
     {
-        auto tile_models = GSModelReferencesForTile(cdb, tile, nsew);
-        if(tile_models.empty())
+        if(tile_models[i].empty())
             continue;
-        log << "GS TILE: " << FileNameForTileInfo(tile) << " (" << tile_models.size() << " model references)" << log.endl;
-        model_filenames.insert(model_filenames.end(), tile_models.begin(), tile_models.end());
-
-        if(model_filenames.size() > 10)
-            break;
+        log << "GS TILE: " << FileNameForTileInfo(tiles[i]) << " (" << tile_models[i].size() << " model references)" << log.endl;
+        model_filenames.insert(model_filenames.end(), tile_models[i].begin(), tile_models[i].end());
     }
+    tile_models.clear();
 
     std::sort(model_filenames.begin(), model_filenames.end());
     model_filenames.erase(std::unique(model_filenames.begin(), model_filenames.end()), model_filenames.end());
     log << model_filenames.size() << " models" << log.endl;
 
-    auto texture_filenames = std::vector<std::string>();
-    for(auto model_filename : model_filenames)
+    auto model_textures = TextureFileNamesForModels(model_filenames, workers);
+
+    // textures are either next to the model zip or members of the texture zip for the tile named by the texture
+    auto model_texture_filenames = std::vector<std::vector<std::string>>(model_filenames.size());
+    ParallelForRanges(model_filenames.size(), 256, workers, [&](size_t begin, size_t end)
     {
-        auto filenames = TextureFileNamesForModel(model_filename);
-        if(!filenames.first)
+        for(size_t i = begin; i < end; ++i)
         {
-            log << "MODEL MISSING: " << model_filename << log.endl;
-            continue;
-        }
-        for (auto filename : filenames.second)
-        {
-            auto fn = ccl::FileInfo(ccl::FileInfo(model_filename).getDirName()).getDirName() + "/" + filename;
-            if(ccl::fileExists(fn))
+            for(const auto& filename : model_textures[i].second)
             {
-                texture_filenames.push_back(fn);
-                continue;
+                auto fn = ccl::FileInfo(ccl::FileInfo(model_filenames[i]).getDirName()).getDirName() + "/" + filename;
+                if(ccl::fileExists(fn))
+                {
+                    model_texture_filenames[i].push_back(fn);
+                    continue;
+                }
+                auto base = ccl::FileInfo(fn).getBaseName();
+                auto tileinfo = TileInfoForFileName(base);
+                auto zipfn = ccl::FileInfo(fn).getDirName() + "/" + FileNameForTileInfo(tileinfo) + ".zip";
+                model_texture_filenames[i].push_back(zipfn + "/" + base);
             }
-            auto base = ccl::FileInfo(fn).getBaseName();
-            auto tileinfo = TileInfoForFileName(base);
-            auto zipfn = ccl::FileInfo(fn).getDirName() + "/" + FileNameForTileInfo(tileinfo) + ".zip";
-            texture_filenames.push_back(zipfn + "/" + base);
         }
+    });
+
+    auto texture_filenames = std::vector<std::string>();
+    for(size_t i = 0, c = model_filenames.size(); i < c; ++i)
+    {
+        if(!model_textures[i].first)
+        {
+            log << "MODEL MISSING: " << model_filenames[i] << log.endl;
+            continue;
+        }
+        texture_filenames.insert(texture_filenames.end(), model_texture_filenames[i].begin(), model_texture_filenames[i].end());
     }
 
     std::sort(texture_filenames.begin(), texture_filenames.end());
     texture_filenames.erase(std::unique(texture_filenames.begin(), texture_filenames.end()), texture_filenames.end());
     log << texture_filenames.size() << " textures" << log.endl;
 
-    for(auto texture_filename : texture_filenames)
+    // sorted names keep each texture zip within a few ranges, so most lookups hit a cached directory
+    auto missing = std::vector<char>(texture_filenames.size(), 0);
+    ParallelForRanges(texture_filenames.size(), 256, workers, [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; ++i)
+            missing[i] = TextureExists(texture_filenames[i]) ? 0 : 1;
+    });
+    for(size_t i = 0, c = texture_filenames.size(); i < c; ++i)
     {
-        if(!TextureExists(texture_filename))
-            log << "TEXTURE MISSING: " << texture_filename << log.endl;
+        if(missing[i])
+            log << "TEXTURE MISSING: " << texture_filenames[i] << log.endl;
     }
 }
 
-void ReportMissingGTFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew)
+void ReportMissingGTFeatureData(const std::string& cdb, std::tuple<double, double, double, double> nsew, int workers)
 {
     ccl::ObjLog log;
     auto tiles = FeatureTileInfoForTiledDataset(cdb, 101, nsew);
+    auto tile_models = std::vector<std::vector<std::string>>(tiles.size());
+    ParallelForRanges(tiles.size(), 1, workers, [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; ++i)
+            tile_models[i] = GTModelReferencesForTile(cdb, tiles[i], nsew);
+    });
+
     auto model_filenames = std::vector<std::string>();
-    for(auto tile : tiles)
+    for(size_t i = 0, c = tiles.size(); i < c; ++i)
     {
-        auto tile_models = GTModelReferencesForTile(cdb, tile, nsew);
-        if(tile_models.empty())
+        if(tile_models[i].empty())
             continue;
-        log << "GT TILE: " << FileNameForTileInfo(tile) << " (" << tile_models.size() << " model references)" << log.endl;
-        model_filenames.insert(model_filenames.end(), tile_models.begin(), tile_models.end());
+        log << "GT TILE: " << FileNameForTileInfo(tiles[i]) << " (" << tile_models[i].size() << " model references)" << log.endl;
+        model_filenames.insert(model_filenames.end(), tile_models[i].begin(), tile_models[i].end());
     }
+    tile_models.clear();
 
     std::sort(model_filenames.begin(), model_filenames.end());
     model_filenames.erase(std::unique(model_filenames.begin(), model_filenames.end()), model_filenames.end());
     log << model_filenames.size() << " models" << log.endl;
 
+    auto model_textures = TextureFileNamesForModels(model_filenames, workers);
+
     auto texture_filenames = std::vector<std::string>();
-    for(auto model_filename : model_filenames)
+    for(size_t i = 0, c = model_filenames.size(); i < c; ++i)
     {
-        auto filenames = TextureFileNamesForModel(model_filename);
-        if(!filenames.first)
+        if(!model_textures[i].first)
         {
-            log << "MODEL MISSING: " << model_filename << log.endl;
+            log << "MODEL MISSING: " << model_filenames[i] << log.endl;
             continue;
         }
-        for (auto filename : filenames.second)
-        {
-            auto fn = ccl::FileInfo(model_filename).getDirName() + "/" + filename;
-            texture_filenames.push_back(fn);
-        }
+        for(const auto& filename : model_textures[i].second)
+            texture_filenames.push_back(ccl::FileInfo(model_filenames[i]).getDirName() + "/" + filename);
     }
 
     std::sort(texture_filenames.begin(), texture_filenames.end());
     texture_filenames.erase(std::unique(texture_filenames.begin(), texture_filenames.end()), texture_filenames.end());
     log << texture_filenames.size() << " textures" << log.endl;
 
-    for(auto texture_filename : texture_filenames)
+    auto missing = std::vector<char>(texture_filenames.size(), 0);
+    ParallelForRanges(texture_filenames.size(), 256, workers, [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; ++i)
+            missing[i] = ccl::fileExists(texture_filenames[i]) ? 0 : 1;
+    });
+    for(size_t i = 0, c = texture_filenames.size(); i < c; ++i)
     {
-        if(!ccl::fileExists(texture_filename))
-            log << "TEXTURE MISSING: " << texture_filename << log.endl;
+        if(missing[i])
+            log << "TEXTURE MISSING: " << texture_filenames[i] << log.endl;
     }
 }
 
@@ -1408,15 +1639,12 @@ std::map<std::string, std::pair<std::string, std::string>> FACCandFSCbyMODLforFe
 
 std::string BytesFromFile(const std::string& filename)
 {
-    std::ifstream file(filename, std::ios::binary);
-    file.unsetf(std::ios::skipws);
-    file.seekg(0, std::ios::end);
-    auto len = file.tellg();
-    file.seekg(0, std::ios::beg);
-    std::string bytes;
-    bytes.reserve(len);
-    bytes.insert(bytes.begin(), std::istream_iterator<char>(file), std::istream_iterator<char>());
-    return bytes;
+    ccl::MappedFile file;
+    if(!file.open(filename) || (file.size() == 0))
+        return std::string();
+    file.advise(ccl::MappedFile::ACCESS_SEQUENTIAL);
+    COGNITICS_TRACE_COUNT("bytes read", file.size());
+    return std::string(reinterpret_cast<const char*>(file.data()), file.size());
 }
 
 void FileFromBytes(const std::string& filename, const std::string& bytes)
@@ -1464,14 +1692,16 @@ void InjectGTModels(const std::string& cdb, const std::vector<sfa::Feature*>& fe
         ccl::makeDirectory(outpath);
 
         auto bytes = BytesFromFile(infile);
-        auto is = std::istringstream(bytes);
-        ccl::BindStream bs(is);
+        ccl::ByteReader reader(bytes.data(), bytes.size());
+        ccl::BindStream bs(reader);
         while(bs.pos() < bytes.size())
         {
             ccl::BigEndian<ccl::uint16_t> opcode;
             ccl::BigEndian<ccl::uint16_t> length;
             bs.bind(opcode);
             bs.bind(length);
+            if(length < 4)
+                break;
             if(opcode == flt::Record::FLT_TEXTUREPALETTE)
             {
                 std::string texture_filename;
@@ -1535,8 +1765,7 @@ bool WriteFeaturesToOGRFile(const std::string& filename, const std::vector<sfa::
         if (!file.create(filename))
             return false;
     }
-    for (auto feature : features)
-        delete file.addFeature(feature);
+    file.addFeatures(features);
     file.close();
     return true;
 }
@@ -1570,14 +1799,14 @@ std::vector<sfa::Feature*> FeaturesForTileInfo(const std::string& cdb, const Til
         auto cnam = feature->attributes.getAttributeAsString("CNAM");
         if (class_map.find(cnam) != class_map.end())
         {
-            auto attributes = class_map[cnam].getVariantMap();
-            for (auto attr : *attributes)
+            const ccl::AttributeContainer& container = class_map[cnam];
+            for (auto attr : *container.getVariantMap())
                 feature->attributes.setAttribute(attr.first, attr.second);
         }
         if (ext_map.find(cnam) != ext_map.end())
         {
-            auto attributes = ext_map[cnam].getVariantMap();
-            for (auto attr : *attributes)
+            const ccl::AttributeContainer& container = ext_map[cnam];
+            for (auto attr : *container.getVariantMap())
                 feature->attributes.setAttribute(attr.first, attr.second);
         }
     }
@@ -27,6 +27,7 @@ DEALINGS IN THE SOFTWARE.
 #include "ctl/Vertex.h"
 #include "ctl/Edge.h"
 #include "ctl/Util.h"
+#include "ctl/IndexedPriorityQueue.h"
 #include <ccl/ObjLog.h>
 #include <algorithm>
 #include <typeinfo>
@@ -2026,6 +2027,9 @@ namespace ctl {
             edge = edge->Onext();
         }
 
+        if (total_area <= 0)
+            return 0;
+
     //    The base point and normal of the plane
         b_vector *= (1/total_area);
         n_vector *= (1/total_area);
@@ -2037,61 +2041,110 @@ namespace ctl {
         return 0;
     }
 
-#if 0
-    void DelaunayTriangulation::Simplify(int targetPoints, float threshold)
+    float DelaunayTriangulation::ComputeQuadricError(Vertex* vert) const
     {
-    //    Create space to hold errors
-        std::multimap<float, Vertex*> errors;
-
-    //    Compute initial error
-        for (int i=0; i<subdivision_->getMaxVerts(); i++)
+    //    Gather the ring of neighboring points around the Vertex
+        std::vector<Vector> ring;
+        Edge* edge = vert->getEdges();
+        Edge* end = edge;
+        do
         {
-            Vertex* vert = subdivision_->getVertex(i);
-            if (vert && !cmap_.IsVertexBound(vert))
-                errors.insert(std::pair<float, Vertex*>(ComputeVertexError(vert), vert));
-        }
+            ring.push_back(edge->Dest()->point);
+            edge = edge->Onext();
+        } while (edge != end);
+        if (ring.size() < 3)
+            return 0;
 
-    //    Main loop
-    //    Remove the necessary points
-        int pointsRemoved = 0;
-        int pointsToRemove = GetNumVertices() - targetPoints;
-        for (std::multimap<float, Vertex*>::iterator it = errors.begin(); it != errors.end(); it++)
-        {
-            if (pointsRemoved++ >= pointsToRemove)
-                return;
-            if (it->first > threshold)
-                return;
+        Vector centroid;
+        for (size_t i = 0, c = ring.size(); i < c; ++i)
+            centroid += ring[i];
+        centroid *= (1.0/ring.size());
 
-            RemoveVertex(it->second);
+    //    Accumulate the area weighted fundamental error quadric (symmetric 4x4) of the fan of triangles
+    //    spanning the ring. This approximates the surface that remains once the Vertex is removed.
+        double q[10] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        double total_area = 0;
+        for (size_t i = 0, c = ring.size(); i < c; ++i)
+        {
+            const Vector& p1 = ring[i];
+            const Vector& p2 = ring[(i + 1) % c];
+            Vector n = (p1 - centroid).cross(p2 - centroid);
+            double length = n.length();
+            if (length <= 0)
+                continue;
+            double a = 0.5 * length;
+            n *= (1/length);
+            double d = -n.dot(centroid);
+
+            q[0] += a*n.x*n.x; q[1] += a*n.x*n.y; q[2] += a*n.x*n.z; q[3] += a*n.x*d;
+            q[4] += a*n.y*n.y; q[5] += a*n.y*n.z; q[6] += a*n.y*d;
+            q[7] += a*n.z*n.z; q[8] += a*n.z*d;
+            q[9] += a*d*d;
+            total_area += a;
         }
+        if (total_area <= 0)
+            return 0;
+
+    //    Evaluate v^T Q v for the Vertex position
+        const Vector& v = vert->point;
+        double error = q[0]*v.x*v.x + 2*q[1]*v.x*v.y + 2*q[2]*v.x*v.z + 2*q[3]*v.x
+                     + q[4]*v.y*v.y + 2*q[5]*v.y*v.z + 2*q[6]*v.y
+                     + q[7]*v.z*v.z + 2*q[8]*v.z
+                     + q[9];
+        return float(sqrt(std::max(0.0, error / total_area)));
     }
-#else
-    void DelaunayTriangulation::Simplify(int targetFaces, float threshold)
+
+    float DelaunayTriangulation::ComputeVertexError(Vertex* vert, SimplifyMetric metric) const
     {
-    //    Create space to hold errors
-        std::multimap<float, Vertex*> errors;
+        if (metric == QUADRIC_ERROR)
+            return ComputeQuadricError(vert);
+        return ComputeVertexError(vert);
+    }
 
+    void DelaunayTriangulation::Simplify(int targetFaces, float threshold, SimplifyMetric metric)
+    {
     //    Compute initial error
+        IndexedPriorityQueue<float> errors(subdivision_->getMaxVerts());
         for (int i=0; i<subdivision_->getMaxVerts(); i++)
         {
             Vertex* vert = subdivision_->getVertex(i);
             if (vert && !cmap_.IsVertexBound(vert))
-                errors.insert(std::pair<float, Vertex*>(ComputeVertexError(vert), vert));
+                errors.push(vert->getID(), ComputeVertexError(vert, metric));
         }
 
     //    Main loop
-    //    Remove the necessary points
-        for (std::multimap<float, Vertex*>::iterator it = errors.begin(); it != errors.end(); it++)
+    //    Remove the lowest error point, then update the errors of its neighbors since their triangles have changed
+        std::vector<Vertex*> neighbors;
+        while (!errors.empty())
         {
             if (GetNumTriangles(true) < targetFaces)
                 return;
-            if (it->first > threshold)
+            if (errors.topPriority() > threshold)
                 return;
 
-            RemoveVertex(it->second);
+            Vertex* vert = subdivision_->getVertex(errors.pop());
+            if (!vert)
+                continue;
+
+            neighbors.clear();
+            Edge* edge = vert->getEdges();
+            Edge* end = edge;
+            do
+            {
+                neighbors.push_back(edge->Dest());
+                edge = edge->Onext();
+            } while (edge != end);
+
+            RemoveVertex(vert);
+
+            for (size_t i = 0, c = neighbors.size(); i < c; ++i)
+            {
+                Vertex* neighbor = neighbors[i];
+                if (errors.contains(neighbor->getID()))
+                    errors.update(neighbor->getID(), ComputeVertexError(neighbor, metric));
+            }
         }
     }
-#endif
 
 
 
@@ -21,90 +21,711 @@ DEALINGS IN THE SOFTWARE.
 ****************************************************************************/
 #include "ctl/QTriangulate.h"
 #include "ctl/Util.h"
+#include <algorithm>
+#include <deque>
+#include <float.h>
+#include <math.h>
 
 namespace ctl {
 
-    bool QTriangulate::snip(PointList contour, int u, int v, int w, int n, const std::vector<int>& V, const Point& normal)
+    namespace
     {
-        Point A = contour[V[u]];
-        Point B = contour[V[v]];
-        Point C = contour[V[w]];
+        /*
+            Ear clipping on a circular doubly linked list of projected vertices. Vertices are additionally
+            linked in z-order (Morton code) so that the "no vertex inside this ear" test only visits the
+            vertices whose codes fall inside the ear's bounding box instead of every remaining vertex.
+            Holes are bridged into the outer ring before clipping. Based on the approach used by mapbox/earcut.
+        */
+        struct EarNode
+        {
+            size_t i;                   // index into the source point list
+            double x;
+            double y;
+            EarNode *prev;
+            EarNode *next;
+            int z;                      // z-order curve value
+            EarNode *prevZ;
+            EarNode *nextZ;
+            bool steiner;
 
-        if ( (B-A).cross(C-A).dot(normal) < 1e-10 )
-            return false;
-        //TArea3D(A,B,C) < 1e-10) return false;
+            EarNode(size_t i, double x, double y) : i(i), x(x), y(y), prev(NULL), next(NULL), z(0), prevZ(NULL), nextZ(NULL), steiner(false) { }
+        };
 
-        for (int p = 0; p < n; p++)
+        class EarClipper
         {
-            if ( (p==u) || (p==v) || (p==w) ) continue;
-            Point P = contour[V[p]];
+        public:
+            std::deque<EarNode> nodes;
+            std::vector<size_t> triangles;
+            bool hashing;
+            double minX;
+            double minY;
+            double invSize;
+
+            EarClipper(void) : hashing(false), minX(0), minY(0), invSize(0) { }
+
+            EarNode *insertNode(size_t i, double x, double y, EarNode *last)
+            {
+                nodes.push_back(EarNode(i, x, y));
+                EarNode *p = &nodes.back();
+                if (!last)
+                {
+                    p->prev = p;
+                    p->next = p;
+                }
+                else
+                {
+                    p->next = last->next;
+                    p->prev = last;
+                    last->next->prev = p;
+                    last->next = p;
+                }
+                return p;
+            }
+
+            static void removeNode(EarNode *p)
+            {
+                p->next->prev = p->prev;
+                p->prev->next = p->next;
+                if (p->prevZ)
+                    p->prevZ->nextZ = p->nextZ;
+                if (p->nextZ)
+                    p->nextZ->prevZ = p->prevZ;
+            }
+
+            static double area(const EarNode *p, const EarNode *q, const EarNode *r)
+            {
+                return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+            }
+
+            static bool equals(const EarNode *a, const EarNode *b)
+            {
+                return (a->x == b->x) && (a->y == b->y);
+            }
+
+            static int sign(double v)
+            {
+                return (v > 0) - (v < 0);
+            }
 
-            Vector v0 = C - A;
-            Vector v1 = B - A;
-            Vector v2 = P - A;
+            static bool pointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+            {
+                return ((cx - px) * (ay - py) >= (ax - px) * (cy - py))
+                    && ((ax - px) * (by - py) >= (bx - px) * (ay - py))
+                    && ((bx - px) * (cy - py) >= (cx - px) * (by - py));
+            }
 
-            double dot00 = v0 * v0;
-            double dot01 = v0 * v1;
-            double dot02 = v0 * v2;
-            double dot11 = v1 * v1;
-            double dot12 = v1 * v2;
+            static bool onSegment(const EarNode *p, const EarNode *q, const EarNode *r)
+            {
+                return (q->x <= std::max(p->x, r->x)) && (q->x >= std::min(p->x, r->x)) && (q->y <= std::max(p->y, r->y)) && (q->y >= std::min(p->y, r->y));
+            }
 
-            double invDenom = 1.0/ (dot00 * dot11 - dot01 * dot01);
-            double u = (dot11 * dot02 - dot01 * dot12) * invDenom;
-            double v = (dot00 * dot12 - dot01 * dot02) * invDenom;
+            static bool intersects(const EarNode *p1, const EarNode *q1, const EarNode *p2, const EarNode *q2)
+            {
+                int o1 = sign(area(p1, q1, p2));
+                int o2 = sign(area(p1, q1, q2));
+                int o3 = sign(area(p2, q2, p1));
+                int o4 = sign(area(p2, q2, q1));
+                if ((o1 != o2) && (o3 != o4))
+                    return true;
+                if ((o1 == 0) && onSegment(p1, p2, q1))
+                    return true;
+                if ((o2 == 0) && onSegment(p1, q2, q1))
+                    return true;
+                if ((o3 == 0) && onSegment(p2, p1, q2))
+                    return true;
+                if ((o4 == 0) && onSegment(p2, q1, q2))
+                    return true;
+                return false;
+            }
 
-            if ((u >= 0) && (v >= 0) && (u + v <= 1))
+            static bool intersectsPolygon(const EarNode *a, const EarNode *b)
+            {
+                const EarNode *p = a;
+                do
+                {
+                    if ((p->i != a->i) && (p->next->i != a->i) && (p->i != b->i) && (p->next->i != b->i) && intersects(p, p->next, a, b))
+                        return true;
+                    p = p->next;
+                } while (p != a);
                 return false;
-        }
+            }
+
+            static bool locallyInside(const EarNode *a, const EarNode *b)
+            {
+                if (area(a->prev, a, a->next) < 0)
+                    return (area(a, b, a->next) >= 0) && (area(a, a->prev, b) >= 0);
+                return (area(a, b, a->prev) < 0) || (area(a, a->next, b) < 0);
+            }
+
+            static bool middleInside(const EarNode *a, const EarNode *b)
+            {
+                const EarNode *p = a;
+                bool inside = false;
+                double px = (a->x + b->x) / 2;
+                double py = (a->y + b->y) / 2;
+                do
+                {
+                    if (((p->y > py) != (p->next->y > py)) && (p->next->y != p->y) && (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x))
+                        inside = !inside;
+                    p = p->next;
+                } while (p != a);
+                return inside;
+            }
+
+            static bool isValidDiagonal(const EarNode *a, const EarNode *b)
+            {
+                return (a->next->i != b->i) && (a->prev->i != b->i) && !intersectsPolygon(a, b)
+                    && ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b) && ((area(a->prev, a, b->prev) != 0) || (area(a, b->prev, b) != 0)))
+                        || (equals(a, b) && (area(a->prev, a, a->next) > 0) && (area(b->prev, b, b->next) > 0)));
+            }
+
+            // link the ring into a list with the requested winding (clockwise in earcut's y-down sense, CCW here)
+            EarNode *linkedList(const std::vector<Vector> &points, size_t start, size_t end, bool clockwise)
+            {
+                double sum = 0;
+                for (size_t i = start, j = end - 1; i < end; j = i++)
+                    sum += (points[j].x - points[i].x) * (points[i].y + points[j].y);
+
+                EarNode *last = NULL;
+                if (clockwise == (sum > 0))
+                {
+                    for (size_t i = start; i < end; ++i)
+                        last = insertNode(i, points[i].x, points[i].y, last);
+                }
+                else
+                {
+                    for (size_t i = end; i-- > start; )
+                        last = insertNode(i, points[i].x, points[i].y, last);
+                }
+                if (last && equals(last, last->next))
+                {
+                    removeNode(last);
+                    last = last->next;
+                }
+                return last;
+            }
+
+            // remove duplicate and collinear points
+            EarNode *filterPoints(EarNode *start, EarNode *end = NULL)
+            {
+                if (!start)
+                    return start;
+                if (!end)
+                    end = start;
+
+                EarNode *p = start;
+                bool again;
+                do
+                {
+                    again = false;
+                    if (!p->steiner && (equals(p, p->next) || (area(p->prev, p, p->next) == 0)))
+                    {
+                        removeNode(p);
+                        p = end = p->prev;
+                        if (p == p->next)
+                            break;
+                        again = true;
+                    }
+                    else
+                        p = p->next;
+                } while (again || (p != end));
+                return end;
+            }
+
+            int zOrder(double x, double y) const
+            {
+                unsigned int ux = (unsigned int)((x - minX) * invSize);
+                unsigned int uy = (unsigned int)((y - minY) * invSize);
+
+                ux = (ux | (ux << 8)) & 0x00FF00FF;
+                ux = (ux | (ux << 4)) & 0x0F0F0F0F;
+                ux = (ux | (ux << 2)) & 0x33333333;
+                ux = (ux | (ux << 1)) & 0x55555555;
+
+                uy = (uy | (uy << 8)) & 0x00FF00FF;
+                uy = (uy | (uy << 4)) & 0x0F0F0F0F;
+                uy = (uy | (uy << 2)) & 0x33333333;
+                uy = (uy | (uy << 1)) & 0x55555555;
+
+                return int(ux | (uy << 1));
+            }
+
+            // simon tatham's linked list merge sort
+            static void sortLinked(EarNode *list)
+            {
+                int inSize = 1;
+                int numMerges;
+                do
+                {
+                    EarNode *p = list;
+                    EarNode *tail = NULL;
+                    list = NULL;
+                    numMerges = 0;
+                    while (p)
+                    {
+                        ++numMerges;
+                        EarNode *q = p;
+                        int pSize = 0;
+                        for (int i = 0; i < inSize; ++i)
+                        {
+                            ++pSize;
+                            q = q->nextZ;
+                            if (!q)
+                                break;
+                        }
+                        int qSize = inSize;
+                        while ((pSize > 0) || ((qSize > 0) && q))
+                        {
+                            EarNode *e;
+                            if ((pSize != 0) && ((qSize == 0) || !q || (p->z <= q->z)))
+                            {
+                                e = p;
+                                p = p->nextZ;
+                                --pSize;
+                            }
+                            else
+                            {
+                                e = q;
+                                q = q->nextZ;
+                                --qSize;
+                            }
+                            if (tail)
+                                tail->nextZ = e;
+                            else
+                                list = e;
+                            e->prevZ = tail;
+                            tail = e;
+                        }
+                        p = q;
+                    }
+                    tail->nextZ = NULL;
+                    inSize *= 2;
+                } while (numMerges > 1);
+            }
+
+            void indexCurve(EarNode *start)
+            {
+                EarNode *p = start;
+                do
+                {
+                    if (p->z == 0)
+                        p->z = zOrder(p->x, p->y);
+                    p->prevZ = p->prev;
+                    p->nextZ = p->next;
+                    p = p->next;
+                } while (p != start);
+                p->prevZ->nextZ = NULL;
+                p->prevZ = NULL;
+                sortLinked(p);
+            }
+
+            static bool isEar(const EarNode *ear)
+            {
+                const EarNode *a = ear->prev;
+                const EarNode *b = ear;
+                const EarNode *c = ear->next;
+                if (area(a, b, c) >= 0)
+                    return false;
+
+                const EarNode *p = ear->next->next;
+                while (p != ear->prev)
+                {
+                    if (pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && (area(p->prev, p, p->next) >= 0))
+                        return false;
+                    p = p->next;
+                }
+                return true;
+            }
+
+            bool isEarHashed(const EarNode *ear) const
+            {
+                const EarNode *a = ear->prev;
+                const EarNode *b = ear;
+                const EarNode *c = ear->next;
+                if (area(a, b, c) >= 0)
+                    return false;
+
+                double minTX = std::min(a->x, std::min(b->x, c->x));
+                double minTY = std::min(a->y, std::min(b->y, c->y));
+                double maxTX = std::max(a->x, std::max(b->x, c->x));
+                double maxTY = std::max(a->y, std::max(b->y, c->y));
+                int minZ = zOrder(minTX, minTY);
+                int maxZ = zOrder(maxTX, maxTY);
+
+                // look for points inside the triangle in both directions of the z-order curve
+                const EarNode *p = ear->prevZ;
+                const EarNode *n = ear->nextZ;
+                while (p && (p->z >= minZ) && n && (n->z <= maxZ))
+                {
+                    if ((p != ear->prev) && (p != ear->next) && pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && (area(p->prev, p, p->next) >= 0))
+                        return false;
+                    p = p->prevZ;
+                    if ((n != ear->prev) && (n != ear->next) && pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, n->x, n->y) && (area(n->prev, n, n->next) >= 0))
+                        return false;
+                    n = n->nextZ;
+                }
+                while (p && (p->z >= minZ))
+                {
+                    if ((p != ear->prev) && (p != ear->next) && pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && (area(p->prev, p, p->next) >= 0))
+                        return false;
+                    p = p->prevZ;
+                }
+                while (n && (n->z <= maxZ))
+                {
+                    if ((n != ear->prev) && (n != ear->next) && pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, n->x, n->y) && (area(n->prev, n, n->next) >= 0))
+                        return false;
+                    n = n->nextZ;
+                }
+                return true;
+            }
+
+            void addTriangle(const EarNode *a, const EarNode *b, const EarNode *c)
+            {
+                triangles.push_back(a->i);
+                triangles.push_back(b->i);
+                triangles.push_back(c->i);
+            }
 
-        return true;
+            // go through all polygon nodes and cure small local self-intersections
+            EarNode *cureLocalIntersections(EarNode *start)
+            {
+                EarNode *p = start;
+                do
+                {
+                    EarNode *a = p->prev;
+                    EarNode *b = p->next->next;
+                    if (!equals(a, b) && intersects(a, p, p->next, b) && locallyInside(a, b) && locallyInside(b, a))
+                    {
+                        addTriangle(a, p, b);
+                        removeNode(p);
+                        removeNode(p->next);
+                        p = start = b;
+                    }
+                    p = p->next;
+                } while (p != start);
+                return filterPoints(p);
+            }
+
+            // link two polygon vertices with a bridge; if the vertices belong to the same ring it splits the polygon into two
+            EarNode *splitPolygon(EarNode *a, EarNode *b)
+            {
+                nodes.push_back(EarNode(a->i, a->x, a->y));
+                EarNode *a2 = &nodes.back();
+                nodes.push_back(EarNode(b->i, b->x, b->y));
+                EarNode *b2 = &nodes.back();
+                EarNode *an = a->next;
+                EarNode *bp = b->prev;
+
+                a->next = b;
+                b->prev = a;
+
+                a2->next = an;
+                an->prev = a2;
+
+                b2->next = a2;
+                a2->prev = b2;
+
+                bp->next = b2;
+                b2->prev = bp;
+
+                return b2;
+            }
+
+            // try splitting the polygon into two and triangulate them independently
+            void splitEarcut(EarNode *start)
+            {
+                EarNode *a = start;
+                do
+                {
+                    EarNode *b = a->next->next;
+                    while (b != a->prev)
+                    {
+                        if ((a->i != b->i) && isValidDiagonal(a, b))
+                        {
+                            EarNode *c = splitPolygon(a, b);
+                            a = filterPoints(a, a->next);
+                            c = filterPoints(c, c->next);
+                            earcutLinked(a, 0);
+                            earcutLinked(c, 0);
+                            return;
+                        }
+                        b = b->next;
+                    }
+                    a = a->next;
+                } while (a != start);
+            }
+
+            void earcutLinked(EarNode *ear, int pass)
+            {
+                if (!ear)
+                    return;
+                if (!pass && hashing)
+                    indexCurve(ear);
+
+                EarNode *stop = ear;
+                while (ear->prev != ear->next)
+                {
+                    EarNode *prev = ear->prev;
+                    EarNode *next = ear->next;
+                    if (hashing ? isEarHashed(ear) : isEar(ear))
+                    {
+                        addTriangle(prev, ear, next);
+                        removeNode(ear);
+                        // skipping the next vertex leads to less sliver triangles
+                        ear = next->next;
+                        stop = next->next;
+                        continue;
+                    }
+
+                    ear = next;
+                    if (ear == stop)
+                    {
+                        // no ears found: try filtering points, then curing local self-intersections, then splitting
+                        if (!pass)
+                            earcutLinked(filterPoints(ear), 1);
+                        else if (pass == 1)
+                        {
+                            ear = cureLocalIntersections(filterPoints(ear));
+                            earcutLinked(ear, 2);
+                        }
+                        else if (pass == 2)
+                            splitEarcut(ear);
+                        break;
+                    }
+                }
+            }
+
+            static EarNode *getLeftmost(EarNode *start)
+            {
+                EarNode *p = start;
+                EarNode *leftmost = start;
+                do
+                {
+                    if ((p->x < leftmost->x) || ((p->x == leftmost->x) && (p->y < leftmost->y)))
+                        leftmost = p;
+                    p = p->next;
+                } while (p != start);
+                return leftmost;
+            }
+
+            static bool sectorContainsSector(const EarNode *m, const EarNode *p)
+            {
+                return (area(m->prev, m, p->prev) < 0) && (area(p->next, m, m->next) < 0);
+            }
+
+            // David Eberly's algorithm for finding a bridge between a hole and the outer polygon
+            static EarNode *findHoleBridge(EarNode *hole, EarNode *outerNode)
+            {
+                EarNode *p = outerNode;
+                double hx = hole->x;
+                double hy = hole->y;
+                double qx = -DBL_MAX;
+                EarNode *m = NULL;
+
+                // find a segment intersected by a ray from the hole's leftmost point to the left
+                do
+                {
+                    if ((hy <= p->y) && (hy >= p->next->y) && (p->next->y != p->y))
+                    {
+                        double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+                        if ((x <= hx) && (x > qx))
+                        {
+                            qx = x;
+                            m = (p->x < p->next->x) ? p : p->next;
+                            if (x == hx)
+                                return m;   // hole touches outer segment; pick leftmost endpoint
+                        }
+                    }
+                    p = p->next;
+                } while (p != outerNode);
+
+                if (!m)
+                    return NULL;
+
+                // look for points inside the triangle of hole point, segment intersection and endpoint;
+                // if there are none, the endpoint is the connection point, otherwise use the point with the minimum angle
+                const EarNode *stop = m;
+                double mx = m->x;
+                double my = m->y;
+                double tanMin = DBL_MAX;
+                p = m;
+                do
+                {
+                    if ((hx >= p->x) && (p->x >= mx) && (hx != p->x) && pointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+                    {
+                        double tanCur = fabs(hy - p->y) / (hx - p->x);
+                        if (locallyInside(p, hole) && ((tanCur < tanMin) || ((tanCur == tanMin) && ((p->x > m->x) || ((p->x == m->x) && sectorContainsSector(m, p))))))
+                        {
+                            m = p;
+                            tanMin = tanCur;
+                        }
+                    }
+                    p = p->next;
+                } while (p != stop);
+
+                return m;
+            }
+
+            EarNode *eliminateHole(EarNode *hole, EarNode *outerNode)
+            {
+                EarNode *bridge = findHoleBridge(hole, outerNode);
+                if (!bridge)
+                    return outerNode;
+
+                EarNode *bridgeReverse = splitPolygon(bridge, hole);
+
+                // filter collinear points around the cuts
+                filterPoints(bridgeReverse, bridgeReverse->next);
+                return filterPoints(bridge, bridge->next);
+            }
+
+            static bool compareX(const EarNode *a, const EarNode *b)
+            {
+                return a->x < b->x;
+            }
+
+            EarNode *eliminateHoles(const std::vector<Vector> &points, const std::vector<size_t> &holeStarts, EarNode *outerNode)
+            {
+                std::vector<EarNode *> queue;
+                for (size_t i = 0, c = holeStarts.size(); i < c; ++i)
+                {
+                    size_t start = holeStarts[i];
+                    size_t end = (i + 1 < c) ? holeStarts[i + 1] : points.size();
+                    EarNode *list = linkedList(points, start, end, false);
+                    if (!list)
+                        continue;
+                    if (list == list->next)
+                        list->steiner = true;
+                    queue.push_back(getLeftmost(list));
+                }
+                std::sort(queue.begin(), queue.end(), compareX);
+
+                // process holes from left to right
+                for (size_t i = 0, c = queue.size(); i < c; ++i)
+                    outerNode = eliminateHole(queue[i], outerNode);
+                return outerNode;
+            }
+
+            void apply(const std::vector<Vector> &points, const std::vector<size_t> &holeStarts)
+            {
+                size_t outerLen = holeStarts.empty() ? points.size() : holeStarts.front();
+                EarNode *outerNode = linkedList(points, 0, outerLen, true);
+                if (!outerNode || (outerNode->next == outerNode->prev))
+                    return;
+
+                if (!holeStarts.empty())
+                    outerNode = eliminateHoles(points, holeStarts, outerNode);
+
+                // if the shape is not too simple, use z-order curve hash later; calculate polygon bbox
+                if (points.size() > 80)
+                {
+                    hashing = true;
+                    minX = DBL_MAX;
+                    minY = DBL_MAX;
+                    double maxX = -DBL_MAX;
+                    double maxY = -DBL_MAX;
+                    for (size_t i = 0; i < outerLen; ++i)
+                    {
+                        minX = std::min(minX, points[i].x);
+                        minY = std::min(minY, points[i].y);
+                        maxX = std::max(maxX, points[i].x);
+                        maxY = std::max(maxY, points[i].y);
+                    }
+                    // minX, minY and invSize are later used to transform coords into integers for z-order calculation
+                    invSize = std::max(maxX - minX, maxY - minY);
+                    invSize = (invSize != 0) ? (32767 / invSize) : 0;
+                }
+
+                earcutLinked(outerNode, 0);
+            }
+        };
+
+        Point NewellNormal(const PointList &contour)
+        {
+            Point normal;
+            for (size_t i = 0, n = contour.size(); i < n; i++)
+            {
+                const Point &v0 = contour[i];
+                const Point &v1 = contour[(i+1)%n];
+                normal[0] += (v0.y - v1.y)*(v0.z + v1.z);
+                normal[1] += (v0.z - v1.z)*(v0.x + v1.x);
+                normal[2] += (v0.x - v1.x)*(v0.y + v1.y);
+            }
+            return normal;
+        }
     }
 
     PointList QTriangulate::apply(PointList contour)
     {
-        int n = int(contour.size());
-        if (n < 3) return PointList();
+        return apply(contour, std::vector<PointList>());
+    }
 
-        PointList result;
-        std::vector<int> V(n);
+    PointList QTriangulate::apply(const PointList& contour, const std::vector<PointList>& holes)
+    {
+        if (contour.size() < 3)
+            return PointList();
 
-        Point normal;
-        for (int i = 0; i < n; i++)
+    //    Project onto the plane of the dominant axis of the contour normal (keeping the rotation order so
+    //    the projected winding follows the normal)
+        Point normal = NewellNormal(contour);
+        double ax = fabs(normal.x);
+        double ay = fabs(normal.y);
+        double az = fabs(normal.z);
+        if ((ax == 0) && (ay == 0) && (az == 0))
+            return PointList();
+        int u = 0;
+        int v = 1;
+        if ((ax > ay) && (ax > az))
+        {
+            u = 1;
+            v = 2;
+        }
+        else if (ay > az)
         {
-            Point v0 = contour[i];
-            Point v1 = contour[(i+1)%n];
-            normal[0] += (v0.y - v1.y)*(v0.z + v1.z);
-            normal[1] += (v0.z - v1.z)*(v0.x + v1.x);
-            normal[2] += (v0.x - v1.x)*(v0.y + v1.y);
+            u = 2;
+            v = 0;
         }
 
-        for (int v = 0; v < n; v++) V[v] = v;
+        PointList source(contour);
+        std::vector<size_t> holeStarts;
+        for (size_t i = 0, c = holes.size(); i < c; ++i)
+        {
+            if (holes[i].size() < 3)
+                continue;
+            holeStarts.push_back(source.size());
+            source.insert(source.end(), holes[i].begin(), holes[i].end());
+        }
 
-        int nv = n;
-        int count = 2*nv;
+        std::vector<Vector> projected(source.size());
+        for (size_t i = 0, c = source.size(); i < c; ++i)
+            projected[i] = Vector(source[i][u], source[i][v], 0);
 
-        for (int v = nv-1; nv>2;)
-        {
-            if (0 >= (count--))    //    Bad polygon
-                return PointList();
+        EarClipper clipper;
+        clipper.apply(projected, holeStarts);
 
-            int u = v; if (nv <= u) u = 0;
-            v = u+1; if (nv <= v) v = 0;
-            int w = v+1; if (nv <= w) w = 0;
+    //    Triangles are produced counter-clockwise in the projected plane; match the winding of the contour
+        double sum = 0;
+        for (size_t i = 0, j = contour.size() - 1, c = contour.size(); i < c; j = i++)
+            sum += (projected[j].x - projected[i].x) * (projected[i].y + projected[j].y);
+        bool reverse = (sum < 0);
 
-            if (snip(contour,u,v,w,nv,V,normal))
+        PointList result;
+        result.reserve(clipper.triangles.size());
+        for (size_t i = 0, c = clipper.triangles.size(); i + 2 < c; i += 3)
+        {
+            result.push_back(source[clipper.triangles[i]]);
+            if (reverse)
+            {
+                result.push_back(source[clipper.triangles[i + 2]]);
+                result.push_back(source[clipper.triangles[i + 1]]);
+            }
+            else
             {
-                result.push_back(contour[V[u]]);
-                result.push_back(contour[V[v]]);
-                result.push_back(contour[V[w]]);
-                for (int s = v, t=v+1; t<nv; s++, t++) 
-                    V[s] = V[t]; 
-                nv--;
-                count = 2*nv;
+                result.push_back(source[clipper.triangles[i + 1]]);
+                result.push_back(source[clipper.triangles[i + 2]]);
             }
         }
-
         return result;
     }
 
-}
\ No newline at end of file
+}
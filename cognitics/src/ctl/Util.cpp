@@ -116,15 +116,15 @@ namespace ctl {
 /******************************************************************************************************
     POLYGON OPERATIONS
 *******************************************************************************************************/
-    bool PointInPolygon(Point p, PointList polygon, double epsilon)
+    bool PointInPolygon(const Point& p, const PointList& polygon, double epsilon)
     {
         int Rcross = 0;
         int Lcross = 0;
 
         for (unsigned int i = 1; i < polygon.size(); i++)
         {
-            Point p1 = polygon[i-1];
-            Point p2 = polygon[i];
+            const Point& p1 = polygon[i-1];
+            const Point& p2 = polygon[i];
 
             if ( p.x == p1.x && p.y == p1.y) return true;
 
@@ -33,14 +33,14 @@ DBaseColDef::DBaseColDef(std::string& oneColumn) {
 
     // Displacement of field in record
     for(unsigned int k = 12; k <=15; k++) {
-        m_fieldDisplacement += (oneColumn.at(k) << (8*(k-12)));
+        m_fieldDisplacement += ((unsigned char)oneColumn.at(k) << (8*(k-12)));
     }
 
-    // Length of field in bytes
-    m_fieldLength = (int)oneColumn.at(16);
+    // Length of field in bytes (up to 254, so read unsigned)
+    m_fieldLength = (unsigned char)oneColumn.at(16);
 
     // Number of decimal places
-    m_fieldDecCount = (int)oneColumn.at(17);
+    m_fieldDecCount = (unsigned char)oneColumn.at(17);
 
     // Parse field flags
     switch(oneColumn.at(18)) {
@@ -55,7 +55,7 @@ DBaseColDef::DBaseColDef(std::string& oneColumn) {
     if(m_fieldFlag == DBaseFieldFlag::AutoIncrementColumn) {
 
         for(unsigned int k = 19; k <=22; k++) {
-            m_autoIncrementNext += (oneColumn.at(k) << (8*(k-19)));
+            m_autoIncrementNext += ((unsigned char)oneColumn.at(k) << (8*(k-19)));
         }
 
         m_autoIncrementStep = oneColumn.at(23);
@@ -0,0 +1,214 @@
+#include "dbflib/DBaseTable.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const size_t FILE_HEADER_LENGTH = 32;
+const size_t COLUMN_DEFINITION_LENGTH = 32;
+
+unsigned long long readLittleEndian(const char* data, size_t bytes) {
+    unsigned long long value = 0;
+    for(size_t i = 0; i < bytes; ++i) {
+        value |= (unsigned long long)(unsigned char)data[i] << (8 * i);
+    }
+    return value;
+}
+
+bool isPadding(char c) {
+    return (c == '\0') || std::isspace((unsigned char)c);
+}
+
+/**< Copies a trimmed ASCII field so it can be passed to strtod/strtoll */
+std::string asciiField(const DBaseCell& cell) {
+    return cell.trimmed().str();
+}
+
+}
+
+DBaseCell DBaseCell::trimmed() const {
+    size_t begin = 0;
+    size_t end = m_length;
+    while((begin < end) && isPadding(m_data[begin])) { ++begin; }
+    while((end > begin) && isPadding(m_data[end - 1])) { --end; }
+    return DBaseCell(m_data + begin, end - begin);
+}
+
+bool DBaseCell::operator==(const DBaseCell& other) const {
+    return (m_length == other.m_length) && (std::memcmp(m_data, other.m_data, m_length) == 0);
+}
+
+///FNV-1a over the field bytes
+size_t DBaseCellHash::operator()(const DBaseCell& cell) const {
+    unsigned long long hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < cell.m_length; ++i) {
+        hash ^= (unsigned char)cell.m_data[i];
+        hash *= 1099511628211ULL;
+    }
+    return size_t(hash);
+}
+
+size_t DBaseColumn::size() const {
+    return m_table->numRecords();
+}
+
+const DBaseColDef& DBaseColumn::definition() const {
+    return m_table->m_colDef.at(m_column);
+}
+
+DBaseCell DBaseColumn::cell(size_t record) const {
+    return m_table->cell(record, m_column);
+}
+
+std::string DBaseColumn::getString(size_t record) const {
+    return m_table->getString(record, m_column);
+}
+
+double DBaseColumn::getDouble(size_t record, double defaultValue) const {
+    return m_table->getDouble(record, m_column, defaultValue);
+}
+
+long long DBaseColumn::getInteger(size_t record, long long defaultValue) const {
+    return m_table->getInteger(record, m_column, defaultValue);
+}
+
+DBaseTable::DBaseTable() {
+}
+
+DBaseTable::~DBaseTable() {
+}
+
+/** \brief Maps the given file and reads its structure.
+ *  \param Name of the dBase file
+ *  \return True if succeded. Otherwise throws exception
+ */
+bool DBaseTable::openFile(const std::string& fileName) {
+    close();
+    if(!m_file.open(fileName)) { throw fileNotFoundEx(); }
+    const char* data = reinterpret_cast<const char*>(m_file.data());
+    size_t size = m_file.size();
+    if(size < FILE_HEADER_LENGTH + 1) { throw unexpectedHeaderEndEx("File is empty", (unsigned int)size); }
+
+    //BYTE 4-7 number of records, 8-9 header length, 10-11 record length
+    size_t numRecordsInDB = (size_t)readLittleEndian(data + 4, 4);
+    size_t headerLength = (size_t)readLittleEndian(data + 8, 2);
+    m_recordLength = (size_t)readLittleEndian(data + 10, 2);
+    if((headerLength > size) || (m_recordLength == 0)) { throw unexpectedHeaderEndEx("Header is truncated"); }
+
+    //column definitions run up to the 0x0D terminator (Visual FoxPro puts a backlink after it)
+    size_t recordOffset = 1;
+    for(size_t pos = FILE_HEADER_LENGTH; (pos < headerLength) && (data[pos] != 0x0D); pos += COLUMN_DEFINITION_LENGTH) {
+        if(pos + COLUMN_DEFINITION_LENGTH > headerLength) { throw unexpectedHeaderEndEx("Header has an unknown number of columns"); }
+        std::string colDefStr(data + pos, COLUMN_DEFINITION_LENGTH);
+        m_colDef.push_back(DBaseColDef(colDefStr));
+        m_columnOffsets.push_back(recordOffset);
+        recordOffset += m_colDef.back().m_fieldLength;
+    }
+    if(recordOffset > m_recordLength) { throw unexpectedHeaderEndEx("Columns exceed the record length"); }
+
+    m_records = data + headerLength;
+    m_numRecords = std::min(numRecordsInDB, (size - headerLength) / m_recordLength);
+    return true;
+}
+
+void DBaseTable::close() {
+    m_index.clear();
+    m_colDef.clear();
+    m_columnOffsets.clear();
+    m_records = nullptr;
+    m_numRecords = 0;
+    m_recordLength = 0;
+    m_file.close();
+}
+
+int DBaseTable::columnIndex(const std::string& name) const {
+    for(size_t i = 0, c = m_colDef.size(); i < c; ++i) {
+        if(m_colDef[i].m_fieldName == name) { return int(i); }
+    }
+    return -1;
+}
+
+bool DBaseTable::isDeleted(size_t record) const {
+    return m_records[record * m_recordLength] != '\x20';
+}
+
+DBaseCell DBaseTable::cell(size_t record, size_t column) const {
+    return DBaseCell(m_records + (record * m_recordLength) + m_columnOffsets[column], m_colDef[column].m_fieldLength);
+}
+
+std::string DBaseTable::getString(size_t record, size_t column) const {
+    return cell(record, column).trimmed().str();
+}
+
+double DBaseTable::getDouble(size_t record, size_t column, double defaultValue) const {
+    DBaseCell field = cell(record, column);
+    switch(m_colDef[column].m_fieldType) {
+        case DBaseFieldType::Integer:
+        case DBaseFieldType::AutoIncrement:
+            if(field.m_length == 4) { return double(int32_t(uint32_t(readLittleEndian(field.m_data, 4)))); }
+            break;
+        case DBaseFieldType::Currency:
+            if(field.m_length == 8) { return double((long long)readLittleEndian(field.m_data, 8)) / 10000.0; }
+            break;
+        case DBaseFieldType::Double:
+            if(field.m_length == 8) {
+                unsigned long long bits = readLittleEndian(field.m_data, 8);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+            break;
+        case DBaseFieldType::Logical: {
+            DBaseCell value = field.trimmed();
+            if(value.empty()) { return defaultValue; }
+            switch(value.m_data[0]) {
+                case 'T': case 't': case 'Y': case 'y': return 1.0;
+                case 'F': case 'f': case 'N': case 'n': return 0.0;
+            }
+            return defaultValue;
+        }
+        default:
+            break;
+    }
+    std::string value = asciiField(field);
+    char* end = nullptr;
+    double result = std::strtod(value.c_str(), &end);
+    return (end == value.c_str()) ? defaultValue : result;
+}
+
+long long DBaseTable::getInteger(size_t record, size_t column, long long defaultValue) const {
+    switch(m_colDef[column].m_fieldType) {
+        case DBaseFieldType::Character:
+        case DBaseFieldType::Numeric:
+        case DBaseFieldType::Float: {
+            std::string value = asciiField(cell(record, column));
+            char* end = nullptr;
+            long long result = std::strtoll(value.c_str(), &end, 10);
+            return (end == value.c_str()) ? defaultValue : result;
+        }
+        default:
+            return (long long)getDouble(record, column, double(defaultValue));
+    }
+}
+
+///Index the trimmed values of a column; keys reference the mapping, so no field is copied
+bool DBaseTable::buildIndex(const std::string& columnName) {
+    m_index.clear();
+    int column = columnIndex(columnName);
+    if(column < 0) { return false; }
+    m_index.reserve(m_numRecords);
+    for(size_t record = 0; record < m_numRecords; ++record) {
+        if(isDeleted(record)) { continue; }
+        m_index[cell(record, size_t(column)).trimmed()] = record;
+    }
+    return true;
+}
+
+long long DBaseTable::find(const std::string& key) const {
+    auto it = m_index.find(DBaseCell(key));
+    return (it == m_index.end()) ? -1 : (long long)it->second;
+}
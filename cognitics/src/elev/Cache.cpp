@@ -23,6 +23,7 @@ DEALINGS IN THE SOFTWARE.
 #include <stdexcept>
 #include "elev/Cache.h"
 #include "elev/DataSource.h"
+#include <ccl/Status.h>
 
 namespace elev
 {
@@ -39,7 +40,16 @@ namespace elev
             entries.pop_back();
             delete entry;
         }
+        COGNITICS_STATUS_LEVEL("elev cache bytes", -int64_t(size));
         size = 0;
+        PublishHits();
+    }
+
+    // hits are counted per lookup, so they are published with the next miss (which reads from disk anyway)
+    void Cache::PublishHits(void)
+    {
+        COGNITICS_STATUS_COUNT("elev cache hits", hits - published_hits);
+        published_hits = hits;
     }
 
     CacheEntry *Cache::GetEntry(DataSource *owner, unsigned int offset, unsigned int size)
@@ -70,6 +80,7 @@ namespace elev
             else ++entry_i;
         }
 
+        unsigned int previous_size = this->size;
         this->size += size;
 
         // make space at the end of the list (oldest)
@@ -85,6 +96,9 @@ namespace elev
         entries.push_front(entry);
 
         ++misses;
+        COGNITICS_STATUS_COUNT("elev cache misses", 1);
+        COGNITICS_STATUS_LEVEL("elev cache bytes", int64_t(this->size) - int64_t(previous_size));
+        PublishHits();
 
         return entry;
     }
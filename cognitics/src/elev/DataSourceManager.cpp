@@ -15,97 +15,12 @@ Copyright 2018 Cognitics, Inc.
 #include "elev/Cache.h"
 
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 
 using namespace ccl;
 namespace elev
 {
-    ElevationBSP::~ElevationBSP(void)
-    {
-        if(minChild)
-            delete minChild;
-        if(maxChild)
-            delete maxChild;
-    }
-
-    ElevationBSP::ElevationBSP(size_t depth, bool vertical) : generated(false), depth(depth), vertical(vertical), split(0.0f), minChild(NULL), maxChild(NULL)
-    {
-    }
-
-    bool ElevationBSP::generate(void)
-    {
-        if(minChild)
-            return false;
-
-        generated = true;
-
-        if(depth > 20)
-            return true;
-
-        if(sources.size() < 4)
-            return true;
-
-        // average the centroids to determine the split
-        double sum = 0.0f;
-        for(std::list<DataSource_Raster *>::iterator it = sources.begin(), end = sources.end(); it != end; ++it)
-        {
-            DataSource_Raster *ds = *it;
-            sum += vertical ? (ds->geo_bound_x_low + ((ds->geo_bound_x_high - ds->geo_bound_x_low) / 2)) : (ds->geo_bound_y_high + ((ds->geo_bound_y_low - ds->geo_bound_y_high) / 2));
-        }
-        split = sum / sources.size();
-
-        // create children
-        minChild = new ElevationBSP(depth + 1, !vertical);
-        maxChild = new ElevationBSP(depth + 1, !vertical);
-
-        // identify where each source goes
-        std::list<DataSource_Raster *> saved_sources;
-        for(std::list<DataSource_Raster *>::iterator it = sources.begin(), end = sources.end(); it != end; ++it)
-        {
-            DataSource_Raster *ds = *it;
-            double low = vertical ? ds->geo_bound_x_low : ds->geo_bound_y_high;
-            double high = vertical ? ds->geo_bound_x_high : ds->geo_bound_y_low;
-            if(low > split)
-                maxChild->sources.push_back(ds);
-            else if(high < split)
-                minChild->sources.push_back(ds);
-            else
-                saved_sources.push_back(ds);
-        }
-
-        // update sources and generate children
-        sources = saved_sources;
-        minChild->generate();
-        maxChild->generate();
-
-        return true;
-    }
-
-    void ElevationBSP::getSourcesForPoint(double x, double y, std::list<DataSource_Raster *> &result)
-    {
-        for(std::list<DataSource_Raster *>::iterator it = sources.begin(), end = sources.end(); it != end; ++it)
-        {
-            DataSource_Raster *ds = *it;
-            double epsilon = abs(vertical ? ds->spacing_x : ds->spacing_y);
-            double low = vertical ? ds->geo_bound_x_low : ds->geo_bound_y_low;
-            double high = vertical ? ds->geo_bound_x_high : ds->geo_bound_y_high;
-            if(low > high)
-                std::swap(low, high);
-            double v = vertical ? x : y;
-            if(low - epsilon > v)
-                continue;
-            if(high + epsilon < v)
-                continue;
-            result.push_back(ds);
-        }
-        if(!minChild)
-            return;
-        double v = vertical ? x : y;
-        if(v <= split)
-            minChild->getSourcesForPoint(x, y, result);
-        if(v >= split)
-            maxChild->getSourcesForPoint(x, y, result);
-    }
-
     DataSourceManager::DataSourceManager(unsigned int cachesize) : generate_debug_features(false)
     {
         log.init("DataSourceManager", this);
@@ -200,11 +115,22 @@ namespace elev
 #endif
         std::vector<DataSource *> search_sources;
         search_sources.reserve(32);
-        if(bsp.generated)
+        if(sourceIndex.isGenerated())
         {
-            std::list<DataSource_Raster *> bsp_sources;
-            bsp.getSourcesForPoint(x, y, bsp_sources);
-            search_sources.insert(search_sources.end(), bsp_sources.begin(), bsp_sources.end());
+            std::vector<sfa::Geometry *> hits;
+            sourceIndex.search(x, y, x, y, hits);
+            // keep the results in source order
+            std::vector<size_t> indices;
+            indices.reserve(hits.size());
+            for(size_t i = 0, c = hits.size(); i < c; ++i)
+            {
+                std::unordered_map<const sfa::Geometry *, size_t>::const_iterator it = sourceByEnvelope.find(hits[i]);
+                if(it != sourceByEnvelope.end())
+                    indices.push_back(it->second);
+            }
+            std::sort(indices.begin(), indices.end());
+            for(size_t i = 0, c = indices.size(); i < c; ++i)
+                search_sources.push_back(sources[indices[i]]);
         }
         else
         {
@@ -224,9 +150,29 @@ namespace elev
 
     void DataSourceManager::generateBSP(void)
     {
+        sourceIndex.clear();
+        sourceEnvelopes.clear();
+        sourceByEnvelope.clear();
         for(size_t i = 0, c = sources.size(); i < c; ++i)
-            bsp.sources.push_back(dynamic_cast<DataSource_Raster *>(sources.at(i)));
-        bsp.generate();
+        {
+            DataSource_Raster *ds = dynamic_cast<DataSource_Raster *>(sources.at(i));
+            if(!ds)
+                continue;
+            // pad by a post so points on the edge still find the source
+            double epsilon_x = std::abs(ds->spacing_x);
+            double epsilon_y = std::abs(ds->spacing_y);
+            double min_x = std::min<double>(ds->geo_bound_x_low, ds->geo_bound_x_high) - epsilon_x;
+            double max_x = std::max<double>(ds->geo_bound_x_low, ds->geo_bound_x_high) + epsilon_x;
+            double min_y = std::min<double>(ds->geo_bound_y_low, ds->geo_bound_y_high) - epsilon_y;
+            double max_y = std::max<double>(ds->geo_bound_y_low, ds->geo_bound_y_high) + epsilon_y;
+            sfa::LineString *envelope = new sfa::LineString;
+            envelope->addPoint(sfa::Point(min_x, min_y));
+            envelope->addPoint(sfa::Point(max_x, max_y));
+            sourceEnvelopes.push_back(std::unique_ptr<sfa::LineString>(envelope));
+            sourceByEnvelope[envelope] = i;
+            sourceIndex.addGeometry(envelope, min_x, min_y, max_x, max_y);
+        }
+        sourceIndex.generate();
     }
 
     bool DataSourceManager::getElevationBounds(double &elevation_min, double &elevation_max)
@@ -8,6 +8,7 @@ Copyright 2017 Cognitics, Inc.
 #include "elev/Elevation_DSM.h"
 
 #include <ccl/Profile.h>
+#include <ccl/Arena.h>
 
 using namespace ccl;
 namespace elev
@@ -168,6 +169,8 @@ namespace elev
 
         if(dsm->generate_debug_features)
         {
+            // debug features outlive any arena scope the caller has open
+            ccl::ArenaScope heapScope(NULL);
             {
                 sfa::Feature *feature = new sfa::Feature;
                 feature->geometry = new sfa::Point(p);
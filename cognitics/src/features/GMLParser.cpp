@@ -462,15 +462,18 @@ void BuildFootprintScene(std::string& outputPath, scenegraph::Scene& masterScene
 				continue;
 			}
 
-			sfa::Point extrudedCenter = feature.localCenter;
-			extrudedCenter.setZ(feature.height);
-
-			sfa::Point endPoint = points[points.size()-1];
-			endPoint.setZ(feature.height);
-			sfa::Point startPoint = points[0];
-			startPoint.setZ(feature.height);
-			scenegraph::Face roofEnd = CreateFace(extrudedCenter, startPoint, endPoint);
-			scene.faces.push_back(roofEnd);
+			ctl::PointList roofPoints;
+			for (int n = 0; n < points.size() - 1; ++n)
+				roofPoints.push_back(ctl::Point(points[n].X(), points[n].Y(), feature.height));
+
+			ctl::PointList roofTriangles = ctl::QTriangulate::apply(roofPoints);
+			for (int n = 0; n + 2 < roofTriangles.size(); n += 3)
+			{
+				sfa::Point roof0(roofTriangles[n + 2].x, roofTriangles[n + 2].y, roofTriangles[n + 2].z);
+				sfa::Point roof1(roofTriangles[n + 1].x, roofTriangles[n + 1].y, roofTriangles[n + 1].z);
+				sfa::Point roof2(roofTriangles[n].x, roofTriangles[n].y, roofTriangles[n].z);
+				scene.faces.push_back(CreateFace(roof0, roof1, roof2));
+			}
 
 			for (int n = 1; n < points.size(); ++n)
 			{
@@ -47,7 +47,7 @@ namespace flt
         /*   4 */ bs.bind(id, 8);
         /*  12 */ bs.bind(siteID, 8);
         /*  20 */ bs.bind(RESERVED20);
-        /*  21 */ bs.bind(revision);
+        /*  21 */ bs.bind(this->revision);
         /*  22 */ bs.bind(recordCode);
         /*  24 */ bs.bind(content, bs.writing() ? int(content.size()) : length - 20);
     }
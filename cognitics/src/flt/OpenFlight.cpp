@@ -21,6 +21,7 @@ DEALINGS IN THE SOFTWARE.
 ****************************************************************************/
 
 #include "flt/OpenFlight.h"
+#include "flt/RecordReader.h"
 #include "flt/Unknown.h"
 #include "flt/Header.h"
 #include "flt/Group.h"
@@ -282,6 +283,7 @@ namespace flt
             return NULL;
         }
         flt->revision = header->formatRevisionLevel;
+        delete header;
         if(!supportsRevision(flt->revision))
             flt->log << ccl::LWARNING << "open(" << filename << "): revision " << flt->revision << " not supported, attempting to continue" << flt->log.endl; 
 
@@ -315,6 +317,7 @@ namespace flt
             return NULL;
         }
         flt->revision = header->formatRevisionLevel;
+        delete header;
         if (!supportsRevision(flt->revision))
             flt->log << ccl::LWARNING << "open(): revision " << flt->revision << " not supported, attempting to continue" << flt->log.endl;
 
@@ -358,77 +361,24 @@ namespace flt
     std::vector<std::string> OpenFlight::getTexturePaletteFilenames(const std::string &filename)
     {
         std::vector<std::string> result;
-        OpenFlight *file = open(filename);
-        if(!file)
+        RecordReader reader;
+        if(!reader.open(filename))
             return result;
-        while(Record *record = file->getNextRecord())
-        {
-            if(record->getRecordType() == Record::FLT_TEXTUREPALETTE)
-            {
-                TexturePalette *tp = dynamic_cast<TexturePalette *>(record);
-                if(!tp->fileName.empty())
-                    result.push_back(tp->fileName);
-            }
-            delete record;
-        }
-        delete file;
+        reader.getTexturePaletteFilenames(result);
         return result;
     }
 
     bool OpenFlight::getBoundingBox(const std::string &filename, double &xmin, double &xmax ,double &ymin, double &ymax, double &zmin, double &zmax)
     {
-        flt::OpenFlight *file = flt::OpenFlight::open(filename);
-        if(!file)
+        RecordReader reader;
+        if(!reader.open(filename))
         {
             //log << ccl::LERR << "Failed to load " + filename + ".";
             return false;
         }
 
-        while(Record *record = file->getNextRecord())
+        reader.scanVertices([&](int opcode, double x, double y, double z)
         {
-            double x = 0;
-            double y = 0;
-            double z = 0;
-            if(record->getRecordType() == Record::FLT_VERTEXWITHCOLOR)
-            {
-                VertexWithColor *vertex = dynamic_cast<VertexWithColor *>(record);
-                if(vertex)
-                {
-                    x = vertex->x;
-                    y = vertex->y;
-                    z = vertex->z;                    
-                }
-            }
-            else if(record->getRecordType() == Record::FLT_VERTEXWITHCOLORNORMAL)
-            {
-                VertexWithColorNormal *vertex = dynamic_cast<VertexWithColorNormal *>(record);
-                if(vertex)
-                {
-                    x = vertex->x;
-                    y = vertex->y;
-                    z = vertex->z;                    
-                }
-            }
-            else if(record->getRecordType() == Record::FLT_VERTEXWITHCOLORNORMALUV)
-            {
-                VertexWithColorNormalUV *vertex = dynamic_cast<VertexWithColorNormalUV *>(record);
-                if(vertex)
-                {
-                    x = vertex->x;
-                    y = vertex->y;
-                    z = vertex->z;                    
-                }
-            }
-            else if(record->getRecordType() == Record::FLT_VERTEXWITHCOLORUV)
-            {
-                VertexWithColorUV *vertex = dynamic_cast<VertexWithColorUV *>(record);
-                if(vertex)
-                {
-                    x = vertex->x;
-                    y = vertex->y;
-                    z = vertex->z;                    
-                }
-            }
             xmin = std::min<double>(x,xmin);
             ymin = std::min<double>(y,ymin);
             zmin = std::min<double>(z,zmin);
@@ -436,9 +386,7 @@ namespace flt
             xmax = std::max<double>(x,xmax);
             ymax = std::max<double>(y,ymax);
             zmax = std::max<double>(z,zmax);
-        
-            delete record;
-        }
+        });
         return true;
     }
 
@@ -493,8 +441,8 @@ namespace flt
             return NULL;
         }
         record->position = position;
-        ccl::binarystringstream bss(data, ccl::binarystringstream::binary | ccl::binarystringstream::in);
-        ccl::BindStream bs((std::istream &)bss);
+        ccl::ByteReader reader(data);
+        ccl::BindStream bs(reader);
         record->bind(bs, length - 4, revision);
         return record;
     }
@@ -545,10 +493,10 @@ namespace flt
             Header *header = dynamic_cast<Header *>(record);
             header->formatRevisionLevel = revision;
         }
-        ccl::binarystringstream bss(ccl::binarystringstream::binary | ccl::binarystringstream::out | ccl::binarystringstream::trunc);
-        ccl::BindStream bs((std::ostream &)bss);
+        ccl::binary data;
+        ccl::ByteWriter writer(data);
+        ccl::BindStream bs(writer);
         record->bind(bs, 0, revision);
-        ccl::binary data(bss.str());
         for(int i = 0;; ++i)
         {
             ccl::BigEndian<ccl::uint16_t> opcode = (i == 0) ? record->getRecordType() : Record::FLT_CONTINUATION;
@@ -573,7 +521,8 @@ namespace flt
 
             bindStream.bind(opcode);
             bindStream.bind(length);
-            bindStream.bind(data, 65532 - 4);
+            ccl::binary part = data.substr(0, 65532 - 4);   // bind() resizes its argument
+            bindStream.bind(part, 65532 - 4);
             data = data.substr(65532 - 4);
             if(!outFile.good())
             {
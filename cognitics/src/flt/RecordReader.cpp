@@ -0,0 +1,217 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "flt/RecordReader.h"
+#include "flt/OpenFlight.h"
+#include <ccl/binary.h>
+#include <ccl/ByteReader.h>
+#include <cstring>
+
+namespace flt
+{
+    namespace
+    {
+        const size_t RECORD_HEADER_LENGTH = 4;
+        const size_t TEXTUREPALETTE_FILENAME_LENGTH = 200;
+
+        // Returns the length of the record part at offset, or 0 if the header is truncated or invalid.
+        size_t partLength(const unsigned char *data, size_t size, size_t offset)
+        {
+            if(offset + RECORD_HEADER_LENGTH > size)
+                return 0;
+            size_t length = ccl::byteorder::loadBigEndian<ccl::uint16_t>(data + offset + 2);
+            if((length < RECORD_HEADER_LENGTH) || (offset + length > size))
+                return 0;
+            return length;
+        }
+    }
+
+    ccl::uint8_t RecordView::getUInt8(size_t offset) const
+    {
+        return (offset + 1 <= length) ? data[offset] : 0;
+    }
+
+    ccl::int16_t RecordView::getInt16(size_t offset) const
+    {
+        return (offset + 2 <= length) ? ccl::byteorder::loadBigEndian<ccl::int16_t>(data + offset) : 0;
+    }
+
+    ccl::uint16_t RecordView::getUInt16(size_t offset) const
+    {
+        return (offset + 2 <= length) ? ccl::byteorder::loadBigEndian<ccl::uint16_t>(data + offset) : 0;
+    }
+
+    ccl::int32_t RecordView::getInt32(size_t offset) const
+    {
+        return (offset + 4 <= length) ? ccl::byteorder::loadBigEndian<ccl::int32_t>(data + offset) : 0;
+    }
+
+    ccl::uint32_t RecordView::getUInt32(size_t offset) const
+    {
+        return (offset + 4 <= length) ? ccl::byteorder::loadBigEndian<ccl::uint32_t>(data + offset) : 0;
+    }
+
+    float RecordView::getFloat(size_t offset) const
+    {
+        return (offset + 4 <= length) ? ccl::byteorder::loadBigEndian<float>(data + offset) : 0.0f;
+    }
+
+    double RecordView::getDouble(size_t offset) const
+    {
+        return (offset + 8 <= length) ? ccl::byteorder::loadBigEndian<double>(data + offset) : 0.0;
+    }
+
+    std::string RecordView::getString(size_t offset, size_t fieldLength) const
+    {
+        if(offset >= length)
+            return std::string();
+        const char *p = reinterpret_cast<const char *>(data + offset);
+        size_t n = std::min<size_t>(fieldLength, length - offset);
+        const char *end = static_cast<const char *>(memchr(p, 0, n));
+        return std::string(p, end ? size_t(end - p) : n);
+    }
+
+    Record *RecordView::decode(int revision) const
+    {
+        if(!data)
+            return NULL;
+        Record *record = createRecordForOpcode(opcode);
+        if(!record)
+            return NULL;
+        record->position = position;
+        if(totalLength == length)
+        {
+            // decode straight from the mapping
+            ccl::ByteReader reader(data + RECORD_HEADER_LENGTH, length - RECORD_HEADER_LENGTH);
+            ccl::BindStream bs(reader);
+            record->bind(bs, int(reader.size()), revision);
+            return record;
+        }
+        ccl::binary payload(data + RECORD_HEADER_LENGTH, data + length);
+        for(size_t offset = length; offset < totalLength; )
+        {
+            size_t continuation = ccl::byteorder::loadBigEndian<ccl::uint16_t>(data + offset + 2);
+            payload.append(data + offset + RECORD_HEADER_LENGTH, data + offset + continuation);
+            offset += continuation;
+        }
+        ccl::ByteReader reader(payload);
+        ccl::BindStream bs(reader);
+        record->bind(bs, int(payload.size()), revision);
+        return record;
+    }
+
+    RecordReader::RecordReader(void) : data(NULL), size(0), offset(0), revision(0)
+    {
+    }
+
+    RecordReader::~RecordReader(void)
+    {
+    }
+
+    bool RecordReader::open(const std::string &filename)
+    {
+        close();
+        if(!file.open(filename))
+            return false;
+        data = file.data();
+        size = file.size();
+        return readHeader();
+    }
+
+    bool RecordReader::open(const void *buffer, size_t length)
+    {
+        close();
+        if(!buffer)
+            return false;
+        data = static_cast<const unsigned char *>(buffer);
+        size = length;
+        return readHeader();
+    }
+
+    bool RecordReader::readHeader(void)
+    {
+        RecordView header;
+        if(!next(header) || (header.opcode != Record::FLT_HEADER))
+        {
+            close();
+            return false;
+        }
+        revision = header.getInt32(12);
+        rewind();
+        return true;
+    }
+
+    void RecordReader::close(void)
+    {
+        file.close();
+        data = NULL;
+        size = 0;
+        offset = 0;
+        revision = 0;
+    }
+
+    void RecordReader::rewind(void)
+    {
+        offset = 0;
+    }
+
+    bool RecordReader::next(RecordView &record)
+    {
+        size_t length = partLength(data, size, offset);
+        if(length == 0)
+            return false;
+        record.opcode = ccl::byteorder::loadBigEndian<ccl::uint16_t>(data + offset);
+        record.position = ccl::uint32_t(offset);
+        record.data = data + offset;
+        record.length = length;
+        size_t end = offset + length;
+        while((end + RECORD_HEADER_LENGTH <= size) && (ccl::byteorder::loadBigEndian<ccl::uint16_t>(data + end) == Record::FLT_CONTINUATION))
+        {
+            size_t continuation = partLength(data, size, end);
+            if(continuation == 0)
+                return false;
+            end += continuation;
+        }
+        record.totalLength = end - offset;
+        offset = end;
+        return true;
+    }
+
+    size_t RecordReader::getTexturePaletteFilenames(std::vector<std::string> &filenames)
+    {
+        rewind();
+        size_t count = 0;
+        RecordView record;
+        while(next(record) && (record.opcode != Record::FLT_PUSHLEVEL))
+        {
+            if(record.opcode != Record::FLT_TEXTUREPALETTE)
+                continue;
+            std::string filename = record.getString(4, TEXTUREPALETTE_FILENAME_LENGTH);
+            if(filename.empty())
+                continue;
+            filenames.push_back(filename);
+            ++count;
+        }
+        return count;
+    }
+
+}
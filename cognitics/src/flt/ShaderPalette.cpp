@@ -63,14 +63,20 @@ namespace flt
             ccl::BigEndian<ccl::int32_t> vertexProgramCount = ccl::int32_t(vertexProgramFiles.size());
             /* 1036 */ bs.bind(vertexProgramCount);
 
-            ccl::BigEndian<ccl::int32_t> fragmentProgramCount = ccl::int32_t(vertexProgramFiles.size());
+            ccl::BigEndian<ccl::int32_t> fragmentProgramCount = ccl::int32_t(fragmentProgramFiles.size());
             /* 1040 */ bs.bind(fragmentProgramCount);
 
-            for(int i = 0, n = vertexProgramCount; i < n; ++i)
-                bs.bind(vertexProgramFiles[i]);
+            if(!bs.writing())
+            {
+                vertexProgramFiles.resize(std::max<int>(vertexProgramCount, 0));
+                fragmentProgramFiles.resize(std::max<int>(fragmentProgramCount, 0));
+            }
 
-            for(int i = 0, n = fragmentProgramCount; i < n; ++i)
-                bs.bind(fragmentProgramFiles[i]);
+            for(size_t i = 0, n = vertexProgramFiles.size(); i < n; ++i)
+                bs.bind(vertexProgramFiles[i], 1024);
+
+            for(size_t i = 0, n = fragmentProgramFiles.size(); i < n; ++i)
+                bs.bind(fragmentProgramFiles[i], 1024);
         }
     }
 
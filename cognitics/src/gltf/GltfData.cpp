@@ -1,40 +1,25 @@
 #include "gltf/GltfData.h"
-#include "b64/base64.h"
+#include <unordered_map>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
 
 namespace gltf
 {
 
 	GltfData::GltfData(scenegraph::Scene* sceneA, GltfInfo& infoA)
-		: scene(sceneA), info(infoA)
+		: scene(sceneA), info(infoA), bufferLength(0), quantized(false)
 	{
-
+		for (int k = 0; k < 3; ++k)
+		{
+			positionScale[k] = 1.0;
+			positionOffset[k] = 0.0;
+		}
 	}
 
 	GltfData::~GltfData()
 	{
-		for (int p = 0; p < primitives.size(); ++p)
-		{
-			if (primitives[p].vertexBuffer != NULL)
-			{
-				delete[] primitives[p].vertexBuffer;
-			}
-			if (primitives[p].normalsBuffer != NULL)
-			{
-				delete[] primitives[p].normalsBuffer;
-			}
-			if (primitives[p].uvBuffer != NULL)
-			{
-				delete[] primitives[p].uvBuffer;
-			}
-			if (primitives[p].batchBuffer != NULL)
-			{
-				delete[] primitives[p].batchBuffer;
-			}
-			if (info.embedTextures && primitives[p].textureBufferLength > 0)
-			{
-				delete[] primitives[p].textureBuffer;
-			}
-		}
 	}
 
 	void GltfData::init()
@@ -44,6 +29,9 @@ namespace gltf
 			return;
 		}
 
+		// welded once up front, so each shared position is transformed once rather than once per face
+		mesh.clear();
+		scene->buildIndexedMesh(mesh);
 
 		if (info.format == "b3dm" || info.format == "i3dm")
 		{
@@ -53,10 +41,9 @@ namespace gltf
 		applyRotation();
 
 		definePrimitives();
-		initMinMaxs();
-		initPrimitivesBuffers();
 		fillBuffers();
 		initTextureBuffers();
+		defineBufferViews();
 	}
 
 	void GltfData::multiplyMatrix()
@@ -104,32 +91,28 @@ namespace gltf
 	{
 		setUpRotationMatrix(-info.angle, info.rtcCenter.X(), info.rtcCenter.Y(), info.rtcCenter.Z());
 
-		for (int i = 0; i < scene->faces.size(); ++i)
+		for (size_t i = 0; i < mesh.getNumPositions(); ++i)
 		{
-			for (int j = 0; j < 3; ++j)
-			{
-				sfa::Point& p = scene->faces[i].verts[j];
-
-				inputMatrix[0][0] = p.X();
-				inputMatrix[1][0] = p.Y();
-				inputMatrix[2][0] = p.Z();
-				inputMatrix[3][0] = 1.0;
+			double* p = &mesh.positions[i * 3];
 
-				multiplyMatrix();
+			inputMatrix[0][0] = p[0];
+			inputMatrix[1][0] = p[1];
+			inputMatrix[2][0] = p[2];
+			inputMatrix[3][0] = 1.0;
 
-				p.setX(outputMatrix[0][0]);
-				p.setY(outputMatrix[1][0]);
-				p.setZ(outputMatrix[2][0]);
+			multiplyMatrix();
 
-			}
+			p[0] = outputMatrix[0][0];
+			p[1] = outputMatrix[1][0];
+			p[2] = outputMatrix[2][0];
 		}
 	}
 
-	void GltfData::convertLocalToEcef(sfa::Point& p)
+	void GltfData::convertLocalToEcef(double* p)
 	{
-		double x = info.flatEarth.convertLocalToGeoLon(p.X());
-		double y = info.flatEarth.convertLocalToGeoLat(p.Y());
-		double z = p.Z() + info.bounds.elev;
+		double x = info.flatEarth.convertLocalToGeoLon(p[0]);
+		double y = info.flatEarth.convertLocalToGeoLat(p[1]);
+		double z = p[2] + info.bounds.elev;
 
 		//TODO store std::min/max lat/lon for tileset bounding box
 
@@ -142,9 +125,9 @@ namespace gltf
 				y -= info.rtcCenter.Y();
 				z -= info.rtcCenter.Z();
 			}
-			p.setX(x);
-			p.setY(y);
-			p.setZ(z);
+			p[0] = x;
+			p[1] = y;
+			p[2] = z;
 		}
 		else
 		{
@@ -154,163 +137,327 @@ namespace gltf
 	}
 	bool GltfData::convertSceneToEcef()
 	{
-		if (scene == NULL || scene->faces.size() == 0)
+		if (mesh.faces.empty())
 		{
 			return false;
 		}
 
-		for (int i = 0; i < scene->faces.size(); ++i)
+		for (size_t i = 0; i < mesh.getNumPositions(); ++i)
 		{
-			for (int j = 0; j < 3; ++j)
-			{
-				convertLocalToEcef(scene->faces[i].verts[j]);
-			}
+			convertLocalToEcef(&mesh.positions[i * 3]);
 		}
 
 		//TODO should update the vertex normals after transforming, 
 		//but this seems to sometimes stall indefinitely
-		if (scene->faces.size() < 200)
+		if (mesh.faces.size() < 200)
 		{
-			//std::cout << "setting vertex normals" << std::endl;
-			scene->setVertexNormals();
-			//std::cout << "finished setting vertex normals" << std::endl;
+			mesh.computeVertexNormals(scene->sharpEdges);
 		}
 
 		return true;
 	}
 
-	void GltfData::initMinMaxs()
+	void GltfData::definePrimitives()
 	{
-		for (int p = 0; p < primitives.size(); ++p)
-		{
-			auto firstFace = primitives[p].faces[0];
-			auto firstVert = firstFace.verts[0];
-			sfa::Point firstUv = firstFace.getUVForVertex(firstVert, 0);
-
-			primitives[p].maxVertexValues.clear();
-			primitives[p].minVertexValues.clear();
-			primitives[p].maxNormalValues.clear();
-			primitives[p].minNormalValues.clear();
-			primitives[p].maxUvValues.clear();
-			primitives[p].minUvValues.clear();
-
-			primitives[p].maxVertexValues.push_back(static_cast<float>(firstVert.X()));
-			primitives[p].maxVertexValues.push_back(static_cast<float>(firstVert.Y()));
-			primitives[p].maxVertexValues.push_back(static_cast<float>(firstVert.Z()));
-			primitives[p].minVertexValues.push_back(static_cast<float>(firstVert.X()));
-			primitives[p].minVertexValues.push_back(static_cast<float>(firstVert.Y()));
-			primitives[p].minVertexValues.push_back(static_cast<float>(firstVert.Z()));
-			primitives[p].maxNormalValues.push_back(static_cast<float>(firstFace.vertexNormals[0].X()));
-			primitives[p].maxNormalValues.push_back(static_cast<float>(firstFace.vertexNormals[0].Y()));
-			primitives[p].maxNormalValues.push_back(static_cast<float>(firstFace.vertexNormals[0].Z()));
-			primitives[p].minNormalValues.push_back(static_cast<float>(firstFace.vertexNormals[0].X()));
-			primitives[p].minNormalValues.push_back(static_cast<float>(firstFace.vertexNormals[0].Y()));
-			primitives[p].minNormalValues.push_back(static_cast<float>(firstFace.vertexNormals[0].Z()));
-			primitives[p].maxUvValues.push_back(static_cast<float>(firstUv.X()));
-			primitives[p].maxUvValues.push_back(static_cast<float>(firstUv.Y()));
-			primitives[p].minUvValues.push_back(static_cast<float>(firstUv.X()));
-			primitives[p].minUvValues.push_back(static_cast<float>(firstUv.Y()));
+		//group faces into primitives by texture
+		std::unordered_map<std::string, size_t> primitiveIndex;
+		for (size_t i = 0; i < mesh.faces.size(); ++i)
+		{
+			const scenegraph::IndexedMesh::IndexedFace& face = mesh.faces[i];
+			if (face.texture < 0 || face.numCorners < 3)
+			{
+				continue;
+			}
+			bool complete = true;
+			for (int j = 0; j < 3; ++j)
+			{
+				const scenegraph::IndexedMesh::Corner& corner = mesh.corners[face.firstCorner + j];
+				complete = complete && (corner.normal != scenegraph::IndexedMesh::NONE) && (corner.uv != scenegraph::IndexedMesh::NONE);
+			}
+			if (!complete)
+			{
+				continue;
+			}
+			const std::string& texName = mesh.textures[face.texture];
+			if (texName == "InvalidTextureID")
+			{
+				continue;
+			}
+			auto it = primitiveIndex.find(texName);
+			if (it == primitiveIndex.end())
+			{
+				it = primitiveIndex.insert(std::make_pair(texName, primitives.size())).first;
+				primitives.push_back(GltfPrimitive());
+				primitives.back().textureName = texName;
+			}
+			primitives[it->second].faces.push_back(i);
 		}
 	}
 
-	void GltfData::definePrimitives()
+	void GltfData::initQuantization()
 	{
-		//group faces into primitives by texture
-		for (int i = 0; i < scene->faces.size(); ++i)
+		quantized = info.quantize && !primitives.empty();
+		if (!quantized)
+		{
+			return;
+		}
+
+		double minValues[3] = { DBL_MAX, DBL_MAX, DBL_MAX };
+		double maxValues[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+		for (size_t p = 0; p < primitives.size(); ++p)
 		{
-			std::string texName = scene->faces[i].getMappedTextureN(0).GetTextureName();
-			if (texName != "InvalidTextureID")
+			for (size_t i = 0; i < primitives[p].faces.size(); ++i)
 			{
-				bool addedToPrim = false;
-				for (int j = 0; j < primitives.size(); ++j)
+				const scenegraph::IndexedMesh::IndexedFace& face = mesh.faces[primitives[p].faces[i]];
+				for (int j = 0; j < 3; ++j)
 				{
-					if (primitives[j].textureName == texName)
+					const double* xyz = &mesh.positions[mesh.corners[face.firstCorner + j].position * 3];
+					for (int k = 0; k < 3; ++k)
 					{
-						primitives[j].faces.push_back(scene->faces[i]);
-						addedToPrim = true;
-						break;
+						minValues[k] = std::min<double>(minValues[k], xyz[k]);
+						maxValues[k] = std::max<double>(maxValues[k], xyz[k]);
 					}
 				}
-				if (!addedToPrim)
-				{
-					GltfPrimitive prim;
-					prim.textureName = texName;
-					prim.faces.push_back(scene->faces[i]);
-					primitives.push_back(prim);
-				}
 			}
 		}
+
+		// map [min, max] onto the full int16 range: p = positionOffset + positionScale * q
+		for (int k = 0; k < 3; ++k)
+		{
+			double range = maxValues[k] - minValues[k];
+			positionScale[k] = (range > 0) ? range / 65535.0 : 1.0;
+			positionOffset[k] = minValues[k] + 32768.0 * positionScale[k];
+		}
 	}
 
-	void GltfData::initPrimitivesBuffers()
+	namespace
 	{
-		for (int p = 0; p < primitives.size(); ++p)
-		{
-			primitives[p].numVerts = static_cast<int>(primitives[p].faces.size()) * 3;
-			primitives[p].vertexBuffer = new float[primitives[p].numVerts * 3];
-			primitives[p].normalsBuffer = new float[primitives[p].numVerts * 3];
-			primitives[p].uvBuffer = new float[primitives[p].numVerts * 2];
-			primitives[p].batchBuffer = new unsigned short[primitives[p].numVerts];
-			primitives[p].vertexBufferLength = primitives[p].numVerts * 3 * sizeof(float);
-			primitives[p].normalsBufferLength = primitives[p].numVerts * 3 * sizeof(float);
-			primitives[p].uvBufferLength = primitives[p].numVerts * 2 * sizeof(float);
-			primitives[p].batchBufferLength = primitives[p].numVerts * sizeof(unsigned short);
+		// vertex identity for welding, taken from the values actually written so quantized duplicates weld as well
+		struct VertexKey
+		{
+			uint32_t values[8];
+
+			bool operator==(const VertexKey& other) const
+			{
+				return memcmp(values, other.values, sizeof(values)) == 0;
+			}
+		};
+
+		struct VertexKeyHash
+		{
+			size_t operator()(const VertexKey& key) const
+			{
+				uint64_t hash = 14695981039346656037ULL;
+				for (int i = 0; i < 8; ++i)
+				{
+					hash ^= key.values[i];
+					hash *= 1099511628211ULL;
+				}
+				return size_t(hash ^ (hash >> 32));
+			}
+		};
+
+		template <typename T>
+		void appendValue(std::vector<char>& buffer, T value)
+		{
+			size_t offset = buffer.size();
+			buffer.resize(offset + sizeof(T));
+			memcpy(&buffer[offset], &value, sizeof(T));
+		}
+
+		template <typename T>
+		uint32_t keyValue(T value)
+		{
+			uint32_t result = 0;
+			memcpy(&result, &value, sizeof(T));
+			return result;
+		}
+
+		int16_t quantizeSigned(double value)
+		{
+			return static_cast<int16_t>(std::lround(std::max<double>(-32768.0, std::min<double>(32767.0, value))));
+		}
+
+		void updateMinMax(std::vector<double>& min, std::vector<double>& max, const double* values, size_t count)
+		{
+			if (min.empty())
+			{
+				min.assign(values, values + count);
+				max.assign(values, values + count);
+				return;
+			}
+			for (size_t i = 0; i < count; ++i)
+			{
+				min[i] = std::min<double>(min[i], values[i]);
+				max[i] = std::max<double>(max[i], values[i]);
+			}
 		}
 	}
 
-	bool GltfData::fillBuffers()
+	void GltfData::fillPrimitiveBuffers(GltfPrimitive& prim)
 	{
-		for (int p = 0; p < primitives.size(); ++p)
+		bool quantizeUvs = quantized;
+		for (size_t i = 0; quantizeUvs && (i < prim.faces.size()); ++i)
 		{
-			float* currentVertexPointer = primitives[p].vertexBuffer;
-			float* currentNormalsPointer = primitives[p].normalsBuffer;
-			float* currentUvPointer = primitives[p].uvBuffer;
-			unsigned short* currentBatchPointer = primitives[p].batchBuffer;
-			for (int i = 0; i < primitives[p].faces.size(); ++i)
+			const scenegraph::IndexedMesh::IndexedFace& face = mesh.faces[prim.faces[i]];
+			for (int j = 0; j < 3; ++j)
 			{
-				for (int j = 0; j < 3; ++j)
+				const double* uv = &mesh.uvs[mesh.corners[face.firstCorner + j].uv * 2];
+				if (uv[0] < 0.0 || uv[0] > 1.0 || uv[1] < 0.0 || uv[1] > 1.0)
 				{
-					float x = static_cast<float>(primitives[p].faces[i].verts[j].X());
-					float y = static_cast<float>(primitives[p].faces[i].verts[j].Y());
-					float z = static_cast<float>(primitives[p].faces[i].verts[j].Z());
-					*currentVertexPointer++ = x;
-					*currentVertexPointer++ = y;
-					*currentVertexPointer++ = z;
-					primitives[p].maxVertexValues[0] = std::max<float>(primitives[p].maxVertexValues[0], x);
-					primitives[p].maxVertexValues[1] = std::max<float>(primitives[p].maxVertexValues[1], y);
-					primitives[p].maxVertexValues[2] = std::max<float>(primitives[p].maxVertexValues[2], z);
-					primitives[p].minVertexValues[0] = std::min<float>(primitives[p].minVertexValues[0], x);
-					primitives[p].minVertexValues[1] = std::min<float>(primitives[p].minVertexValues[1], y);
-					primitives[p].minVertexValues[2] = std::min<float>(primitives[p].minVertexValues[2], z);
-
-
-					x = static_cast<float>(primitives[p].faces[i].vertexNormals[j].X());
-					y = static_cast<float>(primitives[p].faces[i].vertexNormals[j].Y());
-					z = static_cast<float>(primitives[p].faces[i].vertexNormals[j].Z());
-					*currentNormalsPointer++ = x;
-					*currentNormalsPointer++ = y;
-					*currentNormalsPointer++ = z;
-					primitives[p].maxNormalValues[0] = std::max<float>(primitives[p].maxNormalValues[0], x);
-					primitives[p].maxNormalValues[1] = std::max<float>(primitives[p].maxNormalValues[1], y);
-					primitives[p].maxNormalValues[2] = std::max<float>(primitives[p].maxNormalValues[2], z);
-					primitives[p].minNormalValues[0] = std::min<float>(primitives[p].minNormalValues[0], x);
-					primitives[p].minNormalValues[1] = std::min<float>(primitives[p].minNormalValues[1], y);
-					primitives[p].minNormalValues[2] = std::min<float>(primitives[p].minNormalValues[2], z);
-
-					sfa::Point uv = primitives[p].faces[i].textures[0].uvs[j];
-					x = static_cast<float>(uv.X());
-					y = static_cast<float>(uv.Y());
-					*currentUvPointer++ = x;
-					*currentUvPointer++ = y;
-					primitives[p].maxUvValues[0] = std::max<float>(primitives[p].maxUvValues[0], x);
-					primitives[p].maxUvValues[1] = std::max<float>(primitives[p].maxUvValues[1], y);
-					primitives[p].minUvValues[0] = std::min<float>(primitives[p].minUvValues[0], x);
-					primitives[p].minUvValues[1] = std::min<float>(primitives[p].minUvValues[1], y);
-
-					*currentBatchPointer++ = 0;
+					// normalized uint16 can't hold repeating texture coordinates
+					quantizeUvs = false;
+					break;
 				}
 			}
 		}
+		prim.positionComponentType = quantized ? GLTF_SHORT : GLTF_FLOAT;
+		prim.normalComponentType = quantized ? GLTF_SHORT : GLTF_FLOAT;
+		prim.uvComponentType = quantizeUvs ? GLTF_UNSIGNED_SHORT : GLTF_FLOAT;
+
+		std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertexIndex;
+		vertexIndex.reserve(prim.faces.size() * 2);
+		std::unordered_map<scenegraph::IndexedMesh::Corner, uint32_t, scenegraph::IndexedMesh::CornerHash> cornerIndex;
+		cornerIndex.reserve(prim.faces.size() * 2);
+		std::vector<uint32_t> indices;
+		indices.reserve(prim.faces.size() * 3);
+		prim.numVerts = 0;
+
+		for (size_t i = 0; i < prim.faces.size(); ++i)
+		{
+			const scenegraph::IndexedMesh::IndexedFace& face = mesh.faces[prim.faces[i]];
+			for (int j = 0; j < 3; ++j)
+			{
+				const scenegraph::IndexedMesh::Corner& corner = mesh.corners[face.firstCorner + j];
+
+				// a corner already seen in this primitive resolves without rebuilding its vertex key
+				auto cached = cornerIndex.find(corner);
+				if (cached != cornerIndex.end())
+				{
+					indices.push_back(cached->second);
+					continue;
+				}
+
+				const double* v = &mesh.positions[corner.position * 3];
+				const double* n = &mesh.normals[corner.normal * 3];
+				const double* uv = &mesh.uvs[corner.uv * 2];
+
+				// int16 vec3 attributes are padded to 4 components to keep every element 4 byte aligned
+				float position[3];
+				int16_t qposition[4] = { 0, 0, 0, 0 };
+				float normal[3];
+				int16_t qnormal[4] = { 0, 0, 0, 0 };
+				float texcoord[2];
+				uint16_t qtexcoord[2];
+				VertexKey key;
+				if (quantized)
+				{
+					for (int k = 0; k < 3; ++k)
+					{
+						qposition[k] = quantizeSigned((v[k] - positionOffset[k]) / positionScale[k]);
+						qnormal[k] = quantizeSigned(std::max<double>(-1.0, std::min<double>(1.0, n[k])) * 32767.0);
+						key.values[k] = keyValue(qposition[k]);
+						key.values[3 + k] = keyValue(qnormal[k]);
+					}
+				}
+				else
+				{
+					for (int k = 0; k < 3; ++k)
+					{
+						position[k] = static_cast<float>(v[k]);
+						normal[k] = static_cast<float>(n[k]);
+						key.values[k] = keyValue(position[k]);
+						key.values[3 + k] = keyValue(normal[k]);
+					}
+				}
+				if (quantizeUvs)
+				{
+					qtexcoord[0] = static_cast<uint16_t>(std::lround(uv[0] * 65535.0));
+					qtexcoord[1] = static_cast<uint16_t>(std::lround(uv[1] * 65535.0));
+					key.values[6] = qtexcoord[0];
+					key.values[7] = qtexcoord[1];
+				}
+				else
+				{
+					texcoord[0] = static_cast<float>(uv[0]);
+					texcoord[1] = static_cast<float>(uv[1]);
+					key.values[6] = keyValue(texcoord[0]);
+					key.values[7] = keyValue(texcoord[1]);
+				}
+
+				auto result = vertexIndex.insert(std::make_pair(key, uint32_t(prim.numVerts)));
+				indices.push_back(result.first->second);
+				cornerIndex.insert(std::make_pair(corner, result.first->second));
+				if (!result.second)
+				{
+					continue;
+				}
+				++prim.numVerts;
+
+				if (quantized)
+				{
+					double qvalues[3] = { double(qposition[0]), double(qposition[1]), double(qposition[2]) };
+					updateMinMax(prim.minVertexValues, prim.maxVertexValues, qvalues, 3);
+					for (int k = 0; k < 4; ++k)
+					{
+						appendValue(prim.vertexBuffer, qposition[k]);
+						appendValue(prim.normalsBuffer, qnormal[k]);
+					}
+				}
+				else
+				{
+					double values[3] = { position[0], position[1], position[2] };
+					updateMinMax(prim.minVertexValues, prim.maxVertexValues, values, 3);
+					double nvalues[3] = { normal[0], normal[1], normal[2] };
+					updateMinMax(prim.minNormalValues, prim.maxNormalValues, nvalues, 3);
+					for (int k = 0; k < 3; ++k)
+					{
+						appendValue(prim.vertexBuffer, position[k]);
+						appendValue(prim.normalsBuffer, normal[k]);
+					}
+				}
+				if (quantizeUvs)
+				{
+					appendValue(prim.uvBuffer, qtexcoord[0]);
+					appendValue(prim.uvBuffer, qtexcoord[1]);
+				}
+				else
+				{
+					double uvvalues[2] = { texcoord[0], texcoord[1] };
+					updateMinMax(prim.minUvValues, prim.maxUvValues, uvvalues, 2);
+					appendValue(prim.uvBuffer, texcoord[0]);
+					appendValue(prim.uvBuffer, texcoord[1]);
+				}
+			}
+		}
+
+		prim.batchBuffer.assign(prim.numVerts * sizeof(unsigned short), 0);
+
+		prim.numIndices = static_cast<int>(indices.size());
+		prim.indexComponentType = (prim.numVerts <= 65535) ? GLTF_UNSIGNED_SHORT : GLTF_UNSIGNED_INT;
+		if (prim.indexComponentType == GLTF_UNSIGNED_SHORT)
+		{
+			prim.indexBuffer.resize(indices.size() * sizeof(uint16_t));
+			uint16_t* out = reinterpret_cast<uint16_t*>(prim.indexBuffer.data());
+			for (size_t i = 0; i < indices.size(); ++i)
+			{
+				out[i] = static_cast<uint16_t>(indices[i]);
+			}
+		}
+		else
+		{
+			prim.indexBuffer.resize(indices.size() * sizeof(uint32_t));
+			memcpy(prim.indexBuffer.data(), indices.data(), prim.indexBuffer.size());
+		}
+	}
+
+	bool GltfData::fillBuffers()
+	{
+		initQuantization();
+		for (size_t p = 0; p < primitives.size(); ++p)
+		{
+			fillPrimitiveBuffers(primitives[p]);
+		}
 		return true;
 	}
 
@@ -330,67 +477,137 @@ namespace gltf
 				{
 					texName = primitives[p].textureName;
 				}
-				std::ifstream file(texName, std::ios::binary | std::ios::ate);
-				std::streamsize size = file.tellg();
-				if (size <= 0)
+				// mapped rather than read so the texture isn't held in memory a second time while the tile is written
+				std::shared_ptr<ccl::MappedFile> textureFile(new ccl::MappedFile(texName));
+				if (!textureFile->isOpen() || textureFile->size() == 0)
 				{
 					std::cout << "GltfData: Couldn't find texture file " << primitives[p].textureName << std::endl;
 					continue;
 				}
-				file.seekg(0, std::ios::beg);
-				
-				primitives[p].textureBufferLength = size;
-				primitives[p].textureBuffer = new char[size];
-				if (!file.read(primitives[p].textureBuffer, size))
-				{
-					std::cout << "GltfData: Error reading texture file " << primitives[p].textureName << std::endl;
-				}
+				textureFile->advise(ccl::MappedFile::ACCESS_SEQUENTIAL);
+				primitives[p].textureFile = textureFile;
+				primitives[p].textureBuffer = reinterpret_cast<const char*>(textureFile->data());
+				primitives[p].textureBufferLength = static_cast<int>(textureFile->size());
 			}
 		}
 	}
 
-	void GltfData::write()
+	void GltfData::defineBufferViews()
 	{
-		for (int p = 0; p < primitives.size(); ++p)
+		bufferViews.clear();
+		accessors.clear();
+
+		for (size_t p = 0; p < primitives.size(); ++p)
 		{
-			info.file.write(reinterpret_cast<char*>(primitives[p].vertexBuffer), primitives[p].vertexBufferLength);
-			info.file.write(reinterpret_cast<char*>(primitives[p].normalsBuffer), primitives[p].normalsBufferLength);
-			info.file.write(reinterpret_cast<char*>(primitives[p].uvBuffer), primitives[p].uvBufferLength);
-			info.file.write(reinterpret_cast<char*>(primitives[p].batchBuffer), primitives[p].batchBufferLength);
-			if (info.embedTextures)
+			GltfPrimitive& prim = primitives[p];
+			bool quantizedVec3 = (prim.positionComponentType != GLTF_FLOAT);
+
+			bufferViews.push_back(GltfBufferView(prim.vertexBuffer.data(), int(prim.vertexBuffer.size()), quantizedVec3 ? 8 : 0, GLTF_ARRAY_BUFFER));
+			prim.positionAccessor = int(accessors.size());
+			accessors.push_back(GltfAccessor(int(bufferViews.size()) - 1, prim.positionComponentType, "VEC3", prim.numVerts));
+			accessors.back().min = prim.minVertexValues;
+			accessors.back().max = prim.maxVertexValues;
+
+			bufferViews.push_back(GltfBufferView(prim.normalsBuffer.data(), int(prim.normalsBuffer.size()), quantizedVec3 ? 8 : 0, GLTF_ARRAY_BUFFER));
+			prim.normalAccessor = int(accessors.size());
+			accessors.push_back(GltfAccessor(int(bufferViews.size()) - 1, prim.normalComponentType, "VEC3", prim.numVerts, prim.normalComponentType != GLTF_FLOAT));
+			accessors.back().min = prim.minNormalValues;
+			accessors.back().max = prim.maxNormalValues;
+
+			bufferViews.push_back(GltfBufferView(prim.uvBuffer.data(), int(prim.uvBuffer.size()), 0, GLTF_ARRAY_BUFFER));
+			prim.uvAccessor = int(accessors.size());
+			accessors.push_back(GltfAccessor(int(bufferViews.size()) - 1, prim.uvComponentType, "VEC2", prim.numVerts, prim.uvComponentType != GLTF_FLOAT));
+			accessors.back().min = prim.minUvValues;
+			accessors.back().max = prim.maxUvValues;
+
+			bufferViews.push_back(GltfBufferView(prim.batchBuffer.data(), int(prim.batchBuffer.size()), 0, GLTF_ARRAY_BUFFER));
+			prim.batchAccessor = int(accessors.size());
+			accessors.push_back(GltfAccessor(int(bufferViews.size()) - 1, GLTF_UNSIGNED_SHORT, "SCALAR", prim.numVerts));
+			accessors.back().min.push_back(0);
+			accessors.back().max.push_back(0);
+
+			bufferViews.push_back(GltfBufferView(prim.indexBuffer.data(), int(prim.indexBuffer.size()), 0, GLTF_ELEMENT_ARRAY_BUFFER));
+			prim.indexAccessor = int(accessors.size());
+			accessors.push_back(GltfAccessor(int(bufferViews.size()) - 1, prim.indexComponentType, "SCALAR", prim.numIndices));
+
+			if (info.embedTextures && prim.textureBufferLength > 0)
 			{
-				info.file.write(reinterpret_cast<char*>(primitives[p].textureBuffer), primitives[p].textureBufferLength);
+				prim.imageBufferView = int(bufferViews.size());
+				bufferViews.push_back(GltfBufferView(prim.textureBuffer, prim.textureBufferLength, 0, 0));
 			}
 		}
+
+		int offset = 0;
+		for (size_t v = 0; v < bufferViews.size(); ++v)
+		{
+			bufferViews[v].byteOffset = offset;
+			offset += (bufferViews[v].byteLength + 3) & ~3;
+		}
+		bufferLength = offset;
 	}
 
-	void GltfData::getBase64BufferData(std::string& out_data)
+	void GltfData::writeBuffer(std::ostream& out)
 	{
-		out_data = "";
-		for (int p = 0; p < primitives.size(); ++p)
+		const char padding[4] = { 0, 0, 0, 0 };
+		for (size_t v = 0; v < bufferViews.size(); ++v)
 		{
-			std::ostringstream ss1(std::ios::binary);
-			ss1.write(reinterpret_cast<char*>(primitives[p].vertexBuffer), primitives[p].vertexBufferLength);
-			out_data += base64Encode(ss1.str());
-
-			std::ostringstream ss2(std::ios::binary);
-			ss2.write(reinterpret_cast<char*>(primitives[p].normalsBuffer), primitives[p].vertexBufferLength);
-			out_data += base64Encode(ss2.str());
-
-			std::ostringstream ss3(std::ios::binary);
-			ss3.write(reinterpret_cast<char*>(primitives[p].uvBuffer), primitives[p].uvBufferLength);
-			out_data += base64Encode(ss3.str());
+			const GltfBufferView& view = bufferViews[v];
+			out.write(view.data, view.byteLength);
+			out.write(padding, ((view.byteLength + 3) & ~3) - view.byteLength);
+		}
+	}
 
-			std::ostringstream ss4(std::ios::binary);
-			ss4.write(reinterpret_cast<char*>(primitives[p].batchBuffer), primitives[p].batchBufferLength);
-			out_data += base64Encode(ss4.str());
+	bool GltfData::writeBufferFile(const std::string& filename)
+	{
+		std::ofstream file(filename.c_str(), std::ofstream::binary | std::ofstream::out | std::ofstream::trunc);
+		if (!file.good())
+		{
+			std::cout << "GltfData: Error opening buffer file " << filename << std::endl;
+			return false;
+		}
+		writeBuffer(file);
+		return file.good();
+	}
 
-			if (info.embedTextures)
+	void GltfData::writeGlb(std::ostream& out, const std::string& json)
+	{
+		// all chunk lengths are known up front, so the file is written front to back without seeking back to patch sizes
+		uint32_t jsonChunkLength = (static_cast<uint32_t>(json.size()) + 3) & ~3u;
+		uint32_t binChunkLength = static_cast<uint32_t>(bufferLength);
+		uint32_t glbLength = 12 + 8 + jsonChunkLength;
+		if (binChunkLength > 0)
+		{
+			// 3D Tiles requires the embedded glb to end on an 8 byte boundary
+			if ((glbLength + 8 + binChunkLength) % 8 != 0)
 			{
-				std::ostringstream ss5(std::ios::binary);
-				ss5.write(reinterpret_cast<char*>(primitives[p].textureBuffer), primitives[p].textureBufferLength);
-				out_data += base64Encode(ss5.str());
+				binChunkLength += 4;
 			}
+			glbLength += 8 + binChunkLength;
+		}
+		else if (glbLength % 8 != 0)
+		{
+			jsonChunkLength += 4;
+			glbLength += 4;
+		}
+
+		uint32_t version = 2;
+		out.write("glTF", 4);
+		out.write(reinterpret_cast<const char*>(&version), 4);
+		out.write(reinterpret_cast<const char*>(&glbLength), 4);
+
+		out.write(reinterpret_cast<const char*>(&jsonChunkLength), 4);
+		out.write("JSON", 4);
+		out.write(json.data(), json.size());
+		const char spaces[8] = { ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ' };
+		out.write(spaces, jsonChunkLength - json.size());
+
+		if (binChunkLength > 0)
+		{
+			out.write(reinterpret_cast<const char*>(&binChunkLength), 4);
+			out.write("BIN\0", 4);
+			writeBuffer(out);
+			const char zeroes[4] = { 0, 0, 0, 0 };
+			out.write(zeroes, binChunkLength - bufferLength);
 		}
 	}
 }
\ No newline at end of file
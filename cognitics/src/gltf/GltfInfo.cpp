@@ -4,7 +4,7 @@ namespace gltf
 {
 
 	GltfInfo::GltfInfo(std::string filename, GeoRect& pos, double zRotation) :
-		name(filename), bounds(pos), gltfBinary(true), embedTextures(true), angle(zRotation)
+		name(filename), bounds(pos), gltfBinary(true), embedTextures(true), quantize(false), base64Buffers(false), angle(zRotation), coordTrans(NULL)
 	{
 	}
 
@@ -146,77 +146,6 @@ namespace gltf
 		file.seekp(currentPos);
 	}
 
-	void GltfInfo::writeGltfBinaryHeader()
-	{
-		gltfStart = file.tellp();
-		file << "glTF";
-		unsigned int version = 2;
-		file.write(reinterpret_cast<char*>(&version), 4);
-
-		//placeholder that will be overwritten with total file size 
-		gltfSizePos = file.tellp();
-		file << "plhd";
-
-		//chunk header
-		//placeholder for chunk size
-		jsonChunkSizePos = file.tellp();
-		file << "plhd";
-		file << "JSON";
-		jsonChunkStart = file.tellp();
-	}
-
-	void GltfInfo::finalizeJsonChunk()
-	{
-		file.seekp(0, std::ios_base::end);
-		addPadding(' ', 4);
-
-		std::streampos currentPos = file.tellp();
-
-		//write chunk size
-		unsigned int chunkSize = currentPos - jsonChunkStart;
-		file.seekp(jsonChunkSizePos);
-		file.write(reinterpret_cast<char*>(&chunkSize), 4);
-
-		file.seekp(currentPos);
-	}
-
-	void GltfInfo::beginBinaryChunk()
-	{
-		//placeholder for chunk size
-		binChunkSizePos = file.tellp();
-		file << "plhd";
-		file << "BIN";
-		const char zero = 0;
-		file.write(&zero, 1);
-		binChunkStart = file.tellp();
-	}
-
-	void GltfInfo::finalizeBinaryChunk()
-	{
-		addPadding('\0', 4);
-
-		std::streampos currentPos = file.tellp();
-
-		//write chunk size
-		unsigned int chunkSize = currentPos - binChunkStart;
-		file.seekp(binChunkSizePos);
-		file.write(reinterpret_cast<char*>(&chunkSize), 4);
-
-		file.seekp(currentPos);
-
-	}
-
-	void GltfInfo::finalizeGltfBinarySizes()
-	{
-		std::streampos currentPos = file.tellp();
-
-		unsigned int gltfSize = fileEnd - gltfStart;
-		file.seekp(gltfSizePos);
-		file.write(reinterpret_cast<char*>(&gltfSize), 4);
-
-		file.seekp(currentPos);
-	}
-
 	bool GltfInfo::init()
 	{
 		wgs.SetFromUserInput("WGS84");
@@ -296,22 +225,10 @@ namespace gltf
 		{
 			writeFeatureTable();
 		}
-
-		if (gltfBinary)
-		{
-			writeGltfBinaryHeader();
-		}
-
-		file.flush();
 	}
 
 	void GltfInfo::finalizeFile()
 	{
-		if (gltfBinary)
-		{
-			finalizeBinaryChunk();
-		}
-
 		fileEnd = file.tellp();
 
 		if (format == "b3dm")
@@ -324,11 +241,13 @@ namespace gltf
 			//TODO
 		}
 
-		if (gltfBinary)
-		{
-			finalizeGltfBinarySizes();
-		}
-
 		file.close();
 	}
+
+	std::string GltfInfo::getBufferFileName(bool fullPath) const
+	{
+		ccl::FileInfo fi(name);
+		std::string bufferName = fi.getBaseName(true) + ".bin";
+		return fullPath ? ccl::joinPaths(fi.getDirName(), bufferName) : bufferName;
+	}
 }
\ No newline at end of file
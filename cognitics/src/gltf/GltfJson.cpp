@@ -1,14 +1,16 @@
 #include "gltf/GltfJson.h"
+#include "b64/base64.h"
+#include <algorithm>
+#include <cstring>
 
 namespace gltf
 {
 
-	bool GltfJson::write()
+	bool GltfJson::write(std::string& out_json)
 	{
-		FILE* gltfFilePointer = fopen(data.info.name.c_str(), "ab");
-		char writeBuffer[65536];
-		rapidjson::FileWriteStream jsonOutStream(gltfFilePointer, writeBuffer, sizeof(writeBuffer));
-		rapidjson::Writer<rapidjson::FileWriteStream> jsonWriter(jsonOutStream);
+		rapidjson::StringBuffer buffer;
+		JsonWriter jsonWriter(buffer);
+		jsonBuffer = &buffer;
 
 		jsonWriter.StartObject();
 
@@ -21,16 +23,18 @@ namespace gltf
 		writeBuffers(jsonWriter);
 		writeBufferViews(jsonWriter);
 		writeAccessors(jsonWriter);
+		writeExtensions(jsonWriter);
 		writeAsset(jsonWriter);
 
 		jsonWriter.EndObject();
 
-		fclose(gltfFilePointer);
+		jsonBuffer = NULL;
+		out_json.assign(buffer.GetString(), buffer.GetSize());
 
 		return true;
 	}
 
-	void GltfJson::writeScenes(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeScenes(JsonWriter& jsonWriter)
 	{
 		int nodeIndex = 0;
 		jsonWriter.Key("scenes");
@@ -44,7 +48,7 @@ namespace gltf
 		jsonWriter.EndArray();//scenes
 	}
 
-	void GltfJson::writeNodes(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeNodes(JsonWriter& jsonWriter)
 	{
 		int meshIndex = 0;
 		jsonWriter.Key("nodes");
@@ -58,25 +62,30 @@ namespace gltf
 
 		//cesium applies y-up to z-up transform for 3dtiles
 		//need to compensate for that here
-		jsonWriter.Int(1.0);
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(0.0);
-
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(-1.0);
-		jsonWriter.Int(0.0);
-
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(1.0);
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(0.0);
-
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(0.0);
-		jsonWriter.Int(1.0);
+		double matrix[16] = {
+			1.0, 0.0, 0.0, 0.0,
+			0.0, 0.0, -1.0, 0.0,
+			0.0, 1.0, 0.0, 0.0,
+			0.0, 0.0, 0.0, 1.0 };
+		if (data.quantized)
+		{
+			//quantized positions are restored by scale and offset before the y-up compensation
+			const double* scale = data.positionScale;
+			const double* offset = data.positionOffset;
+			matrix[0] = scale[0];
+			matrix[6] = -scale[1];
+			matrix[9] = scale[2];
+			matrix[12] = offset[0];
+			matrix[13] = offset[2];
+			matrix[14] = -offset[1];
+		}
+		for (int i = 0; i < 16; ++i)
+		{
+			if (data.quantized)
+				jsonWriter.Double(matrix[i]);
+			else
+				jsonWriter.Int(static_cast<int>(matrix[i]));
+		}
 
 		jsonWriter.EndArray();//matrix
 
@@ -84,7 +93,7 @@ namespace gltf
 		jsonWriter.EndArray();//nodes
 	}
 
-	void GltfJson::writeMeshes(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeMeshes(JsonWriter& jsonWriter)
 	{
 		jsonWriter.Key("meshes");
 		jsonWriter.StartArray();
@@ -94,20 +103,22 @@ namespace gltf
 
 		for (int p = 0; p < data.primitives.size(); ++p)
 		{
-			int vertexAccessorIndex = p * 4;
+			const GltfPrimitive& prim = data.primitives[p];
 			jsonWriter.StartObject();
 			jsonWriter.Key("material");
 			jsonWriter.Int(p);
+			jsonWriter.Key("indices");
+			jsonWriter.Int(prim.indexAccessor);
 			jsonWriter.Key("attributes");
 			jsonWriter.StartObject();
 			jsonWriter.Key("POSITION");
-			jsonWriter.Int(vertexAccessorIndex);
+			jsonWriter.Int(prim.positionAccessor);
 			jsonWriter.Key("NORMAL");
-			jsonWriter.Int(vertexAccessorIndex + 1);
+			jsonWriter.Int(prim.normalAccessor);
 			jsonWriter.Key("TEXCOORD_0");
-			jsonWriter.Int(vertexAccessorIndex + 2);
+			jsonWriter.Int(prim.uvAccessor);
 			jsonWriter.Key("_BATCHID");
-			jsonWriter.Int(vertexAccessorIndex + 3);
+			jsonWriter.Int(prim.batchAccessor);
 			jsonWriter.EndObject();//attributes
 			jsonWriter.EndObject();//primitive
 		}
@@ -117,7 +128,7 @@ namespace gltf
 		jsonWriter.EndArray();//meshes
 	}
 
-	void GltfJson::writeMaterials(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeMaterials(JsonWriter& jsonWriter)
 	{
 		float roughnessFactor = 1;
 		float metallicFactor = 0;
@@ -148,7 +159,7 @@ namespace gltf
 		jsonWriter.EndArray();//materials
 	}
 
-	void GltfJson::writeTextures(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeTextures(JsonWriter& jsonWriter)
 	{
 		jsonWriter.Key("textures");
 		jsonWriter.StartArray();
@@ -162,7 +173,7 @@ namespace gltf
 		jsonWriter.EndArray();//textures
 	}
 
-	void GltfJson::writeImages(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeImages(JsonWriter& jsonWriter)
 	{
 		jsonWriter.Key("images");
 		jsonWriter.StartArray();
@@ -171,10 +182,10 @@ namespace gltf
 			ccl::FileInfo fi(data.primitives[p].textureName);
 
 			jsonWriter.StartObject();
-			if (data.info.embedTextures)
+			if (data.primitives[p].imageBufferView >= 0)
 			{
 				jsonWriter.Key("bufferView");
-				jsonWriter.Int( (p * 5) + 4);
+				jsonWriter.Int(data.primitives[p].imageBufferView);
 				jsonWriter.Key("mimeType");
 				if (fi.getSuffix() == "jpg" || fi.getSuffix() == "jpeg")
 				{
@@ -204,180 +215,195 @@ namespace gltf
 		jsonWriter.EndArray();//images
 	}
 
-	void GltfJson::writeBuffers(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeBuffers(JsonWriter& jsonWriter)
 	{
-		int totalBufferLength = 0;
-		for (int p = 0; p < data.primitives.size(); ++p)
+		jsonWriter.Key("buffers");
+		jsonWriter.StartArray();
+		if (data.bufferLength > 0)
 		{
-			totalBufferLength += data.primitives[p].vertexBufferLength
-				+ data.primitives[p].normalsBufferLength
-				+ data.primitives[p].uvBufferLength
-				+ data.primitives[p].batchBufferLength;
-			if (data.info.embedTextures)
+			jsonWriter.StartObject();
+			if (data.info.gltfBinary)
 			{
-				totalBufferLength += data.primitives[p].textureBufferLength;
+				jsonWriter.Key("name");
+				jsonWriter.String("buffer");
+			}
+			jsonWriter.Key("byteLength");
+			jsonWriter.Int(data.bufferLength);
+			if (!data.info.gltfBinary)
+			{
+				jsonWriter.Key("uri");
+				if (data.info.base64Buffers)
+				{
+					writeBase64Uri(jsonWriter, *jsonBuffer);
+				}
+				else
+				{
+					jsonWriter.String(data.info.getBufferFileName(false).c_str());
+				}
 			}
+			jsonWriter.EndObject();//buffer
 		}
-		jsonWriter.Key("buffers");
-		jsonWriter.StartArray();
-		jsonWriter.StartObject();
-		if (data.info.gltfBinary)
+		jsonWriter.EndArray();//buffers
+	}
+
+	void GltfJson::writeBase64Uri(JsonWriter& jsonWriter, rapidjson::StringBuffer& jsonBuffer)
+	{
+		// the data uri is encoded block by block straight from the buffer views into the document,
+		// so the buffer is never assembled as a whole before encoding;
+		// blocks are a multiple of 3 bytes so the encoded blocks concatenate without inner padding
+		jsonWriter.RawValue("\"", 1, rapidjson::kStringType);
+		const std::string prefix("data:application/octet-stream;base64,");
+		memcpy(jsonBuffer.Push(prefix.size()), prefix.data(), prefix.size());
+
+		const size_t blockSize = 3 * 16384;
+		std::string block;
+		block.reserve(blockSize + 4);
+		auto flush = [&](bool last)
 		{
-			jsonWriter.Key("name");
-			jsonWriter.String("buffer");
-		}
-		jsonWriter.Key("byteLength");
-		jsonWriter.Int(totalBufferLength);
-		if (!data.info.gltfBinary)
+			size_t encodeLength = last ? block.size() : blockSize;
+			std::string encoded = base64Encode(block.substr(0, encodeLength));
+			memcpy(jsonBuffer.Push(encoded.size()), encoded.data(), encoded.size());
+			block.erase(0, encodeLength);
+		};
+		const char padding[4] = { 0, 0, 0, 0 };
+		for (size_t v = 0; v < data.bufferViews.size(); ++v)
 		{
-			jsonWriter.Key("uri");
-			std::string base64Data;
-			data.getBase64BufferData(base64Data);
-			std::string dataMimeType = "data:application/octet-stream;base64,";
-			base64Data.insert(0, dataMimeType);
-			jsonWriter.String(base64Data.c_str());
+			const GltfBufferView& view = data.bufferViews[v];
+			size_t offset = 0;
+			while (offset < size_t(view.byteLength))
+			{
+				size_t count = std::min<size_t>(blockSize - std::min<size_t>(blockSize, block.size()), view.byteLength - offset);
+				block.append(view.data + offset, count);
+				offset += count;
+				if (block.size() >= blockSize)
+				{
+					flush(false);
+				}
+			}
+			block.append(padding, ((view.byteLength + 3) & ~3) - view.byteLength);
+			if (block.size() >= blockSize)
+			{
+				flush(false);
+			}
 		}
-		jsonWriter.EndObject();//buffer
-		jsonWriter.EndArray();//buffers
+		flush(true);
+		jsonBuffer.Put('"');
 	}
 
-	void GltfJson::writeBufferViews(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeBufferViews(JsonWriter& jsonWriter)
 	{
-		const int arrayBufferTarget = 34962;
-		const int elementArrayBufferTarget = 34963;
-
-		int currentOffset = 0;
-
 		jsonWriter.Key("bufferViews");
 		jsonWriter.StartArray();
-		for (int p = 0; p < data.primitives.size(); ++p)
+		for (size_t v = 0; v < data.bufferViews.size(); ++v)
 		{
-			writeBufferView(jsonWriter, currentOffset, data.primitives[p].vertexBufferLength, arrayBufferTarget);
-			currentOffset += data.primitives[p].vertexBufferLength;
-			writeBufferView(jsonWriter, currentOffset, data.primitives[p].normalsBufferLength, arrayBufferTarget);
-			currentOffset += data.primitives[p].normalsBufferLength;
-			writeBufferView(jsonWriter, currentOffset, data.primitives[p].uvBufferLength, arrayBufferTarget);
-			currentOffset += data.primitives[p].uvBufferLength;
-			writeBufferView(jsonWriter, currentOffset, data.primitives[p].batchBufferLength, arrayBufferTarget);
-			currentOffset += data.primitives[p].batchBufferLength;
-			if (data.info.embedTextures)
-			{
-				writeBufferView(jsonWriter, currentOffset, data.primitives[p].textureBufferLength, arrayBufferTarget);
-				currentOffset += data.primitives[p].textureBufferLength;
-			}
+			writeBufferView(jsonWriter, data.bufferViews[v]);
 		}
 		jsonWriter.EndArray();//bufferViews
 	}
 
-	void GltfJson::writeBufferView(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter, int offset, int length, int target)
+	void GltfJson::writeBufferView(JsonWriter& jsonWriter, const GltfBufferView& view)
 	{
 		int bufferIndex = 0;
 		jsonWriter.StartObject();
 		jsonWriter.Key("buffer");
 		jsonWriter.Int(bufferIndex);
 		jsonWriter.Key("byteOffset");
-		jsonWriter.Int(offset);
+		jsonWriter.Int(view.byteOffset);
 		jsonWriter.Key("byteLength");
-		jsonWriter.Int(length);
-		jsonWriter.Key("target");
-		jsonWriter.Int(target);
+		jsonWriter.Int(view.byteLength);
+		if (view.byteStride > 0)
+		{
+			jsonWriter.Key("byteStride");
+			jsonWriter.Int(view.byteStride);
+		}
+		if (view.target > 0)
+		{
+			jsonWriter.Key("target");
+			jsonWriter.Int(view.target);
+		}
 		jsonWriter.EndObject();
 	}
 
-	void GltfJson::writeAccessors(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeAccessors(JsonWriter& jsonWriter)
 	{
-		const int ushortComponentType = 5123;
-		const int floatComponentType = 5126;
-		const std::string scalarType("SCALAR");
-		const std::string vec2Type("VEC2");
-		const std::string vec3Type("VEC3");
-		const std::string mat4Type("MAT4");
-
-		std::vector<unsigned short> zeroesArray;
-		zeroesArray.push_back(0);
-
 		jsonWriter.Key("accessors");
 		jsonWriter.StartArray();
-		for (int p = 0; p < data.primitives.size(); ++p)
+		for (size_t a = 0; a < data.accessors.size(); ++a)
 		{
-			int buffersPerPrimitive = 4;
-			if (data.info.embedTextures)
-			{
-				++buffersPerPrimitive;
-			}
-			int vertexBufferIndex = p * buffersPerPrimitive;
-			jsonWriter.StartObject();
-			writeAccessor(jsonWriter, vertexBufferIndex, floatComponentType, vec3Type, data.primitives[p].numVerts);
-			writeAccessorMinMax(jsonWriter, data.primitives[p].minVertexValues, data.primitives[p].maxVertexValues);
-			jsonWriter.EndObject();
 			jsonWriter.StartObject();
-			writeAccessor(jsonWriter, vertexBufferIndex + 1, floatComponentType, vec3Type, data.primitives[p].numVerts);
-			writeAccessorMinMax(jsonWriter, data.primitives[p].minNormalValues, data.primitives[p].maxNormalValues);
-			jsonWriter.EndObject();
-			jsonWriter.StartObject();
-			writeAccessor(jsonWriter, vertexBufferIndex + 2, floatComponentType, vec2Type, data.primitives[p].numVerts);
-			writeAccessorMinMax(jsonWriter, data.primitives[p].minUvValues, data.primitives[p].maxUvValues);
-			jsonWriter.EndObject();
-			jsonWriter.StartObject();
-			writeAccessor(jsonWriter, vertexBufferIndex + 3, ushortComponentType, scalarType, data.primitives[p].numVerts);
-			writeAccessorMinMax(jsonWriter, zeroesArray, zeroesArray);
+			writeAccessor(jsonWriter, data.accessors[a]);
+			writeAccessorMinMax(jsonWriter, data.accessors[a]);
 			jsonWriter.EndObject();
 		}
 		jsonWriter.EndArray();
 	}
 
-	void GltfJson::writeAccessor(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter, int bufferViewIndex, int componentType, std::string type, int numVerts)
+	void GltfJson::writeAccessor(JsonWriter& jsonWriter, const GltfAccessor& accessor)
 	{
 		int byteOffset = 0;
 		jsonWriter.Key("bufferView");
-		jsonWriter.Int(bufferViewIndex);
+		jsonWriter.Int(accessor.bufferView);
 		jsonWriter.Key("componentType");
-		jsonWriter.Int(componentType);
+		jsonWriter.Int(accessor.componentType);
+		if (accessor.normalized)
+		{
+			jsonWriter.Key("normalized");
+			jsonWriter.Bool(true);
+		}
 		jsonWriter.Key("type");
-		jsonWriter.String(type.c_str());
+		jsonWriter.String(accessor.type.c_str());
 		jsonWriter.Key("byteOffset");
 		jsonWriter.Int(byteOffset);
 		jsonWriter.Key("count");
-		jsonWriter.Int(numVerts);
+		jsonWriter.Int(accessor.count);
 	}
 
-	void GltfJson::writeAccessorMinMax(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter, std::vector<unsigned short>& min, std::vector<unsigned short>& max)
+	void GltfJson::writeAccessorMinMax(JsonWriter& jsonWriter, const GltfAccessor& accessor)
 	{
+		if (accessor.min.empty() || accessor.max.empty())
+		{
+			return;
+		}
+		bool integer = (accessor.componentType != GLTF_FLOAT);
 		jsonWriter.Key("min");
 		jsonWriter.StartArray();
-		for (int i = 0; i < min.size(); ++i)
+		for (size_t i = 0; i < accessor.min.size(); ++i)
 		{
-			jsonWriter.Int(min[i]);
+			if (integer)
+				jsonWriter.Int(static_cast<int>(accessor.min[i]));
+			else
+				jsonWriter.Double(accessor.min[i]);
 		}
 		jsonWriter.EndArray();
 		jsonWriter.Key("max");
 		jsonWriter.StartArray();
-		for (int i = 0; i < max.size(); ++i)
+		for (size_t i = 0; i < accessor.max.size(); ++i)
 		{
-			jsonWriter.Int(max[i]);
+			if (integer)
+				jsonWriter.Int(static_cast<int>(accessor.max[i]));
+			else
+				jsonWriter.Double(accessor.max[i]);
 		}
 		jsonWriter.EndArray();
 	}
 
-	void GltfJson::writeAccessorMinMax(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter, std::vector<float>& min, std::vector<float>& max)
+	void GltfJson::writeExtensions(JsonWriter& jsonWriter)
 	{
-		jsonWriter.Key("min");
-		jsonWriter.StartArray();
-		for (int i = 0; i < min.size(); ++i)
+		if (!data.quantized)
 		{
-			jsonWriter.Double(min[i]);
+			return;
 		}
+		jsonWriter.Key("extensionsUsed");
+		jsonWriter.StartArray();
+		jsonWriter.String("KHR_mesh_quantization");
 		jsonWriter.EndArray();
-		jsonWriter.Key("max");
+		jsonWriter.Key("extensionsRequired");
 		jsonWriter.StartArray();
-		for (int i = 0; i < max.size(); ++i)
-		{
-			jsonWriter.Double(max[i]);
-		}
+		jsonWriter.String("KHR_mesh_quantization");
 		jsonWriter.EndArray();
 	}
 
-	void GltfJson::writeAsset(rapidjson::Writer<rapidjson::FileWriteStream>& jsonWriter)
+	void GltfJson::writeAsset(JsonWriter& jsonWriter)
 	{
 		jsonWriter.Key("asset");
 		jsonWriter.StartObject();
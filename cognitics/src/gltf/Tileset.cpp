@@ -4,9 +4,7 @@
 
 namespace gltf
 {
-	std::vector<TileInfo> Tileset::tiles;
-
-	void Tileset::GetRadianRectFromExtRef(TileInfo& ref, GeoRect & out_rect)
+	void Tileset::GetRadianRectFromExtRef(const TileInfo& ref, GeoRect & out_rect)
 	{
 		double pi = 3.14159265358979323846264338327950288;
 
@@ -16,7 +14,7 @@ namespace gltf
 		out_rect.north = ref.north	* pi / 180;
 	}
 
-	void Tileset::writeLeafChild(rapidjson::PrettyWriter<rapidjson::FileWriteStream>& writer, TileInfo& ref, int geometricError)
+	void Tileset::writeLeafChild(rapidjson::PrettyWriter<rapidjson::FileWriteStream>& writer, const TileInfo& ref, int geometricError)
 	{
 
 		writer.StartObject();
@@ -49,7 +47,7 @@ namespace gltf
 	}
 
 	void Tileset::writeLods(rapidjson::PrettyWriter<rapidjson::FileWriteStream>& writer, 
-		TileInfo& ref, int geometricError)
+		const TileInfo& ref, int geometricError)
 	{
 
 		writer.StartObject();
@@ -115,6 +113,12 @@ namespace gltf
 		double pi = 3.14159265358979323846264338327950288;
 		int baseError = 65536;
 
+		if (tiles.empty())
+		{
+			std::cout << "Tileset: no tiles to write" << std::endl;
+			return;
+		}
+
 		FILE* fp = fopen(name.c_str(), "wb");
 		char writeBuffer[65536];
 		rapidjson::FileWriteStream os(fp, writeBuffer, sizeof(writeBuffer));
@@ -171,7 +175,7 @@ namespace gltf
 				ccl::FileInfo fi(tiles[i].relativePathName);
 				std::string quadkey = fi.getBaseName(true);
 				tileLods.insert(std::pair<std::string, 
-					TileInfo&>(quadkey, tiles[i]));
+					const TileInfo&>(quadkey, tiles[i]));
 				maxLod = std::max<int>(maxLod, quadkey.size());
 			}
 			else
@@ -24,6 +24,7 @@ DEALINGS IN THE SOFTWARE.
 
 #include <float.h>
 #include <ccl/StringUtils.h>
+#include <ccl/Status.h>
 #include "ip/GDALRasterReader.h"
 #include <sfa_file_factory/sfa_file_factory.h>
 #include <cts/FlatEarthProjection.h>
@@ -104,7 +105,7 @@ namespace gdalsampler
         return theInstance.get();
     }
 
-    CacheManager::CacheManager()
+    CacheManager::CacheManager() : _publishedMemory(0)
     {
         _blockCache.clear();
         _altBlockCache.clear();
@@ -543,19 +544,19 @@ namespace gdalsampler
                     // This is a cheat to approximate edges where the pixel is partially outside the boundary of the file's valid area
                     if(!_validArea.isEmpty())
                     {
-                        if(!_validArea.intersects(&thePixel.coveredArea.ul))
+                        if(!_preparedValidArea.covers(thePixel.coveredArea.ul.X(), thePixel.coveredArea.ul.Y()))
                         {
                             valid_area_weight -= .25;
                         }
-                        if(!_validArea.intersects(&thePixel.coveredArea.ur))
+                        if(!_preparedValidArea.covers(thePixel.coveredArea.ur.X(), thePixel.coveredArea.ur.Y()))
                         {
                             valid_area_weight -= .25;
                         }
-                        if(!_validArea.intersects(&thePixel.coveredArea.lr))
+                        if(!_preparedValidArea.covers(thePixel.coveredArea.lr.X(), thePixel.coveredArea.lr.Y()))
                         {
                             valid_area_weight -= .25;
                         }
-                        if(!_validArea.intersects(&thePixel.coveredArea.ll))
+                        if(!_preparedValidArea.covers(thePixel.coveredArea.ll.X(), thePixel.coveredArea.ll.Y()))
                         {
                             valid_area_weight -= .25;
                         }
@@ -675,10 +676,20 @@ namespace gdalsampler
         return true;
     }
 
+    void CacheManager::PublishMemoryInUse()
+    {
+        int memory = GetMemoryInUse();
+        COGNITICS_STATUS_LEVEL("raster cache bytes", memory - _publishedMemory);
+        _publishedMemory = memory;
+    }
+
     bool CacheManager::PageBlock(CachedRasterBlockPtr &block)
     {
         if(block->IsReady())
+        {
+            COGNITICS_STATUS_COUNT("raster cache hits", 1);
             return true;
+        }
 
         int blocksize = (block->xsize * block->ysize * 3);
         CachedRasterBlockList::iterator block_iter = _altBlockCache.begin();
@@ -691,6 +702,7 @@ namespace gdalsampler
                 block->age = 0;
                 if(block->IsReady())
                 {
+                    COGNITICS_STATUS_COUNT("raster cache hits", 1);
                     return true;
                 }
                 else
@@ -698,6 +710,8 @@ namespace gdalsampler
                     MakeCacheRoom(blocksize);
                     //printf("ReadBlock(in): %s %d,%d %d,%d\n", block->m_filename.c_str(), block->xoffset, block->yoffset, block->xsize, block->ysize);
                     block->ReadBlock();
+                    COGNITICS_STATUS_COUNT("raster cache misses", 1);
+                    PublishMemoryInUse();
                     return true;
                 }
             }
@@ -710,6 +724,8 @@ namespace gdalsampler
         _altBlockCache.push_back(block);
         //printf("ReadBlock(out): %s %d,%d %d,%d\n", block->m_filename.c_str(), block->xoffset, block->yoffset, block->xsize, block->ysize);
         block->ReadBlock();
+        COGNITICS_STATUS_COUNT("raster cache misses", 1);
+        PublishMemoryInUse();
         return true;
     }
 
@@ -1009,6 +1025,7 @@ namespace gdalsampler
     void GDALRasterFile::SetValidArea(sfa::Polygon validarea) 
     {
         _validArea = validarea;        
+        _preparedValidArea.setGeometry(&_validArea);
         sfa::Geometry *envelope = _validArea.getEnvelope();
         sfa::LineString *ls = dynamic_cast<sfa::LineString *>(envelope);
         if(ls && ls->getNumPoints()>1)
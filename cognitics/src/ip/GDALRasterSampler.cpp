@@ -41,7 +41,7 @@ DEALINGS IN THE SOFTWARE.
 
 #include <cdb_util/cdb_util.h>
 
-GDALRasterSampler::GDALRasterSampler() : bsp(NULL)
+GDALRasterSampler::GDALRasterSampler() : rtree(NULL)
 {
     log.init("GDALRasterSampler", this);
     log << ccl::LERR;
@@ -233,9 +233,9 @@ IppStatus WarpPerspective_32f_C1R(Ipp32f *pSrc, IppiSize srcSize, Ipp32s srcStep
 gdalsampler::GDALRasterFileList GDALRasterSampler::GetFilesInAOI(gdalsampler::Quad &aoi)
 {
     gdalsampler::GDALRasterFileList ret;
-    bspMutex.lock();
+    rtreeMutex.lock();
     //aoi is in dest coordinates
-    sfa::BSPCollectGeometriesVisitor visitor;
+    sfa::RTreeCollectGeometriesVisitor visitor;
 
     double top = -DBL_MAX;
     double bottom = DBL_MAX;
@@ -245,7 +245,7 @@ gdalsampler::GDALRasterFileList GDALRasterSampler::GetFilesInAOI(gdalsampler::Qu
     //printf("Searching for files in left: %f right: %f top: %f bottom: %f\n", left, right, top, bottom);
 
     visitor.setBounds(left, bottom, right, top);
-    visitor.visiting(bsp);
+    visitor.visiting(rtree);
 
     visitor.results;
     std::list<sfa::Geometry *>::iterator geom_iter = visitor.results.begin();
@@ -265,25 +265,25 @@ gdalsampler::GDALRasterFileList GDALRasterSampler::GetFilesInAOI(gdalsampler::Qu
             ret.push_back(file);
         }
     }
-    bspMutex.unlock();
+    rtreeMutex.unlock();
     return ret;
 }
 
-bool GDALRasterSampler::BuildBSP(bool rebuild)
+bool GDALRasterSampler::BuildRTree(bool rebuild)
 {
-    bspMutex.lock();
-    if (!rebuild && bsp)
+    rtreeMutex.lock();
+    if (!rebuild && rtree)
     {
-        bspMutex.unlock();
+        rtreeMutex.unlock();
         return true;
     }
-    //Clean up a previous bsp if it exists
-    if (bsp)
+    //Clean up a previous rtree if it exists
+    if (rtree)
     {
-        delete bsp;
-        bsp = NULL;
+        delete rtree;
+        rtree = NULL;
     }
-    bsp = new sfa::BSP;
+    rtree = new sfa::RTree;
     aoimap_t::iterator aoi_iter = aoiFileMap.begin();
     while (aoi_iter != aoiFileMap.end())
     {
@@ -292,7 +292,7 @@ bool GDALRasterSampler::BuildBSP(bool rebuild)
     }
     aoiFileMap.clear();
     gdalsampler::GDALRasterFileList &files = m_reader.GetFiles();
-    //printf("Putting %d files in a bsp\n", files.size());
+    //printf("Putting %d files in an rtree\n", files.size());
     gdalsampler::GDALRasterFileList::iterator file_iter = files.begin();
     while (file_iter != files.end())
     {
@@ -313,11 +313,10 @@ bool GDALRasterSampler::BuildBSP(bool rebuild)
         aoi_poly->addRing(ring);
         //Keep track of the geometry and its associated file
         aoiFileMap[aoi_poly] = file;
-        bsp->addGeometry(aoi_poly);
+        rtree->addGeometry(aoi_poly, left, bottom, right, top);
     }
-    std::map<sfa::Geometry *, sfa::LineString *> envelopes;
-    bsp->generate(envelopes);
-    bspMutex.unlock();
+    rtree->generate();
+    rtreeMutex.unlock();
     return true;
 }
 
@@ -334,8 +333,8 @@ bool GDALRasterSampler::AddFile(std::string file)
     std::string fileext = fi.getSuffix();
     std::string ext = ToLower(fileext);
     bool result = m_reader.AddFile(file);
-    if(result && bsp)
-        BuildBSP(true);
+    if(result && rtree)
+        BuildRTree(true);
     return result;
 }
 
@@ -345,8 +344,8 @@ bool GDALRasterSampler::RemoveFile(std::string file)
     std::string fileext = fi.getSuffix();
     std::string ext = ToLower(fileext);
     bool result = m_reader.RemoveFile(file);
-    if(result && bsp)
-        BuildBSP(true);
+    if(result && rtree)
+        BuildRTree(true);
     return result;
 }
 
@@ -382,8 +381,8 @@ bool GDALRasterSampler::AddDirectory(std::string dir, std::set<std::string> exte
             }
         }
     }
-    if(ret && bsp)
-        BuildBSP(true);
+    if(ret && rtree)
+        BuildRTree(true);
     return ret;
 }
 // Add a coverage file used to specify valid pixels in the source imagery
@@ -627,9 +626,9 @@ bool GDALRasterSampler::SampleIPP(const gdalsampler::GeoExtents &window, u_char
     bool ret = false;
 #ifdef USE_IPP_LIBRARY
 
-    if (!bsp)
+    if (!rtree)
     {
-        BuildBSP(false);
+        BuildRTree(false);
     }
 
     int scratchlen = window.width*window.height;
@@ -755,9 +754,9 @@ bool GDALRasterSampler::SampleIPP(const gdalsampler::GeoExtents &window, float *
     bool ret = false;
 #ifdef USE_IPP_LIBRARY
 
-    if (!bsp)
+    if (!rtree)
     {
-        BuildBSP(false);
+        BuildRTree(false);
     }
 
     int scratchlen = window.width * window.height;
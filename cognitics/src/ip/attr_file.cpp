@@ -5,6 +5,9 @@ Copyright 2017 Cognitics, Inc.
 //#pragma optimize( "", off )
 
 #include "ip/attr.h"
+#include <ccl/ByteReader.h>
+#include <ccl/MappedFile.h>
+#include <algorithm>
 #include <fstream>
 
 namespace ip {
@@ -165,81 +168,76 @@ namespace ip {
         std::string ext = filename.substr(filename.find_last_of(".") + 1);
         if (ext.compare("attr") != 0) return false;
 
-        std::ifstream in;
-        in.open(filename.c_str(), std::ios::in | std::ios::binary );
-        
-        if (!in.is_open()) return false;
+        ccl::MappedFile file;
+        if (!file.open(filename)) return false;
+        ccl::ByteReader in(file.data(), file.size());
 
-        in >> u_size;
-        in >> v_size;
-        in >> u_scale;
-        in >> v_scale;
-        in >> up_x;
-        in >> up_y;
-        in >> fileFormat;
-        in >> minFilterMode;
-        in >> magFilterMode;
-        in >> wrapMode;
-        in >> wrapMode_u;
-        in >> wrapMode_v;
-        in >> modifyFlag;
-        in >> x_pivot;
-        in >> y_pivot;
-        in >> texEnvMode;
-        in >> intensityAsAlpha;
-        in.ignore(32);
+        in.read(u_size);
+        in.read(v_size);
+        in.read(u_scale);
+        in.read(v_scale);
+        in.read(up_x);
+        in.read(up_y);
+        in.read(fileFormat);
+        in.read(minFilterMode);
+        in.read(magFilterMode);
+        in.read(wrapMode);
+        in.read(wrapMode_u);
+        in.read(wrapMode_v);
+        in.read(modifyFlag);
+        in.read(x_pivot);
+        in.read(y_pivot);
+        in.read(texEnvMode);
+        in.read(intensityAsAlpha);
+        in.skip(32);
         //Not sure what is supposed to be here, but this is what OSG does, and it is the only way the rest of the data makes sense.
-        in.ignore(4);
-        in >> float_u_size;
-        in >> float_v_size;
-        in >> originCode;
-        in >> kernelVersion;
-        in >> internalFormat;
-        in >> externalFormat;
-        in >> useMipmap;
-        for (int i = 0; i < 8; i++) in >> mipmap[i];
-        in >> useLodScale;
-        for (int i = 0; i < 16; i++) in >> lodScale[i];
-        in >> clamp;
-        in >> magFilterAlpha;
-        in >> magFilterColor;
-        in.ignore(36);
-        in >> lambertMeridian;
-        in >> lambertUpperLat;
-        in >> lambertLowerLat;
-        in.ignore(28);
-        in >> useDetail;
-        in >> detail_j;
-        in >> detail_k;
-        in >> detail_m;
-        in >> detail_n;
-        in >> detail_s;
-        in >> useTile;
-        in >> txTile_ll_u;
-        in >> txTile_ll_v;
-        in >> txTile_ur_u;
-        in >> txTile_ur_v;
-        in >> projection;
-        in >> earthModel;
-        in.ignore(4);
-        in >> utmZone;
-        in >> imageOrigin;
-        in >> geoUnits;
-        in.ignore(8);
-        in >> hemisphere;
-        in.ignore(604);
+        in.skip(4);
+        in.read(float_u_size);
+        in.read(float_v_size);
+        in.read(originCode);
+        in.read(kernelVersion);
+        in.read(internalFormat);
+        in.read(externalFormat);
+        in.read(useMipmap);
+        for (int i = 0; i < 8; i++) in.read(mipmap[i]);
+        in.read(useLodScale);
+        for (int i = 0; i < 16; i++) in.read(lodScale[i]);
+        in.read(clamp);
+        in.read(magFilterAlpha);
+        in.read(magFilterColor);
+        in.skip(36);
+        in.read(lambertMeridian);
+        in.read(lambertUpperLat);
+        in.read(lambertLowerLat);
+        in.skip(28);
+        in.read(useDetail);
+        in.read(detail_j);
+        in.read(detail_k);
+        in.read(detail_m);
+        in.read(detail_n);
+        in.read(detail_s);
+        in.read(useTile);
+        in.read(txTile_ll_u);
+        in.read(txTile_ll_v);
+        in.read(txTile_ur_u);
+        in.read(txTile_ur_v);
+        in.read(projection);
+        in.read(earthModel);
+        in.skip(4);
+        in.read(utmZone);
+        in.read(imageOrigin);
+        in.read(geoUnits);
+        in.skip(8);
+        in.read(hemisphere);
+        in.skip(604);
 
-        char buf[512];
-        in.read(buf,512);
-        buf[511] = '\0';
-        comments = buf;
+        std::string_view comment = in.readCString(512);
+        comments.assign(comment.data(), std::min<size_t>(comment.size(), 511));
 
-        in.ignore(56);
-        in >> attrVersion;
-        in >> controlPoints;
-        in >> numSubTextures;
-
-        in.close();
+        in.skip(56);
+        in.read(attrVersion);
+        in.read(controlPoints);
+        in.read(numSubTextures);
 
         if (float_u_size == 0 && u_scale == 0)
         {
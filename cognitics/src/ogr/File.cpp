@@ -25,6 +25,8 @@ DEALINGS IN THE SOFTWARE.
 #include <sfa/sfa.h>
 #include <sfa_file_factory/sfa_file_factory.h>
 
+#include <algorithm>
+
 #pragma warning ( push )
 #pragma warning ( disable : 4251 )		// C4251: 'GDALColorTable::aoEntries' : class 'std::vector<_Ty>' needs to have dll-interface to be used by clients of class 'GDALColorTable'
 #include <ogr_api.h>
@@ -238,21 +240,56 @@ namespace ogr
 		if(!feature || !feature->geometry)
 			return NULL;
 
-		// this is pretty inefficient
-		bool is3D = feature->geometry->is3D();
-		bool isMeasured = feature->geometry->isMeasured();
+		sfa::Layer *layer = getLayerForGeometry(feature->geometry);
+		if(!layer)
+			return NULL;
+		return layer->addFeature(feature);
+	}
+
+	size_t File::addFeatures(const std::vector<sfa::Feature *> &features)
+	{
+		if(!dataSource)
+			return 0;
+
+		// group by target layer so each layer writes its features in a single batch
+		std::vector<sfa::Layer *> targets;
+		std::vector<std::vector<sfa::Feature *> > batches;
+		for(size_t i = 0, c = features.size(); i < c; ++i)
+		{
+			sfa::Feature *feature = features[i];
+			if(!feature || !feature->geometry)
+				continue;
+			sfa::Layer *layer = getLayerForGeometry(feature->geometry);
+			if(!layer)
+				continue;
+			size_t index = std::find(targets.begin(), targets.end(), layer) - targets.begin();
+			if(index == targets.size())
+			{
+				targets.push_back(layer);
+				batches.push_back(std::vector<sfa::Feature *>());
+			}
+			batches[index].push_back(feature);
+		}
+
+		size_t result = 0;
+		for(size_t i = 0, c = targets.size(); i < c; ++i)
+			result += targets[i]->addFeatures(batches[i]);
+		return result;
+	}
+
+	sfa::Layer *File::getLayerForGeometry(sfa::Geometry *geometry)
+	{
+		bool is3D = geometry->is3D();
+		bool isMeasured = geometry->isMeasured();
 
 		for(sfa::LayerList::iterator it = layers.begin(), end = layers.end(); it != end; ++it)
 		{
 			sfa::Layer *layer = *it;
-			if(layer->getType() == feature->geometry->getWKBGeometryType(is3D, false))		// ogr doesn't care about measured
-				return layer->addFeature(feature);
+			if(layer->getType() == geometry->getWKBGeometryType(is3D, false))		// ogr doesn't care about measured
+				return layer;
 		}
 
-		sfa::Layer *layer = addLayer(feature->geometry->getGeometryType(), feature->geometry->getWKBGeometryType(is3D, isMeasured), feature->geometry->getCoordinateSystem());
-		if(!layer)
-			return NULL;
-		return layer->addFeature(feature);
+		return addLayer(geometry->getGeometryType(), geometry->getWKBGeometryType(is3D, isMeasured), geometry->getCoordinateSystem());
 	}
 
 	sfa::Layer *File::addLayer(std::string name, sfa::WKBGeometryType type, cts::CS_CoordinateSystem *coordinateSystem)
@@ -24,11 +24,137 @@ DEALINGS IN THE SOFTWARE.
 
 #include "ogr/OGRLayer.h"
 #include "sfa/Feature.h"
+#include "sfa/Factory.h"
 #include <locale>
+#include <cstring>
 #include <ogr/File.h>
+#include <gdal_version.h>
+
+#if defined(GDAL_COMPUTE_VERSION)
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3,6,0)
+#define OGR_LAYER_ARROW_STREAM
+#endif
+#endif
 
 namespace ogr
 {
+	namespace
+	{
+		// getGeometry() returns the member of single-member collections rather than the container
+		sfa::Geometry *unwrapSingleGeometry(sfa::Geometry *geometry)
+		{
+			sfa::GeometryCollection *collection = dynamic_cast<sfa::GeometryCollection *>(geometry);
+			if(!collection || (collection->getNumGeometries() != 1))
+				return geometry;
+			sfa::Geometry *result = collection->getGeometryN(1)->copy();
+			delete collection;
+			return result;
+		}
+
+#ifdef OGR_LAYER_ARROW_STREAM
+		bool arrowIsNull(const struct ArrowArray *column, int64_t index)
+		{
+			const unsigned char *validity = (const unsigned char *)column->buffers[0];
+			if(!validity || (column->null_count == 0))
+				return false;
+			return (validity[index >> 3] & (1 << (index & 7))) == 0;
+		}
+
+		const unsigned char *arrowBinary(const struct ArrowArray *column, int64_t index, bool large, size_t &size)
+		{
+			const unsigned char *data = (const unsigned char *)column->buffers[2];
+			if(large)
+			{
+				const int64_t *offsets = (const int64_t *)column->buffers[1];
+				size = size_t(offsets[index + 1] - offsets[index]);
+				return data + offsets[index];
+			}
+			const int32_t *offsets = (const int32_t *)column->buffers[1];
+			size = size_t(offsets[index + 1] - offsets[index]);
+			return data + offsets[index];
+		}
+
+		// the Arrow formats this reader converts, matched to what readOGRFeature() produces for the field type
+		bool arrowFormatSupported(const char *format, OGRFieldType type)
+		{
+			if(!format[0] || format[1])
+				return false;
+			switch(type)
+			{
+				case OFTInteger:
+					return (format[0] == 'i') || (format[0] == 's') || (format[0] == 'c') || (format[0] == 'b');
+				case OFTReal:
+					return (format[0] == 'g') || (format[0] == 'f');
+				case OFTInteger64:
+					return (format[0] == 'l');
+				case OFTString:
+					return (format[0] == 'u') || (format[0] == 'U');
+				default:
+					return false;
+			}
+		}
+
+		ccl::Variant arrowValue(const struct ArrowArray *column, char format, int64_t index)
+		{
+			switch(format)
+			{
+				case 'i':
+					return ccl::Variant(int(((const int32_t *)column->buffers[1])[index]));
+				case 's':
+					return ccl::Variant(int(((const int16_t *)column->buffers[1])[index]));
+				case 'c':
+					return ccl::Variant(int(((const int8_t *)column->buffers[1])[index]));
+				case 'b':
+					return ccl::Variant(int((((const unsigned char *)column->buffers[1])[index >> 3] >> (index & 7)) & 1));
+				case 'l':
+					return ccl::Variant(std::to_string((long long)((const int64_t *)column->buffers[1])[index]));
+				case 'g':
+					return ccl::Variant(((const double *)column->buffers[1])[index]);
+				case 'f':
+					return ccl::Variant(double(((const float *)column->buffers[1])[index]));
+				default:
+				{
+					size_t size = 0;
+					const unsigned char *text = arrowBinary(column, index, format == 'U', size);
+					return ccl::Variant(std::string((const char *)text, size));
+				}
+			}
+		}
+#endif
+	}
+
+	struct Layer::ArrowReader
+	{
+#ifdef OGR_LAYER_ARROW_STREAM
+		struct ArrowArrayStream stream;
+		struct ArrowSchema schema;
+		struct ArrowArray batch;
+		int64_t row;
+		int geometryColumn;
+		bool largeGeometry;
+		int fidColumn;
+		std::vector<int> fieldColumns;		// arrow column of each layer field, -1 if the stream does not have it
+		std::vector<char> fieldFormats;
+
+		ArrowReader(void) : row(0), geometryColumn(-1), largeGeometry(false), fidColumn(-1)
+		{
+			memset(&stream, 0, sizeof(stream));
+			memset(&schema, 0, sizeof(schema));
+			memset(&batch, 0, sizeof(batch));
+		}
+
+		~ArrowReader(void)
+		{
+			if(batch.release)
+				batch.release(&batch);
+			if(schema.release)
+				schema.release(&schema);
+			if(stream.release)
+				stream.release(&stream);
+		}
+#endif
+	};
+
 	class File;
 	int Layer::getFieldIndex(const std::string &name)
 	{
@@ -46,6 +172,39 @@ namespace ogr
 		return -1;
 	}
 
+	std::string Layer::getMappedFieldName(const std::string &name)
+	{
+		std::string shortName(name);
+		// Look for a previously mapped name
+		std::map<std::string,std::string>::iterator fiter =	fieldNameMap.find(name);
+		if(fiter!=fieldNameMap.end())
+		{
+			shortName = fiter->second;
+		}
+		else
+		{
+			// keep trying until we find a new shortened version.
+			if((int)name.length()>maxFieldNameLenth)
+			{
+				char buf[1024];
+				std::string prefix = name.substr(0,(maxFieldNameLenth-3));
+				for(int i=0;i<99;i++)
+				{
+					sprintf(buf,"%s%d",prefix.c_str(),i);
+					fiter =	fieldNameMap.find(buf);
+					if(fiter==fieldNameMap.end())
+					{
+						//use this name
+						shortName = buf;
+						break;
+					}
+				}
+			}
+		}
+		fieldNameMap[name] = shortName;
+		return shortName;
+	}
+
 	bool Layer::writeOGRFeature(ogr::Feature *feature, OGRFeature *ogrFeature)
 	{
 		feature->ogr_native = ogrFeature;
@@ -55,36 +214,7 @@ namespace ogr
 			if(ignoreFields.find(*it) != ignoreFields.end())
 				continue;
 
-			std::string name = *it;
-			std::string shortName(name);
-			// Look for a previously mapped name
-			std::map<std::string,std::string>::iterator fiter =	fieldNameMap.find(name);
-			if(fiter!=fieldNameMap.end())
-			{
-				shortName = fieldNameMap[name];
-			}
-			else
-			{
-				// keep trying until we find a new shortened version.
-				if((int)name.length()>maxFieldNameLenth)
-				{
-					char buf[1024];
-					std::string prefix = name.substr(0,(maxFieldNameLenth-3));
-					for(int i=0;i<99;i++)
-					{
-						sprintf(buf,"%s%d",prefix.c_str(),i);
-						fiter =	fieldNameMap.find(buf);
-						if(fiter==fieldNameMap.end())
-						{
-							//use this name
-							shortName = buf;
-							break;
-						}
-					}
-				}
-			}
-			fieldNameMap[name] = shortName;
-			name = shortName;
+			std::string name = getMappedFieldName(*it);
 
 			std::transform(name.begin(), name.end(), name.begin(), tolower);
 			ccl::Variant value = feature->attributes.getAttributeAsString(*it);
@@ -411,11 +541,12 @@ namespace ogr
 
 	Layer::~Layer(void)
 	{
+		closeArrowStream();
 		for(FieldList::iterator it = fields.begin(), end = fields.end(); it != end; ++it)
 			delete *it;
 	} 
 
-	Layer::Layer(OGRLayer *layer, sfa::File *_file, OGRDataSource *_ogrDataSource) : layer(layer), file(_file), coordinateSystem(NULL), ogrFile(_ogrDataSource)
+	Layer::Layer(OGRLayer *layer, sfa::File *_file, OGRDataSource *_ogrDataSource) : layer(layer), file(_file), coordinateSystem(NULL), ogrFile(_ogrDataSource), readSchemaFields(size_t(-1)), arrowStreamReading(false), arrowReader(NULL), transactionSize(10000)
 	{
 		maxFieldNameLenth = 32;
 		OGRFeatureDefn *featureDefn = layer->GetLayerDefn();
@@ -651,6 +782,7 @@ namespace ogr
 				sql += " AND ";
 			sql += k + "='" + v + "'";
 		}
+		closeArrowStream();
 		layer->ResetReading();
 		if(sql.size())
 			layer->SetAttributeFilter(sql.c_str());
@@ -665,11 +797,267 @@ namespace ogr
 		ogr::Feature *feature = new ogr::Feature(ogr_feature,this);
 
 		if(!readOGRFeature(feature,ogr_feature))
+		{
+			delete feature;
 			return NULL;
+		}
 		
 		return feature;
 	}
 
+	void Layer::prepareReadSchema(void)
+	{
+		if(readSchemaFields == fields.size())
+			return;
+		readPrototype.clear();
+		std::map<std::string, int> fieldIndices;
+		for(size_t i = 0, c = fields.size(); i < c; ++i)
+		{
+			std::string name = fields[i]->getName();
+			if(readPrototype.hasAttribute(name))
+				continue;
+			readPrototype.setAttribute(name, ccl::Variant());
+			fieldIndices[name] = int(i);
+		}
+		if(!readPrototype.hasAttribute("OBJECTID"))
+			readPrototype.setAttribute("OBJECTID", ccl::Variant());
+		else if(!readPrototype.hasAttribute("FID"))
+			readPrototype.setAttribute("FID", ccl::Variant());
+
+		readSlots.clear();
+		const ccl::AttributeContainer &prototype = readPrototype;
+		const ccl::VariantMap &vmap = *prototype.getVariantMap();
+		for(ccl::VariantMap::const_iterator it = vmap.begin(), end = vmap.end(); it != end; ++it)
+		{
+			std::map<std::string, int>::iterator fit = fieldIndices.find(it->first);
+			readSlots.push_back((fit != fieldIndices.end()) ? fit->second : -1);
+		}
+		readSchemaFields = fields.size();
+	}
+
+	sfa::Geometry *Layer::getGeometryFromWKB(OGRGeometry *ogr_geometry)
+	{
+		size_t size = size_t(ogr_geometry->WkbSize());
+		if(wkbBuffer.size() < size)
+			wkbBuffer.resize(size);
+		if(!size || (ogr_geometry->exportToWkb(wkbNDR, &wkbBuffer[0], wkbVariantIso) != OGRERR_NONE))
+			return getGeometry(ogr_geometry);
+		sfa::Geometry *geometry = sfa::getGeometryFromBinary(&wkbBuffer[0], size);
+		if(!geometry)
+			return getGeometry(ogr_geometry);
+		return unwrapSingleGeometry(geometry);
+	}
+
+	size_t Layer::getNextFeatures(std::vector<sfa::Feature *> &features, size_t count, int cursorId)
+	{
+		if(arrowStreamReading)
+		{
+			size_t result = getNextArrowFeatures(features, count);
+			// the stream may turn out to be unusable for this layer, in which case reading continues below
+			if(arrowStreamReading)
+				return result;
+		}
+
+		prepareReadSchema();
+		// getCoordinateSystem() builds a new object each call; share one between the features of this layer
+		if(!coordinateSystem)
+			coordinateSystem = getCoordinateSystem();
+
+		const ccl::AttributeContainer &prototype = readPrototype;
+		size_t result = 0;
+		while(result < count)
+		{
+			OGRFeature *ogr_feature = layer->GetNextFeature();
+			if(!ogr_feature)
+				break;
+			OGRGeometry *ogr_geometry = ogr_feature->GetGeometryRef();
+			sfa::Geometry *geometry = NULL;
+			if(ogr_geometry && !ogr_geometry->IsEmpty())
+				geometry = getGeometryFromWKB(ogr_geometry);
+			if(!geometry)
+			{
+				// features without a usable geometry are skipped (getNextFeature() stops at them)
+				OGRFeature::DestroyFeature(ogr_feature);
+				continue;
+			}
+
+			ogr::Feature *feature = new ogr::Feature(ogr_feature, this);
+			feature->geometry = geometry;
+			feature->geometry->setCoordinateSystem(coordinateSystem);
+			// copy the keys without indexing them; the index is built once the values are in
+			ccl::VariantMap &vmap = *feature->attributes.getVariantMap();
+			vmap = *prototype.getVariantMap();
+			size_t slot = 0;
+			for(ccl::VariantMap::iterator it = vmap.begin(), end = vmap.end(); it != end; ++it, ++slot)
+			{
+				int i = readSlots[slot];
+				if(i < 0)
+				{
+					it->second = ccl::Variant((ccl::uint64_t)ogr_feature->GetFID());
+					continue;
+				}
+				if(!ogr_feature->IsFieldSet(i))
+					continue;
+				switch(fields[i]->getType())
+				{
+					case OFTInteger:
+						it->second = ccl::Variant(ogr_feature->GetFieldAsInteger(i));
+						break;
+					case OFTReal:
+						it->second = ccl::Variant(ogr_feature->GetFieldAsDouble(i));
+						break;
+					default:
+						it->second = ccl::Variant(std::string(ogr_feature->GetFieldAsString(i)));
+						break;
+				}
+			}
+			feature->attributes.updateLowerCaseMap();
+			features.push_back(feature);
+			++result;
+		}
+		return result;
+	}
+
+	bool Layer::setArrowStreamReading(bool enable)
+	{
+		closeArrowStream();
+#ifdef OGR_LAYER_ARROW_STREAM
+		arrowStreamReading = enable;
+		return true;
+#else
+		arrowStreamReading = false;
+		return !enable;
+#endif
+	}
+
+	void Layer::closeArrowStream(void)
+	{
+		delete arrowReader;
+		arrowReader = NULL;
+	}
+
+	size_t Layer::getNextArrowFeatures(std::vector<sfa::Feature *> &features, size_t count)
+	{
+#ifdef OGR_LAYER_ARROW_STREAM
+		prepareReadSchema();
+		if(!coordinateSystem)
+			coordinateSystem = getCoordinateSystem();
+
+		if(!arrowReader)
+		{
+			arrowReader = new ArrowReader;
+			ArrowReader &reader = *arrowReader;
+			bool usable = layer->GetArrowStream(&reader.stream, NULL) && (reader.stream.get_schema(&reader.stream, &reader.schema) == 0);
+			std::string geometryName = layer->GetGeometryColumn();
+			if(geometryName.empty())
+				geometryName = "wkb_geometry";
+			std::string fidName = layer->GetFIDColumn();
+			if(fidName.empty())
+				fidName = "OGC_FID";
+			reader.fieldColumns.assign(fields.size(), -1);
+			reader.fieldFormats.assign(fields.size(), 0);
+			for(int64_t c = 0; usable && (c < reader.schema.n_children); ++c)
+			{
+				const struct ArrowSchema *child = reader.schema.children[c];
+				std::string name = child->name ? child->name : "";
+				std::string format = child->format ? child->format : "";
+				if((name == geometryName) && ((format == "z") || (format == "Z")))
+				{
+					reader.geometryColumn = int(c);
+					reader.largeGeometry = (format == "Z");
+					continue;
+				}
+				if((name == fidName) && (format == "l"))
+				{
+					reader.fidColumn = int(c);
+					continue;
+				}
+				for(size_t i = 0, ic = fields.size(); i < ic; ++i)
+				{
+					if(fields[i]->getName() != name)
+						continue;
+					if(!arrowFormatSupported(format.c_str(), fields[i]->getType()))
+						usable = false;
+					reader.fieldColumns[i] = int(c);
+					reader.fieldFormats[i] = format[0];
+					break;
+				}
+			}
+			if(!usable || (reader.geometryColumn < 0))
+			{
+				// unsupported column types or no WKB geometry column; fall back to reading OGRFeatures
+				closeArrowStream();
+				arrowStreamReading = false;
+				return 0;
+			}
+		}
+
+		ArrowReader &reader = *arrowReader;
+		const ccl::AttributeContainer &prototype = readPrototype;
+		size_t result = 0;
+		while(result < count)
+		{
+			if(!reader.batch.release || (reader.row >= reader.batch.length))
+			{
+				if(reader.batch.release)
+					reader.batch.release(&reader.batch);
+				memset(&reader.batch, 0, sizeof(reader.batch));
+				if((reader.stream.get_next(&reader.stream, &reader.batch) != 0) || !reader.batch.release)
+					break;
+				reader.row = 0;
+				continue;
+			}
+			int64_t row = reader.batch.offset + reader.row++;
+
+			const struct ArrowArray *geometryArray = reader.batch.children[reader.geometryColumn];
+			int64_t index = geometryArray->offset + row;
+			if(arrowIsNull(geometryArray, index))
+				continue;
+			size_t size = 0;
+			const unsigned char *wkb = arrowBinary(geometryArray, index, reader.largeGeometry, size);
+			sfa::Geometry *geometry = sfa::getGeometryFromBinary(wkb, size);
+			if(geometry && geometry->isEmpty())
+			{
+				delete geometry;
+				geometry = NULL;
+			}
+			if(!geometry)
+				continue;
+
+			ogr::Feature *feature = new ogr::Feature();
+			feature->layer = this;
+			feature->geometry = unwrapSingleGeometry(geometry);
+			feature->geometry->setCoordinateSystem(coordinateSystem);
+			// copy the keys without indexing them; the index is built once the values are in
+			ccl::VariantMap &vmap = *feature->attributes.getVariantMap();
+			vmap = *prototype.getVariantMap();
+			size_t slot = 0;
+			for(ccl::VariantMap::iterator it = vmap.begin(), end = vmap.end(); it != end; ++it, ++slot)
+			{
+				int i = readSlots[slot];
+				int column = (i < 0) ? reader.fidColumn : reader.fieldColumns[i];
+				if(column < 0)
+					continue;
+				const struct ArrowArray *array = reader.batch.children[column];
+				int64_t arrayIndex = array->offset + row;
+				if(arrowIsNull(array, arrayIndex))
+					continue;
+				if(i < 0)
+					it->second = ccl::Variant((ccl::uint64_t)((const int64_t *)array->buffers[1])[arrayIndex]);
+				else
+					it->second = arrowValue(array, reader.fieldFormats[i], arrayIndex);
+			}
+			feature->attributes.updateLowerCaseMap();
+			features.push_back(feature);
+			++result;
+		}
+		return result;
+#else
+		arrowStreamReading = false;
+		return 0;
+#endif
+	}
+
 	sfa::Feature * Layer::addFeature(sfa::Feature *feature)
 	{
 		if(!feature)
@@ -680,41 +1068,9 @@ namespace ogr
 		{			
 			if(ignoreFields.find(*it) != ignoreFields.end())
 				continue;
-			std::string name = *it;
-			std::string shortName(name);
-			// Look for a previously mapped name
-			std::map<std::string,std::string>::iterator fiter =	fieldNameMap.find(name);
-			if(fiter!=fieldNameMap.end())
-			{
-				shortName = fieldNameMap[name];
-			}
-			else
-			{
-				// keep trying until we find a new shortened version.
-				if((int)name.length()>maxFieldNameLenth)
-				{
-					char buf[1024];
-					std::string prefix = name.substr(0,(maxFieldNameLenth-3));
-					for(int i=0;i<99;i++)
-					{
-						sprintf(buf,"%s%d",prefix.c_str(),i);
-						fiter =	fieldNameMap.find(buf);
-						if(fiter==fieldNameMap.end())
-						{
-							//use this name
-							shortName = buf;
-							break;
-						}
-					}
-				}
-			}
-			fieldNameMap[name] = shortName;
-			name = shortName;
+			std::string name = getMappedFieldName(*it);
 			if(!hasField(name))
-			{
-				int type = this->getOGRFieldTypeFromVariantType(feature->attributes.getAttributeType(*it));
-				addField(name,type);
-			}
+				addOGRField(name, getOGRFieldTypeFromVariantType(feature->attributes.getAttributeType(*it)));
 		}
 		OGRFeature *ogrFeature = OGRFeature::CreateFeature(layer->GetLayerDefn());
 		if(!ogrFeature)
@@ -737,6 +1093,109 @@ namespace ogr
 		return feature2;
 	}
 
+	const Layer::WriteSlot &Layer::getWriteSlot(const std::string &key, const ccl::Variant &value)
+	{
+		std::map<std::string, WriteSlot>::iterator it = writeSlots.find(key);
+		if(it != writeSlots.end())
+			return it->second;
+
+		WriteSlot &slot = writeSlots[key];
+		slot.index = -1;
+		slot.type = OFTString;
+		if(ignoreFields.find(key) != ignoreFields.end())
+			return slot;
+		std::string name = getMappedFieldName(key);
+		slot.index = getFieldIndex(name);
+		if(slot.index < 0)
+		{
+			if(!addOGRField(name, getOGRFieldTypeFromVariantType(value.type())))
+				return slot;
+			slot.index = int(fields.size() - 1);
+		}
+		slot.type = fields[slot.index]->getType();
+		return slot;
+	}
+
+	size_t Layer::addFeatures(const std::vector<sfa::Feature *> &features)
+	{
+		bool transactions = (transactionSize > 0) && layer->TestCapability(OLCTransactions);
+		bool inTransaction = transactions && (layer->StartTransaction() == OGRERR_NONE);
+		size_t pending = 0;
+
+		// one OGRFeature is reused for every write; it is recreated only when a new key adds a field
+		OGRFeature *ogrFeature = NULL;
+		std::vector<const WriteSlot *> slots;
+		size_t result = 0;
+		for(size_t i = 0, c = features.size(); i < c; ++i)
+		{
+			sfa::Feature *feature = features[i];
+			if(!feature)
+				continue;
+
+			const ccl::AttributeContainer &attributes = feature->attributes;
+			const ccl::VariantMap &vmap = *attributes.getVariantMap();
+			slots.clear();
+			for(ccl::VariantMap::const_iterator it = vmap.begin(), end = vmap.end(); it != end; ++it)
+				slots.push_back(&getWriteSlot(it->first, it->second));
+
+			int fieldCount = layer->GetLayerDefn()->GetFieldCount();
+			if(ogrFeature && (ogrFeature->GetFieldCount() != fieldCount))
+			{
+				OGRFeature::DestroyFeature(ogrFeature);
+				ogrFeature = NULL;
+			}
+			if(!ogrFeature)
+			{
+				ogrFeature = OGRFeature::CreateFeature(layer->GetLayerDefn());
+				if(!ogrFeature)
+					break;
+			}
+			else
+			{
+				ogrFeature->SetFID(OGRNullFID);
+				for(int f = 0; f < fieldCount; ++f)
+					ogrFeature->UnsetField(f);
+			}
+
+			ogrFeature->SetGeometryDirectly(feature->geometry ? makeGeometry(feature->geometry) : NULL);
+			size_t s = 0;
+			for(ccl::VariantMap::const_iterator it = vmap.begin(), end = vmap.end(); it != end; ++it, ++s)
+			{
+				const WriteSlot &slot = *slots[s];
+				if(slot.index < 0)
+					continue;
+				switch(slot.type)
+				{
+					case OFTInteger:
+						ogrFeature->SetField(slot.index, it->second.as_int());
+						break;
+					case OFTReal:
+						ogrFeature->SetField(slot.index, it->second.as_double());
+						break;
+					default:
+						ogrFeature->SetField(slot.index, it->second.as_string().c_str());
+						break;
+				}
+			}
+
+			if(layer->CreateFeature(ogrFeature) != OGRERR_NONE)
+				continue;
+			++result;
+
+			if(inTransaction && (++pending >= transactionSize))
+			{
+				layer->CommitTransaction();
+				pending = 0;
+				inTransaction = (layer->StartTransaction() == OGRERR_NONE);
+			}
+		}
+		if(ogrFeature)
+			OGRFeature::DestroyFeature(ogrFeature);
+		if(inTransaction)
+			layer->CommitTransaction();
+		return result;
+	}
+
 	sfa::Geometry *Layer::getGeometry(OGRGeometry *ogr_geometry)
 	{
         auto type = ogr_geometry->getGeometryType();
@@ -766,7 +1225,7 @@ namespace ogr
 					sfa::LineString *lineString = new sfa::LineString;
 					int c = ogr->getNumPoints();
 					for(int i = 0; i < c; i++)
-						lineString->addPoint(new sfa::Point(ogr->getX(i), ogr->getY(i)));
+						lineString->addPoint(sfa::Point(ogr->getX(i), ogr->getY(i)));
 					return lineString;
 				}
 				break;
@@ -776,7 +1235,7 @@ namespace ogr
 					sfa::LineString *lineString = new sfa::LineString;
 					int c = ogr->getNumPoints();
 					for(int i = 0; i < c; i++)
-						lineString->addPoint(new sfa::Point(ogr->getX(i), ogr->getY(i), ogr->getZ(i)));
+						lineString->addPoint(sfa::Point(ogr->getX(i), ogr->getY(i), ogr->getZ(i)));
 					return lineString;
 				}
 				break;
@@ -786,7 +1245,7 @@ namespace ogr
 					sfa::LineString *lineString = new sfa::LineString;
 					int c = ogr->getNumPoints();
 					for(int i = 0; i < c; i++)
-						lineString->addPoint(new sfa::Point(ogr->getX(i), ogr->getY(i), ogr->getZ(i), ogr->getM(i)));
+						lineString->addPoint(sfa::Point(ogr->getX(i), ogr->getY(i), ogr->getZ(i), ogr->getM(i)));
 					return lineString;
 				}
 				break;
@@ -797,14 +1256,14 @@ namespace ogr
 					OGRLinearRing *ring = ogr->getExteriorRing();
 					sfa::LineString *oRing = new sfa::LineString;
 					for(int i = 0, c = ring->getNumPoints(); i < c; i++)
-						oRing->addPoint(new sfa::Point(ring->getX(i), ring->getY(i)));
+						oRing->addPoint(sfa::Point(ring->getX(i), ring->getY(i)));
 					polygon->addRing(oRing);
 					for(int r = 0, rcount = ogr->getNumInteriorRings(); r < rcount; r++)
 					{
 						ring = ogr->getInteriorRing(r);
 						sfa::LineString *iRing = new sfa::LineString;
 						for(int i = 0, c = ring->getNumPoints(); i < c; i++)
-							iRing->addPoint(new sfa::Point(ring->getX(i), ring->getY(i)));
+							iRing->addPoint(sfa::Point(ring->getX(i), ring->getY(i)));
 						polygon->addRing(iRing);
 					}
 					return polygon;
@@ -817,14 +1276,14 @@ namespace ogr
 					OGRLinearRing *ring = ogr->getExteriorRing();
 					sfa::LineString *oRing = new sfa::LineString;
 					for(int i = 0, c = ring->getNumPoints(); i < c; i++)
-						oRing->addPoint(new sfa::Point(ring->getX(i), ring->getY(i), ring->getZ(i)));
+						oRing->addPoint(sfa::Point(ring->getX(i), ring->getY(i), ring->getZ(i)));
 					polygon->addRing(oRing);
 					for(int r = 0, rcount = ogr->getNumInteriorRings(); r < rcount; r++)
 					{
 						ring = ogr->getInteriorRing(r);
 						sfa::LineString *iRing = new sfa::LineString;
 						for(int i = 0, c = ring->getNumPoints(); i < c; i++)
-							iRing->addPoint(new sfa::Point(ring->getX(i), ring->getY(i), ring->getZ(i)));
+							iRing->addPoint(sfa::Point(ring->getX(i), ring->getY(i), ring->getZ(i)));
 						polygon->addRing(iRing);
 					}
 					return polygon;
@@ -869,9 +1328,9 @@ namespace ogr
 								delete multiPoint;
 								return geometry;
 							}
+							else
+								multiPoint->addGeometry(geometry);
 						}
-						else
-							multiPoint->addGeometry(geometry);
 					}
 					return multiPoint;
 				}
@@ -188,7 +188,8 @@ namespace scenegraph
         for(size_t i = 0, c = scene->faces.size(); i < c; ++i)
         {
             Face &face = scene->faces.at(i);
-            attributeSetMap[&face] = *(face.attributes.getVariantMap());
+            const ccl::AttributeContainer &attributes = face.attributes;
+            attributeSetMap[&face] = *(attributes.getVariantMap());
         }
 
         // count the uniques and bail if we don't need to split
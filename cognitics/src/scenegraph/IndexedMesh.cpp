@@ -0,0 +1,307 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "scenegraph/IndexedMesh.h"
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace scenegraph
+{
+    namespace
+    {
+        size_t hashValues(const double *value, int count)
+        {
+            ccl::uint64_t hash = 0;
+            for(int i = 0; i < count; ++i)
+            {
+                ccl::uint64_t word;
+                memcpy(&word, &value[i], sizeof(word));
+                hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+                hash ^= hash >> 32;
+            }
+            // coordinates mostly differ in their high bits; fold them into the low bits used for the slot
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33;
+            return size_t(hash);
+        }
+    }
+
+    IndexedMesh::IndexedMesh(void)
+    {
+    }
+
+    void IndexedMesh::clear(void)
+    {
+        positions.clear();
+        normals.clear();
+        uvs.clear();
+        corners.clear();
+        faces.clear();
+        textures.clear();
+        materials.clear();
+        resetTable(positionIndex, 0);
+        resetTable(normalIndex, 0);
+        resetTable(uvIndex, 0);
+        textureIndex.clear();
+        materialIndex.clear();
+    }
+
+    void IndexedMesh::resetTable(WeldTable &table, size_t capacity)
+    {
+        table.slots.assign(capacity, ccl::uint32_t(NONE));
+        table.count = 0;
+    }
+
+    void IndexedMesh::growTable(WeldTable &table, const std::vector<double> &values, int count)
+    {
+        // rebuilt from the value array itself, which is the only copy of the keys
+        size_t capacity = std::max<size_t>(64, table.slots.size() * 2);
+        while(capacity < ((values.size() / count) + 1) * 2)
+            capacity *= 2;
+        resetTable(table, capacity);
+        size_t mask = table.slots.size() - 1;
+        for(size_t i = 0, c = values.size() / count; i < c; ++i)
+        {
+            size_t slot = hashValues(&values[i * count], count) & mask;
+            while(table.slots[slot] != NONE)
+                slot = (slot + 1) & mask;
+            table.slots[slot] = ccl::uint32_t(i);
+        }
+        table.count = values.size() / count;
+    }
+
+    ccl::uint32_t IndexedMesh::addValue(WeldTable &table, std::vector<double> &values, const double *value, int count)
+    {
+        // kept at most half full so probe sequences stay short
+        if((table.count + 1) * 2 > table.slots.size())
+            growTable(table, values, count);
+        size_t mask = table.slots.size() - 1;
+        size_t slot = hashValues(value, count) & mask;
+        for(;;)
+        {
+            ccl::uint32_t index = table.slots[slot];
+            if(index == NONE)
+                break;
+            if(memcmp(&values[index * count], value, count * sizeof(double)) == 0)
+                return index;
+            slot = (slot + 1) & mask;
+        }
+        ccl::uint32_t index = ccl::uint32_t(values.size() / count);
+        table.slots[slot] = index;
+        ++table.count;
+        values.insert(values.end(), value, value + count);
+        return index;
+    }
+
+    void IndexedMesh::addFace(const Face &face, size_t source)
+    {
+        IndexedFace indexedFace;
+        indexedFace.firstCorner = ccl::uint32_t(corners.size());
+        indexedFace.numCorners = ccl::uint32_t(face.verts.size());
+        indexedFace.texture = -1;
+        indexedFace.material = -1;
+        indexedFace.source = source;
+
+        const MappedTexture *texture = face.textures.empty() ? NULL : &face.textures[0];
+        if(texture)
+        {
+            // the texture id avoids resolving the interned name (and taking its lock) for every face
+            int id = texture->GetTextureID();
+            std::unordered_map<int, int>::const_iterator it = textureIndex.find(id);
+            if(it == textureIndex.end())
+            {
+                it = textureIndex.insert(std::make_pair(id, int(textures.size()))).first;
+                textures.push_back(texture->GetTextureName());
+            }
+            indexedFace.texture = it->second;
+        }
+        if(!face.materials.empty())
+        {
+            std::pair<std::map<Material, int>::iterator, bool> result = materialIndex.insert(std::make_pair(face.materials[0], int(materials.size())));
+            if(result.second)
+                materials.push_back(face.materials[0]);
+            indexedFace.material = result.first->second;
+        }
+
+        for(size_t i = 0, c = face.verts.size(); i < c; ++i)
+        {
+            Corner corner;
+            const sfa::Point &v = face.verts[i];
+            double xyz[3] = { v.X(), v.Y(), v.Z() };
+            corner.position = addValue(positionIndex, positions, xyz, 3);
+            corner.normal = NONE;
+            if(i < face.vertexNormals.size())
+            {
+                const sfa::Point &n = face.vertexNormals[i];
+                double ijk[3] = { n.X(), n.Y(), n.Z() };
+                corner.normal = addValue(normalIndex, normals, ijk, 3);
+            }
+            corner.uv = NONE;
+            if(texture && (i < texture->uvs.size()))
+            {
+                const sfa::Point &uv = texture->uvs[i];
+                double st[2] = { uv.X(), uv.Y() };
+                corner.uv = addValue(uvIndex, uvs, st, 2);
+            }
+            corners.push_back(corner);
+        }
+        faces.push_back(indexedFace);
+    }
+
+    void IndexedMesh::addFaces(const FaceList &faceList)
+    {
+        size_t first = faces.size();
+        faces.reserve(first + faceList.size());
+        corners.reserve(corners.size() + (faceList.size() * 3));
+        for(size_t i = 0, c = faceList.size(); i < c; ++i)
+            addFace(faceList[i], i);
+    }
+
+    Face IndexedMesh::getFace(size_t n) const
+    {
+        const IndexedFace &indexedFace = faces.at(n);
+        Face face;
+        bool hasNormals = true;
+        MappedTexture texture;
+        for(ccl::uint32_t i = 0; i < indexedFace.numCorners; ++i)
+        {
+            const Corner &corner = corners[indexedFace.firstCorner + i];
+            const double *xyz = &positions[corner.position * 3];
+            face.verts.push_back(sfa::Point(xyz[0], xyz[1], xyz[2]));
+            if(corner.normal == NONE)
+                hasNormals = false;
+            else
+            {
+                const double *ijk = &normals[corner.normal * 3];
+                face.vertexNormals.push_back(sfa::Point(ijk[0], ijk[1], ijk[2]));
+            }
+            if(corner.uv != NONE)
+            {
+                const double *st = &uvs[corner.uv * 2];
+                texture.uvs.push_back(sfa::Point(st[0], st[1]));
+            }
+        }
+        if(!hasNormals)
+            face.vertexNormals.clear();
+        if(indexedFace.texture >= 0)
+        {
+            texture.SetTextureName(textures[indexedFace.texture]);
+            face.textures.push_back(texture);
+        }
+        if(indexedFace.material >= 0)
+            face.materials.push_back(materials[indexedFace.material]);
+        return face;
+    }
+
+    void IndexedMesh::toFaces(FaceList &faceList) const
+    {
+        faceList.reserve(faceList.size() + faces.size());
+        for(size_t i = 0, c = faces.size(); i < c; ++i)
+            faceList.push_back(getFace(i));
+    }
+
+    void IndexedMesh::getFaceNormal(size_t n, double normal[3]) const
+    {
+        normal[0] = normal[1] = normal[2] = 0.0;
+        const IndexedFace &indexedFace = faces.at(n);
+        if(indexedFace.numCorners < 3)
+            return;
+        const double *p0 = &positions[corners[indexedFace.firstCorner].position * 3];
+        const double *p1 = &positions[corners[indexedFace.firstCorner + 1].position * 3];
+        const double *p2 = &positions[corners[indexedFace.firstCorner + 2].position * 3];
+        double a[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        double b[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        normal[0] = (a[1] * b[2]) - (a[2] * b[1]);
+        normal[1] = (a[2] * b[0]) - (a[0] * b[2]);
+        normal[2] = (a[0] * b[1]) - (a[1] * b[0]);
+        double length = sqrt((normal[0] * normal[0]) + (normal[1] * normal[1]) + (normal[2] * normal[2]));
+        if(length > 0.0)
+        {
+            normal[0] /= length;
+            normal[1] /= length;
+            normal[2] /= length;
+        }
+    }
+
+    void IndexedMesh::computeVertexNormals(bool sharpEdges)
+    {
+        normals.clear();
+        resetTable(normalIndex, 0);
+
+        if(sharpEdges)
+        {
+            for(size_t i = 0, c = faces.size(); i < c; ++i)
+            {
+                double normal[3];
+                getFaceNormal(i, normal);
+                ccl::uint32_t index = addValue(normalIndex, normals, normal, 3);
+                for(ccl::uint32_t j = 0; j < faces[i].numCorners; ++j)
+                    corners[faces[i].firstCorner + j].normal = index;
+            }
+            return;
+        }
+
+        // each face contributes its normal to every vertex it touches, weighted by its share of the total area
+        std::vector<double> weighted(positions.size(), 0.0);
+        std::vector<double> totalArea(getNumPositions(), 0.0);
+        for(size_t i = 0, c = faces.size(); i < c; ++i)
+        {
+            const IndexedFace &indexedFace = faces[i];
+            if(indexedFace.numCorners < 3)
+                continue;
+            double normal[3];
+            getFaceNormal(i, normal);
+
+            // Newell's method gives twice the vector area of the polygon
+            double newell[3] = { 0.0, 0.0, 0.0 };
+            for(ccl::uint32_t j = 0; j < indexedFace.numCorners; ++j)
+            {
+                const double *p = &positions[corners[indexedFace.firstCorner + j].position * 3];
+                const double *q = &positions[corners[indexedFace.firstCorner + ((j + 1) % indexedFace.numCorners)].position * 3];
+                newell[0] += (p[1] - q[1]) * (p[2] + q[2]);
+                newell[1] += (p[2] - q[2]) * (p[0] + q[0]);
+                newell[2] += (p[0] - q[0]) * (p[1] + q[1]);
+            }
+            double area = sqrt((newell[0] * newell[0]) + (newell[1] * newell[1]) + (newell[2] * newell[2])) / 2.0;
+
+            for(ccl::uint32_t j = 0; j < indexedFace.numCorners; ++j)
+            {
+                ccl::uint32_t position = corners[indexedFace.firstCorner + j].position;
+                for(int k = 0; k < 3; ++k)
+                    weighted[(position * 3) + k] += normal[k] * area;
+                totalArea[position] += area;
+            }
+        }
+
+        normals.resize(positions.size());
+        for(size_t i = 0, c = getNumPositions(); i < c; ++i)
+        {
+            for(int k = 0; k < 3; ++k)
+                normals[(i * 3) + k] = (totalArea[i] > 0.0) ? weighted[(i * 3) + k] / totalArea[i] : 0.0;
+        }
+        for(size_t i = 0, c = corners.size(); i < c; ++i)
+            corners[i].normal = corners[i].position;
+    }
+
+}
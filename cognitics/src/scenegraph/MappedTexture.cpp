@@ -75,4 +75,10 @@ namespace scenegraph
 
     }
 
+    // the interned name index; equal ids mean equal names, without taking the name lock
+    int MappedTexture::GetTextureID() const
+    {
+        return textureNameIdx;
+    }
+
 }
\ No newline at end of file
@@ -297,6 +297,18 @@ namespace scenegraph
             children[i]->setVertexNormals();
     }
 
+    void Scene::buildIndexedMesh(IndexedMesh &mesh) const
+    {
+        mesh.addFaces(faces);
+    }
+
+    void Scene::setFacesFromIndexedMesh(const IndexedMesh &mesh)
+    {
+        faces.clear();
+        mesh.toFaces(faces);
+        hasVertexNormals = false;
+    }
+
     bool Scene::sortFaces()
     {
         bsp.setFaces(&faces,true);
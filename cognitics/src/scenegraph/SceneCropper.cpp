@@ -21,13 +21,14 @@ DEALINGS IN THE SOFTWARE.
 ****************************************************************************/
 #include "scenegraph/SceneCropper.h"
 #include "scenegraph/MappedTextureMatrix.h"
+#include <ccl/Arena.h>
 
 //#pragma optimize( "", off )
 
 namespace scenegraph {
 
 //!    Append points to a list while ensuring no duplicate points are added
-    static void appendCropPoint(std::vector<sfa::Point>& points, const sfa::Point& p)
+    static void appendCropPoint(std::pmr::vector<sfa::Point>& points, const sfa::Point& p)
     {
         if (points.empty())
             points.push_back(p);
@@ -77,7 +78,7 @@ namespace scenegraph {
         double xmax, 
         double ymin,
         double ymax,
-        std::vector<sfa::Point>& output
+        std::pmr::vector<sfa::Point>& output
         )
     {
         double tEnter = 0;
@@ -123,7 +124,7 @@ namespace scenegraph {
         const sfa::Point& p2,
         const sfa::Point& p3,
         const sfa::Point& p4,
-        std::vector<sfa::Point>& output
+        std::pmr::vector<sfa::Point>& output
         )
     {
         sfa::Point p21 = p2 - p1;
@@ -216,6 +217,9 @@ namespace scenegraph {
         Scene* newScene = new Scene();
         newScene->matrix = scene->matrix;
 
+        //Clipped points are scratch for a single face
+        ccl::Arena arena(4096);
+
         //Crop each face
         for (size_t i=0; i<scene->faces.size(); i++)
         {
@@ -226,7 +230,8 @@ namespace scenegraph {
                 continue;
 
             //Clip Face
-            std::vector<sfa::Point> points;
+            arena.reset();
+            std::pmr::vector<sfa::Point> points(&arena);
             for (size_t j = 0, n = face.verts.size(); j < n; j++)
                 cropLine(face.verts[j], face.verts[(j+1)%n], xmin, xmax, ymin, ymax, points);
 
@@ -255,7 +260,7 @@ namespace scenegraph {
                 Face newFace;
                 newFace.smc = face.smc;
                 newFace.featureID = face.featureID;
-                newFace.verts = points;
+                newFace.verts.assign(points.begin(), points.end());
                 newFaces.push_back(newFace);
             }
 
@@ -299,6 +304,9 @@ namespace scenegraph {
 
         Scene* newScene = new Scene();
 
+        //Clipped points are scratch for a single face
+        ccl::Arena arena(4096);
+
         //Crop each face
         for (size_t i=0; i<scene->faces.size(); i++)
         {
@@ -309,7 +317,8 @@ namespace scenegraph {
                 continue;
 
             //Clip Face
-            std::vector<sfa::Point> points;
+            arena.reset();
+            std::pmr::vector<sfa::Point> points(&arena);
             for (size_t j = 0, n = face.verts.size(); j < n; j++)
                 cropLine(face.verts[j], face.verts[(j+1)%n], p1, p2, points);
 
@@ -334,7 +343,7 @@ namespace scenegraph {
             else
             {
                 Face newFace;
-                newFace.verts = points;
+                newFace.verts.assign(points.begin(), points.end());
                 newFaces.push_back(newFace);
             }
 
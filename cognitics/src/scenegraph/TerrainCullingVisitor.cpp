@@ -21,6 +21,7 @@ DEALINGS IN THE SOFTWARE.
 ****************************************************************************/
 
 #include "scenegraph/TerrainCullingVisitor.h"
+#include <algorithm>
 
 namespace scenegraph
 {
@@ -30,25 +31,32 @@ namespace scenegraph
 
     TerrainCullingVisitor::TerrainCullingVisitor(const std::vector<sfa::Polygon> &polygons) : polygons(polygons)
     {
+        prepare();
+    }
+
+    void TerrainCullingVisitor::prepare(void)
+    {
+        prepared.clear();
+        prepared.reserve(polygons.size());
+        for(size_t i = 0, c = polygons.size(); i < c; ++i)
+            prepared.push_back(sfa::PreparedGeometry(&polygons[i]));
     }
 
     void TerrainCullingVisitor::visiting(Scene *scene)
     {
-        for(FaceList::iterator it = scene->faces.begin(), end = scene->faces.end(); it != end; ++it)
+        auto culled = [this](const Face &face)
         {
-            Face &face = *it;
             if(face.verts.empty())
-                continue;
+                return false;
             sfa::Polygon terrainPolygon = face.getPolygon();
-            for(size_t i = 0, c = polygons.size(); i < c; ++i)
+            for(size_t i = 0, c = prepared.size(); i < c; ++i)
             {
-                if(polygons[i].contains(&terrainPolygon))
-                {
-                    it = scene->faces.erase(it);
-                    break;
-                }
+                if(prepared[i].contains(&terrainPolygon))
+                    return true;
             }
-        }
+            return false;
+        };
+        scene->faces.erase(std::remove_if(scene->faces.begin(), scene->faces.end(), culled), scene->faces.end());
 
         traverse(scene);
     }
@@ -56,6 +64,7 @@ namespace scenegraph
     void TerrainCullingVisitor::setPolygons(const std::vector<sfa::Polygon> &polygons)
     {
         this->polygons = polygons;
+        prepare();
     }
 
 
@@ -22,6 +22,7 @@ DEALINGS IN THE SOFTWARE.
 
 #include "scenegraph/TransformVisitor.h"
 #include "scenegraph/LOD.h"
+#include <ccl/Parallel.h>
 
 namespace scenegraph
 {
@@ -35,7 +36,8 @@ namespace scenegraph
 
     void TransformVisitor::visiting(Scene *scene)
     {
-        for(size_t i = 0, c = scene->faces.size(); i < c; ++i)
+        // faces are independent, so they are transformed in parallel
+        ccl::parallel_for(0, scene->faces.size(), 256, [&](size_t i)
         {
             Face &face = scene->faces.at(i);
             // update face coordinates based on transform
@@ -49,7 +51,7 @@ namespace scenegraph
                 n = mat * n;
                 face.setNormalN(i,n);
             }            
-        }
+        });
 
         for(size_t i = 0, c = scene->externalReferences.size(); i < c; ++i)
         {
@@ -23,9 +23,45 @@ DEALINGS IN THE SOFTWARE.
 #include "scenegraph/scenegraph.h"
 #include "scenegraph/Scene.h"
 #include <sfa/sfa.h>
+#include <ctl/QTriangulate.h>
 
 namespace scenegraph
 {
+    namespace
+    {
+        ctl::PointList RingToPointList(const sfa::LineString *ring)
+        {
+            ctl::PointList points;
+            int numPoints = ring ? ring->getNumPoints() : 0;
+            points.reserve(numPoints);
+            for(int i = 0; i < numPoints; ++i)
+            {
+                sfa::Point *point = ring->getPointN(i);
+                points.push_back(ctl::Point(point->X(), point->Y(), point->Z()));
+            }
+            return points;
+        }
+
+        void addPolygonFaces(Scene *scene, const sfa::Polygon *polygon, const sfa::Feature *feature)
+        {
+            ctl::PointList exterior = RingToPointList(polygon->getExteriorRing());
+            std::vector<ctl::PointList> holes;
+            for(int i = 0, c = polygon->getNumInteriorRing(); i < c; ++i)
+                holes.push_back(RingToPointList(polygon->getInteriorRingN(i)));
+
+            ctl::PointList triangles = ctl::QTriangulate::apply(exterior, holes);
+            for(size_t i = 0; i + 2 < triangles.size(); i += 3)
+            {
+                Face face;
+                for(int j = 0; j < 3; ++j)
+                    face.addVert(sfa::Point(triangles[i + j].x, triangles[i + j].y, triangles[i + j].z));
+                face.SetFaceNormal(face.computeNormal());
+                face.attributes = feature->attributes;
+                scene->faces.push_back(face);
+            }
+        }
+    }
+
     Scene *buildSceneFromFeature(sfa::Feature *feature)
     {
         if(!feature || !feature->geometry)
@@ -43,6 +79,22 @@ namespace scenegraph
             return scene;
         }
 
+        if(feature->geometry->getWKBGeometryType() == sfa::wkbPolygon)
+        {
+            Scene *scene = new Scene;
+            addPolygonFaces(scene, dynamic_cast<sfa::Polygon *>(feature->geometry), feature);
+            return scene;
+        }
+
+        if(feature->geometry->getWKBGeometryType() == sfa::wkbMultiPolygon)
+        {
+            Scene *scene = new Scene;
+            sfa::MultiPolygon *geometry = dynamic_cast<sfa::MultiPolygon *>(feature->geometry);
+            for(int i = 1, c = geometry->getNumGeometries(); i <= c; ++i)
+                addPolygonFaces(scene, dynamic_cast<sfa::Polygon *>(geometry->getGeometryN(i)), feature);
+            return scene;
+        }
+
         return NULL;
     }
 
@@ -147,8 +147,8 @@ namespace scenegraph
                         {
                             sfa::Point *pt = new sfa::Point(x, y);
                             sfa::LineString ls;
-                            ls.addPoint(new sfa::Point(x1, y1, z1));
-                            ls.addPoint(new sfa::Point(x2, y2, z2));
+                            ls.addPoint(sfa::Point(x1, y1, z1));
+                            ls.addPoint(sfa::Point(x2, y2, z2));
                             ls.interpolateZ(pt);
                             pt->setZ(pt->Z() + originalZ);
                             newPoints.push_back(pt);
@@ -29,6 +29,7 @@ DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 
 namespace scenegraph
 {
@@ -77,30 +78,6 @@ namespace scenegraph
         }
     };
 
-    OpenFlightVertex buildOpenFlightVertexFromFace(Face &face, int i)
-    {
-        OpenFlightVertex v1;
-        if(face.getNumVertices() > i)
-        {
-            sfa::Point pt = face.getVertN(i);
-            v1.x = pt.X();
-            v1.y = pt.Y();
-            v1.z = pt.Z();
-            sfa::Point n1 = face.getNormalN(i);
-            v1.i = n1.X();
-            v1.j = n1.Y();
-            v1.k = n1.Z();
-            if(face.textures.size() && face.textures[0].uvs.size())
-            {
-                sfa::Point uv1 = face.textures[0].uvs[i];
-                v1.u = uv1.X();
-                v1.v = uv1.Y();
-            }
-        }
-        return v1;
-
-    }
-
     struct SceneOpenFlightBuilder
     {
         std::string filename;
@@ -118,12 +95,12 @@ namespace scenegraph
         std::map<std::string, int> textureMap;
         flt::LightSourcePalette *lightSourcePalette;
         flt::VertexPalette *vertexPalette;
-        std::set<OpenFlightVertex> vertexSet;
-        std::vector<OpenFlightVertex> vertexVector;
-        std::map<OpenFlightVertex, size_t> vertexMap;
-        std::set<OpenFlightVertex> vertexSetM;
-        std::vector<OpenFlightVertex> vertexVectorM;
-        std::map<OpenFlightVertex, size_t> vertexMapM;
+        IndexedMesh mesh;                                   // faces of every scene in the hierarchy
+        std::map<const Scene *, size_t> sceneFirstFace;     // index of each scene's first face in the mesh
+        std::vector<OpenFlightVertex> vertexVector;         // palette vertices with texture coordinates
+        std::vector<OpenFlightVertex> vertexVectorM;        // palette vertices without
+        std::vector<size_t> cornerVertex;                   // palette index of each mesh corner
+        std::map<OpenFlightVertex, size_t> vertexMapM;      // light point vertices in vertexVectorM
         size_t vertexSize;
 
         SceneOpenFlightBuilder(const std::string &filename, Scene *scene, int revision) : filename(filename), scene(scene), revision(revision), vertexSize(64)
@@ -258,18 +235,14 @@ namespace scenegraph
 
             for(size_t i = 0, c = scene->lightPoints.size(); i < c; ++i)
             {
-                LightPoint &lightPoint = scene->lightPoints[i];
+                const LightPoint &lightPoint = scene->lightPoints[i];
                 flt::LightPoint *lightPointRecord = new flt::LightPoint;
 
                 header->nextLightPointNodeID = header->nextLightPointNodeID + 1;
 
                 flt::VertexList *vertexListRecord = new flt::VertexList;
 
-                OpenFlightVertex ofv;
-                ofv.x = lightPoint.point.X();
-                ofv.y = lightPoint.point.Y();
-                ofv.z = lightPoint.point.Z();
-                size_t index = vertexMapM[ofv];
+                size_t index = vertexMapM[getLightPointVertex(lightPoint)];
                 vertexListRecord->offsets.push_back(int(8 + (vertexVector.size() * vertexSize) + (index * (vertexSize - 8))));
 
                 records.push_back(lightPointRecord);
@@ -295,9 +268,11 @@ namespace scenegraph
                 records.push_back(new flt::PopLevel);
             }
 
+            size_t firstFace = sceneFirstFace[scene];
             for(size_t i = 0, c = scene->faces.size(); i < c; ++i)
             {
-                Face &face = scene->faces[i];
+                const Face &face = scene->faces[i];
+                const IndexedMesh::IndexedFace &meshFace = mesh.faces[firstFace + i];
                 flt::Face *faceRecord = new flt::Face;
 
                 if(face.id.size()==0)
@@ -340,11 +315,11 @@ namespace scenegraph
                 faceRecord->transparency = (face.transparency>1.0)?65535:face.transparency*65535;
                 faceRecord->lightMode = 3;
 
-                if(face.materials.size() > 0)
-                    faceRecord->materialIndex = materialMap[face.materials[0]];
+                if(meshFace.material >= 0)
+                    faceRecord->materialIndex = materialMap[mesh.materials[meshFace.material]];
 
-                if(face.textures.size() > 0)
-                    faceRecord->texturePatternIndex = textureMap[face.textures[0].GetTextureName()];
+                if(meshFace.texture >= 0)
+                    faceRecord->texturePatternIndex = textureMap[mesh.textures[meshFace.texture]];
 
                 if(faceRecord->texturePatternIndex == -1)
                 {
@@ -356,18 +331,13 @@ namespace scenegraph
                         faceRecord->drawType = 0;
 
                 flt::VertexList *vertexListRecord = new flt::VertexList;
-                for(size_t j = 0, jc = face.getNumVertices(); j < jc; ++j)
+                for(ccl::uint32_t j = 0; j < meshFace.numCorners; ++j)
                 {
-                    if(face.textures.empty())
-                    {
-                        size_t index = vertexMapM[buildOpenFlightVertexFromFace(face, int(j))];
+                    size_t index = cornerVertex[meshFace.firstCorner + j];
+                    if(meshFace.texture < 0)
                         vertexListRecord->offsets.push_back(int(8 + (vertexVector.size() * vertexSize) + (index * (vertexSize - 8))));
-                    }
                     else
-                    {
-                        size_t index = vertexMap[buildOpenFlightVertexFromFace(face, int(j))];
                         vertexListRecord->offsets.push_back(int(8 + (index * vertexSize)));
-                    }
                 }
 
                 records.push_back(faceRecord);
@@ -435,20 +405,64 @@ namespace scenegraph
                 records.push_back(new flt::PopLevel);
         }
 
-        void buildVertexSetFromScene(Scene *scene)
+        OpenFlightVertex getLightPointVertex(const LightPoint &lightPoint)
         {
-            for(size_t i = 0, c = scene->faces.size(); i < c; ++i)
+            return OpenFlightVertex(float(lightPoint.point.X()), float(lightPoint.point.Y()), float(lightPoint.point.Z()));
+        }
+
+        void buildMeshFromScene(Scene *scene)
+        {
+            sceneFirstFace[scene] = mesh.faces.size();
+            scene->buildIndexedMesh(mesh);
+            for(size_t i = 0, c = scene->lightPoints.size(); i < c; ++i)
+            {
+                OpenFlightVertex ofv = getLightPointVertex(scene->lightPoints[i]);
+                if(vertexMapM.insert(std::make_pair(ofv, vertexVectorM.size())).second)
+                    vertexVectorM.push_back(ofv);
+            }
+            for(size_t i = 0, c = scene->children.size(); i < c; ++i)
+                buildMeshFromScene(scene->children.at(i));
+        }
+
+        // Each distinct position/normal/uv corner of the mesh becomes one palette vertex; corners are welded
+        // by index, so no per-vertex ordered lookups are needed.
+        void buildVertexPalette(void)
+        {
+            std::unordered_map<IndexedMesh::Corner, size_t, IndexedMesh::CornerHash> texturedIndex;
+            std::unordered_map<IndexedMesh::Corner, size_t, IndexedMesh::CornerHash> untexturedIndex;
+            texturedIndex.reserve(mesh.getNumPositions());
+            cornerVertex.resize(mesh.corners.size());
+            for(size_t i = 0, c = mesh.faces.size(); i < c; ++i)
             {
-                for(size_t j = 0, jc = scene->faces[i].getNumVertices(); j < jc; ++j)
+                const IndexedMesh::IndexedFace &face = mesh.faces[i];
+                bool textured = (face.texture >= 0);
+                std::vector<OpenFlightVertex> &vertices = textured ? vertexVector : vertexVectorM;
+                for(ccl::uint32_t j = 0; j < face.numCorners; ++j)
                 {
-                    if(scene->faces[i].textures.empty())
-                        vertexSetM.insert(buildOpenFlightVertexFromFace(scene->faces[i], int(j)));
-                    else
-                        vertexSet.insert(buildOpenFlightVertexFromFace(scene->faces[i], int(j)));
+                    const IndexedMesh::Corner &corner = mesh.corners[face.firstCorner + j];
+                    std::pair<std::unordered_map<IndexedMesh::Corner, size_t, IndexedMesh::CornerHash>::iterator, bool> result =
+                        (textured ? texturedIndex : untexturedIndex).insert(std::make_pair(corner, vertices.size()));
+                    cornerVertex[face.firstCorner + j] = result.first->second;
+                    if(!result.second)
+                        continue;
+                    const double *p = &mesh.positions[corner.position * 3];
+                    OpenFlightVertex ofv((float)p[0], (float)p[1], (float)p[2]);
+                    if(corner.normal != IndexedMesh::NONE)
+                    {
+                        const double *n = &mesh.normals[corner.normal * 3];
+                        ofv.i = float(n[0]);
+                        ofv.j = float(n[1]);
+                        ofv.k = float(n[2]);
+                    }
+                    if(textured && (corner.uv != IndexedMesh::NONE))
+                    {
+                        const double *uv = &mesh.uvs[corner.uv * 2];
+                        ofv.u = float(uv[0]);
+                        ofv.v = float(uv[1]);
+                    }
+                    vertices.push_back(ofv);
                 }
             }
-            for(size_t i = 0, c = scene->children.size(); i < c; ++i)
-                buildVertexSetFromScene(scene->children.at(i));
         }
 
         bool build(void)
@@ -574,12 +588,11 @@ namespace scenegraph
             records.push_back(lightSourcePalette);
 
 
-            buildVertexSetFromScene(scene);
+            buildMeshFromScene(scene);
+            buildVertexPalette();
             flt::RecordList vertexList;
-            vertexVector.insert(vertexVector.end(), vertexSet.begin(), vertexSet.end());
             for(size_t i = 0, c = vertexVector.size(); i < c; ++i)
             {
-                vertexMap[vertexVector[i]] = i;
                 flt::VertexWithColorNormalUV *vertexRecord = new flt::VertexWithColorNormalUV;
                 vertexRecord->x = vertexVector[i].x;
                 vertexRecord->y = vertexVector[i].y;
@@ -595,10 +608,8 @@ namespace scenegraph
                 vertexRecord->colorIndex = -1;
                 vertexList.push_back(vertexRecord);
             }
-            vertexVectorM.insert(vertexVectorM.end(), vertexSetM.begin(), vertexSetM.end());
             for(size_t i = 0, c = vertexVectorM.size(); i < c; ++i)
             {
-                vertexMapM[vertexVectorM[i]] = i;
                 flt::VertexWithColorNormal *vertexRecord = new flt::VertexWithColorNormal;
                 vertexRecord->x = vertexVectorM[i].x;
                 vertexRecord->y = vertexVectorM[i].y;
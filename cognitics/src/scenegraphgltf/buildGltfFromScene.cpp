@@ -6,7 +6,7 @@
 namespace scenegraph
 {
 	bool buildGltfFromScene(std::string &filename, Scene* scene,
-		double north, double south, double east, double west, double minElev, double maxElev, int id, double angle)
+		double north, double south, double east, double west, double minElev, double maxElev, int id, double angle, bool quantize, gltf::TileInfo* tileInfo)
 	{
 		GeoRect tilePos;
 		tilePos.east = east;
@@ -20,39 +20,45 @@ namespace scenegraph
 		gltf::GltfJson json(data);
 
 		info.init();
+		info.quantize = quantize;
 		data.init();
 
-		info.createFile();
-
-		json.write();
+		std::string jsonText;
+		json.write(jsonText);
 
+		info.createFile();
 		if (info.gltfBinary)
 		{
-			info.finalizeJsonChunk();
-			info.beginBinaryChunk();
-
-			data.write();
+			data.writeGlb(info.file, jsonText);
+		}
+		else
+		{
+			info.file.write(jsonText.data(), jsonText.size());
+			if (!info.base64Buffers && data.bufferLength > 0)
+			{
+				data.writeBufferFile(info.getBufferFileName(true));
+			}
 		}
-
 		info.finalizeFile();
 
 		filename = info.name;
 		
-		gltf::TileInfo ti;
-		ti.typeId = id;
-		ti.relativePathName = info.relativePathName;
-		ti.north = north;
-		ti.south = south;
-		ti.east = east;
-		ti.west = west;
-		ti.minElev = minElev;
-		ti.maxElev = maxElev;
-		gltf::Tileset::tiles.push_back(ti);
+		if (tileInfo != NULL)
+		{
+			tileInfo->typeId = id;
+			tileInfo->relativePathName = info.relativePathName;
+			tileInfo->north = north;
+			tileInfo->south = south;
+			tileInfo->east = east;
+			tileInfo->west = west;
+			tileInfo->minElev = minElev;
+			tileInfo->maxElev = maxElev;
+		}
 
 		return true;
 	}
 
-	bool buildTilesetFromScene(const std::string &filename, Scene* scene, double north, double south, double east, double west)
+	bool buildTilesetFromScene(const std::string &filename, Scene* scene, double north, double south, double east, double west, const std::vector<gltf::TileInfo> &tiles)
 	{
 		GeoRect bounds;
 		bounds.east = east;
@@ -61,7 +67,7 @@ namespace scenegraph
 		bounds.west = west;
 		bounds.elev = 0;
 
-		gltf::Tileset tileset(filename, scene, bounds);
+		gltf::Tileset tileset(filename, scene, bounds, tiles);
 		
 		tileset.write();
 		
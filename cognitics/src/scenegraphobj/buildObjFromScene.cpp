@@ -29,7 +29,7 @@ namespace scenegraph
         int elevWidth;
         int elevHeight;
         ctl::PointList workingPts;
-        scenegraph::Scene scene;
+        scenegraph::IndexedMesh mesh;
         // constructor
         SceneObjBuilder(const std::string outputName, double lWest, double lNorth, double width, double height, int elevationWidth, int elevationHeight, const ctl::PointList &workingPoints)
         {
@@ -45,7 +45,6 @@ namespace scenegraph
             elevWidth = elevationWidth;
             elevHeight = elevationHeight;
             workingPts = workingPoints;
-            scene = NULL;
         }
         SceneObjBuilder(const std::string outputName, double lWest, double lNorth, double width, double height, scenegraph::Scene *inScene)
         {
@@ -58,7 +57,7 @@ namespace scenegraph
             localNorth = lNorth;
             localWidth = width;
             localHeight = height;
-            scene = *inScene;
+            inScene->buildIndexedMesh(mesh);
         }
 
         // destructor
@@ -72,152 +71,75 @@ namespace scenegraph
             //tileInfo.open(outputNameInfo, std::ofstream::out | std::ofstream::app);
             //tileInfo << localWest << " " << localNorth << "\n";
             //tileInfo.close();
-            std::ofstream file(outputNameObj);
-            file << std::setprecision(9);
-            file << "mtllib material.mtl\n";
-
-            std::map<std::string, std::vector<scenegraph::Face*>> seperatedFaces;
-
-            for (auto& face : scene.faces)
-            {
-                auto string = face.getMappedTextureN(0).GetTextureName();
-                if (seperatedFaces.find(string) == seperatedFaces.end())
-                {
-                    seperatedFaces[string] = std::vector<scenegraph::Face*>();
-                }
-                seperatedFaces[string].push_back(&face);
-            }
-
-            int index = 0;
-
-            for (auto& faceList : seperatedFaces)
-            {
-                for (auto&face : faceList.second)
-                {
-                    for (int i = 0; i < 3; i++)
-                    {
-                        file << "v " << face->verts[i].X() << " " << face->verts[i].Y() << " " << face->verts[i].Z() << "\n";
-                    }
-                }
-            }
-
-            for (auto& faceList : seperatedFaces)
-            {
-                for (auto&face : faceList.second)
-                {
-                    for (int i = 0; i < 3; i++)
-                    {
-                        float u = face->textures[0].uvs[i].X();
-                        float v = face->textures[0].uvs[i].Y();
-                        file << "vt " << u << " " << v << " " << 0 << "\n";
-                    }
-                }
-            }
-
-            index = 0;
-
-            for (auto& kvp : seperatedFaces)
-            {
-                file << "usemtl " << kvp.first << "\n";
-                for (auto& face : kvp.second)
-                {
-                    index += 3;
-                    int index1 = index - 2;
-                    int index2 = index - 1;
-                    int index3 = index;
-
-                    file << "f ";
-                    file << index1 << "/" << index1 << " ";
-                    file << index2 << "/" << index2 << " ";
-                    file << index3 << "/" << index3 << "\n";
-                }
-            }
-
-            // print out material file 
-            file.close();
-			if (material.is_open())
-			{
-				material.close();
-			}
-            material.open(outputNameMtl, std::ofstream::out | std::ofstream::app);
-            material << std::setprecision(9);
-            for (auto& kvp : seperatedFaces)
-            {
-                material << "newmtl " << kvp.first << "\n";
-                material << "Ka " << 1.0 << " " << 1.0 << " " << 1.0 << "\n";
-                material << "Kd " << 1.0 << " " << 1.0 << " " << 1.0 << "\n";
-                material << "Ks " << 0.0 << " " << 0.0 << " " << 0.0 << "\n";
-                material << "Tr " << 1.0 << "\n";
-                material << "illum " << 1 << "\n";
-                material << "Ns " << 0.0 << "\n";
-                material << "map_Kd " << kvp.first << "\n";
-            }
-            material.close();
-
-            return true;
+            return writeMesh(false);
         }
 
         bool buildXZY()
+        {
+            return writeMesh(true);
+        }
+
+        // Writes the welded mesh arrays once and references them from the faces, grouped by texture name.
+        // The xzy layout mirrors X and swaps Y/Z, and also writes the vertex normals.
+        bool writeMesh(bool xzy)
         {
             std::ofstream file(outputNameObj);
             file << std::setprecision(9);
             file << "mtllib material.mtl\n";
 
-            std::map<std::string, std::vector<scenegraph::Face*>> seperatedFaces;
-
-            for (auto& face : scene.faces)
+            for (size_t i = 0, c = mesh.getNumPositions(); i < c; ++i)
             {
-                auto string = face.getMappedTextureN(0).GetTextureName();
-                if (seperatedFaces.find(string) == seperatedFaces.end())
-                {
-                    seperatedFaces[string] = std::vector<scenegraph::Face*>();
-                }
-                seperatedFaces[string].push_back(&face);
+                const double *p = &mesh.positions[i * 3];
+                if (xzy)
+                    file << "v " << -p[0] << " " << p[2] << " " << p[1] << "\n";
+                else
+                    file << "v " << p[0] << " " << p[1] << " " << p[2] << "\n";
             }
-
-            int index = 0;
-
-            for (auto& faceList : seperatedFaces)
+            if (xzy)
             {
-                for (auto&face : faceList.second)
+                for (size_t i = 0, c = mesh.getNumNormals(); i < c; ++i)
                 {
-                    for (int i = 0; i < 3; i++)
-                    {
-                        file << "v " << -face->verts[i].X() << " " << face->verts[i].Z() << " " << face->verts[i].Y() << "\n";
-                        file << "vn " << -face->vertexNormals[i].X() << " " << face->vertexNormals[i].Z() << " " << face->vertexNormals[i].Y() << "\n";
-                    }
+                    const double *n = &mesh.normals[i * 3];
+                    file << "vn " << -n[0] << " " << n[2] << " " << n[1] << "\n";
                 }
             }
-
-            for (auto& faceList : seperatedFaces)
+            for (size_t i = 0, c = mesh.getNumUVs(); i < c; ++i)
             {
-                for (auto&face : faceList.second)
-                {
-                    for (int i = 0; i < 3; i++)
-                    {
-                        float u = face->textures[0].uvs[i].X();
-                        float v = face->textures[0].uvs[i].Y();
-                        file << "vt " << u << " " << v << " " << 0 << "\n";
-                    }
-                }
+                float u = float(mesh.uvs[i * 2]);
+                float v = float(mesh.uvs[(i * 2) + 1]);
+                file << "vt " << u << " " << v << " " << 0 << "\n";
             }
 
-            index = 0;
+            std::map<std::string, std::vector<size_t>> seperatedFaces;
+            for (size_t i = 0, c = mesh.faces.size(); i < c; ++i)
+            {
+                const scenegraph::IndexedMesh::IndexedFace &face = mesh.faces[i];
+                if (face.texture < 0 || face.numCorners < 3)
+                    continue;
+                seperatedFaces[mesh.textures[face.texture]].push_back(i);
+            }
 
             for (auto& kvp : seperatedFaces)
             {
                 file << "usemtl " << kvp.first << "\n";
-                for (auto& face : kvp.second)
+                for (size_t i : kvp.second)
                 {
-                    index += 3;
-                    int index1 = index - 2;
-                    int index2 = index - 1;
-                    int index3 = index;
-
-                    file << "f ";
-                    file << index1 << "/" << index1 << " ";
-                    file << index2 << "/" << index2 << " ";
-                    file << index3 << "/" << index3 << "\n";
+                    const scenegraph::IndexedMesh::IndexedFace &face = mesh.faces[i];
+                    file << "f";
+                    for (ccl::uint32_t j = 0; j < face.numCorners; ++j)
+                    {
+                        const scenegraph::IndexedMesh::Corner &corner = mesh.corners[face.firstCorner + j];
+                        bool hasUV = (corner.uv != scenegraph::IndexedMesh::NONE);
+                        bool hasNormal = xzy && (corner.normal != scenegraph::IndexedMesh::NONE);
+                        file << " " << (corner.position + 1);
+                        if (hasUV || hasNormal)
+                            file << "/";
+                        if (hasUV)
+                            file << (corner.uv + 1);
+                        if (hasNormal)
+                            file << "/" << (corner.normal + 1);
+                    }
+                    file << "\n";
                 }
             }
 
@@ -874,18 +874,18 @@ namespace sfa {
                             norm->Z()*((v1->X() - v0->X())*(v2->Y() - v0->Y()) - (v1->Y() - v0->Y())*(v2->X() - v0->X()));
 
                 LineString* line = new LineString;
-                line->addPoint(new Point(v0.get()));
+                line->addPoint(Point(v0.get()));
                 if (TP > 0)
                 {
-                    line->addPoint(new Point(v1.get()));
-                    line->addPoint(new Point(v2.get()));
+                    line->addPoint(Point(v1.get()));
+                    line->addPoint(Point(v2.get()));
                 }
                 else
                 {
-                    line->addPoint(new Point(v2.get()));
-                    line->addPoint(new Point(v1.get()));
+                    line->addPoint(Point(v2.get()));
+                    line->addPoint(Point(v1.get()));
                 }
-                line->addPoint(new Point(v0.get()));
+                line->addPoint(Point(v0.get()));
 
                 Polygon* polygon = new Polygon;
                 polygon->addRing(line);
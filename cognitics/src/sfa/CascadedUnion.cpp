@@ -0,0 +1,408 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "sfa/CascadedUnion.h"
+#include "sfa/LineString.h"
+#include <ccl/JobManager.h>
+#include <ccl/sem.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+namespace sfa {
+
+    namespace
+    {
+        struct UnionBounds
+        {
+            double minX, minY, maxX, maxY;
+
+            UnionBounds(void) : minX(DBL_MAX), minY(DBL_MAX), maxX(-DBL_MAX), maxY(-DBL_MAX) { }
+
+            bool intersects(const UnionBounds &other) const
+            {
+                return (minX <= other.maxX) && (other.minX <= maxX) && (minY <= other.maxY) && (other.minY <= maxY);
+            }
+
+            void expand(const UnionBounds &other)
+            {
+                minX = std::min(minX, other.minX);
+                minY = std::min(minY, other.minY);
+                maxX = std::max(maxX, other.maxX);
+                maxY = std::max(maxY, other.maxY);
+            }
+        };
+
+        UnionBounds getPolygonBounds(const Polygon *polygon)
+        {
+            UnionBounds bounds;
+            const LineString *ring = polygon->getExteriorRing();
+            for(int i = 0, c = ring->getNumPoints(); i < c; ++i)
+            {
+                Point point = ring->getCoordinateN(i);
+                bounds.minX = std::min(bounds.minX, point.X());
+                bounds.minY = std::min(bounds.minY, point.Y());
+                bounds.maxX = std::max(bounds.maxX, point.X());
+                bounds.maxY = std::max(bounds.maxY, point.Y());
+            }
+            // pad by the tolerance so that polygons sharing an edge are still merged
+            bounds.minX -= SFA_EPSILON;
+            bounds.minY -= SFA_EPSILON;
+            bounds.maxX += SFA_EPSILON;
+            bounds.maxY += SFA_EPSILON;
+            return bounds;
+        }
+
+        // a set of disjoint polygons covering one subtree; owns its polygons
+        struct UnionPart
+        {
+            PolygonList polygons;
+            std::vector<UnionBounds> bounds;
+            UnionBounds extent;
+
+            UnionPart(void) { }
+            UnionPart(UnionPart &&other) : polygons(std::move(other.polygons)), bounds(std::move(other.bounds)), extent(other.extent)
+            {
+                other.polygons.clear();
+                other.bounds.clear();
+                other.extent = UnionBounds();
+            }
+            UnionPart &operator=(UnionPart &&other)
+            {
+                if(this != &other)
+                {
+                    release();
+                    polygons.swap(other.polygons);
+                    bounds.swap(other.bounds);
+                    std::swap(extent, other.extent);
+                }
+                return *this;
+            }
+            UnionPart(const UnionPart &) = delete;
+            UnionPart &operator=(const UnionPart &) = delete;
+
+            ~UnionPart(void)
+            {
+                release();
+            }
+
+            void release(void)
+            {
+                for(size_t i = 0, c = polygons.size(); i < c; ++i)
+                    delete polygons[i];
+                polygons.clear();
+                bounds.clear();
+                extent = UnionBounds();
+            }
+
+            void add(Polygon *polygon)
+            {
+                add(polygon, getPolygonBounds(polygon));
+            }
+
+            void add(Polygon *polygon, const UnionBounds &polygonBounds)
+            {
+                polygons.push_back(polygon);
+                bounds.push_back(polygonBounds);
+                extent.expand(polygonBounds);
+            }
+        };
+
+        void copyPolygons(const Geometry *geometry, UnionPart &part)
+        {
+            if(const Polygon *polygon = dynamic_cast<const Polygon *>(geometry))
+            {
+                if(!polygon->isEmpty())
+                    part.add(new Polygon(*polygon));
+            }
+            else if(const GeometryCollection *collection = dynamic_cast<const GeometryCollection *>(geometry))
+            {
+                // disjoint inputs come back as a collection of the (multi)polygon operands
+                for(int i = 1, c = collection->getNumGeometries(); i <= c; ++i)
+                    copyPolygons(collection->getGeometryN(i), part);
+            }
+        }
+
+        // takes ownership of the overlay result
+        void addPolygons(Geometry *geometry, UnionPart &part)
+        {
+            Polygon *polygon = dynamic_cast<Polygon *>(geometry);
+            if(polygon && !polygon->isEmpty())
+            {
+                part.add(polygon);
+                return;
+            }
+            copyPolygons(geometry, part);
+            delete geometry;
+        }
+
+        // merges b into a; only the polygons of each side that overlap the extent of the other side go through the overlay
+        void merge(UnionPart &a, UnionPart &b)
+        {
+            if(b.polygons.empty())
+                return;
+            if(a.polygons.empty())
+            {
+                a = std::move(b);
+                return;
+            }
+            if(!a.extent.intersects(b.extent))
+            {
+                for(size_t i = 0, c = b.polygons.size(); i < c; ++i)
+                    a.add(b.polygons[i], b.bounds[i]);
+                b.polygons.clear();
+                b.bounds.clear();
+                return;
+            }
+
+            UnionPart result;
+            std::vector<Polygon *> interactingA, interactingB;
+            for(size_t i = 0, c = a.polygons.size(); i < c; ++i)
+            {
+                if(a.bounds[i].intersects(b.extent))
+                    interactingA.push_back(a.polygons[i]);
+                else
+                    result.add(a.polygons[i], a.bounds[i]);
+            }
+            for(size_t i = 0, c = b.polygons.size(); i < c; ++i)
+            {
+                if(b.bounds[i].intersects(a.extent))
+                    interactingB.push_back(b.polygons[i]);
+                else
+                    result.add(b.polygons[i], b.bounds[i]);
+            }
+            a.polygons.clear();
+            a.bounds.clear();
+            b.polygons.clear();
+            b.bounds.clear();
+
+            if(interactingA.empty() || interactingB.empty())
+            {
+                for(size_t i = 0, c = interactingA.size(); i < c; ++i)
+                    result.add(interactingA[i]);
+                for(size_t i = 0, c = interactingB.size(); i < c; ++i)
+                    result.add(interactingB[i]);
+                a = std::move(result);
+                return;
+            }
+
+            MultiPolygon multiA, multiB;
+            for(size_t i = 0, c = interactingA.size(); i < c; ++i)
+                multiA.addGeometry(interactingA[i]);
+            for(size_t i = 0, c = interactingB.size(); i < c; ++i)
+                multiB.addGeometry(interactingB[i]);
+
+            Geometry *merged = NULL;
+            try
+            {
+                merged = multiA.Union(&multiB);
+            }
+            catch(std::exception &)
+            {
+                merged = NULL;
+            }
+
+            if(merged)
+                addPolygons(merged, result);
+            else
+            {
+                // the overlay failed; keep both sides unmerged rather than dropping area
+                for(size_t i = 0, c = interactingA.size(); i < c; ++i)
+                    result.add(new Polygon(*interactingA[i]));
+                for(size_t i = 0, c = interactingB.size(); i < c; ++i)
+                    result.add(new Polygon(*interactingB[i]));
+            }
+            a = std::move(result);
+        }
+
+        void reduce(std::vector<UnionPart> &parts, size_t first, size_t count)
+        {
+            if(count < 2)
+                return;
+            size_t half = count / 2;
+            reduce(parts, first, half);
+            reduce(parts, first + half, count - half);
+            merge(parts[first], parts[first + half]);
+        }
+
+        // Sort-Tile-Recursive order: vertical slices by envelope center x, then by center y within each slice
+        // (alternating direction so consecutive slices stay adjacent)
+        void sortParts(std::vector<UnionPart> &parts)
+        {
+            const size_t leafCapacity = 16;
+            size_t count = parts.size();
+            std::vector<std::pair<double, double> > centers(count);
+            std::vector<size_t> order(count);
+            for(size_t i = 0; i < count; ++i)
+            {
+                centers[i].first = (parts[i].extent.minX + parts[i].extent.maxX) / 2;
+                centers[i].second = (parts[i].extent.minY + parts[i].extent.maxY) / 2;
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(), [&centers](size_t a, size_t b) { return centers[a].first < centers[b].first; });
+            size_t leaves = (count + leafCapacity - 1) / leafCapacity;
+            size_t slices = std::max<size_t>(1, size_t(std::ceil(std::sqrt(double(leaves)))));
+            size_t sliceSize = slices * leafCapacity;
+            for(size_t first = 0, slice = 0; first < count; first += sliceSize, ++slice)
+            {
+                size_t last = std::min(count, first + sliceSize);
+                bool ascending = ((slice % 2) == 0);
+                std::sort(order.begin() + first, order.begin() + last, [&centers, ascending](size_t a, size_t b)
+                {
+                    return ascending ? (centers[a].second < centers[b].second) : (centers[a].second > centers[b].second);
+                });
+            }
+            std::vector<UnionPart> sorted;
+            sorted.reserve(count);
+            for(size_t i = 0; i < count; ++i)
+                sorted.push_back(std::move(parts[order[i]]));
+            parts.swap(sorted);
+        }
+
+        class UnionJob : public ccl::Job
+        {
+        private:
+            std::function<void(void)> work;
+            ccl::semaphore *done;
+
+        public:
+            UnionJob(ccl::JobManager *manager, const std::function<void(void)> &work, ccl::semaphore *done) : ccl::Job(manager), work(work), done(done) { }
+
+            virtual int execute(void)
+            {
+                work();
+                done->signal();
+                return 0;
+            }
+        };
+
+        void reduceParallel(std::vector<UnionPart> &parts, size_t numThreads)
+        {
+            // the jobs are unowned, so they have to outlive the manager's final cleanup
+            std::vector<std::unique_ptr<UnionJob> > jobs;
+            ccl::semaphore done;
+            ccl::JobManager manager(numThreads);
+
+            // leaves: one serial cascaded union per chunk
+            size_t chunks = std::min(parts.size(), numThreads * 4);
+            std::vector<size_t> chunkStart(chunks + 1);
+            for(size_t i = 0; i <= chunks; ++i)
+                chunkStart[i] = i * parts.size() / chunks;
+            for(size_t i = 0; i < chunks; ++i)
+            {
+                size_t first = chunkStart[i];
+                size_t count = chunkStart[i + 1] - first;
+                jobs.emplace_back(new UnionJob(&manager, [&parts, first, count]() { reduce(parts, first, count); }, &done));
+                manager.submitJob(jobs.back().get(), false);
+            }
+            for(size_t i = 0; i < chunks; ++i)
+                done.wait(INFINITE);
+
+            // upper levels: merge neighbouring chunk results pairwise, one level at a time
+            std::vector<size_t> roots(chunkStart.begin(), chunkStart.end() - 1);
+            while(roots.size() > 1)
+            {
+                size_t pairs = roots.size() / 2;
+                for(size_t i = 0; i < pairs; ++i)
+                {
+                    size_t a = roots[2 * i];
+                    size_t b = roots[2 * i + 1];
+                    jobs.emplace_back(new UnionJob(&manager, [&parts, a, b]() { merge(parts[a], parts[b]); }, &done));
+                    manager.submitJob(jobs.back().get(), false);
+                }
+                for(size_t i = 0; i < pairs; ++i)
+                    done.wait(INFINITE);
+                std::vector<size_t> next;
+                for(size_t i = 0; i < roots.size(); i += 2)
+                    next.push_back(roots[i]);
+                roots.swap(next);
+            }
+            manager.waitForCompletion();
+        }
+
+        Geometry* buildResult(UnionPart &part)
+        {
+            if(part.polygons.empty())
+                return NULL;
+            if(part.polygons.size() == 1)
+            {
+                Polygon *polygon = part.polygons.front();
+                part.polygons.clear();
+                part.bounds.clear();
+                return polygon;
+            }
+            MultiPolygon *result = new MultiPolygon;
+            for(size_t i = 0, c = part.polygons.size(); i < c; ++i)
+                result->addGeometry(part.polygons[i]);
+            part.polygons.clear();
+            part.bounds.clear();
+            return result;
+        }
+
+        Geometry* cascade(std::vector<UnionPart> &parts, size_t numThreads)
+        {
+            if(parts.empty())
+                return NULL;
+            sortParts(parts);
+            // below a few polygons per thread the job overhead outweighs the overlays
+            if((numThreads > 1) && (parts.size() >= numThreads * 8))
+                reduceParallel(parts, numThreads);
+            else
+                reduce(parts, 0, parts.size());
+            return buildResult(parts.front());
+        }
+    }
+
+    Geometry* CascadedUnion::apply(const PolygonList& list, size_t numThreads)
+    {
+        std::vector<UnionPart> parts;
+        parts.reserve(list.size());
+        for(size_t i = 0, c = list.size(); i < c; ++i)
+        {
+            if(!list[i] || list[i]->isEmpty())
+                continue;
+            parts.push_back(UnionPart());
+            parts.back().add(new Polygon(*list[i]));
+        }
+        return cascade(parts, numThreads);
+    }
+
+    Geometry* CascadedUnion::apply(const MultiPolygon* multiPolygon, size_t numThreads)
+    {
+        std::vector<UnionPart> parts;
+        if(!multiPolygon)
+            return NULL;
+        for(int i = 1, c = multiPolygon->getNumGeometries(); i <= c; ++i)
+        {
+            Polygon *polygon = dynamic_cast<Polygon *>(multiPolygon->getGeometryN(i));
+            if(!polygon || polygon->isEmpty())
+                continue;
+            parts.push_back(UnionPart());
+            parts.back().add(new Polygon(*polygon));
+        }
+        return cascade(parts, numThreads);
+    }
+
+}
@@ -367,10 +367,10 @@ namespace sfa {
         for (int i = 0; i < int(hull_faces.size()); i++)
         {
             LineString* line = new LineString;
-            line->addPoint(new Point(hull_faces[i]->points[0]));
-            line->addPoint(new Point(hull_faces[i]->points[1]));
-            line->addPoint(new Point(hull_faces[i]->points[2]));
-            line->addPoint(new Point(hull_faces[i]->points[0]));
+            line->addPoint(Point(hull_faces[i]->points[0]));
+            line->addPoint(Point(hull_faces[i]->points[1]));
+            line->addPoint(Point(hull_faces[i]->points[2]));
+            line->addPoint(Point(hull_faces[i]->points[0]));
             Polygon* poly = new Polygon;
             poly->addRing(line);
             result->addPatch(poly);
@@ -0,0 +1,154 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "sfa/CoordinateSequence.h"
+#include <algorithm>
+#include <cstring>
+
+namespace sfa
+{
+    CoordinateSequence::~CoordinateSequence(void)
+    {
+    }
+
+    CoordinateSequence::CoordinateSequence(void) : hasZ(false), hasM(false)
+    {
+    }
+
+    CoordinateSequence::CoordinateSequence(bool hasZ, bool hasM) : hasZ(hasZ), hasM(hasM)
+    {
+    }
+
+    void CoordinateSequence::setDimension(bool withZ, bool withM)
+    {
+        if((withZ == hasZ) && (withM == hasM))
+            return;
+        size_t count = size();
+        size_t oldStride = stride();
+        size_t newStride = 2 + (withZ ? 1 : 0) + (withM ? 1 : 0);
+        std::vector<double> result(count * newStride, 0.0);
+        for(size_t i = 0; i < count; ++i)
+        {
+            const double *src = &values[i * oldStride];
+            double *dst = &result[i * newStride];
+            dst[0] = src[0];
+            dst[1] = src[1];
+            if(withZ && hasZ)
+                dst[2] = src[2];
+            if(withM && hasM)
+                dst[withZ ? 3 : 2] = src[hasZ ? 3 : 2];
+        }
+        values.swap(result);
+        hasZ = withZ;
+        hasM = withM;
+    }
+
+    void CoordinateSequence::swap(CoordinateSequence &other)
+    {
+        values.swap(other.values);
+        std::swap(hasZ, other.hasZ);
+        std::swap(hasM, other.hasM);
+    }
+
+    void CoordinateSequence::assign(const void *packed, size_t count, bool withZ, bool withM)
+    {
+        hasZ = withZ;
+        hasM = withM;
+        values.resize(count * stride());
+        if(!values.empty())
+            memcpy(&values[0], packed, values.size() * sizeof(double));
+    }
+
+    Point CoordinateSequence::getPoint(size_t i) const
+    {
+        const double *v = &values[i * stride()];
+        Point result(v[0], v[1]);
+        if(hasZ)
+            result.setZ(v[2]);
+        if(hasM)
+            result.setM(v[hasZ ? 3 : 2]);
+        return result;
+    }
+
+    void CoordinateSequence::setPoint(size_t i, const Point &point)
+    {
+        if((point.is3D() && !hasZ) || (point.isMeasured() && !hasM))
+            setDimension(hasZ || point.is3D(), hasM || point.isMeasured());
+        double *v = &values[i * stride()];
+        v[0] = point.X();
+        v[1] = point.Y();
+        if(hasZ)
+            v[2] = point.Z();
+        if(hasM)
+            v[hasZ ? 3 : 2] = point.M();
+    }
+
+    void CoordinateSequence::addPoint(double x, double y)
+    {
+        values.push_back(x);
+        values.push_back(y);
+        if(hasZ)
+            values.push_back(0.0);
+        if(hasM)
+            values.push_back(0.0);
+    }
+
+    void CoordinateSequence::addPoint(double x, double y, double z)
+    {
+        if(!hasZ)
+            setDimension(true, hasM);
+        values.push_back(x);
+        values.push_back(y);
+        values.push_back(z);
+        if(hasM)
+            values.push_back(0.0);
+    }
+
+    void CoordinateSequence::addPoint(const Point &point)
+    {
+        values.resize(values.size() + stride());
+        setPoint(size() - 1, point);
+    }
+
+    void CoordinateSequence::insertPoint(size_t pos, const Point &point)
+    {
+        if((point.is3D() && !hasZ) || (point.isMeasured() && !hasM))
+            setDimension(hasZ || point.is3D(), hasM || point.isMeasured());
+        values.insert(values.begin() + (pos * stride()), stride(), 0.0);
+        setPoint(pos, point);
+    }
+
+    void CoordinateSequence::removePoint(size_t pos)
+    {
+        std::vector<double>::iterator it = values.begin() + (pos * stride());
+        values.erase(it, it + stride());
+    }
+
+    void CoordinateSequence::reverse(void)
+    {
+        size_t count = size();
+        size_t n = stride();
+        for(size_t i = 0, j = count - 1; (count > 0) && (i < j); ++i, --j)
+            std::swap_ranges(values.begin() + (i * n), values.begin() + ((i + 1) * n), values.begin() + (j * n));
+    }
+
+}
@@ -26,6 +26,9 @@ DEALINGS IN THE SOFTWARE.
 
 #include "sfa/PointMath.h"
 
+#include <algorithm>
+#include <new>
+
 namespace sfa
 {
     Curve::~Curve(void)
@@ -33,70 +36,135 @@ namespace sfa
         clearPoints();
     }
 
-    Curve::Curve(void)
+    Curve::Curve(void) : materialized(false)
     {
     }
 
-    Curve::Curve(const Curve& curve)
+    Curve::Curve(const Curve& curve) : materialized(false)
     {
         setCoordinateSystem(curve.getCoordinateSystem());
-        points.resize(curve.points.size());
-        for(size_t i=0,ic=curve.points.size();i<ic;i++)
-            points[i] = (new Point(*curve.points.at(i)));
+        assignCoordinates(curve);
     }
 
-    Curve::Curve(const Curve* curve)
+    Curve::Curve(const Curve* curve) : materialized(false)
     {
         setCoordinateSystem(curve->getCoordinateSystem());
-        points.resize(curve->points.size());
-        for(size_t i=0,ic=curve->points.size();i<ic;i++)
-            points[i] = (new Point(*curve->points.at(i)));
+        assignCoordinates(*curve);
     }
 
     Curve& Curve::operator=(const Curve& rhs)
     {
-        for (PointList::iterator it = points.begin(), end = points.end(); it != end; it++)
-            delete (*it);
-        points.clear();
-
+        if(this == &rhs)
+            return *this;
+        clearPoints();
         setCoordinateSystem(rhs.getCoordinateSystem());
-        points.resize(rhs.points.size());
-        for(size_t i=0,ic=rhs.points.size();i<ic;i++)
-            points[i] = (new Point(*rhs.points.at(i)));
+        assignCoordinates(rhs);
         return *this;
     }
 
+    void Curve::materialize(void) const
+    {
+        if(!isPacked())
+            return;
+        // the first caller builds the Points; anyone else blocks until they are published
+        std::call_once(materializeOnce, [this]()
+        {
+            // a curve can be materialized long after it was allocated (by a read inside a ccl::ArenaScope), so its
+            // Points always come from the heap rather than an arena that is rewound before the curve is deleted
+            ccl::ArenaScope heapScope(NULL);
+            points.resize(coordinates.size());
+            for(size_t i = 0, ic = coordinates.size(); i < ic; ++i)
+                points[i] = new Point(coordinates.getPoint(i));
+            materialized.store(true, std::memory_order_release);
+        });
+    }
+
+    void Curve::unpack(void)
+    {
+        materialize();
+        CoordinateSequence().swap(coordinates);
+    }
+
+    void Curve::assignCoordinates(const Curve& other)
+    {
+        if(other.isPacked())
+        {
+            coordinates = other.coordinates;
+            return;
+        }
+        bool hasZ = false;
+        bool hasM = false;
+        for(PointList::const_iterator it = other.points.begin(), end = other.points.end(); it != end; ++it)
+        {
+            hasZ = hasZ || (*it)->is3D();
+            hasM = hasM || (*it)->isMeasured();
+        }
+        CoordinateSequence packed(hasZ, hasM);
+        packed.reserve(other.points.size());
+        for(PointList::const_iterator it = other.points.begin(), end = other.points.end(); it != end; ++it)
+            packed.addPoint(**it);
+        coordinates.swap(packed);
+    }
+
     void Curve::clearPoints(void)
     {
         for (PointList::iterator it = points.begin(), end = points.end(); it != end; it++)
             delete (*it);
         points.clear();
+        CoordinateSequence().swap(coordinates);
+        materialized.store(false, std::memory_order_release);
+        // a once_flag can't be reset; clearing has exclusive access, so start the next materialize with a new one
+        new (&materializeOnce) std::once_flag;
+    }
+
+    void Curve::swapCoordinates(CoordinateSequence& other)
+    {
+        clearPoints();
+        coordinates.swap(other);
     }
 
     void Curve::addPoint(Point* point)
     {
+        unpack();
         points.push_back(point);
     }
 
     void Curve::addPoint(const Point& point)
     {
-        addPoint(new Point(point));
+        if(isPacked())
+        {
+            coordinates.addPoint(point);
+            return;
+        }
+        unpack();
+        points.push_back(new Point(point));
     }
 
     void Curve::insertPoint(int pos, Point* point)
     {
+        unpack();
         points.insert(points.begin() + pos, point);
     }
 
     void Curve::insertPoint(int pos, const Point& point)
     {
-        insertPoint(pos,new Point(point));
+        if(isPacked())
+        {
+            coordinates.insertPoint(pos, point);
+            return;
+        }
+        unpack();
+        points.insert(points.begin() + pos, new Point(point));
     }
 
 
 
     void Curve::removePoint(Point* point)
     {
+        // a packed curve has no Point objects, so it cannot own this one
+        if(isPacked())
+            return;
+        unpack();
         for(PointList::iterator it = points.begin(), end = points.end(); it != end; ++it)
         {
             if(*it == point)
@@ -110,6 +178,13 @@ namespace sfa
 
     void Curve::removePoint(int pos)
     {
+        if(isPacked())
+        {
+            if (pos >= 0 && pos < int(coordinates.size()))
+                coordinates.removePoint(pos);
+            return;
+        }
+        unpack();
         if (pos >= 0 && pos < int(points.size()))
             delete points[pos];
         points.erase(points.begin() + pos);
@@ -117,6 +192,12 @@ namespace sfa
 
     void Curve::reverse(void)
     {
+        if(isPacked())
+        {
+            coordinates.reverse();
+            return;
+        }
+        unpack();
         std::reverse(points.begin(),points.end());
     }
 
@@ -124,8 +205,21 @@ namespace sfa
     {
         if(mathTransform)
         {
-            for(PointList::iterator it = points.begin(), end = points.end(); it != end; ++it)
-                (*it)->setCoordinateSystem(coordinateSystem, mathTransform);
+            if(isPacked())
+            {
+                for(size_t i = 0, ic = coordinates.size(); i < ic; ++i)
+                {
+                    Point point = coordinates.getPoint(i);
+                    point.setCoordinateSystem(coordinateSystem, mathTransform);
+                    coordinates.setPoint(i, point);
+                }
+            }
+            else
+            {
+                unpack();
+                for(PointList::iterator it = points.begin(), end = points.end(); it != end; ++it)
+                    (*it)->setCoordinateSystem(coordinateSystem, mathTransform);
+            }
         }
         Geometry::setCoordinateSystem(coordinateSystem, mathTransform);
     }
@@ -142,52 +236,91 @@ namespace sfa
 
         double minX, maxX, minY, maxY, minZ, maxZ, minM, maxM;
         minX = maxX = minY = maxY = minZ = maxZ = minM = maxM = 0;
-        Point* startPoint = getStartPoint();
 
-        minX = maxX = startPoint->X();
-        minY = maxY = startPoint->Y();
-        minZ = maxZ = startPoint->Z();
-        minM = maxM = startPoint->M();
-
-        for(PointList::const_iterator it = points.begin(), end = points.end(); it != end; ++it)
+        if(isPacked())
         {
-            Point* point = *it;
-
-            if(point->X() < minX)
-                minX = point->X();
-            if(point->X() > maxX)
-                maxX = point->X();
-            if(point->Y() < minY)
-                minY = point->Y();
-            if(point->Y() > maxY)
-                maxY = point->Y();
-            if(point->is3D())
+            const double *v = coordinates.data();
+            const size_t stride = coordinates.getStride();
+            const size_t count = coordinates.size();
+            const bool hasZ = coordinates.is3D();
+            const bool hasM = coordinates.isMeasured();
+            const size_t mOffset = hasZ ? 3 : 2;
+
+            minX = maxX = v[0];
+            minY = maxY = v[1];
+            if(hasZ)
+                minZ = maxZ = v[2];
+            if(hasM)
+                minM = maxM = v[mOffset];
+
+            for(size_t i = 1; i < count; ++i)
             {
-                if(point->Z() < minZ)
-                    minZ = point->Z();
-                if(point->Z() > maxZ)
-                    maxZ = point->Z();
+                v += stride;
+                minX = std::min<double>(minX, v[0]);
+                maxX = std::max<double>(maxX, v[0]);
+                minY = std::min<double>(minY, v[1]);
+                maxY = std::max<double>(maxY, v[1]);
+                if(hasZ)
+                {
+                    minZ = std::min<double>(minZ, v[2]);
+                    maxZ = std::max<double>(maxZ, v[2]);
+                }
+                if(hasM)
+                {
+                    minM = std::min<double>(minM, v[mOffset]);
+                    maxM = std::max<double>(maxM, v[mOffset]);
+                }
             }
-            if(point->isMeasured())
+        }
+        else
+        {
+            Point* startPoint = points.front();
+
+            minX = maxX = startPoint->X();
+            minY = maxY = startPoint->Y();
+            minZ = maxZ = startPoint->Z();
+            minM = maxM = startPoint->M();
+
+            for(PointList::const_iterator it = points.begin(), end = points.end(); it != end; ++it)
             {
-                if(point->M() < minM)
-                    minM = point->M();
-                if(point->M() > maxM)
-                    maxM = point->M();
+                Point* point = *it;
+
+                if(point->X() < minX)
+                    minX = point->X();
+                if(point->X() > maxX)
+                    maxX = point->X();
+                if(point->Y() < minY)
+                    minY = point->Y();
+                if(point->Y() > maxY)
+                    maxY = point->Y();
+                if(point->is3D())
+                {
+                    if(point->Z() < minZ)
+                        minZ = point->Z();
+                    if(point->Z() > maxZ)
+                        maxZ = point->Z();
+                }
+                if(point->isMeasured())
+                {
+                    if(point->M() < minM)
+                        minM = point->M();
+                    if(point->M() > maxM)
+                        maxM = point->M();
+                }
             }
         }
 
-        Point* minPoint = new Point(minX, minY);
-        Point* maxPoint = new Point(maxX, maxY);
+        Point minPoint(minX, minY);
+        Point maxPoint(maxX, maxY);
         if(is3D())
         {
-            minPoint->setZ(minZ);
-            maxPoint->setZ(maxZ);
+            minPoint.setZ(minZ);
+            maxPoint.setZ(maxZ);
         }
         if(isMeasured())
         {
-            minPoint->setM(minM);
-            maxPoint->setM(maxM);
+            minPoint.setM(minM);
+            maxPoint.setM(maxM);
         }
 
         LineString* envelope = new LineString;
@@ -198,27 +331,34 @@ namespace sfa
 
     bool Curve::isEmpty(void) const
     {
-        return points.empty();
+        return isPacked() ? coordinates.empty() : points.empty();
     }
 
     bool Curve::isSimple(void) const
     {
+        std::vector<Point> vertices;
+        vertices.reserve(numVertices());
+        for (size_t i = 0, ic = numVertices(); i < ic; i++)
+            vertices.push_back(vertex(i));
+        const int count = int(vertices.size());
+        const bool closed = isClosed();
+
         //a simple curve is not self intersecting, test all the edges against all other edges
-        for (int i = 0; i < int(points.size()-1); i++)
+        for (int i = 0; i < count - 1; i++)
         {
-            for (int j = 0; j < int(points.size()-1); j++)
+            for (int j = 0; j < count - 1; j++)
             {
-                Point* p1 = points[i];
-                Point* p2 = points[i+1];
-                Point* p3 = points[j];
-                Point* p4 = points[j+1];
+                Point* p1 = &vertices[i];
+                Point* p2 = &vertices[i+1];
+                Point* p3 = &vertices[j];
+                Point* p4 = &vertices[j+1];
 
                 //    Don't bother with trivial intersections
                 if (i==j || i==j+1 || i+1==j) continue;
-                else if (isClosed())
+                else if (closed)
                 {
-                    if (i==0 && j==(points.size()-2)) continue;
-                    if (j==0 && i==(points.size()-2)) continue;
+                    if (i==0 && j==(count-2)) continue;
+                    if (j==0 && i==(count-2)) continue;
                 }
 
                 bool Bp1 = Between(p3,p4,p1);
@@ -255,6 +395,8 @@ namespace sfa
 
     bool Curve::is3D(void) const
     {
+        if(isPacked())
+            return !coordinates.empty() && coordinates.is3D();
         for(PointList::const_iterator it = points.begin(), end = points.end(); it != end; ++it)
         {
             if((*it)->is3D())
@@ -265,6 +407,8 @@ namespace sfa
 
     bool Curve::isMeasured(void) const
     {
+        if(isPacked())
+            return !coordinates.empty() && coordinates.isMeasured();
         for(PointList::const_iterator it = points.begin(), end = points.end(); it != end; ++it)
         {
             if((*it)->isMeasured())
@@ -275,11 +419,11 @@ namespace sfa
 
     Geometry* Curve::getBoundary(void) const
     {
-        if(isClosed())
+        if(isEmpty() || isClosed())
             return NULL;
         MultiPoint* boundary = new MultiPoint();
-        boundary->addGeometry(new Point(getStartPoint()));
-        boundary->addGeometry(new Point(getEndPoint()));
+        boundary->addGeometry(new Point(vertex(0)));
+        boundary->addGeometry(new Point(vertex(numVertices() - 1)));
         return boundary;
     }
 
@@ -288,6 +432,8 @@ namespace sfa
         if (!isMeasured())
             return new MultiPoint;
 
+        materialize();
+
         PointList pointCollection;
         LineStringList lineCollection;
 
@@ -313,7 +459,7 @@ namespace sfa
                 {
                     if (open)
                     {
-                        temp->addPoint(new Point(start));
+                        temp->addPoint(Point(start));
                         open = false;
                     }
                     else
@@ -326,7 +472,7 @@ namespace sfa
                     interpolatedPoint->setM(mValue);
 
                     if (!open) temp = new LineString;
-                    temp->addPoint(new Point(start));
+                    temp->addPoint(Point(start));
                     temp->addPoint(interpolatedPoint);
 
                     lineCollection.push_back(temp);
@@ -384,7 +530,7 @@ namespace sfa
 
                 temp = new LineString;
                 temp->addPoint(interpolatedPoint);
-                if (!interpolatedPoint->equals(stop)) temp->addPoint(new Point(stop));
+                if (!interpolatedPoint->equals(stop)) temp->addPoint(Point(stop));
                 open = true;
 
                 if (i == int(points.size() - 2))
@@ -401,14 +547,14 @@ namespace sfa
             {
                 if (open)
                 {
-                    temp->addPoint(new Point(stop));
+                    temp->addPoint(Point(stop));
                 }
                 else
                 {
                     open = true;
                     temp = new LineString;
-                    temp->addPoint(new Point(start));
-                    temp->addPoint(new Point(stop));
+                    temp->addPoint(Point(start));
+                    temp->addPoint(Point(stop));
                 }
 
                 if (i == int(points.size() - 2)) lineCollection.push_back(temp);
@@ -437,17 +583,30 @@ namespace sfa
 
     Point* Curve::getStartPoint(void) const
     {
-        return points.empty() ? NULL : points.front();
+        if(isEmpty())
+            return NULL;
+        materialize();
+        return points.front();
     }
 
     Point* Curve::getEndPoint(void) const
     {
-        return points.empty() ? NULL : points.back();
+        if(isEmpty())
+            return NULL;
+        materialize();
+        return points.back();
     }
 
     bool Curve::isClosed(void) const
     {
-        return (getStartPoint() == NULL) ? false : getStartPoint()->equals(getEndPoint());
+        if(isEmpty())
+            return false;
+        if(!isPacked())
+            return points.front()->equals(points.back());
+        size_t last = coordinates.size() - 1;
+        double dx = coordinates.X(last) - coordinates.X(0);
+        double dy = coordinates.Y(last) - coordinates.Y(0);
+        return ((dx * dx) + (dy * dy)) < (SFA_EPSILON * SFA_EPSILON);
     }
 
     bool Curve::isRing(void) const
@@ -40,17 +40,17 @@ namespace sfa {
             return false;
         }
 
-        Point* Amin = envA->getPointN(0);
-        Point* Amax = envA->getPointN(1);
-        Point* Bmin = envB->getPointN(0);
-        Point* Bmax = envB->getPointN(1);
+        Point Amin = envA->getCoordinateN(0);
+        Point Amax = envA->getCoordinateN(1);
+        Point Bmin = envB->getCoordinateN(0);
+        Point Bmax = envB->getCoordinateN(1);
 
         bool result = true;
 
-        if (Amin->X() > (Bmax->X() + SFA_EPSILON)) result = false;
-        else if (Amin->Y() > (Bmax->Y() + SFA_EPSILON)) result =  false;
-        else if (Amax->X() < (Bmin->X() - SFA_EPSILON)) result =  false;
-        else if (Amax->Y() < (Bmin->Y() - SFA_EPSILON)) result =  false;
+        if (Amin.X() > (Bmax.X() + SFA_EPSILON)) result = false;
+        else if (Amin.Y() > (Bmax.Y() + SFA_EPSILON)) result =  false;
+        else if (Amax.X() < (Bmin.X() - SFA_EPSILON)) result =  false;
+        else if (Amax.Y() < (Bmin.Y() - SFA_EPSILON)) result =  false;
 
         delete envA;
         delete envB;
@@ -73,19 +73,19 @@ namespace sfa {
             return false;
         }
 
-        Point* Amin = envA->getPointN(0);
-        Point* Amax = envA->getPointN(1);
-        Point* Bmin = envB->getPointN(0);
-        Point* Bmax = envB->getPointN(1);
+        Point Amin = envA->getCoordinateN(0);
+        Point Amax = envA->getCoordinateN(1);
+        Point Bmin = envB->getCoordinateN(0);
+        Point Bmax = envB->getCoordinateN(1);
 
         bool result = true;
 
-        if (Amin->X() > (Bmax->X() + SFA_EPSILON)) result =  false;
-        else if (Amin->Y() > (Bmax->Y() + SFA_EPSILON)) result =  false;
-        else if (Amin->Z() > (Bmax->Z() + SFA_EPSILON)) result =  false;
-        else if (Amax->X() < (Bmin->X() - SFA_EPSILON)) result =  false;
-        else if (Amax->Y() < (Bmin->Y() - SFA_EPSILON)) result =  false;
-        else if (Amax->Z() < (Bmin->Z() - SFA_EPSILON)) result =  false;
+        if (Amin.X() > (Bmax.X() + SFA_EPSILON)) result =  false;
+        else if (Amin.Y() > (Bmax.Y() + SFA_EPSILON)) result =  false;
+        else if (Amin.Z() > (Bmax.Z() + SFA_EPSILON)) result =  false;
+        else if (Amax.X() < (Bmin.X() - SFA_EPSILON)) result =  false;
+        else if (Amax.Y() < (Bmin.Y() - SFA_EPSILON)) result =  false;
+        else if (Amax.Z() < (Bmin.Z() - SFA_EPSILON)) result =  false;
 
         delete envA;
         delete envB;
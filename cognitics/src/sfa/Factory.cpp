@@ -36,6 +36,8 @@ DEALINGS IN THE SOFTWARE.
 #include "sfa/MultiSurface.h"
 #include "sfa/MultiPolygon.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 namespace sfa
@@ -229,4 +231,197 @@ namespace sfa
         return geometry;
     }
 
+    namespace
+    {
+        // Reads WKB straight from memory. Returns NULL (and sets failed) on truncated input; unsupported types
+        // (polyhedral surfaces, TINs) set unsupported so the caller can fall back to the stream based reader.
+        class WKBDecoder
+        {
+        private:
+            const unsigned char *pos;
+            const unsigned char *end;
+            std::vector<double> swapped;
+
+            bool has(size_t bytes) const
+            {
+                return size_t(end - pos) >= bytes;
+            }
+
+            ccl::uint32_t readUInt32(bool bigEndian)
+            {
+                unsigned char bytes[4];
+                memcpy(bytes, pos, 4);
+                pos += 4;
+                if(bigEndian != ccl::machBigEndian())
+                    std::reverse(bytes, bytes + 4);
+                ccl::uint32_t result;
+                memcpy(&result, bytes, 4);
+                return result;
+            }
+
+            double readDouble(bool bigEndian)
+            {
+                unsigned char bytes[8];
+                memcpy(bytes, pos, 8);
+                pos += 8;
+                if(bigEndian != ccl::machBigEndian())
+                    std::reverse(bytes, bytes + 8);
+                double result;
+                memcpy(&result, bytes, 8);
+                return result;
+            }
+
+            bool readCoordinates(CoordinateSequence &sequence, bool bigEndian, bool withZ, bool withM)
+            {
+                if(!has(4))
+                    return false;
+                ccl::uint32_t count = readUInt32(bigEndian);
+                size_t stride = 2 + (withZ ? 1 : 0) + (withM ? 1 : 0);
+                if(!has(size_t(count) * stride * 8))
+                    return false;
+                if(bigEndian == ccl::machBigEndian())
+                {
+                    sequence.assign(pos, count, withZ, withM);
+                    pos += size_t(count) * stride * 8;
+                }
+                else
+                {
+                    swapped.resize(size_t(count) * stride);
+                    for(size_t i = 0, c = swapped.size(); i < c; ++i)
+                        swapped[i] = readDouble(bigEndian);
+                    sequence.assign(swapped.empty() ? NULL : &swapped[0], count, withZ, withM);
+                }
+                return true;
+            }
+
+        public:
+            bool failed;
+            bool unsupported;
+
+            WKBDecoder(const unsigned char *wkb, size_t size) : pos(wkb), end(wkb + size), failed(false), unsupported(false) { }
+
+            Geometry *read(void)
+            {
+                if(!has(5))
+                {
+                    failed = true;
+                    return NULL;
+                }
+                bool bigEndian = (*pos++ == wkbXDR);
+                ccl::uint32_t type = readUInt32(bigEndian);
+                bool withZ = (type & 0x80000000) != 0;
+                bool withM = (type & 0x40000000) != 0;
+                if(type & 0x20000000)
+                {
+                    // EWKB SRID
+                    if(!has(4))
+                    {
+                        failed = true;
+                        return NULL;
+                    }
+                    pos += 4;
+                }
+                type &= 0x0FFFFFFF;
+                ccl::uint32_t dimension = type / 1000;
+                type %= 1000;
+                withZ = withZ || (dimension == 1) || (dimension == 3);
+                withM = withM || (dimension == 2) || (dimension == 3);
+
+                switch(type)
+                {
+                    case wkbPoint:
+                    {
+                        size_t count = 2 + (withZ ? 1 : 0) + (withM ? 1 : 0);
+                        if(!has(count * 8))
+                            break;
+                        double x = readDouble(bigEndian);
+                        double y = readDouble(bigEndian);
+                        Point *point = new Point(x, y);
+                        if(withZ)
+                            point->setZ(readDouble(bigEndian));
+                        if(withM)
+                            point->setM(readDouble(bigEndian));
+                        return point;
+                    }
+                    case wkbLineString:
+                    {
+                        CoordinateSequence sequence;
+                        if(!readCoordinates(sequence, bigEndian, withZ, withM))
+                            break;
+                        LineString *line = new LineString;
+                        line->swapCoordinates(sequence);
+                        return line;
+                    }
+                    case wkbPolygon:
+                    case wkbTriangle:
+                    {
+                        if(!has(4))
+                            break;
+                        ccl::uint32_t rings = readUInt32(bigEndian);
+                        Polygon *polygon = new Polygon;
+                        for(ccl::uint32_t i = 0; i < rings; ++i)
+                        {
+                            CoordinateSequence sequence;
+                            if(!readCoordinates(sequence, bigEndian, withZ, withM))
+                            {
+                                delete polygon;
+                                failed = true;
+                                return NULL;
+                            }
+                            LineString *ring = new LineString;
+                            ring->swapCoordinates(sequence);
+                            polygon->addRing(ring);
+                        }
+                        return polygon;
+                    }
+                    case wkbMultiPoint:
+                    case wkbMultiLineString:
+                    case wkbMultiPolygon:
+                    case wkbGeometryCollection:
+                    {
+                        if(!has(4))
+                            break;
+                        ccl::uint32_t count = readUInt32(bigEndian);
+                        GeometryCollection *collection = NULL;
+                        if(type == wkbMultiPoint)
+                            collection = new MultiPoint;
+                        else if(type == wkbMultiLineString)
+                            collection = new MultiLineString;
+                        else if(type == wkbMultiPolygon)
+                            collection = new MultiPolygon;
+                        else
+                            collection = new GeometryCollection;
+                        for(ccl::uint32_t i = 0; i < count; ++i)
+                        {
+                            Geometry *geometry = read();
+                            if(!geometry)
+                            {
+                                delete collection;
+                                return NULL;
+                            }
+                            collection->addGeometry(geometry);
+                        }
+                        return collection;
+                    }
+                    default:
+                        unsupported = true;
+                        return NULL;
+                }
+                failed = true;
+                return NULL;
+            }
+        };
+    }
+
+    Geometry* getGeometryFromBinary(const unsigned char *wkb, size_t size)
+    {
+        if(!wkb)
+            return NULL;
+        WKBDecoder decoder(wkb, size);
+        Geometry* geometry = decoder.read();
+        if(!geometry && decoder.unsupported)
+            return getGeometryFromBinary(ccl::binary(wkb, size));
+        return geometry;
+    }
+
 }
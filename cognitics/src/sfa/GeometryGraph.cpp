@@ -120,9 +120,9 @@ namespace sfa {
         b.loc[arg] = BOUNDARY;
 
         //    Special Case: Using a collapse line to represent a single boundary point
-        if (line->getNumPoints() == 2 && line->getStartPoint()->equals(line->getEndPoint()))
+        if (line->getNumPoints() == 2 && line->isClosed())
         {
-            PointNode* node = new PointNode(line->getStartPoint(),b,arg);
+            PointNode* node = new PointNode(line->getCoordinateN(0),b,arg);
             addBoundaryPoint(node);
             addIsolatedPoint(node);
             return;
@@ -136,8 +136,8 @@ namespace sfa {
         EdgeNode* edge = new EdgeNode(el,e,er,arg);
 
         //    Add first and last Boundary Points
-        PointNode* start = new PointNode(line->getStartPoint(),b,arg);
-        PointNode* end = new PointNode(line->getEndPoint(),b,arg);
+        PointNode* start = new PointNode(line->getCoordinateN(0),b,arg);
+        PointNode* end = new PointNode(line->getCoordinateN(line->getNumPoints() - 1),b,arg);
         addBoundaryPoint(start);
         addBoundaryPoint(end);
 
@@ -145,7 +145,7 @@ namespace sfa {
         edge->addPointNode(start);
         for (int i = 1; i < line->getNumPoints() - 1; i++)
         {
-            edge->addPoint(line->getPointN(i));
+            edge->addPoint(line->getCoordinateN(i));
         }
         edge->addPointNode(end);
         edges.push_back(edge);
@@ -163,13 +163,13 @@ namespace sfa {
 
         EdgeNode* edge = new EdgeNode(el,e,er,arg);
         //    Add first point
-        edge->addPoint(line->getPointN(0));
+        edge->addPoint(line->getCoordinateN(0));
         PointNode* start = edge->getPointN(0);
 
         //    Add the points to the edge
         for (int i = 1; i < line->getNumPoints()-1; i++)
         {
-            edge->addPoint(line->getPointN(i));
+            edge->addPoint(line->getCoordinateN(i));
         }
 
         //    Add back the same pointer for the first point
@@ -190,13 +190,13 @@ namespace sfa {
         EdgeNode* edge = new EdgeNode(el,e,er,arg, saveZ);
 
         //    Add first point
-        edge->addPoint(line->getPointN(0));
+        edge->addPoint(line->getCoordinateN(0));
         PointNode* start = edge->getPointN(0);
 
         //    Add the points to the edge
         for (int i = 1; i < line->getNumPoints()-1; i++)
         {
-            edge->addPoint(line->getPointN(i));
+            edge->addPoint(line->getCoordinateN(i));
         }
 
         //    Add back the same pointer for the first point
@@ -214,7 +214,7 @@ namespace sfa {
     //    Check for collapsed area case. This special case is used to represent a boundary line with no area
         if (polygon->getExteriorRing()->getNumPoints() == 3)
         {
-            if (polygon->getExteriorRing()->getStartPoint()->equals(polygon->getExteriorRing()->getEndPoint()))
+            if (polygon->getExteriorRing()->isClosed())
             {
                 Label b;
                 b.dim = 1;
@@ -224,8 +224,8 @@ namespace sfa {
                 ext.loc[arg] = EXTERIOR;
 
                 EdgeNode* edge = new EdgeNode(ext,b,ext,arg);
-                edge->addPoint(polygon->getExteriorRing()->getPointN(0));
-                edge->addPoint(polygon->getExteriorRing()->getPointN(1));
+                edge->addPoint(polygon->getExteriorRing()->getCoordinateN(0));
+                edge->addPoint(polygon->getExteriorRing()->getCoordinateN(1));
                 edges.push_back(edge);
                 return;
             }
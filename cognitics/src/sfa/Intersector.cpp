@@ -31,8 +31,36 @@ DEALINGS IN THE SOFTWARE.
 #include "sfa/SegmentIntersector.h"
 #include "sfa/EnvelopeCheck.h"
 
+#include <vector>
+
 namespace sfa {
 
+    namespace
+    {
+        // copies of the vertices, so packed lines don't create Point objects for every vertex
+        std::vector<Point> Vertices(const LineString* line)
+        {
+            std::vector<Point> result;
+            result.reserve(line->getNumPoints());
+            for (int i = 0; i < line->getNumPoints(); i++)
+                result.push_back(line->getCoordinateN(i));
+            return result;
+        }
+
+        bool SegmentsIntersect(const std::vector<Point>& a, const std::vector<Point>& b)
+        {
+            for (size_t i = 0; i + 1 < a.size(); i++)
+            {
+                for (size_t j = 0; j + 1 < b.size(); j++)
+                {
+                    if (SegmentIntersector::Intersects(&a[i],&a[i+1],&b[j],&b[j+1]))
+                        return true;
+                }
+            }
+            return false;
+        }
+    }
+
     bool Intersector::Point_Point(const Geometry* a, const Geometry* b)
     {
         return a->equals(b);
@@ -43,11 +71,13 @@ namespace sfa {
         const Point* p = dynamic_cast<const Point*>(a);
         const LineString* l = dynamic_cast<const LineString*>(b);
 
-        if (p->equals(l->getStartPoint()) || p->equals(l->getEndPoint())) return true;
-        for (int i = 0; i < l->getNumPoints() - 1; i++)
+        std::vector<Point> vertices = Vertices(l);
+        if (vertices.empty()) return false;
+        if (p->equals(&vertices.front()) || p->equals(&vertices.back())) return true;
+        for (size_t i = 0; i + 1 < vertices.size(); i++)
         {
-            const Point* p1 = l->getPointN(i);
-            const Point* p2 = l->getPointN(i+1);
+            const Point* p1 = &vertices[i];
+            const Point* p2 = &vertices[i+1];
             if (Collinear(p1,p2,p))
                 if (Between(p1,p2,p)) return true;
         }
@@ -67,15 +97,7 @@ namespace sfa {
         const LineString* l1 = static_cast<const LineString*>(a);
         const LineString* l2 = static_cast<const LineString*>(b);
 
-        for (int i = 0; i < (l1->getNumPoints()-1); i++ )
-        {
-            for (int j = 0; j < (l2->getNumPoints()-1); j++ )
-            {
-                if (SegmentIntersector::Intersects(l1->getPointN(i),l1->getPointN(i+1),l2->getPointN(j),l2->getPointN(j+1)))
-                    return true;
-            }
-        }
-        return false;
+        return SegmentsIntersect(Vertices(l1), Vertices(l2));
     }
 
     bool Intersector::LineString_Polygon(const Geometry* a, const Geometry* b)
@@ -95,7 +117,8 @@ namespace sfa {
         }
 
         //    Check if LineString is within the polygon
-        return Point_Polygon(l->getPointN(0),other);
+        Point first = l->getCoordinateN(0);
+        return Point_Polygon(&first,other);
     }
 
     bool Intersector::Polygon_Polygon(const Geometry* a, const Geometry* b)
@@ -122,25 +145,24 @@ namespace sfa {
         }
 
         //    Test rings for intersection
+        std::vector<std::vector<Point> > Bvertices;
+        for (LineStringList::iterator Bit = Blist.begin(); Bit != Blist.end(); ++Bit)
+            Bvertices.push_back(Vertices(*Bit));
         for (LineStringList::iterator Ait = Alist.begin(); Ait != Alist.end(); ++Ait)
         {
-            for (LineStringList::iterator Bit = Blist.begin(); Bit != Blist.end(); ++Bit)
+            std::vector<Point> Avertices = Vertices(*Ait);
+            for (size_t k = 0; k < Bvertices.size(); k++)
             {
-                for (int h = 0; h < (*Ait)->getNumPoints()-1; h++)
-                {
-                    for (int k = 0; k < (*Bit)->getNumPoints()-1; k++)
-                    {
-                        if (SegmentIntersector::Intersects((*Ait)->getPointN(h),(*Ait)->getPointN(h+1),
-                        (*Bit)->getPointN(k),(*Bit)->getPointN(k+1)))
-                            return true;
-                    }
-                }
+                if (SegmentsIntersect(Avertices, Bvertices[k]))
+                    return true;
             }
         }
 
         //    Test for within relation
-        if (Point_Polygon(Alist.front()->getPointN(0),B)) return true;
-        else if (Point_Polygon(Blist.front()->getPointN(0),A)) return true;
+        Point Afirst = Alist.front()->getCoordinateN(0);
+        Point Bfirst = Blist.front()->getCoordinateN(0);
+        if (Point_Polygon(&Afirst,B)) return true;
+        else if (Point_Polygon(&Bfirst,A)) return true;
         else return false;
     }
 
@@ -256,6 +256,20 @@ namespace sfa {
         return feature_copy;
     }
     
+    size_t Layer::getNextFeatures(std::vector<sfa::Feature *> &features, size_t count, int cursorId)
+    {
+        size_t result = 0;
+        while(result < count)
+        {
+            sfa::Feature *feature = getNextFeature(cursorId);
+            if(!feature)
+                break;
+            features.push_back(feature);
+            ++result;
+        }
+        return result;
+    }
+
     sfa::Feature * Layer::addFeature(sfa::Feature *feature)
     {
         sfa::Feature *feature2 = new sfa::Feature();
@@ -279,6 +293,20 @@ namespace sfa {
         }
     }
     
+    size_t Layer::addFeatures(const std::vector<sfa::Feature *> &features)
+    {
+        size_t result = 0;
+        for(size_t i = 0, c = features.size(); i < c; ++i)
+        {
+            sfa::Feature *feature = addFeature(features[i]);
+            if(!feature)
+                continue;
+            delete feature;
+            ++result;
+        }
+        return result;
+    }
+
     bool Layer::updateFeature(sfa::Feature *feature)
     {
         // geometry type must match!
@@ -36,6 +36,30 @@ DEALINGS IN THE SOFTWARE.
 
 namespace sfa
 {
+    namespace
+    {
+        template <typename T>
+        void writeCoordinates(std::ostream &os, const CoordinateSequence &coordinates, bool withZ, bool withM)
+        {
+            for(size_t i = 0, ic = coordinates.size(); i < ic; ++i)
+            {
+                T dx(coordinates.X(i));
+                T dy(coordinates.Y(i));
+                os << dx << dy;
+                if(withZ)
+                {
+                    T dz(coordinates.Z(i));
+                    os << dz;
+                }
+                if(withM)
+                {
+                    T dm(coordinates.M(i));
+                    os << dm;
+                }
+            }
+        }
+    }
+
     LineString::~LineString(void)
     {
     }
@@ -54,16 +78,16 @@ namespace sfa
 
     LineString& LineString::operator=(const LineString& rhs)
     {
+        if(this == &rhs)
+            return *this;
         clearPoints();
-        points.resize(rhs.points.size());
-        for(size_t i=0,ic=rhs.points.size();i<ic;i++)
-            points[i] = (new Point(*rhs.points.at(i)));
+        assignCoordinates(rhs);
         return *this;
     }
 
     std::string LineString::getGeometryType(void) const
     {
-        if(points.size() == 2)
+        if(numVertices() == 2)
             return "Line";
         if(isSimple() && isClosed()) return "LinearRing";
         // TODO: if closed and simple, return "LinearRing", but is it necessary to do simple every time?
@@ -72,19 +96,43 @@ namespace sfa
     
     int LineString::getNumPoints(void) const
     {
-        return (int)points.size();
+        return (int)numVertices();
     }
 
     Point* LineString::getPointN(int n) const
     {
-        if (n >= 0 && n < int(points.size()))
+        if (n >= 0 && n < int(numVertices()))
+        {
+            materialize();
             return points[n];
+        }
         throw std::runtime_error("LineString::getPointN(): index out of bounds");
     }
 
+    Point LineString::getCoordinateN(int n) const
+    {
+        if (n >= 0 && n < int(numVertices()))
+            return vertex(n);
+        throw std::runtime_error("LineString::getCoordinateN(): index out of bounds");
+    }
+
     double LineString::getLength(void) const
     {
         double length = 0;
+        if(isPacked())
+        {
+            const double *v = coordinates.data();
+            const size_t stride = coordinates.getStride();
+            const bool hasZ = coordinates.is3D();
+            for (size_t i = 1, ic = coordinates.size(); i < ic; i++, v += stride)
+            {
+                double dx = v[stride] - v[0];
+                double dy = v[stride + 1] - v[1];
+                double dz = hasZ ? v[stride + 2] - v[2] : 0.0;
+                length += sqrt(dx*dx + dy*dy + dz*dz);
+            }
+            return length;
+        }
         for (int i = 0; i < int(points.size()) - 1; i++)
         {
             double v[3] = { points[i+1]->X() - points[i]->X() , points[i+1]->Y() - points[i]->Y() , points[i+1]->Z() - points[i]->Z() };
@@ -96,6 +144,18 @@ namespace sfa
     double LineString::getLength2D(void) const
     {
         double length = 0;
+        if(isPacked())
+        {
+            const double *v = coordinates.data();
+            const size_t stride = coordinates.getStride();
+            for (size_t i = 1, ic = coordinates.size(); i < ic; i++, v += stride)
+            {
+                double dx = v[stride] - v[0];
+                double dy = v[stride + 1] - v[1];
+                length += sqrt(dx*dx + dy*dy);
+            }
+            return length;
+        }
         for (int i = 0; i < int(points.size()) - 1; i++)
         {
             double v[2] = { points[i+1]->X() - points[i]->X() , points[i+1]->Y() - points[i]->Y() };
@@ -113,8 +173,8 @@ namespace sfa
     {
     //    Must convert into a multiPoint
         MultiPoint mpoint;
-        for (PointList::const_iterator it = points.begin(), end = points.end(); it != end; it++)
-            mpoint.addGeometry(new Point(*it));
+        for (size_t i = 0, ic = numVertices(); i < ic; i++)
+            mpoint.addGeometry(new Point(vertex(i)));
         return ConvexHull3D::apply(&mpoint);
     }
 
@@ -148,11 +208,11 @@ namespace sfa
         }
         else
         {
-            for(PointList::const_iterator it = points.begin(), end = points.end(); it != end; ++it)
+            for(size_t i = 0, ic = numVertices(); i < ic; ++i)
             {
-                if(it != points.begin())
+                if(i > 0)
                     os << ",";
-                (*it)->toText(os, false, withZ, withM);
+                vertex(i).toText(os, false, withZ, withM);
             }
         }
         os << ")";
@@ -173,8 +233,8 @@ namespace sfa
     //    Parse Points, the check for ) will also remove the commas
         while (is.good())
         {
-            Point* point = new Point;
-            point->fromText(is,false,withZ,withM);
+            Point point;
+            point.fromText(is,false,withZ,withM);
             addPoint(point);
             while (is.peek() == ' ') is.ignore(1);
             if (is.get() == ')') return;
@@ -183,16 +243,25 @@ namespace sfa
 
     void LineString::toBinary(std::ostream &os, WKBByteOrder byteOrder, bool withZ, bool withM) const
     {
+        ccl::uint32_t count = ccl::uint32_t(numVertices());
         if(byteOrder == wkbXDR)
         {
-            ccl::BigEndian<ccl::uint32_t> numPoints(ccl::uint32_t(points.size()));
+            ccl::BigEndian<ccl::uint32_t> numPoints(count);
             os << numPoints;
         }
         else
         {
-            ccl::LittleEndian<ccl::uint32_t> numPoints(ccl::uint32_t(points.size()));
+            ccl::LittleEndian<ccl::uint32_t> numPoints(count);
             os << numPoints;
         }
+        if(isPacked())
+        {
+            if(byteOrder == wkbXDR)
+                writeCoordinates<ccl::BigEndian<double> >(os, coordinates, withZ, withM);
+            else
+                writeCoordinates<ccl::LittleEndian<double> >(os, coordinates, withZ, withM);
+            return;
+        }
         for(PointList::const_iterator it = points.begin(), end = points.end(); it != end; ++it)
         {
             (*it)->toBinary(os, byteOrder, withZ, withM);
@@ -214,21 +283,29 @@ namespace sfa
             is >> tempPoints;
             numPoints = tempPoints;
         }
+        if(isPacked())
+        {
+            coordinates.setDimension(coordinates.is3D() || withZ, coordinates.isMeasured() || withM);
+            coordinates.reserve(coordinates.size() + numPoints);
+        }
         for(ccl::uint32_t i = 0; i < numPoints; ++i)
         {
-            Point* point = new Point();
-            point->fromBinary(is, byteOrder, withZ, withM);
+            Point point;
+            point.fromBinary(is, byteOrder, withZ, withM);
             addPoint(point);
         }
     }
 
     bool LineString::isParentOf(const GeometryBase *child) const
     {
-        if(!child)
+        // every accessor that hands out a Point pointer (getPointN(), getStartPoint(), ...) materializes the
+        // line first, so a line that is still packed can't own the child; the answer matches the Point list
+        // without building it, which would make Polygon/GeometryCollection::getParentOf() materialize every ring
+        if(!child || isPacked())
             return false;
-        for(int i = 0, c = getNumPoints(); i < c; ++i)
+        for(PointList::const_iterator it = points.begin(), end = points.end(); it != end; ++it)
         {
-            if(getPointN(i) == child)
+            if(*it == child)
                 return true;
         }
         return false;
@@ -248,11 +325,11 @@ namespace sfa
     {
         if((getNumPoints() < 2) || (segment >= getNumPoints()))
             return false;
-        Point* a = getPointN(segment);
-        Point* b = getPointN(segment + 1);
-        if(b->Y() - a->Y() == 0)
+        const Point a = getCoordinateN(segment);
+        const Point b = getCoordinateN(segment + 1);
+        if(b.Y() - a.Y() == 0)
             return false;
-        p->setX(a->X() + ((p->Y() - a->Y()) / (b->Y() - a->Y()) * (b->X() - a->X())));
+        p->setX(a.X() + ((p->Y() - a.Y()) / (b.Y() - a.Y()) * (b.X() - a.X())));
         return true;
     }
 
@@ -260,11 +337,11 @@ namespace sfa
     {
         if((getNumPoints() < 2) || (segment >= getNumPoints()))
             return false;
-        Point* a = getPointN(segment);
-        Point* b = getPointN(segment + 1);
-        if(b->Z() - a->Z() == 0)
+        const Point a = getCoordinateN(segment);
+        const Point b = getCoordinateN(segment + 1);
+        if(b.Z() - a.Z() == 0)
             return false;
-        p->setX(a->X() + ((p->Z() - a->Z()) / (b->Z() - a->Z()) * (b->X() - a->X())));
+        p->setX(a.X() + ((p->Z() - a.Z()) / (b.Z() - a.Z()) * (b.X() - a.X())));
         return true;
     }
 
@@ -272,11 +349,11 @@ namespace sfa
     {
         if((getNumPoints() < 2) || (segment >= getNumPoints()))
             return false;
-        Point* a = getPointN(segment);
-        Point* b = getPointN(segment + 1);
-        if(b->X() - a->X() == 0)
+        const Point a = getCoordinateN(segment);
+        const Point b = getCoordinateN(segment + 1);
+        if(b.X() - a.X() == 0)
             return false;
-        p->setY(a->Y() + ((p->X() - a->X()) / (b->X() - a->X()) * (b->Y() - a->Y())));
+        p->setY(a.Y() + ((p->X() - a.X()) / (b.X() - a.X()) * (b.Y() - a.Y())));
         return true;
     }
 
@@ -284,11 +361,11 @@ namespace sfa
     {
         if((getNumPoints() < 2) || (segment >= getNumPoints()))
             return false;
-        Point* a = getPointN(segment);
-        Point* b = getPointN(segment + 1);
-        if(b->Z() - a->Z() == 0)
+        const Point a = getCoordinateN(segment);
+        const Point b = getCoordinateN(segment + 1);
+        if(b.Z() - a.Z() == 0)
             return false;
-        p->setY(a->Y() + ((p->Z() - a->Z()) / (b->Z() - a->Z()) * (b->Y() - a->Y())));
+        p->setY(a.Y() + ((p->Z() - a.Z()) / (b.Z() - a.Z()) * (b.Y() - a.Y())));
         return true;
     }
 
@@ -296,11 +373,11 @@ namespace sfa
     {
         if((getNumPoints() < 2) || (segment >= getNumPoints()))
             return false;
-        Point* a = getPointN(segment);
-        Point* b = getPointN(segment + 1);
-        if(b->X() - a->X() == 0)
+        const Point a = getCoordinateN(segment);
+        const Point b = getCoordinateN(segment + 1);
+        if(b.X() - a.X() == 0)
             return false;
-        p->setZ(a->Z() + ((p->X() - a->X()) / (b->X() - a->X()) * (b->Z() - a->Z())));
+        p->setZ(a.Z() + ((p->X() - a.X()) / (b.X() - a.X()) * (b.Z() - a.Z())));
         return true;
     }
 
@@ -308,11 +385,11 @@ namespace sfa
     {
         if((getNumPoints() < 2) || (segment >= getNumPoints()))
             return false;
-        Point* a = getPointN(segment);
-        Point* b = getPointN(segment + 1);
-        if(b->Y() - a->Y() == 0)
+        const Point a = getCoordinateN(segment);
+        const Point b = getCoordinateN(segment + 1);
+        if(b.Y() - a.Y() == 0)
             return false;
-        p->setZ(a->Z() + ((p->Y() - a->Y()) / (b->Y() - a->Y()) * (b->Z() - a->Z())));
+        p->setZ(a.Z() + ((p->Y() - a.Y()) / (b.Y() - a.Y()) * (b.Z() - a.Z())));
         return true;
     }
 
@@ -341,6 +418,7 @@ namespace sfa
         {            
             return 0;
         }
+        unpack();
         double softDist = maxDist + (maxDist*tolerance);
         double maxDist2 = softDist*softDist;//so we don't need to do sqrts
         sfa::PointList newPoints;
@@ -370,8 +448,9 @@ namespace sfa
 
     int LineString::addDeviatedColinearPoints(double mean, double stddev, double mindist)
     {
-        if((mean == 0) || points.empty())
+        if((mean == 0) || isEmpty())
             return 0;
+        unpack();
 
         sfa::PointList newPoints;
         for(size_t i = 0, c = points.size(); i < c - 1; ++i)
@@ -402,9 +481,10 @@ namespace sfa
     int LineString::removeColinearPoints(double epsilon)
     {
         sfa::PointList newPoints;
-        size_t numPoints = points.size();
+        size_t numPoints = numVertices();
         if(numPoints<3)
             return 0;//too small to remove any points
+        unpack();
         double total_error = 0;
         sfa::Point *start = points.at(0);
         newPoints.push_back(start);
@@ -571,8 +651,9 @@ namespace sfa
     {
         bool zSpecified = (zEpsilon != 0.0f);
 
-        if (points.empty())
+        if (isEmpty())
             return 0;
+        unpack();
 
         size_t initialSize = points.size();
 
@@ -676,16 +757,16 @@ namespace sfa
         double dist = DBL_MAX;
         sfa::Point intersection;
         int segment = -1;
-        size_t numPoints = points.size();
+        size_t numPoints = numVertices();
         if(endPt==-1)
             endPt = int(numPoints);
         for(size_t i=startPt;i<(endPt-1);i++)
         {
             sfa::Point thisintersection;
             double thisdist = DBL_MAX;
-            sfa::Point *p1 = points.at(i);
-            sfa::Point *p2 = points.at(i+1);
-            if(calculateDistance2D2(*p1,*p2,searchPoint,thisintersection,thisdist))
+            sfa::Point p1 = getCoordinateN(int(i));
+            sfa::Point p2 = getCoordinateN(int(i+1));
+            if(calculateDistance2D2(p1,p2,searchPoint,thisintersection,thisdist))
             {
                 if(thisdist < dist)
                 {
@@ -736,16 +817,16 @@ namespace sfa
         double dist = DBL_MAX;
         sfa::Point intersection;
         int segment = -1;
-        size_t numPoints = points.size();
+        size_t numPoints = numVertices();
         if(endPt==-1)
             endPt = int(numPoints);
         for(size_t i=startPt;i<(endPt-1);i++)
         {
             sfa::Point thisintersection;
             double thisdist = DBL_MAX;
-            sfa::Point *p1 = points.at(i);
-            sfa::Point *p2 = points.at(i+1);
-            if(calculateDistance2(*p1,*p2,searchPoint,thisintersection,thisdist))
+            sfa::Point p1 = getCoordinateN(int(i));
+            sfa::Point p2 = getCoordinateN(int(i+1));
+            if(calculateDistance2(p1,p2,searchPoint,thisintersection,thisdist))
             {
                 if(thisdist < dist)
                 {
@@ -763,21 +844,21 @@ namespace sfa
 
     void LineString::reverse()
     {
-        std::reverse(points.begin(), points.end());
+        Curve::reverse();
     }
 
     bool LineString::getPointAtS(double &s, sfa::Point &pt, int &afterIdx, bool use3D)
     {
-        if(points.size()<2)
+        if(numVertices()<2)
             return false;
         if(s < 0)
             return false;
         double prevPos = 0;
-        sfa::Point *prevpt = points.at(0);
-        for(size_t i=1,ic=points.size();i<ic;i++)
+        sfa::Point prevpt = vertex(0);
+        for(size_t i=1,ic=numVertices();i<ic;i++)
         {
-            sfa::Point *currpt = points.at(i);
-            sfa::Point line = *currpt - *prevpt;
+            sfa::Point currpt = vertex(i);
+            sfa::Point line = currpt - prevpt;
             if(!use3D)
             {
                 double len = sqrt(line.X() * line.X() + line.Y() * line.Y());
@@ -785,7 +866,7 @@ namespace sfa
                 {
                     double seg_s = s - prevPos;
                     line *= (seg_s/len);
-                    pt = *prevpt + line;
+                    pt = prevpt + line;
                     afterIdx = int(i - 1);
                     return true;
                 }
@@ -798,7 +879,7 @@ namespace sfa
                 {
                     double seg_s = s - prevPos;
                     line *= seg_s;
-                    pt = *prevpt + line;
+                    pt = prevpt + line;
                     afterIdx = int(i - 1);
                     return true;
                 }
@@ -807,8 +888,8 @@ namespace sfa
             prevpt = currpt;
             
         }
-        afterIdx = int(points.size() - 1);
-        pt = points.at(afterIdx);
+        afterIdx = int(numVertices() - 1);
+        pt = vertex(afterIdx);
         return true;
     }
 
@@ -816,7 +897,7 @@ namespace sfa
     {
         sfa::Point firstPt,lastPt;
         int firstidx = -1;
-        int lastidx = (int)points.size();
+        int lastidx = (int)numVertices();
         if(!this->getPointAtS(offset0,firstPt,firstidx,false))
             return false;
         double beforeLen2D = getLength2D();
@@ -826,6 +907,7 @@ namespace sfa
         if(!getPointAtS(endOffsetS,lastPt,lastidx,false))
             return false;
 
+        unpack();
         sfa::PointList newPoints;
         newPoints.push_back(new sfa::Point(firstPt));
         for(size_t i=0,ic=points.size();i<ic;i++)
@@ -842,8 +924,9 @@ namespace sfa
 
     void LineString::clean(double minDistance2)
     {
-        if(points.size()<3)
+        if(numVertices()<3)
             return;//Nothing to clean
+        unpack();
         sfa::PointList newPoints;
         newPoints.push_back(points.at(0));
         sfa::Point *prev = points.at(0);
@@ -891,6 +974,17 @@ namespace sfa
 
     void LineString::transform(const sfa::Matrix &xform)
     {
+        if(isPacked())
+        {
+            for (size_t i = 0, ic = coordinates.size(); i < ic; i++)
+            {
+                Point point = coordinates.getPoint(i);
+                point.transform(xform);
+                coordinates.setPoint(i, point);
+            }
+            return;
+        }
+        unpack();
         for (size_t i = 0, ic = points.size(); i < ic; i++)
         {
             points.at(i)->transform(xform);
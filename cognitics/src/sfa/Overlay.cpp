@@ -179,7 +179,7 @@ namespace sfa {
             if (includedAreaEdges[i]->isVisited()) continue;
 
             LineString* ring = new LineString;
-            ring->addPoint(new Point(includedAreaEdges[i]->getOrigin()->getPoint()));
+            ring->addPoint(Point(includedAreaEdges[i]->getOrigin()->getPoint()));
             EdgeNodeEnd* next = includedAreaEdges[i];
 
             next->visit();
@@ -302,7 +302,7 @@ namespace sfa {
         for (EdgeNodeEndList::iterator it = includedLineEdges.begin(); it != includedLineEdges.end(); ++it)
         {
             LineString* next = new LineString;
-            next->addPoint(new Point((*it)->getOrigin()->getPoint()));
+            next->addPoint(Point((*it)->getOrigin()->getPoint()));
             (*it)->appendToLineString(next);
             result.push_back(next);
         }
@@ -157,16 +157,16 @@ namespace sfa {
 
                 do
                 {
-                    tempLine->addPoint(new Point(nextPoint));
+                    tempLine->addPoint(Point(nextPoint));
                     currentPointIndex = (currentPointIndex + 1)%(currentResult->getNumPoints()-1);
                     nextPoint = currentResult->getPointN(currentPointIndex);
                 } 
                 while (!nextPoint->equals(stop));
 
-                tempLine->addPoint(new Point(nextPoint));
+                tempLine->addPoint(Point(nextPoint));
 
     //    Close ring
-                tempLine->addPoint(new Point(tempLine->getStartPoint()));
+                tempLine->addPoint(Point(tempLine->getStartPoint()));
                 if (currentResult) delete currentResult;
                 currentResult = tempLine;
 
@@ -194,7 +194,7 @@ namespace sfa {
             Point* nextPoint = nextMerge->getPointN(currentPointIndex);
             do
             {
-                tempLine->addPoint(new Point(nextPoint));
+                tempLine->addPoint(Point(nextPoint));
                 currentPointIndex = (currentPointIndex + 1)%(nextMerge->getNumPoints()-1);
                 nextPoint = nextMerge->getPointN(currentPointIndex);
             } 
@@ -208,8 +208,8 @@ namespace sfa {
     */
             if (touchingCurrentVertex.size() == (currentResult->getNumPoints() - 1))
             {
-                tempLine->addPoint(new Point(nextPoint));
-                tempLine->addPoint(new Point(tempLine->getEndPoint()));
+                tempLine->addPoint(Point(nextPoint));
+                tempLine->addPoint(Point(tempLine->getEndPoint()));
                 if (currentResult) delete currentResult;
                 currentResult = tempLine;
 
@@ -226,14 +226,14 @@ namespace sfa {
 
             do
             {
-                tempLine->addPoint(new Point(nextPoint));
+                tempLine->addPoint(Point(nextPoint));
                 currentPointIndex = (currentPointIndex + 1)%(currentResult->getNumPoints()-1);
                 nextPoint = currentResult->getPointN(currentPointIndex);
             }
             while (!nextPoint->equals(stop));
 
     //    Close ring
-            tempLine->addPoint(new Point(nextMerge->getPointN(touchingMergeVertex[startIndex])));
+            tempLine->addPoint(Point(nextMerge->getPointN(touchingMergeVertex[startIndex])));
             if (currentResult) delete currentResult;
             currentResult = tempLine;
 
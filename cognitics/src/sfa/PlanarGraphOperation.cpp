@@ -167,8 +167,8 @@ namespace sfa {
     void PlanarGraphOperation::addSegment(const Point* p1, const Point* p2, int arg)
     {
         LineString line;
-        line.addPoint(new Point(p1));
-        line.addPoint(new Point(p2));
+        line.addPoint(Point(p1));
+        line.addPoint(Point(p2));
 
     //    use 0.0 as the default third point, if not valid, find a third point
         Point origin(0,0,0);
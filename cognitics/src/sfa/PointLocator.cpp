@@ -33,9 +33,15 @@ namespace sfa {
 
     bool PointLocator::PointOnLine(const Point* p, const LineString* line)
     {
+        if (line->getNumPoints() < 2) return false;
+        Point p1 = line->getCoordinateN(0);
         for (int i = 0; i < line->getNumPoints() - 1; i++)
-            if (Collinear(line->getPointN(i),line->getPointN(i+1),p))
-                if (Between(line->getPointN(i),line->getPointN(i+1),p)) return true;
+        {
+            Point p2 = line->getCoordinateN(i+1);
+            if (Collinear(&p1,&p2,p))
+                if (Between(&p1,&p2,p)) return true;
+            p1 = p2;
+        }
 
         return false;
     }
@@ -57,7 +63,9 @@ namespace sfa {
         const LineString* line = dynamic_cast<const LineString*>(geom);
         if (!line->isRing())
         {
-            if (p->equals(line->getStartPoint()) || p->equals(line->getEndPoint())) return BOUNDARY;
+            Point start = line->getCoordinateN(0);
+            Point end = line->getCoordinateN(line->getNumPoints() - 1);
+            if (p->equals(&start) || p->equals(&end)) return BOUNDARY;
         }
         if (PointOnLine(p,line)) return INTERIOR;
         else return EXTERIOR;
@@ -0,0 +1,441 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "sfa/PreparedGeometry.h"
+#include "sfa/PointLocator.h"
+#include "sfa/Relate.h"
+#include "sfa/LineString.h"
+#include "sfa/Polygon.h"
+#include "sfa/MultiPolygon.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sfa
+{
+    namespace
+    {
+        struct Shape
+        {
+            std::vector<double> vertices;               // x, y pairs
+            std::vector<double> segments;               // x1, y1, x2, y2
+            std::vector<double> ringStarts;             // first vertex (x, y) of each polygon ring
+            bool areal;
+            Shape(void) : areal(false) { }
+        };
+
+        void addLine(Shape &shape, const LineString *line, bool ring)
+        {
+            int count = line->getNumPoints();
+            for(int i = 0; i < count; ++i)
+            {
+                Point point = line->getCoordinateN(i);
+                shape.vertices.push_back(point.X());
+                shape.vertices.push_back(point.Y());
+                if(i > 0)
+                {
+                    size_t last = shape.vertices.size() - 4;
+                    shape.segments.insert(shape.segments.end(), shape.vertices.begin() + last, shape.vertices.end());
+                }
+            }
+            if(ring && (count > 0))
+            {
+                shape.ringStarts.push_back(shape.vertices[shape.vertices.size() - 2 * count]);
+                shape.ringStarts.push_back(shape.vertices[shape.vertices.size() - 2 * count + 1]);
+            }
+        }
+
+        // returns false for geometries the fast paths do not handle (polyhedral surfaces, mixed collections)
+        bool collectShape(Shape &shape, const Geometry *geometry)
+        {
+            if(const Point *point = dynamic_cast<const Point *>(geometry))
+            {
+                if(!point->isEmpty())
+                {
+                    shape.vertices.push_back(point->X());
+                    shape.vertices.push_back(point->Y());
+                }
+                return true;
+            }
+            if(const LineString *line = dynamic_cast<const LineString *>(geometry))
+            {
+                addLine(shape, line, false);
+                return true;
+            }
+            if(const Polygon *polygon = dynamic_cast<const Polygon *>(geometry))
+            {
+                shape.areal = true;
+                if(polygon->isEmpty())
+                    return true;
+                addLine(shape, polygon->getExteriorRing(), true);
+                for(int i = 0, c = polygon->getNumInteriorRing(); i < c; ++i)
+                    addLine(shape, polygon->getInteriorRingN(i), true);
+                return true;
+            }
+            const GeometryCollection *collection = dynamic_cast<const GeometryCollection *>(geometry);
+            if(!collection || (collection->getWKBGeometryType() == wkbGeometryCollection))
+                return false;
+            for(int i = 1, c = collection->getNumGeometries(); i <= c; ++i)
+            {
+                if(!collectShape(shape, collection->getGeometryN(i)))
+                    return false;
+            }
+            return true;
+        }
+
+        double distance2ToSegment(double x, double y, double x1, double y1, double x2, double y2)
+        {
+            double dx = x2 - x1;
+            double dy = y2 - y1;
+            double len2 = dx * dx + dy * dy;
+            double t = 0;
+            if(len2 > 0)
+                t = std::max(0.0, std::min(1.0, ((x - x1) * dx + (y - y1) * dy) / len2));
+            double px = x1 + t * dx - x;
+            double py = y1 + t * dy - y;
+            return px * px + py * py;
+        }
+
+        int orientation(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            double cross = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+            return (cross > 0) ? 1 : ((cross < 0) ? -1 : 0);
+        }
+
+        bool segmentsIntersect(const double *a, const double *b)
+        {
+            if((std::max(a[0], a[2]) < std::min(b[0], b[2]) - SFA_EPSILON) || (std::max(b[0], b[2]) < std::min(a[0], a[2]) - SFA_EPSILON))
+                return false;
+            if((std::max(a[1], a[3]) < std::min(b[1], b[3]) - SFA_EPSILON) || (std::max(b[1], b[3]) < std::min(a[1], a[3]) - SFA_EPSILON))
+                return false;
+            int o1 = orientation(a[0], a[1], a[2], a[3], b[0], b[1]);
+            int o2 = orientation(a[0], a[1], a[2], a[3], b[2], b[3]);
+            int o3 = orientation(b[0], b[1], b[2], b[3], a[0], a[1]);
+            int o4 = orientation(b[0], b[1], b[2], b[3], a[2], a[3]);
+            if((o1 * o2 < 0) && (o3 * o4 < 0))
+                return true;
+            // touching or collinear cases, with the same tolerance as the point tests
+            double eps2 = SFA_EPSILON * SFA_EPSILON;
+            return (distance2ToSegment(b[0], b[1], a[0], a[1], a[2], a[3]) <= eps2)
+                || (distance2ToSegment(b[2], b[3], a[0], a[1], a[2], a[3]) <= eps2)
+                || (distance2ToSegment(a[0], a[1], b[0], b[1], b[2], b[3]) <= eps2)
+                || (distance2ToSegment(a[2], a[3], b[0], b[1], b[2], b[3]) <= eps2);
+        }
+
+        // even-odd test against all segments of the shape; only used for the (few) ring start points of the prepared geometry
+        bool insideShape(const Shape &shape, double x, double y)
+        {
+            bool inside = false;
+            for(size_t i = 0, c = shape.segments.size(); i < c; i += 4)
+            {
+                const double *s = &shape.segments[i];
+                if((s[1] > y) != (s[3] > y))
+                {
+                    if(x < s[0] + (y - s[1]) * (s[2] - s[0]) / (s[3] - s[1]))
+                        inside = !inside;
+                }
+            }
+            return inside;
+        }
+
+        const char *coversPatterns[] = { "T*****FF*", "*T****FF*", "***T**FF*", "****T*FF*" };
+    }
+
+    PreparedGeometry::~PreparedGeometry(void)
+    {
+    }
+
+    PreparedGeometry::PreparedGeometry(void) : areal(false), minX(0), minY(0), maxX(-1), maxY(-1), binHeight(0)
+    {
+    }
+
+    PreparedGeometry::PreparedGeometry(const Geometry *geometry) : areal(false), minX(0), minY(0), maxX(-1), maxY(-1), binHeight(0)
+    {
+        setGeometry(geometry);
+    }
+
+    void PreparedGeometry::setGeometry(const Geometry *geometry)
+    {
+        this->geometry.reset();
+        areal = false;
+        minX = minY = 0;
+        maxX = maxY = -1;
+        segments.clear();
+        ringStarts.clear();
+        binStart.clear();
+        binSegments.clear();
+        binHeight = 0;
+        if(!geometry || geometry->isEmpty())
+            return;
+        this->geometry = GeometrySP(geometry->copy());
+
+        Geometry *envelope = geometry->getEnvelope();
+        if(LineString *line = dynamic_cast<LineString *>(envelope))
+        {
+            Point minPoint = line->getCoordinateN(0);
+            Point maxPoint = line->getCoordinateN(line->getNumPoints() - 1);
+            minX = minPoint.X();
+            minY = minPoint.Y();
+            maxX = maxPoint.X();
+            maxY = maxPoint.Y();
+        }
+        else if(Point *point = dynamic_cast<Point *>(envelope))
+        {
+            minX = maxX = point->X();
+            minY = maxY = point->Y();
+        }
+        delete envelope;
+
+        if(!dynamic_cast<const Polygon *>(geometry) && !dynamic_cast<const MultiPolygon *>(geometry))
+            return;
+        Shape shape;
+        collectShape(shape, geometry);
+        areal = true;
+        ringStarts.swap(shape.ringStarts);
+        segments.reserve(shape.segments.size() / 4);
+        for(size_t i = 0, c = shape.segments.size(); i < c; i += 4)
+        {
+            Segment segment = { shape.segments[i], shape.segments[i + 1], shape.segments[i + 2], shape.segments[i + 3] };
+            segments.push_back(segment);
+        }
+        buildIndex();
+    }
+
+    void PreparedGeometry::buildIndex(void)
+    {
+        // aim for a handful of segments per bin, but cap the total number of bin entries for spiky rings whose
+        // segments each span many bins
+        double spans = 0;
+        for(const Segment &segment : segments)
+            spans += std::abs(segment.y2 - segment.y1);
+        double bins = std::max<double>(1.0, segments.size() / 4.0);
+        if(spans > 0)
+            bins = std::min(bins, 8.0 * segments.size() * (maxY - minY) / spans);
+        binHeight = (maxY - minY) / std::max(1.0, std::floor(bins));
+        if(!(binHeight > 0))
+        {
+            bins = 1;
+            binHeight = 0;
+        }
+        size_t binCount = std::max<size_t>(1, size_t(bins));
+        binStart.assign(binCount + 1, 0);
+
+        // segments are registered in every bin their y-range (plus tolerance) touches, counted first and then filled
+        for(const Segment &segment : segments)
+        {
+            size_t first = getBin(std::min(segment.y1, segment.y2) - SFA_EPSILON);
+            size_t last = getBin(std::max(segment.y1, segment.y2) + SFA_EPSILON);
+            for(size_t b = first; b <= last; ++b)
+                ++binStart[b + 1];
+        }
+        for(size_t b = 0; b < binCount; ++b)
+            binStart[b + 1] += binStart[b];
+        binSegments.resize(binStart[binCount]);
+        std::vector<size_t> fill(binStart.begin(), binStart.end() - 1);
+        for(size_t i = 0, c = segments.size(); i < c; ++i)
+        {
+            size_t first = getBin(std::min(segments[i].y1, segments[i].y2) - SFA_EPSILON);
+            size_t last = getBin(std::max(segments[i].y1, segments[i].y2) + SFA_EPSILON);
+            for(size_t b = first; b <= last; ++b)
+                binSegments[fill[b]++] = i;
+        }
+    }
+
+    size_t PreparedGeometry::getBin(double y) const
+    {
+        if(!(binHeight > 0) || (y <= minY))
+            return 0;
+        size_t bins = binStart.size() - 1;
+        size_t bin = size_t((y - minY) / binHeight);
+        return std::min(bin, bins - 1);
+    }
+
+    Location PreparedGeometry::locate(double x, double y) const
+    {
+        if(!geometry)
+            return EXTERIOR;
+        if((x < minX - SFA_EPSILON) || (x > maxX + SFA_EPSILON) || (y < minY - SFA_EPSILON) || (y > maxY + SFA_EPSILON))
+            return EXTERIOR;
+        if(!areal)
+        {
+            Point point(x, y);
+            return PointLocator::apply(&point, geometry.get());
+        }
+
+        double eps2 = SFA_EPSILON * SFA_EPSILON;
+        size_t bin = getBin(y);
+        bool inside = false;
+        for(size_t i = binStart[bin], end = binStart[bin + 1]; i < end; ++i)
+        {
+            const Segment &s = segments[binSegments[i]];
+            if(distance2ToSegment(x, y, s.x1, s.y1, s.x2, s.y2) <= eps2)
+                return BOUNDARY;
+            if((s.y1 > y) != (s.y2 > y))
+            {
+                if(x < s.x1 + (y - s.y1) * (s.x2 - s.x1) / (s.y2 - s.y1))
+                    inside = !inside;
+            }
+        }
+        return inside ? INTERIOR : EXTERIOR;
+    }
+
+    void PreparedGeometry::locate(const double *x, const double *y, size_t count, Location *results) const
+    {
+        for(size_t i = 0; i < count; ++i)
+            results[i] = locate(x[i], y[i]);
+    }
+
+    size_t PreparedGeometry::covers(const double *x, const double *y, size_t count, bool *results) const
+    {
+        size_t covered = 0;
+        for(size_t i = 0; i < count; ++i)
+        {
+            results[i] = (locate(x[i], y[i]) != EXTERIOR);
+            if(results[i])
+                ++covered;
+        }
+        return covered;
+    }
+
+    bool PreparedGeometry::intersectsBoundary(const Segment &segment) const
+    {
+        double a[4] = { segment.x1, segment.y1, segment.x2, segment.y2 };
+        size_t first = getBin(std::min(segment.y1, segment.y2) - SFA_EPSILON);
+        size_t last = getBin(std::max(segment.y1, segment.y2) + SFA_EPSILON);
+        for(size_t b = first; b <= last; ++b)
+        {
+            for(size_t i = binStart[b], end = binStart[b + 1]; i < end; ++i)
+            {
+                const Segment &s = segments[binSegments[i]];
+                double c[4] = { s.x1, s.y1, s.x2, s.y2 };
+                if(segmentsIntersect(a, c))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    bool PreparedGeometry::ringVertexInside(const Geometry *other) const
+    {
+        Shape shape;
+        collectShape(shape, other);
+        for(size_t i = 0, c = ringStarts.size(); i < c; i += 2)
+        {
+            if(insideShape(shape, ringStarts[i], ringStarts[i + 1]))
+                return true;
+        }
+        return false;
+    }
+
+    bool PreparedGeometry::contains(const Geometry *another) const
+    {
+        if(!geometry || !another || another->isEmpty())
+            return false;
+        if(const Point *point = dynamic_cast<const Point *>(another))
+            return contains(point->X(), point->Y());
+        Shape shape;
+        if(!areal || !collectShape(shape, another))
+            return geometry->contains(another);
+
+        bool touching = false;
+        for(size_t i = 0, c = shape.vertices.size(); i < c; i += 2)
+        {
+            Location location = locate(shape.vertices[i], shape.vertices[i + 1]);
+            if(location == EXTERIOR)
+                return false;
+            if(location == BOUNDARY)
+                touching = true;
+        }
+        for(size_t i = 0, c = shape.segments.size(); !touching && (i < c); i += 4)
+        {
+            Segment segment = { shape.segments[i], shape.segments[i + 1], shape.segments[i + 2], shape.segments[i + 3] };
+            touching = intersectsBoundary(segment);
+        }
+        if(touching)
+            return geometry->contains(another);
+
+        // the test geometry is strictly inside the outer rings; it is only contained if no prepared ring lies inside it
+        return !shape.areal || !ringVertexInside(another);
+    }
+
+    bool PreparedGeometry::covers(const Geometry *another) const
+    {
+        if(!geometry || !another || another->isEmpty())
+            return false;
+        if(const Point *point = dynamic_cast<const Point *>(another))
+            return covers(point->X(), point->Y());
+        Shape shape;
+        if(areal && collectShape(shape, another))
+        {
+            bool touching = false;
+            for(size_t i = 0, c = shape.vertices.size(); i < c; i += 2)
+            {
+                Location location = locate(shape.vertices[i], shape.vertices[i + 1]);
+                if(location == EXTERIOR)
+                    return false;
+                if(location == BOUNDARY)
+                    touching = true;
+            }
+            for(size_t i = 0, c = shape.segments.size(); !touching && (i < c); i += 4)
+            {
+                Segment segment = { shape.segments[i], shape.segments[i + 1], shape.segments[i + 2], shape.segments[i + 3] };
+                touching = intersectsBoundary(segment);
+            }
+            if(!touching)
+                return !shape.areal || !ringVertexInside(another);
+        }
+
+        Relate relate(geometry.get(), another);
+        de9im matrix = relate.getMatrix();
+        for(const char *pattern : coversPatterns)
+        {
+            if(matrix.compare(pattern))
+                return true;
+        }
+        return false;
+    }
+
+    bool PreparedGeometry::intersects(const Geometry *another) const
+    {
+        if(!geometry || !another || another->isEmpty())
+            return false;
+        if(const Point *point = dynamic_cast<const Point *>(another))
+            return intersects(point->X(), point->Y());
+        Shape shape;
+        if(!areal || !collectShape(shape, another))
+            return geometry->intersects(another);
+
+        for(size_t i = 0, c = shape.vertices.size(); i < c; i += 2)
+        {
+            if(locate(shape.vertices[i], shape.vertices[i + 1]) != EXTERIOR)
+                return true;
+        }
+        for(size_t i = 0, c = shape.segments.size(); i < c; i += 4)
+        {
+            Segment segment = { shape.segments[i], shape.segments[i + 1], shape.segments[i + 2], shape.segments[i + 3] };
+            if(intersectsBoundary(segment))
+                return true;
+        }
+        // no vertex inside and no crossing: the only remaining case is the prepared geometry lying inside the test geometry
+        return shape.areal && ringVertexInside(another);
+    }
+
+}
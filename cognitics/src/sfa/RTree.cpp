@@ -0,0 +1,496 @@
+/*************************************************************************
+Copyright (c) 2019 Cognitics, Inc.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+#include "sfa/RTree.h"
+#include "sfa/LineString.h"
+#include "sfa/Point.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace sfa
+{
+    namespace
+    {
+        bool getGeometryBounds(const Geometry *geometry, RTreeBounds &bounds)
+        {
+            if(!geometry)
+                return false;
+            Geometry *envelope = geometry->getEnvelope();
+            LineString *line = dynamic_cast<LineString *>(envelope);
+            bool result = false;
+            if(line && (line->getNumPoints() == 2))
+            {
+                Point minPoint = line->getCoordinateN(0);
+                Point maxPoint = line->getCoordinateN(1);
+                bounds = RTreeBounds(minPoint.X(), minPoint.Y(), maxPoint.X(), maxPoint.Y());
+                result = true;
+            }
+            else if(Point *point = dynamic_cast<Point *>(envelope))
+            {
+                bounds = RTreeBounds(point->X(), point->Y(), point->X(), point->Y());
+                result = true;
+            }
+            delete envelope;
+            return result;
+        }
+
+        template <typename T>
+        RTreeBounds getRangeBounds(const std::vector<T> &items, size_t first, size_t count)
+        {
+            RTreeBounds result;
+            for(size_t i = first, end = first + count; i < end; ++i)
+                result.expand(items[i].bounds);
+            return result;
+        }
+
+        template <typename T>
+        bool lessCenterX(const T &a, const T &b)
+        {
+            return a.bounds.centerX() < b.bounds.centerX();
+        }
+
+        template <typename T>
+        bool lessCenterY(const T &a, const T &b)
+        {
+            return a.bounds.centerY() < b.bounds.centerY();
+        }
+
+        // Sort-Tile-Recursive ordering: sort by x, cut into vertical slices of S*M items, then sort each slice by y.
+        // Consecutive runs of M items then make well shaped nodes.
+        template <typename T>
+        void sortTileRecursive(std::vector<T> &items, size_t capacity)
+        {
+            size_t count = items.size();
+            size_t pageCount = (count + capacity - 1) / capacity;
+            size_t sliceCount = size_t(std::ceil(std::sqrt(double(pageCount))));
+            size_t sliceSize = std::max<size_t>(sliceCount * capacity, 1);
+            std::sort(items.begin(), items.end(), lessCenterX<T>);
+            for(size_t start = 0; start < count; start += sliceSize)
+            {
+                size_t end = std::min<size_t>(start + sliceSize, count);
+                std::sort(items.begin() + start, items.begin() + end, lessCenterY<T>);
+            }
+        }
+
+        // Calls f(entry) for every live entry whose bounds touch the window.
+        template <typename F>
+        void forEachInWindow(const std::vector<RTree::Node> &nodes, const std::vector<RTree::Entry> &entries, const std::vector<RTree::Entry> &pending, const RTreeBounds &window, F f)
+        {
+            if(!nodes.empty())
+            {
+                std::vector<size_t> stack;
+                stack.push_back(nodes.size() - 1);
+                while(!stack.empty())
+                {
+                    const RTree::Node &node = nodes[stack.back()];
+                    stack.pop_back();
+                    if(!node.bounds.intersects(window))
+                        continue;
+                    for(size_t i = node.first, end = node.first + node.count; i < end; ++i)
+                    {
+                        if(!node.leaf)
+                            stack.push_back(i);
+                        else if(entries[i].geometry && entries[i].bounds.intersects(window))
+                            f(entries[i]);
+                    }
+                }
+            }
+            for(size_t i = 0, c = pending.size(); i < c; ++i)
+            {
+                if(pending[i].bounds.intersects(window))
+                    f(pending[i]);
+            }
+        }
+
+        struct NearestCandidate
+        {
+            double distance2;
+            const RTree::Node *node;
+            const RTree::Entry *entry;
+            bool exact;
+
+            // std::priority_queue is a max heap; invert so the closest candidate is on top
+            bool operator<(const NearestCandidate &other) const { return distance2 > other.distance2; }
+        };
+
+        NearestCandidate makeCandidate(double distance2, const RTree::Node *node, const RTree::Entry *entry, bool exact)
+        {
+            NearestCandidate candidate;
+            candidate.distance2 = distance2;
+            candidate.node = node;
+            candidate.entry = entry;
+            candidate.exact = exact;
+            return candidate;
+        }
+
+        // Exact squared distance from (x, y) to a geometry. Points (and anything whose envelope is a point) use the envelope.
+        double getGeometryDistance2(const RTree::Entry &entry, double x, double y)
+        {
+            const RTreeBounds &bounds = entry.bounds;
+            if((bounds.minX == bounds.maxX) && (bounds.minY == bounds.maxY))
+                return bounds.distance2(x, y);
+            Point point(x, y);
+            double distance = point.distance(entry.geometry);
+            return distance * distance;
+        }
+    }
+
+    void RTreeBounds::expand(const RTreeBounds &other)
+    {
+        minX = std::min<double>(minX, other.minX);
+        minY = std::min<double>(minY, other.minY);
+        maxX = std::max<double>(maxX, other.maxX);
+        maxY = std::max<double>(maxY, other.maxY);
+    }
+
+    double RTreeBounds::distance2(double x, double y) const
+    {
+        double dx = (x < minX) ? minX - x : ((x > maxX) ? x - maxX : 0.0);
+        double dy = (y < minY) ? minY - y : ((y > maxY) ? y - maxY : 0.0);
+        return (dx * dx) + (dy * dy);
+    }
+
+    RTree::~RTree(void)
+    {
+    }
+
+    RTree::RTree(size_t nodeCapacity) : nodeCapacity(std::max<size_t>(nodeCapacity, 2)), removedCount(0), generated(false)
+    {
+    }
+
+    void RTree::addGeometry(Geometry *geometry)
+    {
+        RTreeBounds bounds;
+        if(getGeometryBounds(geometry, bounds))
+            addGeometry(geometry, bounds.minX, bounds.minY, bounds.maxX, bounds.maxY);
+    }
+
+    void RTree::addGeometry(Geometry *geometry, double minX, double minY, double maxX, double maxY)
+    {
+        if(!geometry)
+            return;
+        Entry entry;
+        entry.bounds = RTreeBounds(std::min<double>(minX, maxX), std::min<double>(minY, maxY), std::max<double>(minX, maxX), std::max<double>(minY, maxY));
+        entry.geometry = geometry;
+        pending.push_back(entry);
+    }
+
+    void RTree::generate(void)
+    {
+        pack();
+    }
+
+    void RTree::insert(Geometry *geometry)
+    {
+        RTreeBounds bounds;
+        if(getGeometryBounds(geometry, bounds))
+            insert(geometry, bounds.minX, bounds.minY, bounds.maxX, bounds.maxY);
+    }
+
+    void RTree::insert(Geometry *geometry, double minX, double minY, double maxX, double maxY)
+    {
+        addGeometry(geometry, minX, minY, maxX, maxY);
+        if(pending.size() > std::max<size_t>(nodeCapacity * 4, entries.size() / 8))
+            pack();
+    }
+
+    bool RTree::removeGeometry(Geometry *geometry)
+    {
+        if(!geometry)
+            return false;
+        for(std::vector<Entry>::iterator it = pending.begin(), end = pending.end(); it != end; ++it)
+        {
+            if(it->geometry == geometry)
+            {
+                pending.erase(it);
+                return true;
+            }
+        }
+        for(size_t i = 0, c = entries.size(); i < c; ++i)
+        {
+            if(entries[i].geometry == geometry)
+            {
+                // leave a hole; node bounds stay conservative until the next pack
+                entries[i].geometry = NULL;
+                ++removedCount;
+                if(removedCount > entries.size() / 2)
+                    pack();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void RTree::clear(void)
+    {
+        entries.clear();
+        nodes.clear();
+        pending.clear();
+        removedCount = 0;
+        generated = false;
+    }
+
+    size_t RTree::size(void) const
+    {
+        return entries.size() - removedCount + pending.size();
+    }
+
+    RTreeBounds RTree::getBounds(void) const
+    {
+        RTreeBounds result;
+        if(!nodes.empty())
+            result = nodes.back().bounds;
+        for(size_t i = 0, c = pending.size(); i < c; ++i)
+            result.expand(pending[i].bounds);
+        return result;
+    }
+
+    void RTree::pack(void)
+    {
+        std::vector<Entry> packed;
+        packed.reserve(size());
+        for(size_t i = 0, c = entries.size(); i < c; ++i)
+        {
+            if(entries[i].geometry)
+                packed.push_back(entries[i]);
+        }
+        packed.insert(packed.end(), pending.begin(), pending.end());
+        entries.swap(packed);
+        std::vector<Entry>().swap(pending);
+        removedCount = 0;
+        nodes.clear();
+        generated = true;
+        if(entries.empty())
+            return;
+
+        sortTileRecursive(entries, nodeCapacity);
+        std::vector<Node> level;
+        level.reserve((entries.size() + nodeCapacity - 1) / nodeCapacity);
+        for(size_t first = 0, c = entries.size(); first < c; first += nodeCapacity)
+        {
+            Node node;
+            node.first = first;
+            node.count = std::min<size_t>(nodeCapacity, c - first);
+            node.bounds = getRangeBounds(entries, node.first, node.count);
+            node.leaf = true;
+            level.push_back(node);
+        }
+
+        // each level is appended to the flat node array; the single node of the last level is the root
+        while(level.size() > 1)
+        {
+            sortTileRecursive(level, nodeCapacity);
+            size_t base = nodes.size();
+            nodes.insert(nodes.end(), level.begin(), level.end());
+            std::vector<Node> parents;
+            parents.reserve((level.size() + nodeCapacity - 1) / nodeCapacity);
+            for(size_t first = 0, c = level.size(); first < c; first += nodeCapacity)
+            {
+                Node node;
+                node.first = base + first;
+                node.count = std::min<size_t>(nodeCapacity, c - first);
+                node.bounds = getRangeBounds(level, first, node.count);
+                node.leaf = false;
+                parents.push_back(node);
+            }
+            level.swap(parents);
+        }
+        nodes.push_back(level.front());
+    }
+
+    void RTree::search(double minX, double minY, double maxX, double maxY, std::vector<Geometry *> &results) const
+    {
+        RTreeBounds window(minX, minY, maxX, maxY);
+        forEachInWindow(nodes, entries, pending, window, [&results](const Entry &entry) { results.push_back(entry.geometry); });
+    }
+
+    void RTree::search(const Polygon &window, std::vector<Geometry *> &results) const
+    {
+        RTreeBounds bounds;
+        if(!getGeometryBounds(&window, bounds))
+            return;
+        forEachInWindow(nodes, entries, pending, bounds, [&results, &window](const Entry &entry)
+        {
+            if(entry.geometry->intersects(&window))
+                results.push_back(entry.geometry);
+        });
+    }
+
+    Geometry *RTree::nearest(double x, double y, double maxDistance) const
+    {
+        std::vector<Geometry *> result = nearestN(x, y, 1, maxDistance);
+        return result.empty() ? NULL : result.front();
+    }
+
+    std::vector<Geometry *> RTree::nearestN(double x, double y, size_t k, double maxDistance) const
+    {
+        // best first search: candidates are ordered by the distance to their bounds, which never exceeds the true
+        // distance, so an entry popped with its exact distance is closer than anything left in the queue
+        std::vector<Geometry *> result;
+        if(k == 0)
+            return result;
+        double maxDistance2 = (maxDistance >= DBL_MAX) ? DBL_MAX : maxDistance * maxDistance;
+        std::priority_queue<NearestCandidate> queue;
+        if(!nodes.empty())
+            queue.push(makeCandidate(nodes.back().bounds.distance2(x, y), &nodes.back(), NULL, false));
+        for(size_t i = 0, c = pending.size(); i < c; ++i)
+            queue.push(makeCandidate(pending[i].bounds.distance2(x, y), NULL, &pending[i], false));
+        while(!queue.empty() && (result.size() < k))
+        {
+            NearestCandidate candidate = queue.top();
+            queue.pop();
+            if(candidate.distance2 > maxDistance2)
+                break;
+            if(candidate.entry)
+            {
+                if(candidate.exact)
+                    result.push_back(candidate.entry->geometry);
+                else
+                    queue.push(makeCandidate(getGeometryDistance2(*candidate.entry, x, y), NULL, candidate.entry, true));
+                continue;
+            }
+            const Node &node = *candidate.node;
+            for(size_t i = node.first, end = node.first + node.count; i < end; ++i)
+            {
+                if(node.leaf)
+                {
+                    if(entries[i].geometry)
+                        queue.push(makeCandidate(entries[i].bounds.distance2(x, y), NULL, &entries[i], false));
+                }
+                else
+                    queue.push(makeCandidate(nodes[i].bounds.distance2(x, y), &nodes[i], NULL, false));
+            }
+        }
+        return result;
+    }
+
+    void RTree::accept(RTreeVisitor &visitor) const
+    {
+        if(!nodes.empty())
+        {
+            std::vector<size_t> stack;
+            stack.push_back(nodes.size() - 1);
+            while(!stack.empty())
+            {
+                const Node &node = nodes[stack.back()];
+                stack.pop_back();
+                if(!visitor.acceptBounds(node.bounds))
+                    continue;
+                for(size_t i = node.first, end = node.first + node.count; i < end; ++i)
+                {
+                    if(!node.leaf)
+                        stack.push_back(i);
+                    else if(entries[i].geometry && visitor.acceptBounds(entries[i].bounds))
+                        visitor.visitGeometry(entries[i].geometry, entries[i].bounds);
+                }
+            }
+        }
+        for(size_t i = 0, c = pending.size(); i < c; ++i)
+        {
+            if(visitor.acceptBounds(pending[i].bounds))
+                visitor.visitGeometry(pending[i].geometry, pending[i].bounds);
+        }
+    }
+
+    RTreeVisitor::~RTreeVisitor(void)
+    {
+    }
+
+    RTreeVisitor::RTreeVisitor(void)
+    {
+    }
+
+    void RTreeVisitor::visit(RTree *tree)
+    {
+        visiting(tree);
+    }
+
+    void RTreeVisitor::visiting(RTree *tree)
+    {
+        if(tree)
+            tree->accept(*this);
+    }
+
+    bool RTreeVisitor::acceptBounds(const RTreeBounds &)
+    {
+        return true;
+    }
+
+    void RTreeVisitor::visitGeometry(Geometry *, const RTreeBounds &)
+    {
+    }
+
+    RTreeCollectGeometriesVisitor::~RTreeCollectGeometriesVisitor(void)
+    {
+    }
+
+    RTreeCollectGeometriesVisitor::RTreeCollectGeometriesVisitor(void) : minX(-DBL_MAX), maxX(DBL_MAX), minY(-DBL_MAX), maxY(DBL_MAX)
+    {
+    }
+
+    void RTreeCollectGeometriesVisitor::setBounds(double minX, double minY, double maxX, double maxY)
+    {
+        this->minX = minX;
+        this->minY = minY;
+        this->maxX = maxX;
+        this->maxY = maxY;
+    }
+
+    bool RTreeCollectGeometriesVisitor::acceptBounds(const RTreeBounds &bounds)
+    {
+        return bounds.intersects(RTreeBounds(minX, minY, maxX, maxY));
+    }
+
+    void RTreeCollectGeometriesVisitor::visitGeometry(Geometry *geometry, const RTreeBounds &)
+    {
+        results.push_back(geometry);
+    }
+
+    RTreeCollectGeometriesInPolygonVisitor::~RTreeCollectGeometriesInPolygonVisitor(void)
+    {
+    }
+
+    RTreeCollectGeometriesInPolygonVisitor::RTreeCollectGeometriesInPolygonVisitor(void) : windowBounds(0, 0, 0, 0)
+    {
+    }
+
+    void RTreeCollectGeometriesInPolygonVisitor::setBoundingPolygon(const Polygon &proposedWindow)
+    {
+        window = proposedWindow;
+        if(!getGeometryBounds(&window, windowBounds))
+            windowBounds = RTreeBounds();
+        results.clear();
+    }
+
+    bool RTreeCollectGeometriesInPolygonVisitor::acceptBounds(const RTreeBounds &bounds)
+    {
+        return bounds.intersects(windowBounds);
+    }
+
+    void RTreeCollectGeometriesInPolygonVisitor::visitGeometry(Geometry *geometry, const RTreeBounds &)
+    {
+        if(geometry->intersects(&window))
+            results.push_back(geometry);
+    }
+
+}
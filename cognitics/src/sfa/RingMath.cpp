@@ -33,8 +33,13 @@ namespace sfa {
     {
         if(!ring || !ring->isClosed()) return 0;
         double area = 0;
+        Point a = ring->getCoordinateN(0);
         for (int i = 0; i < ring->getNumPoints() - 1; i++)
-            area += (ring->getPointN(i)->X() + ring->getPointN(i+1)->X())*(ring->getPointN(i)->Y() - ring->getPointN(i+1)->Y());
+        {
+            Point b = ring->getCoordinateN(i+1);
+            area += (a.X() + b.X())*(a.Y() - b.Y());
+            a = b;
+        }
         return -area*0.5;
     }
 
@@ -50,17 +55,29 @@ namespace sfa {
     Centroid Algorithms
 ****************************************************************************/
 
+    namespace
+    {
+        void AddRingCentroidTerms(const LineString* ring, double& x, double& y)
+        {
+            if (ring->getNumPoints() < 2) return;
+            Point p1 = ring->getCoordinateN(0);
+            for (int i = 0; i < ring->getNumPoints() - 1; i++)
+            {
+                Point p2 = ring->getCoordinateN(i+1);
+                double b = p1.X()*p2.Y() - p1.Y()*p2.X();
+                x += (p1.X() + p2.X())*b;
+                y += (p1.Y() + p2.Y())*b;
+                p1 = p2;
+            }
+        }
+    }
+
     Point GetRingCentroid(const LineString* ring)
     {
         double x = 0;
         double y = 0;
 
-        for (int i = 0; i < ring->getNumPoints() - 1; i++)
-        {
-            double b = ring->getPointN(i)->X()*ring->getPointN(i+1)->Y() - ring->getPointN(i)->Y()*ring->getPointN(i+1)->X();
-            x += (ring->getPointN(i)->X() + ring->getPointN(i+1)->X())*b;
-            y += (ring->getPointN(i)->Y() + ring->getPointN(i+1)->Y())*b;
-        }
+        AddRingCentroidTerms(ring, x, y);
 
         double area = GetRingArea(ring);
         x /= 6*area;
@@ -77,23 +94,12 @@ namespace sfa {
     //    Add contribution of exterior ring
         LineString* ring = polygon->getExteriorRing();
 
-        for (int i = 0; i < ring->getNumPoints() - 1; i++)
-        {
-            double b = ring->getPointN(i)->X()*ring->getPointN(i+1)->Y() - ring->getPointN(i)->Y()*ring->getPointN(i+1)->X();
-            x += (ring->getPointN(i)->X() + ring->getPointN(i+1)->X())*b;
-            y += (ring->getPointN(i)->Y() + ring->getPointN(i+1)->Y())*b;
-        }
+        AddRingCentroidTerms(ring, x, y);
 
     //    Add contribution of interior rings
         for (int j = 0; j < polygon->getNumInteriorRing(); j++)
         {
-            ring = polygon->getInteriorRingN(j);
-            for (int i = 0; i < ring->getNumPoints() - 1; i++)
-            {
-                double b = ring->getPointN(i)->X()*ring->getPointN(i+1)->Y() - ring->getPointN(i)->Y()*ring->getPointN(i+1)->X();
-                x += (ring->getPointN(i)->X() + ring->getPointN(i+1)->X())*b;
-                y += (ring->getPointN(i)->Y() + ring->getPointN(i+1)->Y())*b;
-            }
+            AddRingCentroidTerms(polygon->getInteriorRingN(j), x, y);
         }
 
     //    Factor in area
@@ -187,8 +193,8 @@ namespace sfa {
     {
         for (int i = 1; i < ring.getNumPoints(); i++)
         {
-            Point p1 = *(ring.getPointN(i-1));
-            Point p2 = *(ring.getPointN(i));
+            Point p1 = ring.getCoordinateN(i-1);
+            Point p2 = ring.getCoordinateN(i);
 
             if (point.equals(&p1)) return true;
 
@@ -73,11 +73,15 @@ namespace sfa {
             return true;
         }
         //result is a segment
-        result = new LineString;
-        static_cast<LineString*>(result)->addPoint(new Point(points[0]));
-        static_cast<LineString*>(result)->getPointN(0)->clearZ();
-        static_cast<LineString*>(result)->addPoint(new Point(points[1]));
-        static_cast<LineString*>(result)->getPointN(1)->clearZ();
+        //    the points are copied without Z before they are added, so the segment stays packed
+        LineString* segment = new LineString;
+        for (int i = 0; i < 2; i++)
+        {
+            Point point(points[i]);
+            point.clearZ();
+            segment->addPoint(point);
+        }
+        result = segment;
         return true;
     }
 
@@ -122,8 +126,8 @@ namespace sfa {
         if (Bp2 && !p2p3) points.push_back(p2);
         if (Bp4) points.push_back(p4);
 
-        static_cast<LineString*>(result)->addPoint(new Point(points[0]));
-        static_cast<LineString*>(result)->addPoint(new Point(points[1]));
+        static_cast<LineString*>(result)->addPoint(Point(points[0]));
+        static_cast<LineString*>(result)->addPoint(Point(points[1]));
         return true;
     }
 
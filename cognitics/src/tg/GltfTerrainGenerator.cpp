@@ -2,6 +2,8 @@
 #include <ctl/ctl.h>
 #include <ip/pngwrapper.h>
 #include <ip/jpgwrapper.h>
+#include <ccl/JobManager.h>
+#include <memory>
 //#include <filesystem>
 
 
@@ -12,6 +14,95 @@
 
 using namespace cognitics;
 
+namespace
+{
+    // Elevation_DSM and the DataSourceManager cache behind it are not thread-safe,
+    // so each worker borrows a sampler of its own over the same files.
+    class ElevationSamplerPool
+    {
+        ccl::mutex samplersMutex;
+        std::vector<std::unique_ptr<elev::DataSourceManager> > managers;
+        std::vector<std::unique_ptr<elev::Elevation_DSM> > samplers;
+        std::vector<elev::Elevation_DSM*> available;
+
+    public:
+        ElevationSamplerPool(const std::vector<std::string>& filenames, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                managers.emplace_back(new elev::DataSourceManager(1000000));
+                for (auto& filename : filenames)
+                    managers.back()->AddFile_Raster_GDAL(filename);
+                managers.back()->generateBSP();
+                samplers.emplace_back(new elev::Elevation_DSM(managers.back().get(), elev::elevation_strategy::ELEVATION_BILINEAR));
+                available.push_back(samplers.back().get());
+            }
+        }
+
+        // there is one sampler per worker, so one is always free for a running job
+        elev::Elevation_DSM* acquire()
+        {
+            ccl::scoped_mutex lock(&samplersMutex);
+            elev::Elevation_DSM* sampler = available.back();
+            available.pop_back();
+            return sampler;
+        }
+
+        void release(elev::Elevation_DSM* sampler)
+        {
+            ccl::scoped_mutex lock(&samplersMutex);
+            available.push_back(sampler);
+        }
+    };
+
+    // Texture, TIN and GLB for one LOD tile. Results are collected by the caller in tile order once all jobs are done.
+    class LODTileJob : public ccl::Job
+    {
+    public:
+        LODTileJob(ccl::JobManager* manager, ElevationSamplerPool* samplers) : ccl::Job(manager), samplers(samplers), quantize(false), ok(false) { }
+
+        ElevationSamplerPool* samplers;
+        TileInfo info;
+        std::string outputPath;
+        std::string outputFormat;
+        bool quantize;
+
+        gltf::TileInfo tile;
+        scenegraph::ExternalReference ext;
+        bool ok;
+
+        virtual int execute(void)
+        {
+            std::string jpgFilename = ccl::joinPaths(outputPath, info.quadKey + ".jpg");
+            if (!TerrainGenerator::writeTileTexture(info.imageFileName, jpgFilename))
+            {
+                log << ccl::LERR << "Couldn't open tile image " << info.imageFileName << log.endl;
+                return -1;
+            }
+
+            const GeoExtents& e = info.extents;
+            cts::FlatEarthProjection projection((e.north + e.south) / 2, (e.east + e.west) / 2);
+            unsigned int seed = (unsigned int)std::hash<std::string>()(info.quadKey);
+            double minElev, maxElev;
+            elev::Elevation_DSM* edsm = samplers->acquire();
+            scenegraph::Scene* scene = TerrainGenerator::buildTileScene(jpgFilename, outputFormat, *edsm, projection, e.north, e.south, e.east, e.west, seed);
+            TerrainGenerator::getElevationRange(*edsm, e.north, e.south, e.east, e.west, 100, minElev, maxElev);
+            samplers->release(edsm);
+
+            std::string outputExportName = ccl::joinPaths(outputPath, info.quadKey + outputFormat);
+            ext.scale = sfa::Point(e.east - e.west, e.north - e.south, maxElev - minElev);
+            ext.position = sfa::Point(e.west, e.south, minElev);
+            ext.groupID = 1;
+            ext.filename = outputExportName;
+
+            scenegraph::buildGltfFromScene(outputExportName, scene, e.north, e.south, e.east, e.west, 0 /*minElev*/, maxElev, 1, 0.0, quantize, &tile);
+            delete scene;
+            ok = true;
+            return 0;
+        }
+    };
+}
+
 void GltfTerrainGenerator::AdjustJSON_UV(double& u, double& v)
 {
     //gltf uses upper left origin for uvs
@@ -23,19 +114,24 @@ void GltfTerrainGenerator::BuildFromScene(const std::string& outputName, scenegr
 {
 	logger << ccl::LWARNING << "BuildFromScene: GLTF requires bounding box for export. Make sure bounds are set correctly." << logger.endl;
 	std::string name = outputName;
-    scenegraph::buildGltfFromScene(name, scene, north, south, east, west);
+    gltf::TileInfo tile;
+    scenegraph::buildGltfFromScene(name, scene, north, south, east, west, 0.0, 1.0, 0, 0.0, meshQuantization, &tile);
+    tilesetTiles.push_back(tile);
 }
 
 void GltfTerrainGenerator::CreateMasterFile()
 {
-    scenegraph::buildTilesetFromScene(ccl::joinPaths(outputPath, "tileset.json"), &master, north, south, east, west);
+    scenegraph::buildTilesetFromScene(ccl::joinPaths(outputPath, "tileset.json"), &master, north, south, east, west, tilesetTiles);
+    tilesetTiles.clear();
 }
 
 void GltfTerrainGenerator::ExportBuilding(FeatureInfo& featureInfo, const ccl::FileInfo& fi, const std::string& outputPath, scenegraph::Scene* scene, float lat, float lon)
 {
     float elev = featureInfo.elev;
     std::string featurefilename = outputPath + fi.getBaseName(true) + ".b3dm";
-    scenegraph::buildGltfFromScene(featurefilename, scene, lat, lat, lon, lon, elev, elev+1.0, 2, featureInfo.AO1);
+    gltf::TileInfo tile;
+    scenegraph::buildGltfFromScene(featurefilename, scene, lat, lat, lon, lon, elev, elev+1.0, 2, featureInfo.AO1, meshQuantization, &tile);
+    tilesetTiles.push_back(tile);
 
 }
 
@@ -60,7 +156,9 @@ void GltfTerrainGenerator::ExportTree(int treeIndex, const ccl::FileInfo& fi, co
     ss << outputPath << fi.getBaseName(true) << "_" << treeIndex << ".b3dm";
     std::cout << "Writing tree file: " << fi.getBaseName(true) << "_" << treeIndex << std::endl;
 	std::string filename = ss.str();
-    scenegraph::buildGltfFromScene(filename, &scene2, lat, lat, lon, lon, elev, elev+1.0, 3);
+    gltf::TileInfo tile;
+    scenegraph::buildGltfFromScene(filename, &scene2, lat, lat, lon, lon, elev, elev+1.0, 3, 0.0, meshQuantization, &tile);
+    tilesetTiles.push_back(tile);
 
 }
 /*
@@ -341,7 +439,7 @@ void GltfTerrainGenerator::generateFixedGrid(const std::string & imgFile, const
 
 	logger << "Writing " << outputExportName << "..." << logger.endl;
 
-	scenegraph::buildGltfFromScene(outputExportName, scene, north, south, east, west, minElev, maxElev, 1);
+	scenegraph::buildGltfFromScene(outputExportName, scene, north, south, east, west, minElev, maxElev, 1, 0.0, meshQuantization);
 
 	delete tin;
 	delete dt;
@@ -385,20 +483,54 @@ void GltfTerrainGenerator::generateFixedGridWithLOD(std::string geoServerURL, do
 	GetData(geoServerURL, 0, infos.size(), &infos);
 
 	std::cout << "DONE" << std::endl;
-	elev::DataSourceManager dsm(1000000);
+	GDALAllRegister();
 
+	std::vector<std::string> elevationFileNames;
 	for (auto& info : infos)
 	{
-		dsm.AddFile_Raster_GDAL(info.elevationFileName);
+		elevationFileNames.push_back(info.elevationFileName);
+	}
+
+	elev::DataSourceManager dsm(1000000);
+	for (auto& filename : elevationFileNames)
+	{
+		dsm.AddFile_Raster_GDAL(filename);
 	}
+	dsm.generateBSP();
 
 	elev::Elevation_DSM edsm(&dsm, elev::elevation_strategy::ELEVATION_BILINEAR);
 
-	for (auto& info : infos)
+	// each tile is independent; the jobs are unowned so the results can be read back after the manager is done
+	tilesetTiles.clear();
 	{
-		generateFixedGrid(info.imageFileName, outputPath, info.quadKey, outputFormat, edsm, info.extents.north, info.extents.south, info.extents.east, info.extents.west);
+		size_t numThreads = std::min<size_t>(workers, std::max<size_t>(infos.size(), 1));
+		ElevationSamplerPool samplers(elevationFileNames, numThreads);
+		std::vector<std::unique_ptr<LODTileJob> > jobs;
+		ccl::JobManager manager(numThreads);
+		for (auto& info : infos)
+		{
+			jobs.emplace_back(new LODTileJob(&manager, &samplers));
+			LODTileJob* job = jobs.back().get();
+			job->info = info;
+			job->outputPath = outputPath;
+			job->outputFormat = outputFormat;
+			job->quantize = meshQuantization;
+			manager.submitJob(job, false);
+		}
+		manager.waitForCompletion();
+
+		// the root tile comes first, as Tileset expects
+		for (auto& job : jobs)
+		{
+			if (!job->ok)
+				continue;
+			tilesetTiles.push_back(job->tile);
+			master.externalReferences.push_back(job->ext);
+		}
 	}
 
+	SetBuildingElevations(edsm);
+
 	createFeatures(edsm);
 	//WriteLODfile(infos, outputPath + "/lodFile.txt", lodDepth);
 	setBounds(north, south, east, west);
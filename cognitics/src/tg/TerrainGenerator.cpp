@@ -26,6 +26,7 @@ DEALINGS IN THE SOFTWARE.
 
 #include "tg/TerrainGenerator.h"
 #include <ccl/FileInfo.h>
+#include <ccl/Arena.h>
 #include <ip/pngwrapper.h>
 #include <ip/jpgwrapper.h>
 #include <limits>
@@ -56,6 +57,9 @@ DEALINGS IN THE SOFTWARE.
 #include <string>
 #include <vector>
 #include <cctype>
+#include <random>
+#include <thread>
+#include <functional>
 
 #include "scenegraphgltf/scenegraphgltf.h"
 
@@ -71,7 +75,8 @@ namespace cognitics
         north(DBL_MAX), south(-DBL_MAX), east(DBL_MAX), west(-DBL_MAX),
         localNorth(DBL_MAX), localSouth(-DBL_MAX), localEast(DBL_MAX), localWest(-DBL_MAX),
         outputPath("output/"), 
-        textureWidth(1024), textureHeight(1024), texelSize(5.0f),
+        textureWidth(1024), textureHeight(1024), texelSize(5.0f), meshQuantization(false),
+        workers(std::max<int>(1, std::thread::hardware_concurrency())),
         elevationDSM(100 * 1024 * 1024), elevationSampler(&elevationDSM, elev::ELEVATION_BILINEAR)
     {
         logger.init("TerrainGenerator");
@@ -147,6 +152,18 @@ namespace cognitics
         logger << ccl::LINFO << "setTexelSize(" << texelSize << ")" << logger.endl;
     }
 
+    void TerrainGenerator::setMeshQuantization(bool meshQuantization)
+    {
+        this->meshQuantization = meshQuantization;
+        logger << ccl::LINFO << "setMeshQuantization(" << meshQuantization << ")" << logger.endl;
+    }
+
+    void TerrainGenerator::setWorkers(int workers)
+    {
+        this->workers = std::max<int>(1, workers);
+        logger << ccl::LINFO << "setWorkers(" << this->workers << ")" << logger.endl;
+    }
+
     /*void TerrainGenerator::generate(int row, int col)
     {
         master.externalReferences.clear();
@@ -1102,64 +1119,45 @@ namespace cognitics
         delete dt;
     }
 
-    void TerrainGenerator::generateFixedGrid(const std::string &imgFile, const std::string &outputPath, const std::string &outputName, std::string format, elev::Elevation_DSM& edsm, double north, double south, double east, double west)
+    bool TerrainGenerator::writeTileTexture(const std::string &imgFile, const std::string &jpgFilename)
     {
-        std::string outputFileName = ccl::joinPaths(outputPath, outputName + format);
         // open imgFile which is a tif.
-        GDALDataset  *poDataset;
-        GDALAllRegister();
-        poDataset = (GDALDataset *)GDALOpen(imgFile.c_str(), GA_ReadOnly);
+        GDALDataset *poDataset = (GDALDataset *)GDALOpen(imgFile.c_str(), GA_ReadOnly);
         if (poDataset == NULL)
         {
-            return;
+            return false;
         }
         int rasterWidth = poDataset->GetRasterXSize();
         int rasterHeight = poDataset->GetRasterYSize();
-        int len = rasterWidth * rasterHeight * 3;
-        unsigned char* buf = new unsigned char[len];
-        unsigned char* bufPtr = buf;
-
+        ccl::binary buffer;
+        buffer.resize(size_t(rasterWidth) * rasterHeight * 3);
         for (int i = 0; i < 3; i++)
         {
             auto pBand = poDataset->GetRasterBand(i + 1);
-            pBand->RasterIO(GF_Read, 0, 0, rasterWidth, rasterHeight, bufPtr + i, rasterWidth, rasterHeight, GDT_Byte, 3, 3 * rasterWidth);
+            pBand->RasterIO(GF_Read, 0, 0, rasterWidth, rasterHeight, &buffer[i], rasterWidth, rasterHeight, GDT_Byte, 3, 3 * rasterWidth);
         }
+        GDALClose(poDataset);
 
-        std::string jpgFilename = ccl::joinPaths(outputPath, outputName + ".jpg");
-        ExportTextureMetaData(jpgFilename);
         ip::ImageInfo info;
         info.width = rasterWidth;
         info.height = rasterHeight;
         info.depth = 3;
         info.interleaved = true;
         info.dataType = ip::ImageInfo::UBYTE;
-        ccl::binary buffer;
-        buffer.resize(len);
-        int counter = 0;
-        for (int i = 0; i < len; i++)
-        {
-            buffer[i] = buf[i];
-        }
-        ip::WriteJPG24(jpgFilename, info, buffer);
-        ExportTextureMetaData(jpgFilename);
-        delete[] buf;
-		ccl::FileInfo fi(outputName);
-		std::string tileName = fi.getBaseName(true);
-
-		flatEarth.setOrigin((north + south) / 2, (east + west) / 2);
+        return ip::WriteJPG24(jpgFilename, info, buffer);
+    }
 
-		double tileWorldNorth = north;
-		double tileWorldSouth = south;
-		double tileWorldWest = west;
-		double tileWorldEast = east;
+    scenegraph::Scene *TerrainGenerator::buildTileScene(const std::string &textureName, const std::string &format, elev::Elevation_DSM &edsm, const cts::FlatEarthProjection &projection, double north, double south, double east, double west, unsigned int seed)
+    {
+        // the elevation posts and boundary points sampled here are discarded once the scene is built
+        ccl::ArenaScope arenaScope(ccl::Arena::forThread());
 
-		localWest = flatEarth.convertGeoToLocalX(west);
-		localEast = flatEarth.convertGeoToLocalX(east);
-		localNorth = flatEarth.convertGeoToLocalY(north);
-		localSouth = flatEarth.convertGeoToLocalY(south);
-		double localWidth = localEast - localWest;
-		double localHeight = localNorth - localSouth;
-		logger << ccl::LINFO << "Using Elevation File MBR: N:" << north << "(" << localNorth << ") S:" << south << "(" << localSouth << ") W:" << west << "(" << localWest << ") E:" << east << "(" << localEast << ")" << logger.endl;
+        double localWest = projection.convertGeoToLocalX(west);
+        double localEast = projection.convertGeoToLocalX(east);
+        double localNorth = projection.convertGeoToLocalY(north);
+        double localSouth = projection.convertGeoToLocalY(south);
+        double localWidth = localEast - localWest;
+        double localHeight = localNorth - localSouth;
 
         int nSamples = 100;
 
@@ -1201,12 +1199,12 @@ namespace cognitics
             int col = 0;
             double lon = west;
             p.setX(lon);
-            double localPostX = flatEarth.convertGeoToLocalX(lon);
+            double localPostX = projection.convertGeoToLocalX(lon);
             for (int row = 0; row < nSamples; row++)
             {   // Go from pixel space to geo
                 double lat = (row * spacingY) + north;
                 // Go from geo to local                
-                double localPostY = flatEarth.convertGeoToLocalY(lat);
+                double localPostY = projection.convertGeoToLocalY(lat);
                 p.setY(lat);
                 edsm.Get(&p);
                 boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, p.Z()));
@@ -1215,40 +1213,40 @@ namespace cognitics
             col = nSamples - 1;
             lon = east;
             p.setX(lon);
-            localPostX = flatEarth.convertGeoToLocalX(lon);
+            localPostX = projection.convertGeoToLocalX(lon);
             for (int row = 0; row < nSamples; row++)
             {   // Go from pixel space to geo
                 double lat = (row * spacingY) + north;
                 // Go from geo to local
                 p.setY(lat);
                 edsm.Get(&p);
-                double localPostY = flatEarth.convertGeoToLocalY(lat);
+                double localPostY = projection.convertGeoToLocalY(lat);
                 boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, p.Z()));
             }
             // Bottom boundary
             double lat = south;
             p.setY(lat);
-            double localPostY = flatEarth.convertGeoToLocalY(lat);
+            double localPostY = projection.convertGeoToLocalY(lat);
             for (int col = 0; col < nSamples; col++)
             {   // Go from pixel space to geo
                 double lon = (col * spacingX) + west;
                 // Go from geo to local
                 p.setX(lon);
                 edsm.Get(&p);
-                double localPostX = flatEarth.convertGeoToLocalX(lon);
+                double localPostX = projection.convertGeoToLocalX(lon);
                 boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, p.Z()));
             }
             // Top boundary
             lat = north;
             p.setY(lat);
-            localPostY = flatEarth.convertGeoToLocalY(lat);
+            localPostY = projection.convertGeoToLocalY(lat);
             for (int col = 0; col < nSamples; col++)
             {   // Go from pixel space to geo
                 double lon = (col * spacingX) + west;
                 // Go from geo to local
                 p.setX(lon);
                 edsm.Get(&p);
-                double localPostX = flatEarth.convertGeoToLocalX(lon);
+                double localPostX = projection.convertGeoToLocalX(lon);
                 boundaryLineString.addPoint(sfa::Point(localPostX, localPostY, p.Z()));
             }
 
@@ -1265,15 +1263,14 @@ namespace cognitics
         {
             for (int row = 1; row < nSamples - 2; ++row)
             {
-                printf("");
                 for (int col = 1; col < nSamples - 2; ++col)
                 {
                     // Go from pixel space to geo
                     double lat = (row * spacingY) + north;
                     double lon = (col * spacingX) + west;
                     // Go from geo to local
-                    double localPostX = flatEarth.convertGeoToLocalX(lon);
-                    double localPostY = flatEarth.convertGeoToLocalY(lat);
+                    double localPostX = projection.convertGeoToLocalX(lon);
+                    double localPostY = projection.convertGeoToLocalY(lat);
                     p.setX(lon);
                     p.setY(lat);
                     edsm.Get(&p);
@@ -1288,8 +1285,10 @@ namespace cognitics
         ctl::DelaunayTriangulation *dt = new ctl::DelaunayTriangulation(gamingArea, delaunayResizeIncrement);
 
         //Randomly the order of point insertions to avoid worst case performance of DelaunayTriangulation
-        std::random_shuffle(boundaryPoints.begin(), boundaryPoints.end());
-        std::random_shuffle(workingPoints.begin(), workingPoints.end());
+        //The generator is seeded per tile so the output does not depend on which thread built it
+        std::mt19937 rng(seed);
+        std::shuffle(boundaryPoints.begin(), boundaryPoints.end(), rng);
+        std::shuffle(workingPoints.begin(), workingPoints.end(), rng);
 
         {
             //Alternate inserting boundary and working points to avoid worst case performance of DelaunayTriangulation
@@ -1342,7 +1341,7 @@ namespace cognitics
 
             // Add texturing
             scenegraph::MappedTexture mt;
-            mt.SetTextureName(jpgFilename);
+            mt.SetTextureName(textureName);
             // Each texture should map to the tile extents directly
             // So create a transform from the tile boundaries to local coordinates
             if (IsObjOutput(format))
@@ -1362,6 +1361,59 @@ namespace cognitics
             scene->faces.push_back(face);
         }
 
+        delete tin;
+        delete dt;
+        // the posts from the last sample belong to the arena scope
+        edsm.Clear();
+        return scene;
+    }
+
+    void TerrainGenerator::getElevationRange(elev::Elevation_DSM &edsm, double north, double south, double east, double west, int nSamples, double &minElev, double &maxElev)
+    {
+        double spacingX = (north - south) / nSamples;
+        double spacingY = -(east - west) / nSamples;
+        minElev = DBL_MAX;
+        maxElev = -DBL_MAX;
+        for (int row = 0; row < nSamples; ++row)
+        {
+            for (int col = 0; col < nSamples; ++col)
+            {
+                // Go from pixel space to geo
+                double lat = (row * spacingY) + north;
+                double lon = (col * spacingX) + west;
+                sfa::Point p1;
+                p1.setX(lon);
+                p1.setY(lat);
+                edsm.Get(&p1);
+                auto z = p1.Z();
+                minElev = std::min(z, minElev);
+                maxElev = std::max(z, maxElev);
+            }
+        }
+    }
+
+    void TerrainGenerator::generateFixedGrid(const std::string &imgFile, const std::string &outputPath, const std::string &outputName, std::string format, elev::Elevation_DSM& edsm, double north, double south, double east, double west)
+    {
+        std::string jpgFilename = ccl::joinPaths(outputPath, outputName + ".jpg");
+        GDALAllRegister();
+        if (!writeTileTexture(imgFile, jpgFilename))
+        {
+            return;
+        }
+        ExportTextureMetaData(jpgFilename);
+
+		flatEarth.setOrigin((north + south) / 2, (east + west) / 2);
+
+		localWest = flatEarth.convertGeoToLocalX(west);
+		localEast = flatEarth.convertGeoToLocalX(east);
+		localNorth = flatEarth.convertGeoToLocalY(north);
+		localSouth = flatEarth.convertGeoToLocalY(south);
+		double localWidth = localEast - localWest;
+		double localHeight = localNorth - localSouth;
+		logger << ccl::LINFO << "Using Elevation File MBR: N:" << north << "(" << localNorth << ") S:" << south << "(" << localSouth << ") W:" << west << "(" << localWest << ") E:" << east << "(" << localEast << ")" << logger.endl;
+
+        scenegraph::Scene *scene = buildTileScene(jpgFilename, format, edsm, flatEarth, north, south, east, west, (unsigned int)std::hash<std::string>()(outputName));
+
         logger << "Writing " << outputName << "..." << logger.endl;
 
 		std::string outputExportName = ccl::joinPaths(outputPath, outputName + format);
@@ -1378,24 +1430,8 @@ namespace cognitics
         ext.filename = outputExportName;
         if (IsGltfTypeOutput(format))
         {
-            double minElev = DBL_MAX;
-            double maxElev = DBL_MIN;
-            for (int row = 0; row < nSamples; ++row)
-            {
-                for (int col = 0; col < nSamples; ++col)
-                {
-                    // Go from pixel space to geo
-                    double lat = (row * spacingY) + north;
-                    double lon = (col * spacingX) + west;
-					sfa::Point p1;
-					p1.setX(lon);
-                    p1.setY(lat);
-                    edsm.Get(&p1);
-                    auto z = p1.Z();
-                    minElev = std::min(z, minElev);
-                    maxElev = std::max(z, maxElev);
-                }
-            }
+            double minElev, maxElev;
+            getElevationRange(edsm, north, south, east, west, 100, minElev, maxElev);
 
 			ext.groupID = 1;
             ext.position.setX(west);
@@ -1405,7 +1441,9 @@ namespace cognitics
             ext.scale.setY(north - south);
             ext.scale.setZ(maxElev - minElev);
 
-			scenegraph::buildGltfFromScene(outputExportName, scene, north, south, east, west, 0 /*minElev*/, maxElev, 1);
+            gltf::TileInfo tile;
+			scenegraph::buildGltfFromScene(outputExportName, scene, north, south, east, west, 0 /*minElev*/, maxElev, 1, 0.0, meshQuantization, &tile);
+            tilesetTiles.push_back(tile);
 
         }
         master.externalReferences.push_back(ext);
@@ -1414,8 +1452,6 @@ namespace cognitics
         {
             delete scene;
         }*/
-        delete tin;
-        delete dt;
 	}
 
 	/*void TerrainGenerator::generateFeatures(const std::string &featureFile, const std::string &outputName, GsBuildings *features, const std::vector<double> &grid, int spacingX, int spacingY, int width)